@@ -419,6 +419,8 @@ static PGFunction load_plpgsql_function(char* funcname)
         retval = &mot_fdw_validator;
     } else if (!strcmp(funcname, "mot_fdw_handler")) {
         retval = &mot_fdw_handler;
+    } else if (!strcmp(funcname, "mot_histogram_statistics")) {
+        retval = &mot_histogram_statistics;
 #endif
     } else if (!strcmp(funcname, "log_fdw_handler")) {
         retval = &log_fdw_handler;
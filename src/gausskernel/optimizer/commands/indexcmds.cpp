@@ -720,12 +720,18 @@ Oid DefineIndex(Oid relationId, IndexStmt* stmt, Oid indexRelationId, bool is_al
     }
     accessMethodId = HeapTupleGetOid(tuple);
     accessMethodForm = (Form_pg_am)GETSTRUCT(tuple);
-    if (stmt->unique && !accessMethodForm->amcanunique)
+#ifdef ENABLE_MOT
+    /* MOT builds its own unique, multicolumn hash indexes, it only borrows the hash operator classes */
+    bool isMOTHash = (strcmp(accessMethodName, "hash") == 0 && isMOTFromTblOid(RelationGetRelid(rel)));
+#else
+    bool isMOTHash = false;
+#endif
+    if (stmt->unique && !accessMethodForm->amcanunique && !isMOTHash)
         ereport(ERROR,
             (errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
                 errmsg("access method \"%s\" does not support unique indexes", accessMethodName)));
 
-    if (numberOfAttributes > 1 && !accessMethodForm->amcanmulticol)
+    if (numberOfAttributes > 1 && !accessMethodForm->amcanmulticol && !isMOTHash)
         ereport(ERROR,
             (errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
                 errmsg("access method \"%s\" does not support multicolumn indexes", accessMethodName)));
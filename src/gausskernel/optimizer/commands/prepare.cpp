@@ -47,6 +47,9 @@
 #include "pgxc/execRemote.h"
 #include "catalog/pgxc_node.h"
 #endif
+#ifdef ENABLE_MOT
+#include "storage/mot/jit_exec.h"
+#endif
 
 void InitQueryHashTable(void);
 static ParamListInfo EvaluateParams(PreparedStatement *pstmt, List* params, const char* queryString, EState* estate);
@@ -158,6 +161,20 @@ void PrepareQuery(PrepareStmt* stmt, const char* queryString)
             break;
     }
 
+#ifdef ENABLE_MOT
+    /* MOT statements prepared through SQL are jitted like those prepared through a Parse message */
+    StorageEngineType storageEngineType = SE_TYPE_UNSPECIFIED;
+    CheckTablesStorageEngine(query, &storageEngineType);
+    plansource->storageEngineType = storageEngineType;
+
+    if (storageEngineType == SE_TYPE_MOT && !IS_PGXC_COORDINATOR && JitExec::IsMotCodegenEnabled()) {
+        JitExec::JitPlan* jitPlan = JitExec::IsJittable(query, queryString);
+        if (jitPlan != NULL) {
+            plansource->mot_jit_context = JitExec::JitCodegenQuery(query, queryString, jitPlan);
+        }
+    }
+#endif
+
     /* Rewrite the query. The result could be 0, 1, or many queries. */
     query_list = QueryRewrite(query);
 
@@ -1225,6 +1242,14 @@ void ExplainExecuteQuery(
             ExplainSeparatePlans(es);
     }
 
+#ifdef ENABLE_MOT
+    /* tell whether EXECUTE runs the statement through MOT jitted code, and as which kind of query */
+    if (cplan->mot_jit_context != NULL && !IS_PGXC_COORDINATOR && JitExec::IsMotCodegenEnabled() &&
+        es->format == EXPLAIN_FORMAT_TEXT) {
+        appendStringInfo(es->str, "MOT JIT: %s\n", JitExec::GetJitContextCommand(cplan->mot_jit_context));
+    }
+#endif
+
     if (estate != NULL)
         FreeExecutorState(estate);
 
@@ -267,6 +267,14 @@ volatile bool is_stable_epoch_send = false, is_epoch_advanced_by_message = true,
 std::vector<std::string> kTxnNodeIp, kStorageNodeIp;
 std::string kLocalIp;
 uint64_t kStorageUpdaterThreadNum = 32, kStorageReaderThreadNum = 32, kMessageManagerThreadNum = 4, kEpochSize_us = 10000, txn_ip_index = 0 ;
+uint64_t kClientBatchWindow_us = 0, kClientBatchMaxTxnNum = 256; // client send batching, 0 means send every txn at once
+// wire compression: codec none/lz4/zstd/adaptive, the codecs txn nodes decode and the link bandwidth to assume
+std::string kWireCodec = "adaptive", kTxnWireCodec;
+uint64_t kWireCodecLevel = 1, kLinkBandwidthMbps = 10000;
+// txn node routing: p2c (power of two choices), least (least outstanding) or round_robin
+std::string kTxnRoutePolicy = "p2c";
+uint64_t kTxnReplyTimeout_us = 500000; // a verdict this late ejects its txn node from routing for a while
+uint64_t kTxnVerdictTimeout_us = 10000000; // a txn still without a verdict this long after the reply timeout is aborted
 
 void GenerateClientThreads();
 void GenerateStorageThreads();
@@ -11466,6 +11474,11 @@ void GenerateStorageThreads(){
         storage_message_manager_thread_ids.push_back(g_instance.pid_cxt.StorageMessageManagerPIDS[i]);
     }
 
+    // every updater owns one apply lane, workers beyond the lane limit would have nothing to apply
+    if (kStorageUpdaterThreadNum > FDWStorageMaxApplyLaneNum()) {
+        ereport(LOG, (errmsg("storage updater threads limited to %lu apply lanes", FDWStorageMaxApplyLaneNum())));
+        kStorageUpdaterThreadNum = FDWStorageMaxApplyLaneNum();
+    }
     g_instance.pid_cxt.StorageUpdaterPIDS = (ThreadId*)palloc( kStorageUpdaterThreadNum * sizeof(ThreadId));
     if (g_instance.pid_cxt.StorageUpdaterPIDS == NULL && kStorageUpdaterThreadNum != 0) {
         ereport(FATAL, (errmsg("communicator palloc StorageUpdaterPIDS mempry failed")));
@@ -11510,6 +11523,16 @@ void TaasGetServerInfo(){
         symbol_local_or_remote++;
     }
 
+    tinyxml2::XMLElement* storage_element = root->FirstChildElement("storage_node_ip");
+    while (storage_element) {
+        tinyxml2::XMLElement* storage_ip = storage_element->FirstChildElement("storage_ip");
+        while (storage_ip) {
+            kStorageNodeIp.push_back(std::string(storage_ip->GetText()));
+            storage_ip = storage_ip->NextSiblingElement();
+        }
+        storage_element = storage_element->NextSiblingElement("storage_node_ip");
+    }
+
     tinyxml2::XMLElement* local_ip = root->FirstChildElement("client_local_ip");
     std::string temp3(local_ip->GetText());
     kLocalIp = temp3;
@@ -11518,11 +11541,69 @@ void TaasGetServerInfo(){
     kMessageManagerThreadNum = std::stoull(message_num->GetText());
     tinyxml2::XMLElement* worker_num = root->FirstChildElement("worker_thread_num");
     kStorageUpdaterThreadNum = kStorageReaderThreadNum = std::stoull(worker_num->GetText());
+    tinyxml2::XMLElement* batch_window = root->FirstChildElement("client_batch_window_us");
+    if (batch_window != nullptr) {
+        kClientBatchWindow_us = std::stoull(batch_window->GetText());
+    }
+    tinyxml2::XMLElement* batch_max_txn = root->FirstChildElement("client_batch_max_txn_num");
+    if (batch_max_txn != nullptr) {
+        kClientBatchMaxTxnNum = std::stoull(batch_max_txn->GetText());
+        if (kClientBatchMaxTxnNum == 0) {
+            kClientBatchMaxTxnNum = 1;
+        }
+    }
+
+    tinyxml2::XMLElement* wire_codec = root->FirstChildElement("wire_codec");
+    if (wire_codec != nullptr) {
+        kWireCodec = std::string(wire_codec->GetText());
+    }
+    tinyxml2::XMLElement* wire_codec_level = root->FirstChildElement("wire_codec_level");
+    if (wire_codec_level != nullptr) {
+        kWireCodecLevel = std::stoull(wire_codec_level->GetText());
+    }
+    tinyxml2::XMLElement* txn_wire_codec = root->FirstChildElement("txn_wire_codec");
+    if (txn_wire_codec != nullptr && txn_wire_codec->GetText() != nullptr) {
+        kTxnWireCodec = std::string(txn_wire_codec->GetText());
+    }
+    tinyxml2::XMLElement* link_bandwidth = root->FirstChildElement("link_bandwidth_mbps");
+    if (link_bandwidth != nullptr) {
+        kLinkBandwidthMbps = std::stoull(link_bandwidth->GetText());
+        if (kLinkBandwidthMbps == 0) {
+            kLinkBandwidthMbps = 1;
+        }
+    }
+    tinyxml2::XMLElement* route_policy = root->FirstChildElement("txn_route_policy");
+    if (route_policy != nullptr) {
+        kTxnRoutePolicy = std::string(route_policy->GetText());
+    }
+    tinyxml2::XMLElement* reply_timeout = root->FirstChildElement("txn_reply_timeout_us");
+    if (reply_timeout != nullptr) {
+        kTxnReplyTimeout_us = std::stoull(reply_timeout->GetText());
+    }
+    tinyxml2::XMLElement* verdict_timeout = root->FirstChildElement("txn_verdict_timeout_us");
+    if (verdict_timeout != nullptr) {
+        kTxnVerdictTimeout_us = std::stoull(verdict_timeout->GetText());
+        if (kTxnVerdictTimeout_us == 0) {
+            kTxnVerdictTimeout_us = 1;
+        }
+    }
+    tinyxml2::XMLElement* protobuf_gzip = root->FirstChildElement("protobuf_gzip");
+    if (protobuf_gzip != nullptr) {
+        is_protobuf_gzip = (std::string(protobuf_gzip->GetText()) == "true");
+    }
 
     ereport(LOG, (errmsg("========================================================")));
     for(int i = 0; i < (int)kTxnNodeIp.size(); i++ ){
         ereport(LOG, (errmsg("ip: %s",kTxnNodeIp[i].c_str())));
     }
+    for(int i = 0; i < (int)kStorageNodeIp.size(); i++ ){
+        ereport(LOG, (errmsg("storage ip: %s",kStorageNodeIp[i].c_str())));
+    }
     ereport(LOG, (errmsg("master_ip %s", kLocalIp.c_str())));
+    ereport(LOG, (errmsg("client_batch_window_us %lu client_batch_max_txn_num %lu", kClientBatchWindow_us, kClientBatchMaxTxnNum)));
+    ereport(LOG, (errmsg("wire_codec %s level %lu txn_wire_codec %s link_bandwidth_mbps %lu protobuf_gzip %d", kWireCodec.c_str(),
+        kWireCodecLevel, kTxnWireCodec.c_str(), kLinkBandwidthMbps, (int)is_protobuf_gzip)));
+    ereport(LOG, (errmsg("txn_route_policy %s txn_reply_timeout_us %lu txn_verdict_timeout_us %lu", kTxnRoutePolicy.c_str(),
+        kTxnReplyTimeout_us, kTxnVerdictTimeout_us)));
     ereport(LOG, (errmsg("========================================================")));
 }
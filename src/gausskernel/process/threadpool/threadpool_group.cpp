@@ -72,6 +72,7 @@ ThreadPoolGroup::ThreadPoolGroup(int maxWorkerNum, int expectWorkerNum, int maxS
       m_sessionCount(0),
       m_waitServeSessionCount(0),
       m_processTaskCount(0),
+      m_remoteWaitWorkerNum(0),
       m_groupId(groupId),
       m_numaId(numaId),
       m_groupCpuNum(cpuNum),
@@ -356,6 +357,32 @@ bool ThreadPoolGroup::IsGroupHang()
     return ishang;
 }
 
+/*
+ * A worker waiting for a remote commit verdict (e.g. MOT transactions offloaded to TaaS) holds
+ * its session but does no work. We account for it so the scheduler can bring up more workers
+ * for the ready sessions instead of waiting for the hang detection to kick in.
+ */
+void ThreadPoolGroup::BeginRemoteWait()
+{
+    (void)pg_atomic_fetch_add_u32((volatile uint32*)&m_remoteWaitWorkerNum, 1);
+}
+
+void ThreadPoolGroup::EndRemoteWait()
+{
+    (void)pg_atomic_fetch_sub_u32((volatile uint32*)&m_remoteWaitWorkerNum, 1);
+}
+
+/*
+ * The workers added for remote waits are capped at one per waiting worker on top of the default
+ * worker count, and at the group's max worker count.
+ */
+bool ThreadPoolGroup::IsRemoteWaitStarved()
+{
+    int remoteWaitWorkerNum = m_remoteWaitWorkerNum;
+    return remoteWaitWorkerNum != 0 && m_idleWorkerNum == 0 && m_waitServeSessionCount != 0 &&
+           m_expectWorkerNum < Min(m_defaultWorkerNum + remoteWaitWorkerNum, m_maxWorkerNum);
+}
+
 void ThreadPoolGroup::AttachThreadToCPU(ThreadId thread, int cpu)
 {
     cpu_set_t cpuset;
@@ -153,6 +153,15 @@ void ThreadPoolScheduler::ShutDown() const
 void ThreadPoolScheduler::AdjustWorkerPool(int idx)
 {
     ThreadPoolGroup* group = m_groups[idx];
+    /*
+     * Workers parked on remote commit replies while sessions wait to be served: enlarge right
+     * away, the group is not hung, it is just short of runnable workers. Once the group cannot
+     * grow any more for that reason, fall through to the regular hang detection.
+     */
+    if (group->IsRemoteWaitStarved() && group->EnlargeWorkers(THREAD_SCHEDULER_STEP)) {
+        m_freeTestCount[idx] = 0;
+        return;
+    }
     /* When no idle worker and no task has been processed, the system may hang. */
     if (group->IsGroupHang()) {
         m_hangTestCount[idx]++;
@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * -------------------------------------------------------------------------
+ *
+ * snapshot_registry.cpp
+ *    Registry of the snapshot CSNs used by transactions reading row versions.
+ *
+ * IDENTIFICATION
+ *    src/gausskernel/storage/mot/core/src/concurrency_control/snapshot_registry.cpp
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include "snapshot_registry.h"
+
+namespace MOT {
+constexpr uint32_t SnapshotRegistry::INVALID_SLOT;
+constexpr uint32_t SnapshotRegistry::MAX_SNAPSHOT_SLOTS;
+constexpr uint64_t SnapshotRegistry::FREE_SLOT;
+
+SnapshotRegistry SnapshotRegistry::m_instance;
+
+void SnapshotRegistry::SetStableCsn(uint64_t csn)
+{
+    uint64_t current = m_stableCsn.load(std::memory_order_relaxed);
+    while (current < csn && !m_stableCsn.compare_exchange_weak(current, csn, std::memory_order_acq_rel)) {
+    }
+}
+
+uint32_t SnapshotRegistry::Acquire(uint64_t& snapshotCsn)
+{
+    uint64_t provisional = GetStableCsn();
+    uint32_t start = m_nextSlot.fetch_add(1, std::memory_order_relaxed);
+    for (uint32_t i = 0; i < MAX_SNAPSHOT_SLOTS; ++i) {
+        uint32_t slot = (start + i) % MAX_SNAPSHOT_SLOTS;
+        uint64_t expected = FREE_SLOT;
+        if (m_slots[slot].m_csn.compare_exchange_strong(expected, provisional + 1, std::memory_order_seq_cst)) {
+            // Re-read after publishing the slot: a trimmer that missed the slot read the stable CSN before we did
+            // here, so it keeps everything visible at this (possibly newer) snapshot.
+            snapshotCsn = m_stableCsn.load(std::memory_order_seq_cst);
+            return slot;
+        }
+    }
+    return INVALID_SLOT;
+}
+
+void SnapshotRegistry::Release(uint32_t slot)
+{
+    if (slot < MAX_SNAPSHOT_SLOTS) {
+        m_slots[slot].m_csn.store(FREE_SLOT, std::memory_order_release);
+    }
+}
+
+uint64_t SnapshotRegistry::GetOldestSnapshot() const
+{
+    // the stable CSN must be read before the slots, see Acquire()
+    uint64_t oldest = m_stableCsn.load(std::memory_order_seq_cst);
+    for (uint32_t i = 0; i < MAX_SNAPSHOT_SLOTS; ++i) {
+        uint64_t csn = m_slots[i].m_csn.load(std::memory_order_seq_cst);
+        if (csn != FREE_SLOT && csn - 1 < oldest) {
+            oldest = csn - 1;
+        }
+    }
+    return oldest;
+}
+}  // namespace MOT
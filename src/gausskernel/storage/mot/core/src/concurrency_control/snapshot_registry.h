@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * -------------------------------------------------------------------------
+ *
+ * snapshot_registry.h
+ *    Registry of the snapshot CSNs used by transactions reading row versions.
+ *
+ * IDENTIFICATION
+ *    src/gausskernel/storage/mot/core/src/concurrency_control/snapshot_registry.h
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef MOT_SNAPSHOT_REGISTRY_H
+#define MOT_SNAPSHOT_REGISTRY_H
+
+#include <atomic>
+#include <cstdint>
+
+namespace MOT {
+/**
+ * @class SnapshotRegistry
+ * @brief Tracks the snapshot CSNs of transactions that read row versions (see enable_row_versions). Row versions
+ * are trimmed only below the oldest registered snapshot, and the trimmed versions are reclaimed through the GC.
+ */
+class SnapshotRegistry {
+public:
+    /** @var Returned by Acquire() when all snapshot slots are taken. */
+    static constexpr uint32_t INVALID_SLOT = (uint32_t)-1;
+
+    /** @brief Retrieves the single registry instance. */
+    static SnapshotRegistry& GetInstance()
+    {
+        return m_instance;
+    }
+
+    /**
+     * @brief Advances the stable CSN, up to which every committed row version is installed.
+     * @param csn The new stable CSN. Lower values are ignored.
+     */
+    void SetStableCsn(uint64_t csn);
+
+    /** @brief Retrieves the stable CSN. */
+    inline uint64_t GetStableCsn() const
+    {
+        return m_stableCsn.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Registers a reader at the current stable CSN.
+     * @param[out] snapshotCsn The snapshot CSN the reader must use.
+     * @return The slot to pass to Release(), or INVALID_SLOT if no slot is available.
+     */
+    uint32_t Acquire(uint64_t& snapshotCsn);
+
+    /**
+     * @brief Unregisters a reader.
+     * @param slot The slot returned by Acquire().
+     */
+    void Release(uint32_t slot);
+
+    /**
+     * @brief Retrieves the oldest snapshot CSN a current or future reader may use. Versions that are not visible at
+     * this CSN or any later one may be retired.
+     */
+    uint64_t GetOldestSnapshot() const;
+
+private:
+    SnapshotRegistry() : m_stableCsn(0), m_nextSlot(0)
+    {
+        for (uint32_t i = 0; i < MAX_SNAPSHOT_SLOTS; ++i) {
+            m_slots[i].m_csn.store(FREE_SLOT, std::memory_order_relaxed);
+        }
+    }
+
+    /** @var Maximum number of concurrently registered readers. */
+    static constexpr uint32_t MAX_SNAPSHOT_SLOTS = 1024;
+
+    /** @var A free slot. Snapshots are stored as csn + 1, so CSN 0 is a valid snapshot. */
+    static constexpr uint64_t FREE_SLOT = 0;
+
+    struct alignas(64) SnapshotSlot {
+        std::atomic<uint64_t> m_csn;
+    };
+
+    /** @var The single registry instance. */
+    static SnapshotRegistry m_instance;
+
+    /** @var The registered snapshots. */
+    SnapshotSlot m_slots[MAX_SNAPSHOT_SLOTS];
+
+    /** @var Up to this CSN every committed row version is installed. */
+    std::atomic<uint64_t> m_stableCsn;
+
+    /** @var Where the next slot search starts. */
+    std::atomic<uint32_t> m_nextSlot;
+};
+}  // namespace MOT
+
+#endif /* MOT_SNAPSHOT_REGISTRY_H */
@@ -0,0 +1,157 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * -------------------------------------------------------------------------
+ *
+ * histogram_statistic_variable.cpp
+ *    A statistic variable computing percentiles of integral samples.
+ *
+ * IDENTIFICATION
+ *    src/gausskernel/storage/mot/core/src/infra/stats/histogram_statistic_variable.cpp
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include <math.h>
+#include <stdio.h>
+
+#include "histogram_statistic_variable.h"
+
+namespace MOT {
+constexpr uint32_t HistogramStatisticVariable::SUB_BUCKET_BITS;
+constexpr uint32_t HistogramStatisticVariable::SUB_BUCKET_COUNT;
+constexpr uint32_t HistogramStatisticVariable::MAX_VALUE_BITS;
+constexpr uint32_t HistogramStatisticVariable::BUCKET_COUNT;
+
+HistogramStatisticVariable::HistogramStatisticVariable(const char* name, const char* units /* = "" */)
+    : StatisticVariable(name), m_max(0), m_countSaved(0), m_p50(0), m_p90(0), m_p99(0), m_p999(0)
+{
+    errno_t erc = snprintf_s(m_units, STAT_VAR_MAX_NAME_LEN, STAT_VAR_MAX_NAME_LEN - 1, "%s", units);
+    securec_check_ss(erc, "\0", "\0");
+    erc = memset_s(m_buckets, sizeof(m_buckets), 0, sizeof(m_buckets));
+    securec_check(erc, "\0", "\0");
+}
+
+uint64_t HistogramStatisticVariable::GetBucketValue(uint32_t bucket)
+{
+    if (bucket < SUB_BUCKET_COUNT) {
+        return bucket;
+    }
+    uint32_t shift = bucket / SUB_BUCKET_COUNT - 1;
+    uint64_t lowerBound = (uint64_t)(SUB_BUCKET_COUNT + bucket % SUB_BUCKET_COUNT) << shift;
+    return lowerBound + (((uint64_t)1 << shift) >> 1);
+}
+
+uint64_t HistogramStatisticVariable::GetPercentile(double percentile) const
+{
+    // sum the buckets rather than use m_count, which may be ahead of them while samples are being added
+    uint64_t count = 0;
+    for (uint32_t i = 0; i < BUCKET_COUNT; ++i) {
+        count += m_buckets[i];
+    }
+    if (count == 0) {
+        return 0;
+    }
+
+    uint64_t rank = (uint64_t)ceil(count * percentile / 100.0);
+    if (rank == 0) {
+        rank = 1;
+    }
+    uint64_t seen = 0;
+    for (uint32_t i = 0; i < BUCKET_COUNT; ++i) {
+        seen += m_buckets[i];
+        if (seen >= rank) {
+            uint64_t value = GetBucketValue(i);
+            return (value < m_max) ? value : m_max;
+        }
+    }
+    return m_max;
+}
+
+void HistogramStatisticVariable::Summarize(bool updateTstamp)
+{
+    (void)updateTstamp;
+    m_countSaved = m_count;
+    m_p50 = GetPercentile(50.0);
+    m_p90 = GetPercentile(90.0);
+    m_p99 = GetPercentile(99.0);
+    m_p999 = GetPercentile(99.9);
+}
+
+void HistogramStatisticVariable::Print(LogLevel logLevel) const
+{
+    MOT_LOG(logLevel,
+        "%s={ samples: %" PRIu64 ", p50: %" PRIu64 " %s, p90: %" PRIu64 " %s, p99: %" PRIu64 " %s, p99.9: %" PRIu64
+        " %s, max: %" PRIu64 " %s }",
+        m_name,
+        m_countSaved,
+        m_p50,
+        m_units,
+        m_p90,
+        m_units,
+        m_p99,
+        m_units,
+        m_p999,
+        m_units,
+        m_max,
+        m_units);
+}
+
+void HistogramStatisticVariable::Assign(const StatisticVariable& rhs)
+{
+    const HistogramStatisticVariable& histRhs = static_cast<const HistogramStatisticVariable&>(rhs);
+    errno_t erc = memcpy_s(m_buckets, sizeof(m_buckets), histRhs.m_buckets, sizeof(histRhs.m_buckets));
+    securec_check(erc, "\0", "\0");
+    m_max = histRhs.m_max;
+    m_count = histRhs.m_count;
+}
+
+void HistogramStatisticVariable::Add(const StatisticVariable& rhs)
+{
+    const HistogramStatisticVariable& histRhs = static_cast<const HistogramStatisticVariable&>(rhs);
+    for (uint32_t i = 0; i < BUCKET_COUNT; ++i) {
+        m_buckets[i] += histRhs.m_buckets[i];
+    }
+    if (histRhs.m_max > m_max) {
+        m_max = histRhs.m_max;
+    }
+    m_count += histRhs.m_count;
+}
+
+void HistogramStatisticVariable::Subtract(const StatisticVariable& rhs)
+{
+    const HistogramStatisticVariable& histRhs = static_cast<const HistogramStatisticVariable&>(rhs);
+    for (uint32_t i = 0; i < BUCKET_COUNT; ++i) {
+        m_buckets[i] -= histRhs.m_buckets[i];
+    }
+    m_count -= histRhs.m_count;
+}
+
+void HistogramStatisticVariable::Divide(uint32_t factor)
+{
+    if (factor > 0) {
+        for (uint32_t i = 0; i < BUCKET_COUNT; ++i) {
+            m_buckets[i] /= factor;
+        }
+        m_count /= factor;
+    }
+}
+
+void HistogramStatisticVariable::Reset()
+{
+    errno_t erc = memset_s(m_buckets, sizeof(m_buckets), 0, sizeof(m_buckets));
+    securec_check(erc, "\0", "\0");
+    m_max = 0;
+    m_count = 0;
+}
+}  // namespace MOT
@@ -0,0 +1,180 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * -------------------------------------------------------------------------
+ *
+ * histogram_statistic_variable.h
+ *    A statistic variable computing percentiles of integral samples.
+ *
+ * IDENTIFICATION
+ *    src/gausskernel/storage/mot/core/src/infra/stats/histogram_statistic_variable.h
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef HISTOGRAM_STATISTIC_VARIABLE_H
+#define HISTOGRAM_STATISTIC_VARIABLE_H
+
+#include "statistic_variable.h"
+
+namespace MOT {
+/**
+ * @class HistogramStatisticVariable
+ * @brief A statistic variable for integral types (usually latencies). It computes percentiles of the samples.
+ * @detail Samples are counted in logarithmic buckets (HDR style): values below 8 have a bucket each, and every
+ * power of two above is split into 8 linear sub-buckets, so a reported percentile is off by at most 1/16 of its value.
+ * Adding a sample only increments a counter, and histograms are merged by adding their counters, so per-thread
+ * histograms are aggregated like any other statistic variable. Values of 2^40 or more share the last bucket.
+ */
+class HistogramStatisticVariable : public StatisticVariable {
+public:
+    /**
+     * @brief Constructor.
+     * @param name Name used for printing.
+     * @param units The unit name to use in display.
+     */
+    explicit HistogramStatisticVariable(const char* name, const char* units = "");
+
+    /** @brief Destructor. */
+    ~HistogramStatisticVariable() override
+    {}
+
+    /**
+     * @brief Summarizes statistics for printing.
+     * @param updateTstamp Unused.
+     */
+    void Summarize(bool updateTstamp) override;
+
+    /**
+     * @brief Prints statistics to log file using the given log level.
+     * @param log_levelThe log level to use.
+     */
+    void Print(LogLevel logLevel) const override;
+
+    /**
+     * @brief Copies statistics from another object into this object.
+     * @param rhs The right-hand-side object to copy from.
+     */
+    void Assign(const StatisticVariable& rhs) override;
+
+    /**
+     * @brief Adds statistics of another object to this object.
+     * @param rhs The right-hand-side object to add from.
+     */
+    void Add(const StatisticVariable& rhs) override;
+
+    /**
+     * @brief Subtracts statistics of another object from this object. The maximum cannot be subtracted, so it
+     * remains the maximum of this object.
+     * @param rhs The right-hand-side subtrahend object.
+     */
+    void Subtract(const StatisticVariable& rhs) override;
+
+    /**
+     * @brief Divides the statistics of this object by a given factor.
+     * @param factor The division factor.
+     */
+    void Divide(uint32_t factor) override;
+
+    /**
+     * @brief Resets all statistic values to zero.
+     */
+    void Reset() override;
+
+    const HistogramStatisticVariable* AsHistogram() const override
+    {
+        return this;
+    }
+
+    /**
+     * @brief Adds a sample to the statistics.
+     * @param value The sample value
+     */
+    inline void AddSample(uint64_t value)
+    {
+        ++m_buckets[GetBucket(value)];
+        if (value > m_max) {
+            m_max = value;
+        }
+        ++m_count;
+    }
+
+    /**
+     * @brief Computes a percentile of all the samples.
+     * @param percentile The percentile in the range (0, 100].
+     * @return The percentile value (the middle of the bucket holding it), or zero if there are no samples.
+     */
+    uint64_t GetPercentile(double percentile) const;
+
+    /** @brief Retrieves the maximum sample value. */
+    inline uint64_t GetMax() const
+    {
+        return m_max;
+    }
+
+    /** @brief Retrieves the unit name of the samples. */
+    inline const char* GetUnits() const
+    {
+        return m_units;
+    }
+
+    /** @var The number of bits of a bucket value that select its sub-bucket. */
+    static constexpr uint32_t SUB_BUCKET_BITS = 3;
+
+    /** @var The number of sub-buckets every power of two is split into. */
+    static constexpr uint32_t SUB_BUCKET_COUNT = 1U << SUB_BUCKET_BITS;
+
+    /** @var The number of bits of the largest value having its own bucket. */
+    static constexpr uint32_t MAX_VALUE_BITS = 40;
+
+    /** @var The number of buckets. */
+    static constexpr uint32_t BUCKET_COUNT = (MAX_VALUE_BITS - SUB_BUCKET_BITS + 1) * SUB_BUCKET_COUNT;
+
+private:
+    /** @brief Computes the bucket of a value. */
+    static inline uint32_t GetBucket(uint64_t value)
+    {
+        if (value < SUB_BUCKET_COUNT) {
+            return (uint32_t)value;
+        }
+        uint32_t msb = 63 - (uint32_t)__builtin_clzll(value);
+        if (msb >= MAX_VALUE_BITS) {
+            return BUCKET_COUNT - 1;
+        }
+        uint32_t shift = msb - SUB_BUCKET_BITS;
+        return (msb - SUB_BUCKET_BITS + 1) * SUB_BUCKET_COUNT + (uint32_t)((value >> shift) & (SUB_BUCKET_COUNT - 1));
+    }
+
+    /** @brief Computes the value representing a bucket (its middle). */
+    static uint64_t GetBucketValue(uint32_t bucket);
+
+    /** @var Unit name to use in display. */
+    char m_units[STAT_VAR_MAX_NAME_LEN];
+
+    /** @var The maximum sample value. */
+    uint64_t m_max;
+
+    /** @var The sample count of each bucket. */
+    uint64_t m_buckets[BUCKET_COUNT];
+
+    /** @var Last seen sample count. */
+    uint64_t m_countSaved;
+
+    /** @var Percentiles computed when last summarized. */
+    uint64_t m_p50;
+    uint64_t m_p90;
+    uint64_t m_p99;
+    uint64_t m_p999;
+};
+}  // namespace MOT
+#endif /* HISTOGRAM_STATISTIC_VARIABLE_H */
@@ -32,6 +32,8 @@
 constexpr size_t STAT_VAR_MAX_NAME_LEN = 64;
 
 namespace MOT {
+class HistogramStatisticVariable;
+
 /**
  * @class StatisticVariable
  * @brief The base class for all statistic variable types.
@@ -108,6 +110,15 @@ public:
      */
     virtual void Reset() = 0;
 
+    /**
+     * @brief Retrieves this object as a histogram statistic variable.
+     * @return The histogram, or null if this is not a histogram statistic variable.
+     */
+    virtual const HistogramStatisticVariable* AsHistogram() const
+    {
+        return nullptr;
+    }
+
     /**
      * Retrieves the amount of samples accumulated in this statistic variable.
      * @return The sample count.
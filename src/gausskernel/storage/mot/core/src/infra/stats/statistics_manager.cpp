@@ -366,6 +366,25 @@ void StatisticsManager::PrintStatistics(LogLevel logLevel, uint32_t statOpts /*
     pthread_mutex_unlock(&m_providersLock);
 }
 
+bool StatisticsManager::GetHistogramSummaries(mot_vector<HistogramSummary>& summaries)
+{
+    bool result = true;
+    pthread_mutex_lock(&m_providersLock);
+
+    mot_list<StatisticsProvider*>::iterator itr = m_providers.begin();
+    while (itr != m_providers.end()) {
+        StatisticsProvider* provider = *itr;
+        if (provider->IsEnabled() && !provider->GetHistogramSummaries(summaries)) {
+            result = false;
+            break;
+        }
+        ++itr;
+    }
+
+    pthread_mutex_unlock(&m_providersLock);
+    return result;
+}
+
 bool StatisticsManager::StartStatsPrintThread()
 {
     if (!m_running) {
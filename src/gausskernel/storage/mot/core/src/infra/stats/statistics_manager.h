@@ -114,6 +114,13 @@ public:
         PrintStatistics(logLevel, STAT_OPT_ALL);
     }
 
+    /**
+     * @brief Retrieves the percentiles of all histogram statistic variables of all enabled providers.
+     * @param[out] summaries Receives a summary of each histogram that has samples.
+     * @return True if succeeded, otherwise false.
+     */
+    bool GetHistogramSummaries(mot_vector<HistogramSummary>& summaries);
+
     /**
      * @brief Derives classes should react to a notification that configuration changed. New
      * configuration is accessible via the ConfigManager.
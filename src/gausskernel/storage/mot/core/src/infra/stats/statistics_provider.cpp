@@ -23,6 +23,7 @@
  */
 
 #include "statistics_provider.h"
+#include "histogram_statistic_variable.h"
 #include "mot_engine.h"
 #include "thread_id.h"
 #include "session_context.h"
@@ -48,6 +49,7 @@ StatisticsProvider::StatisticsProvider(
       m_diffStats(nullptr),
       m_diffAverageStats(nullptr),
       m_deadThreadStats(nullptr),
+      m_deadThreadTotalStats(nullptr),
       m_prevGlobalStats(nullptr),
       m_diffGlobalStats(nullptr)
 {
@@ -95,6 +97,9 @@ StatisticsProvider::~StatisticsProvider()
     if (m_deadThreadStats) {
         delete m_deadThreadStats;
     }
+    if (m_deadThreadTotalStats) {
+        delete m_deadThreadTotalStats;
+    }
 }
 
 bool StatisticsProvider::Initialize()
@@ -105,8 +110,9 @@ bool StatisticsProvider::Initialize()
     m_diffStats = m_generator->CreateThreadStatistics(ThreadStatistics::THREAD_ID_DIFF);
     m_diffAverageStats = m_generator->CreateThreadStatistics(ThreadStatistics::THREAD_ID_DIFF_AVG);
     m_deadThreadStats = m_generator->CreateThreadStatistics(ThreadStatistics::THREAD_ID_TOTAL);
+    m_deadThreadTotalStats = m_generator->CreateThreadStatistics(ThreadStatistics::THREAD_ID_TOTAL);
     if (!m_aggregateStats || !m_prevAggregateStats || !m_averageStats || !m_diffStats || !m_diffAverageStats ||
-        !m_deadThreadStats) {
+        !m_deadThreadStats || !m_deadThreadTotalStats) {
         MOT_REPORT_ERROR(MOT_ERROR_OOM, "Load Statistics", "Failed to create thread statistics object(s)");
         return false;  // safe cleanup in object destruction
     }
@@ -202,6 +208,7 @@ void StatisticsProvider::UnreserveThreadSlot()
             pthread_spin_lock(&m_statLock);
             ThreadStatistics* threadStats = m_threadStats[threadId];
             m_deadThreadStats->Add(*threadStats);
+            m_deadThreadTotalStats->Add(*threadStats);
             m_threadStats[threadId] = nullptr;  // this must be guarded with a lock due to race with Summarize()
             pthread_spin_unlock(&m_statLock);
             FreeThreadStats(threadId, threadStats);  // cleanup now outside lock scope
@@ -292,6 +299,59 @@ bool StatisticsProvider::HasStatisticsFor(uint32_t statOpts)
     return result;
 }
 
+bool StatisticsProvider::GetHistogramSummaries(mot_vector<HistogramSummary>& summaries)
+{
+    ThreadStatistics* totalStats = m_generator->CreateThreadStatistics(ThreadStatistics::THREAD_ID_TOTAL);
+    if (totalStats == nullptr) {
+        MOT_REPORT_ERROR(MOT_ERROR_OOM, "Query Statistics", "Failed to create thread statistics object");
+        return false;
+    }
+
+    pthread_spin_lock(&m_statLock);
+    for (uint32_t i = 0; i < m_threadStatCount; ++i) {
+        if (m_threadStats[i] != nullptr) {
+            totalStats->Add(*m_threadStats[i]);
+        }
+    }
+    totalStats->Add(*m_deadThreadTotalStats);
+    pthread_spin_unlock(&m_statLock);
+
+    bool result = true;
+    for (uint32_t statId = 0; statId < totalStats->GetStatCount(); ++statId) {
+        const HistogramStatisticVariable* histogram = totalStats->GetStatistic(statId)->AsHistogram();
+        if ((histogram == nullptr) || (histogram->GetSampleCount() == 0)) {
+            continue;
+        }
+
+        HistogramSummary summary;
+        errno_t erc = snprintf_s(summary.m_provider, MAX_PROVIDER_NAME, MAX_PROVIDER_NAME - 1, "%s", m_name);
+        securec_check_ss(erc, "\0", "\0");
+        // strip the thread qualifier suffix
+        const char* name = histogram->GetName();
+        const char* qualifier = strchr(name, '[');
+        int nameLen = (qualifier != nullptr) ? (int)(qualifier - name) : (int)strlen(name);
+        erc = snprintf_s(summary.m_name, STAT_VAR_MAX_NAME_LEN, STAT_VAR_MAX_NAME_LEN - 1, "%.*s", nameLen, name);
+        securec_check_ss(erc, "\0", "\0");
+        erc = snprintf_s(
+            summary.m_units, STAT_VAR_MAX_NAME_LEN, STAT_VAR_MAX_NAME_LEN - 1, "%s", histogram->GetUnits());
+        securec_check_ss(erc, "\0", "\0");
+        summary.m_sampleCount = histogram->GetSampleCount();
+        summary.m_p50 = histogram->GetPercentile(50.0);
+        summary.m_p90 = histogram->GetPercentile(90.0);
+        summary.m_p99 = histogram->GetPercentile(99.0);
+        summary.m_p999 = histogram->GetPercentile(99.9);
+        summary.m_max = histogram->GetMax();
+        if (!summaries.push_back(summary)) {
+            MOT_REPORT_ERROR(MOT_ERROR_OOM, "Query Statistics", "Failed to add histogram summary");
+            result = false;
+            break;
+        }
+    }
+
+    delete totalStats;
+    return result;
+}
+
 void StatisticsProvider::PrintStatistics(LogLevel logLevel, uint32_t statOpts /* = STAT_OPT_DEFAULT */)
 {
     if (statOpts & STAT_OPT_SCOPE_THREAD) {
@@ -65,6 +65,28 @@ constexpr uint32_t STAT_OPT_ALL = 0xFFFFFFFF;
 /** @define The default statistics printing option. */
 constexpr uint32_t STAT_OPT_DEFAULT = (STAT_OPT_SCOPE_GLOBAL | STAT_OPT_PERIOD_TOTAL | STAT_OPT_LEVEL_SUMMARY);
 
+/**
+ * @struct HistogramSummary
+ * @brief Percentiles of a histogram statistic variable, aggregated over all threads since startup.
+ */
+struct HistogramSummary {
+    /** @var The name of the statistics provider. */
+    char m_provider[MAX_PROVIDER_NAME];
+
+    /** @var The name of the statistic variable (without thread qualifier). */
+    char m_name[STAT_VAR_MAX_NAME_LEN];
+
+    /** @var The unit name of the samples. */
+    char m_units[STAT_VAR_MAX_NAME_LEN];
+
+    uint64_t m_sampleCount;
+    uint64_t m_p50;
+    uint64_t m_p90;
+    uint64_t m_p99;
+    uint64_t m_p999;
+    uint64_t m_max;
+};
+
 /**
  * @class StatisticsProvider
  * @brief Designates a components which is responsible for providing system
@@ -149,6 +171,14 @@ public:
         PrintStatistics(logLevel, STAT_OPT_ALL);
     }
 
+    /**
+     * @brief Aggregates the thread-level histogram statistic variables of this provider over all live and exited
+     * threads since startup. This does not interfere with periodic summaries.
+     * @param[out] summaries Receives a summary of each histogram that has samples.
+     * @return True if succeeded, otherwise false.
+     */
+    bool GetHistogramSummaries(mot_vector<HistogramSummary>& summaries);
+
 protected:
     /**
      * @brief Allow deriving class to print more non-standard statistics
@@ -245,6 +275,9 @@ private:
     /** @var Aggregate dead thread statistic variable. */
     ThreadStatistics* m_deadThreadStats;
 
+    /** @var Aggregate dead thread statistic variable since startup (not reset by periodic summaries). */
+    ThreadStatistics* m_deadThreadTotalStats;
+
     /** @var Global statistics. */
     GlobalStatistics* m_prevGlobalStats;
 
@@ -67,6 +67,16 @@ public:
         return m_statVars.size();
     }
 
+    /**
+     * @brief Retrieves a contained statistic variable.
+     * @param statId The statistic variable identifier (smaller than @ref GetStatCount()).
+     * @return The statistic variable.
+     */
+    inline const StatisticVariable* GetStatistic(uint32_t statId) const
+    {
+        return m_statVars[statId];
+    }
+
     /**
      * @brief Retrieves the logical identifier of the thread that these statistics describe.
      * @return The logical thread identifier.
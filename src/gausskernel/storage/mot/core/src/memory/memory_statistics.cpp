@@ -120,12 +120,22 @@ DetailedMemoryGlobalStatistics::DetailedMemoryGlobalStatistics(GlobalStatistics:
         erc = snprintf_s(name, nameLen, nameLen - 1, "local-[%u]-chunks-reserved", i);
         securec_check_ss(erc, "\0", "\0");
         m_localChunksReserved[i].Configure(MakeName(name, namingScheme).c_str(), MEGA_BYTE, "MB");
+
+        erc = snprintf_s(name, nameLen, nameLen - 1, "huge-page-[%u]-chunks-mapped", i);
+        securec_check_ss(erc, "\0", "\0");
+        m_hugePageChunksMapped[i].Configure(MakeName(name, namingScheme).c_str(), MEGA_BYTE, "MB");
+
+        erc = snprintf_s(name, nameLen, nameLen - 1, "huge-page-[%u]-chunks-fallback", i);
+        securec_check_ss(erc, "\0", "\0");
+        m_hugePageChunksFallback[i].Configure(MakeName(name, namingScheme).c_str(), MEGA_BYTE, "MB");
     }
 
     for (uint32_t i = 0; i < nodeCount; ++i) {
         RegisterStatistics(&m_numaLocalAllocated[i]);
         RegisterStatistics(&m_globalChunksReserved[i]);
         RegisterStatistics(&m_localChunksReserved[i]);
+        RegisterStatistics(&m_hugePageChunksMapped[i]);
+        RegisterStatistics(&m_hugePageChunksFallback[i]);
     }
 }
 
@@ -162,12 +172,16 @@ MemoryGlobalStatistics::MemoryGlobalStatistics(GlobalStatistics::NamingScheme na
       m_numaInterleavedAllocated(MakeName("numa-interleaved-allocated", namingScheme).c_str(), MEGA_BYTE, "MB"),
       m_numaLocalAllocated(MakeName("numa-local-allocated", namingScheme).c_str(), MEGA_BYTE, "MB"),
       m_globalChunksReserved(MakeName("global-chunks-reserved", namingScheme).c_str(), MEGA_BYTE, "MB"),
-      m_localChunksReserved(MakeName("local-chunks-reserved", namingScheme).c_str(), MEGA_BYTE, "MB")
+      m_localChunksReserved(MakeName("local-chunks-reserved", namingScheme).c_str(), MEGA_BYTE, "MB"),
+      m_hugePageChunksMapped(MakeName("huge-page-chunks-mapped", namingScheme).c_str(), MEGA_BYTE, "MB"),
+      m_hugePageChunksFallback(MakeName("huge-page-chunks-fallback", namingScheme).c_str(), MEGA_BYTE, "MB")
 {
     RegisterStatistics(&m_numaInterleavedAllocated);
     RegisterStatistics(&m_numaLocalAllocated);
     RegisterStatistics(&m_globalChunksReserved);
     RegisterStatistics(&m_localChunksReserved);
+    RegisterStatistics(&m_hugePageChunksMapped);
+    RegisterStatistics(&m_hugePageChunksFallback);
 }
 
 TypedStatisticsGenerator<DetailedMemoryThreadStatistics, DetailedMemoryGlobalStatistics>
@@ -144,10 +144,24 @@ public:
         m_localChunksReserved[node].AddSample(bytes);
     }
 
+    /** @brief Updates the statistics for total chunk bytes mapped with explicit huge pages. */
+    inline void AddHugePageChunksMapped(int node, int64_t bytes)
+    {
+        m_hugePageChunksMapped[node].AddSample(bytes);
+    }
+
+    /** @brief Updates the statistics for total chunk bytes that could not be mapped with explicit huge pages. */
+    inline void AddHugePageChunksFallback(int node, int64_t bytes)
+    {
+        m_hugePageChunksFallback[node].AddSample(bytes);
+    }
+
 private:
     MemoryStatisticVariable m_numaLocalAllocated[MEM_MAX_NUMA_NODES];
     MemoryStatisticVariable m_globalChunksReserved[MEM_MAX_NUMA_NODES];
     MemoryStatisticVariable m_localChunksReserved[MEM_MAX_NUMA_NODES];
+    MemoryStatisticVariable m_hugePageChunksMapped[MEM_MAX_NUMA_NODES];
+    MemoryStatisticVariable m_hugePageChunksFallback[MEM_MAX_NUMA_NODES];
 };
 
 class MemoryThreadStatistics : public ThreadStatistics {
@@ -281,11 +295,25 @@ public:
         return m_localChunksReserved.AddSample(bytes);
     }
 
+    /** @brief Updates the statistics for total chunk bytes mapped with explicit huge pages. */
+    inline void AddHugePageChunksMapped(int64_t bytes)
+    {
+        return m_hugePageChunksMapped.AddSample(bytes);
+    }
+
+    /** @brief Updates the statistics for total chunk bytes that could not be mapped with explicit huge pages. */
+    inline void AddHugePageChunksFallback(int64_t bytes)
+    {
+        return m_hugePageChunksFallback.AddSample(bytes);
+    }
+
 private:
     MemoryStatisticVariable m_numaInterleavedAllocated;
     MemoryStatisticVariable m_numaLocalAllocated;
     MemoryStatisticVariable m_globalChunksReserved;
     MemoryStatisticVariable m_localChunksReserved;
+    MemoryStatisticVariable m_hugePageChunksMapped;
+    MemoryStatisticVariable m_hugePageChunksFallback;
 };
 
 class DetailedMemoryStatisticsProvider : public StatisticsProvider, public IConfigChangeListener {
@@ -341,6 +369,24 @@ public:
         }
     }
 
+    /** @brief Updates the statistics for total chunk bytes mapped with explicit huge pages. */
+    inline void AddHugePageChunksMapped(int node, int64_t bytes)
+    {
+        DetailedMemoryGlobalStatistics* mgs = GetGlobalStatistics<DetailedMemoryGlobalStatistics>();
+        if (mgs) {
+            mgs->AddHugePageChunksMapped(node, bytes);
+        }
+    }
+
+    /** @brief Updates the statistics for total chunk bytes that could not be mapped with explicit huge pages. */
+    inline void AddHugePageChunksFallback(int node, int64_t bytes)
+    {
+        DetailedMemoryGlobalStatistics* mgs = GetGlobalStatistics<DetailedMemoryGlobalStatistics>();
+        if (mgs) {
+            mgs->AddHugePageChunksFallback(node, bytes);
+        }
+    }
+
     /** @brief Updates the memory statistics for global-memory chunks on a specific node. */
     inline void AddGlobalChunksUsed(int node, int64_t bytes)
     {
@@ -497,6 +543,24 @@ public:
         }
     }
 
+    /** @brief Updates the statistics for total chunk bytes mapped with explicit huge pages. */
+    inline void AddHugePageChunksMapped(int64_t bytes)
+    {
+        MemoryGlobalStatistics* mgs = GetGlobalStatistics<MemoryGlobalStatistics>();
+        if (mgs) {
+            mgs->AddHugePageChunksMapped(bytes);
+        }
+    }
+
+    /** @brief Updates the statistics for total chunk bytes that could not be mapped with explicit huge pages. */
+    inline void AddHugePageChunksFallback(int64_t bytes)
+    {
+        MemoryGlobalStatistics* mgs = GetGlobalStatistics<MemoryGlobalStatistics>();
+        if (mgs) {
+            mgs->AddHugePageChunksFallback(bytes);
+        }
+    }
+
     /** @brief Updates the memory statistics for total global-memory chunks on all nodes. */
     inline void AddGlobalChunksUsed(int64_t bytes)
     {
@@ -90,6 +90,7 @@ extern int MemCfgInit()
         g_memGlobalCfg.m_maxConnectionCount);
 
     g_memGlobalCfg.m_chunkAllocPolicy = motCfg.m_chunkAllocPolicy;
+    g_memGlobalCfg.m_chunkHugePageMode = motCfg.m_chunkHugePageMode;
     g_memGlobalCfg.m_chunkPreallocWorkerCount = motCfg.m_chunkPreallocWorkerCount;
     g_memGlobalCfg.m_highRedMarkPercent = motCfg.m_highRedMarkPercent;
 
@@ -116,6 +117,13 @@ extern int MemCfgInit()
         }
     }
 
+    // explicit huge pages are mapped through the NUMA API
+    if ((g_memGlobalCfg.m_chunkHugePageMode == MEM_HUGE_PAGE_EXPLICIT) &&
+        (!motCfg.m_enableNuma || (g_memGlobalCfg.m_chunkAllocPolicy == MEM_ALLOC_POLICY_NATIVE))) {
+        g_memGlobalCfg.m_chunkHugePageMode = MEM_HUGE_PAGE_TRANSPARENT;
+        MOT_LOG_WARN("Explicit huge pages require NUMA chunk allocation, using transparent huge pages instead");
+    }
+
     MemCfgPrint("Startup Report", LogLevel::LL_TRACE);
 
     MOT_LOG_TRACE("MM configuration loaded");
@@ -181,6 +189,11 @@ extern void MemCfgToString(int indent, const char* name, StringBuffer* stringBuf
         indent,
         "",
         MemAllocPolicyToString(g_memGlobalCfg.m_chunkAllocPolicy));
+    StringBufferAppend(stringBuffer,
+        "%*sChunk Huge Page Mode: %s\n",
+        indent,
+        "",
+        MemHugePageModeToString(g_memGlobalCfg.m_chunkHugePageMode));
     StringBufferAppend(stringBuffer,
         "%*sChunk pre-allocation Worker Count: %u\n",
         indent,
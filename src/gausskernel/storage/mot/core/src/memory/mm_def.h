@@ -368,6 +368,69 @@ public:
     }
 };
 
+/** @typedef Huge page mode of chunk pools. */
+enum MemHugePageMode : uint32_t {
+    /** @var Designates invalid huge page mode. */
+    MEM_HUGE_PAGE_INVALID,
+
+    /** @var Chunks are mapped with regular pages. */
+    MEM_HUGE_PAGE_NONE,
+
+    /** @var Chunks are mapped with regular pages advised for transparent huge pages. */
+    MEM_HUGE_PAGE_TRANSPARENT,
+
+    /**
+     * @var Chunks are mapped with explicit huge pages (reserved through hugetlbfs). If no huge page is available a
+     * chunk is mapped with regular pages advised for transparent huge pages.
+     */
+    MEM_HUGE_PAGE_EXPLICIT
+};
+
+/**
+ * @brief Converts string value to huge page mode enumeration.
+ * @param hugePageModeStr The huge page mode string.
+ * @return The huge page mode enumeration.
+ */
+extern MemHugePageMode MemHugePageModeFromString(const char* hugePageModeStr);
+
+/**
+ * @brief Converts huge page mode enumeration into string form.
+ * @param hugePageMode The huge page mode.
+ * @return The huge page mode string.
+ */
+extern const char* MemHugePageModeToString(MemHugePageMode hugePageMode);
+
+/**
+ * @class TypeFormatter<MemHugePageMode>
+ * @brief Specialization of TypeFormatter<T> with [ T = MemHugePageMode ].
+ */
+template <>
+class TypeFormatter<MemHugePageMode> {
+public:
+    /**
+     * @brief Converts a value to string.
+     * @param value The value to convert.
+     * @param[out] stringValue The resulting string.
+     */
+    static inline const char* ToString(const MemHugePageMode& value, mot_string& stringValue)
+    {
+        stringValue = MemHugePageModeToString(value);
+        return stringValue.c_str();
+    }
+
+    /**
+     * @brief Converts a string to a value.
+     * @param The string to convert.
+     * @param[out] The resulting value.
+     * @return Boolean value denoting whether the conversion succeeded or not.
+     */
+    static inline bool FromString(const char* stringValue, MemHugePageMode& value)
+    {
+        value = MemHugePageModeFromString(stringValue);
+        return value != MemHugePageMode::MEM_HUGE_PAGE_INVALID;
+    }
+};
+
 }  // namespace MOT
 
 /** @define Enables/disable entire memory module. */
@@ -229,6 +229,29 @@ extern void* MemNumaAllocAlignedGlobal(uint64_t size, uint64_t align)
     return result;
 }
 
+extern void* MemNumaAllocHugeLocal(uint64_t size, int node)
+{
+    void* result = MotSysNumaAllocHugeOnNode(size, node);
+    if (result != NULL) {
+        UpdateLocalStats(size, node);
+    }
+    return result;
+}
+
+extern void* MemNumaAllocHugeGlobal(uint64_t size)
+{
+    void* result = MotSysNumaAllocHugeInterleaved(size);
+    if (result != NULL) {
+        UpdateGlobalStats(size);
+    }
+    return result;
+}
+
+extern bool MemNumaAdviseHugePages(void* buf, uint64_t size)
+{
+    return (MotSysNumaAdviseHugePages(buf, size) == 0);
+}
+
 extern void MemNumaFreeLocal(void* buf, uint64_t size, int node)
 {
     if (GetGlobalConfiguration().m_enableNuma) {
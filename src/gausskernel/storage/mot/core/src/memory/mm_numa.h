@@ -94,6 +94,31 @@ extern void* MemNumaAllocAlignedLocal(uint64_t size, uint64_t align, int node);
  */
 extern void* MemNumaAllocAlignedGlobal(uint64_t size, uint64_t align);
 
+/**
+ * @brief Allocate NUMA-node local buffer backed by explicit huge pages. The buffer is aligned to the huge page size.
+ * @param size The allocation size in bytes. Must be a multiple of the huge page size.
+ * @param node The NUMA node identifier.
+ * @return A pointer to the allocated memory or NULL if there are not enough free huge pages (no error is reported).
+ * @note The buffer is reclaimed by a call to @ref MemNumaFreeLocal.
+ */
+extern void* MemNumaAllocHugeLocal(uint64_t size, int node);
+
+/**
+ * @brief Allocate NUMA-interleaved buffer backed by explicit huge pages. The buffer is aligned to the huge page size.
+ * @param size The allocation size in bytes. Must be a multiple of the huge page size.
+ * @return A pointer to the allocated memory or NULL if there are not enough free huge pages (no error is reported).
+ * @note The buffer is reclaimed by a call to @ref MemNumaFreeGlobal.
+ */
+extern void* MemNumaAllocHugeGlobal(uint64_t size);
+
+/**
+ * @brief Advises the kernel to back a buffer with transparent huge pages.
+ * @param buf The buffer. Only the huge page aligned parts of the buffer can benefit.
+ * @param size The size in bytes of the buffer.
+ * @return True if succeeded, or false if transparent huge pages are not supported by the kernel.
+ */
+extern bool MemNumaAdviseHugePages(void* buf, uint64_t size);
+
 /**
  * @brief Reclaim memory previously allocated by a call to @fn mm_numa_alloc_local.
  * @param buf The buffer to reclaim.
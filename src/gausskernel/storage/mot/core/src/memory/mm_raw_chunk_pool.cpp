@@ -54,9 +54,9 @@ inline int GteNextNode()
     return (MOT_ATOMIC_INC(nextNode) - 1) % g_memGlobalCfg.m_nodeCount;
 }
 
-inline void* NumaAllocInterleavedChunk(size_t size, size_t align)
+inline void* NumaAllocInterleavedChunk(size_t size, size_t align, int node)
 {
-    return MemNumaAllocAlignedLocal(size, align, GteNextNode());
+    return MemNumaAllocAlignedLocal(size, align, node);
 }
 
 inline void NumaFreeInterleavedChunk(void* buf, size_t size, int node)
@@ -741,49 +741,111 @@ static void MakeChunkResident(MemRawChunkHeader* chunk)
     }
 }
 
+// Nodes on which explicit huge pages ran out (warning is issued once per node)
+static uint32_t hugePageFallbackNodes[MEM_MAX_NUMA_NODES] = {0};
+
+// Transparent huge pages unsupported by the kernel (warning is issued once)
+static uint32_t hugePageAdviseFailed = 0;
+
+static MemRawChunkHeader* AllocateExplicitHugeChunk(MemRawChunkPool* chunkPool, size_t allocSize, int node)
+{
+    // chunk alignment is satisfied by the huge page alignment of the mapping
+    MemRawChunkHeader* chunk = nullptr;
+    if (chunkPool->m_allocType == MEM_ALLOC_GLOBAL &&
+        g_memGlobalCfg.m_chunkAllocPolicy == MEM_ALLOC_POLICY_PAGE_INTERLEAVED) {
+        chunk = (MemRawChunkHeader*)MemNumaAllocHugeGlobal(allocSize);
+    } else {
+        chunk = (MemRawChunkHeader*)MemNumaAllocHugeLocal(allocSize, node);
+    }
+
+    if (chunk != nullptr) {
+        MemoryStatisticsProvider::m_provider->AddHugePageChunksMapped(allocSize);
+        DetailedMemoryStatisticsProvider::m_provider->AddHugePageChunksMapped(node, allocSize);
+    } else {
+        if (MOT_ATOMIC_CAS(hugePageFallbackNodes[node], 0, 1)) {
+            MOT_LOG_WARN("No free explicit huge page for chunk on node %d (errno %d), falling back to transparent "
+                         "huge pages (consider increasing nr_hugepages)",
+                node,
+                errno);
+        }
+        MemoryStatisticsProvider::m_provider->AddHugePageChunksFallback(allocSize);
+        DetailedMemoryStatisticsProvider::m_provider->AddHugePageChunksFallback(node, allocSize);
+    }
+    return chunk;
+}
+
+static void AdviseTransparentHugeChunk(MemRawChunkHeader* chunk, size_t allocSize)
+{
+    if (!MemNumaAdviseHugePages(chunk, allocSize) && MOT_ATOMIC_CAS(hugePageAdviseFailed, 0, 1)) {
+        MOT_LOG_WARN("Failed to advise transparent huge pages for chunks (errno %d), chunks are mapped with regular "
+                     "pages",
+            errno);
+    }
+}
+
 static MemRawChunkHeader* AllocateChunkFromKernel(MemRawChunkPool* chunkPool, size_t allocSize, size_t align)
 {
     MemRawChunkHeader* chunk = nullptr;
-    if (chunkPool->m_allocType == MEM_ALLOC_GLOBAL) {
-        if (g_memGlobalCfg.m_chunkAllocPolicy == MEM_ALLOC_POLICY_LOCAL) {
-            // allocate from specific local node
-            chunk = (MemRawChunkHeader*)MemNumaAllocAlignedLocal(allocSize, align, chunkPool->m_node);
-        } else if (g_memGlobalCfg.m_chunkAllocPolicy == MEM_ALLOC_POLICY_CHUNK_INTERLEAVED) {
-            // allocate chunk from next node (round robin)
-            chunk = (MemRawChunkHeader*)NumaAllocInterleavedChunk(allocSize, align);
-        } else if (g_memGlobalCfg.m_chunkAllocPolicy == MEM_ALLOC_POLICY_PAGE_INTERLEAVED) {
-            // allocate chunk from all nodes (interleaved on page boundary)
-            chunk = (MemRawChunkHeader*)MemNumaAllocAlignedGlobal(allocSize, align);
-        } else if (g_memGlobalCfg.m_chunkAllocPolicy == MEM_ALLOC_POLICY_NATIVE) {
-            // allocate from kernel using malloc()
-            int res = posix_memalign((void**)&chunk, align, allocSize);
-            if (res != 0) {
-                MOT_REPORT_SYSTEM_ERROR_CODE(
-                    res, posix_memalign, "Chunk Allocation", "Failed to allocate aligned 2MB chunk");
-                chunk = nullptr;
+    // pick the round robin node once, so that a fallback allocation stays on the same node
+    int node = chunkPool->m_node;
+    if (chunkPool->m_allocType == MEM_ALLOC_GLOBAL &&
+        g_memGlobalCfg.m_chunkAllocPolicy == MEM_ALLOC_POLICY_CHUNK_INTERLEAVED) {
+        node = GteNextNode();
+    }
+
+    if (g_memGlobalCfg.m_chunkHugePageMode == MEM_HUGE_PAGE_EXPLICIT) {
+        chunk = AllocateExplicitHugeChunk(chunkPool, allocSize, node);
+    }
+
+    if (chunk == nullptr) {
+        if (chunkPool->m_allocType == MEM_ALLOC_GLOBAL) {
+            if (g_memGlobalCfg.m_chunkAllocPolicy == MEM_ALLOC_POLICY_LOCAL) {
+                // allocate from specific local node
+                chunk = (MemRawChunkHeader*)MemNumaAllocAlignedLocal(allocSize, align, chunkPool->m_node);
+            } else if (g_memGlobalCfg.m_chunkAllocPolicy == MEM_ALLOC_POLICY_CHUNK_INTERLEAVED) {
+                // allocate chunk from next node (round robin)
+                chunk = (MemRawChunkHeader*)NumaAllocInterleavedChunk(allocSize, align, node);
+            } else if (g_memGlobalCfg.m_chunkAllocPolicy == MEM_ALLOC_POLICY_PAGE_INTERLEAVED) {
+                // allocate chunk from all nodes (interleaved on page boundary)
+                chunk = (MemRawChunkHeader*)MemNumaAllocAlignedGlobal(allocSize, align);
+            } else if (g_memGlobalCfg.m_chunkAllocPolicy == MEM_ALLOC_POLICY_NATIVE) {
+                // allocate from kernel using malloc()
+                int res = posix_memalign((void**)&chunk, align, allocSize);
+                if (res != 0) {
+                    MOT_REPORT_SYSTEM_ERROR_CODE(
+                        res, posix_memalign, "Chunk Allocation", "Failed to allocate aligned 2MB chunk");
+                    chunk = nullptr;
+                }
+            } else {
+                MOT_REPORT_ERROR(MOT_ERROR_INTERNAL,
+                    "Chunk Allocation",
+                    "Invalid chunk allocation policy: %u",
+                    (unsigned)g_memGlobalCfg.m_chunkAllocPolicy);
+                return nullptr;
             }
         } else {
-            MOT_REPORT_ERROR(MOT_ERROR_INTERNAL,
-                "Chunk Allocation",
-                "Invalid chunk allocation policy: %u",
-                (unsigned)g_memGlobalCfg.m_chunkAllocPolicy);
-            return nullptr;
+            if (g_memGlobalCfg.m_chunkAllocPolicy == MEM_ALLOC_POLICY_NATIVE) {
+                int res = posix_memalign((void**)&chunk, align, allocSize);
+                if (res != 0) {
+                    MOT_REPORT_SYSTEM_ERROR_CODE(
+                        res, posix_memalign, "Chunk Allocation", "Failed to allocate aligned 2MB chunk");
+                    chunk = nullptr;
+                }
+            } else {
+                chunk = (MemRawChunkHeader*)MemNumaAllocAlignedLocal(allocSize, align, chunkPool->m_node);
+            }
         }
-        if (chunk) {
-            MemoryStatisticsProvider::m_provider->AddGlobalChunksReserved(allocSize);
+
+        // must be done before the chunk is made resident, otherwise it is already backed by regular pages
+        if (chunk && g_memGlobalCfg.m_chunkHugePageMode != MEM_HUGE_PAGE_NONE) {
+            AdviseTransparentHugeChunk(chunk, allocSize);
         }
-    } else {
-        if (g_memGlobalCfg.m_chunkAllocPolicy == MEM_ALLOC_POLICY_NATIVE) {
-            int res = posix_memalign((void**)&chunk, align, allocSize);
-            if (res != 0) {
-                MOT_REPORT_SYSTEM_ERROR_CODE(
-                    res, posix_memalign, "Chunk Allocation", "Failed to allocate aligned 2MB chunk");
-                chunk = nullptr;
-            }
+    }
+
+    if (chunk) {
+        if (chunkPool->m_allocType == MEM_ALLOC_GLOBAL) {
+            MemoryStatisticsProvider::m_provider->AddGlobalChunksReserved(allocSize);
         } else {
-            chunk = (MemRawChunkHeader*)MemNumaAllocAlignedLocal(allocSize, align, chunkPool->m_node);
-        }
-        if (chunk) {
             MemoryStatisticsProvider::m_provider->AddLocalChunksReserved(allocSize);
             DetailedMemoryStatisticsProvider::m_provider->AddLocalChunksReserved(chunkPool->m_node, allocSize);
         }
@@ -56,6 +56,14 @@
 #define MPOL_MF_MOVE (1 << 1)     /* Move pages owned by this process to conform to mapping */
 #define MPOL_MF_MOVE_ALL (1 << 2) /* Move every page to conform to mapping */
 
+// Huge page size selection for mmap (adapted from /usr/include/linux/mman.h)
+#ifndef MAP_HUGE_SHIFT
+#define MAP_HUGE_SHIFT 26
+#endif
+#ifndef MAP_HUGE_2MB
+#define MAP_HUGE_2MB (21 << MAP_HUGE_SHIFT)
+#endif
+
 // some required utility macros
 #define ROUND_UP(x, y) (((x) + (y)-1) & ~((y)-1))
 #define CPU_BYTES(x) (ROUND_UP(x, sizeof(long)))
@@ -372,6 +380,73 @@ void* MotSysNumaAllocAlignedLocal(size_t size, size_t align)
     return mem;
 }
 
+static void* MotSysNumaMapHuge(size_t size)
+{
+    // no error dump, running out of reserved huge pages is expected and handled by the caller
+    // a huge page mapping is aligned to the huge page size
+    return mmap(0, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB | MAP_HUGE_2MB, -1, 0);
+}
+
+static void* MotSysNumaBindHuge(void* mem, size_t size, int policy, const BitMaskSt* bmp)
+{
+    if (syscall(__NR_mbind,
+            (intptr_t)mem,
+            size,
+            policy,
+            (intptr_t)bmp->m_maskp,
+            bmp->m_size + 1,
+            MOTMBindFlags) != 0) {
+        MotSysNumaReportError("mbind");
+        munmap(mem, size);
+        return nullptr;
+    }
+
+    // huge pages are reserved on mmap() but taken from a node only on first touch, so populate the mapping right
+    // away while the policy is in effect (touching each huge page is enough)
+    for (size_t offset = 0; offset < size; offset += HUGE_PAGE_SIZE_BYTES) {
+        *((volatile uint8_t*)mem + offset) = 0;
+    }
+    return mem;
+}
+
+void* MotSysNumaAllocHugeOnNode(size_t size, int node)
+{
+    if (size == 0 || (size % HUGE_PAGE_SIZE_BYTES) != 0) {
+        errno = EINVAL;
+        return nullptr;
+    }
+
+    void* mem = MotSysNumaMapHuge(size);
+    if (mem == MAP_FAILED) {
+        return nullptr;
+    }
+
+    // a strict policy would raise SIGBUS on first touch if the node has no free huge page left (the reservation is
+    // not per node), so prefer the node instead
+    BITMASK_ONSTACK(bmp, g_nodeMaskSize);
+    BITMASK_SETBIT(bmp, node);
+    return MotSysNumaBindHuge(mem, size, MPOL_PREFERRED, bmp);
+}
+
+void* MotSysNumaAllocHugeInterleaved(size_t size)
+{
+    if (size == 0 || (size % HUGE_PAGE_SIZE_BYTES) != 0) {
+        errno = EINVAL;
+        return nullptr;
+    }
+
+    void* mem = MotSysNumaMapHuge(size);
+    if (mem == MAP_FAILED) {
+        return nullptr;
+    }
+    return MotSysNumaBindHuge(mem, size, MPOL_INTERLEAVE, g_allNodesBm);
+}
+
+int MotSysNumaAdviseHugePages(void* mem, size_t size)
+{
+    return madvise(mem, size, MADV_HUGEPAGE);
+}
+
 void MotSysNumaFree(void* mem, size_t size)
 {
     munmap(mem, size);
@@ -65,6 +65,21 @@ void* MotSysNumaAllocAlignedOnNode(size_t size, size_t align, int node);
 /* Alloc memory on local node */
 void* MotSysNumaAllocAlignedLocal(size_t size, size_t align);
 
+/* The size of an explicit huge page (allocated through hugetlbfs). */
+#define HUGE_PAGE_SIZE_BYTES (2UL * 1024 * 1024)
+
+/* Alloc memory backed by explicit huge pages preferably located on node (size must be a multiple of huge page size).
+   Returns null without reporting an error if there are not enough free huge pages. */
+void* MotSysNumaAllocHugeOnNode(size_t size, int node);
+
+/* Alloc memory backed by explicit huge pages interleaved on all nodes (size must be a multiple of huge page size).
+   Returns null without reporting an error if there are not enough free huge pages. */
+void* MotSysNumaAllocHugeInterleaved(size_t size);
+
+/* Advise the kernel to back memory with transparent huge pages (memory must be huge page aligned to benefit).
+   Returns zero if succeeded, otherwise -1 (errno is set). */
+int MotSysNumaAdviseHugePages(void* mem, size_t size);
+
 /* Free memory allocated by the functions above */
 void MotSysNumaFree(void* mem, size_t size);
 
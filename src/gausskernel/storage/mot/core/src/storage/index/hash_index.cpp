@@ -0,0 +1,551 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * -------------------------------------------------------------------------
+ *
+ * hash_index.cpp
+ *    Primary index implementation using a concurrent resizable hash table.
+ *
+ * IDENTIFICATION
+ *    src/gausskernel/storage/mot/core/src/storage/index/hash_index.cpp
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include <algorithm>
+#include <random>
+#include <unordered_set>
+#include "hash_index.h"
+#include "mot_engine.h"
+#include "mm_global_api.h"
+#include "mm_gc_manager.h"
+
+namespace MOT {
+IMPLEMENT_CLASS_LOGGER(HashPrimaryIndex, Storage);
+
+constexpr uint64_t HashPrimaryIndex::INITIAL_BUCKETS;
+constexpr uint64_t HashPrimaryIndex::LOCK_STRIPES;
+constexpr uint64_t HashPrimaryIndex::MAX_LOAD_FACTOR;
+constexpr uint64_t HashPrimaryIndex::MIGRATE_STRIPES_PER_STEP;
+constexpr uint64_t HashPrimaryIndex::SAMPLE_CHAIN_LENGTH;
+
+void HashPrimaryIndex::HashIterator::Next()
+{
+    if (m_node == nullptr) {
+        return;
+    }
+    if (m_single) {
+        m_node = nullptr;
+        return;
+    }
+    m_node = m_node->m_next.load(std::memory_order_acquire);
+    std::atomic<HashNode*>* heads = m_buckets->GetHeads();
+    while (m_node == nullptr && m_bucket < m_buckets->m_mask) {
+        m_node = heads[++m_bucket].load(std::memory_order_acquire);
+    }
+}
+
+uint64_t HashPrimaryIndex::HashKey(const uint8_t* buf, uint16_t len)
+{
+    // word at a time multiply-xorshift, keys are mostly short fixed-length column images
+    const uint64_t mul = 0x9ddfea08eb382d69ULL;
+    uint64_t hash = len * mul;
+    uint16_t i = 0;
+    for (; i + sizeof(uint64_t) <= len; i += sizeof(uint64_t)) {
+        uint64_t word;
+        errno_t erc = memcpy_s(&word, sizeof(word), buf + i, sizeof(word));
+        securec_check(erc, "\0", "\0");
+        hash = (hash ^ word) * mul;
+        hash ^= hash >> 47;
+    }
+    uint64_t tail = 0;
+    for (uint16_t shift = 0; i < len; ++i, shift += 8) {
+        tail |= ((uint64_t)buf[i]) << shift;
+    }
+    hash = (hash ^ tail) * mul;
+    hash ^= hash >> 47;
+    return hash * mul;
+}
+
+HashPrimaryIndex::HashBuckets* HashPrimaryIndex::AllocBuckets(uint64_t bucketCount, ObjAllocInterface* nodePool)
+{
+    uint64_t size = sizeof(HashBuckets) + bucketCount * sizeof(std::atomic<HashNode*>);
+    HashBuckets* buckets = static_cast<HashBuckets*>(MemGlobalAlloc(size));
+    if (buckets == nullptr) {
+        return nullptr;
+    }
+    buckets->m_mask = bucketCount - 1;
+    buckets->m_nodePool = nodePool;
+    std::atomic<HashNode*>* heads = buckets->GetHeads();
+    for (uint64_t i = 0; i < bucketCount; ++i) {
+        heads[i].store(nullptr, std::memory_order_relaxed);
+    }
+    return buckets;
+}
+
+HashPrimaryIndex::HashNode* HashPrimaryIndex::FindNode(HashBuckets* buckets, const Key* key, uint64_t hash)
+{
+    return FindInChain(buckets->GetHeads()[hash & buckets->m_mask].load(std::memory_order_acquire), key, hash);
+}
+
+HashPrimaryIndex::HashNode* HashPrimaryIndex::FindInChain(HashNode* node, const Key* key, uint64_t hash)
+{
+    while (node != nullptr) {
+        if (node->m_hash == hash) {
+            Key* nodeKey = node->GetKey();
+            if (nodeKey->GetKeyLength() == key->GetKeyLength() &&
+                memcmp(nodeKey->GetKeyBuf(), key->GetKeyBuf(), key->GetKeyLength()) == 0) {
+                return node;
+            }
+        }
+        node = node->m_next.load(std::memory_order_acquire);
+    }
+    return nullptr;
+}
+
+HashPrimaryIndex::HashNode* HashPrimaryIndex::NewNode(const Key* key, uint64_t hash, Sentinel* sentinel)
+{
+    HashNode* node = static_cast<HashNode*>(m_nodePool->Alloc());
+    if (node == nullptr) {
+        return nullptr;
+    }
+    node->m_hash = hash;
+    node->m_sentinel = sentinel;
+    Key* nodeKey = new (node->GetKey()) Key(key->GetKeyLength());
+    nodeKey->CpKey(key->GetKeyBuf(), key->GetKeyLength());
+    return node;
+}
+
+void HashPrimaryIndex::LinkNode(HashBuckets* buckets, HashNode* node)
+{
+    std::atomic<HashNode*>& head = buckets->GetHeads()[node->m_hash & buckets->m_mask];
+    node->m_next.store(head.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    head.store(node, std::memory_order_release);
+}
+
+HashPrimaryIndex::HashNode* HashPrimaryIndex::UnlinkNode(HashBuckets* buckets, const Key* key, uint64_t hash)
+{
+    std::atomic<HashNode*>* link = &buckets->GetHeads()[hash & buckets->m_mask];
+    HashNode* node = link->load(std::memory_order_relaxed);
+    while (node != nullptr) {
+        Key* nodeKey = node->GetKey();
+        if (node->m_hash == hash && nodeKey->GetKeyLength() == key->GetKeyLength() &&
+            memcmp(nodeKey->GetKeyBuf(), key->GetKeyBuf(), key->GetKeyLength()) == 0) {
+            // readers standing on the node still find the rest of the chain through its next pointer
+            link->store(node->m_next.load(std::memory_order_relaxed), std::memory_order_release);
+            return node;
+        }
+        link = &node->m_next;
+        node = link->load(std::memory_order_relaxed);
+    }
+    return nullptr;
+}
+
+HashPrimaryIndex::HashBuckets* HashPrimaryIndex::GetMigratedTarget(uint64_t stripe, HashBuckets* buckets) const
+{
+    HashBuckets* target = m_growTarget.load(std::memory_order_acquire);
+    if (target == nullptr || target == buckets || !m_stripeLocks[stripe].m_migrated) {
+        return nullptr;
+    }
+    return target;
+}
+
+RC HashPrimaryIndex::IndexInitImpl(void** args)
+{
+    m_nodePool = ObjAllocInterface::GetObjPool(sizeof(HashNode) + sizeof(Key) + ALIGN8(m_keyLength), false);
+    if (m_nodePool == nullptr) {
+        MOT_REPORT_ERROR(MOT_ERROR_OOM, "Initialize Index", "Failed to create hash node pool");
+        return RC_MEMORY_ALLOCATION_ERROR;
+    }
+
+    HashBuckets* buckets = AllocBuckets(INITIAL_BUCKETS, m_nodePool);
+    if (buckets == nullptr) {
+        ObjAllocInterface::FreeObjPool(&m_nodePool);
+        MOT_REPORT_ERROR(MOT_ERROR_OOM, "Initialize Index", "Failed to allocate hash buckets");
+        return RC_MEMORY_ALLOCATION_ERROR;
+    }
+    m_buckets.store(buckets, std::memory_order_release);
+    m_count.store(0, std::memory_order_relaxed);
+    m_initialized = true;
+    return RC_OK;
+}
+
+void HashPrimaryIndex::DestroyTable()
+{
+    // the nodes go with their pool
+    HashBuckets* buckets = m_buckets.exchange(nullptr);
+    if (buckets != nullptr) {
+        MemGlobalFree(buckets);
+    }
+    // a grow still migrating leaves its target behind
+    HashBuckets* grown = m_growTarget.exchange(nullptr);
+    if (grown != nullptr) {
+        MemGlobalFree(grown);
+    }
+    for (uint64_t i = 0; i < LOCK_STRIPES; ++i) {
+        m_stripeLocks[i].m_migrated = false;
+    }
+    m_migrateStripe = 0;
+    m_growing.store(false);
+    if (m_nodePool != nullptr) {
+        ObjAllocInterface::FreeObjPool(&m_nodePool);
+        m_nodePool = nullptr;
+    }
+    m_count.store(0, std::memory_order_relaxed);
+}
+
+Sentinel* HashPrimaryIndex::IndexInsertImpl(const Key* key, Sentinel* sentinel, bool& inserted, uint32_t pid)
+{
+    MOT_ASSERT(key->GetKeyLength() <= m_keyLength);
+    uint64_t hash = HashKey(key->GetKeyBuf(), key->GetKeyLength());
+    Sentinel* result = nullptr;
+    inserted = false;
+
+    const uint64_t stripe = hash & (LOCK_STRIPES - 1);
+    spin_lock& lock = m_stripeLocks[stripe].m_lock;
+    lock.lock();
+    HashBuckets* buckets = m_buckets.load(std::memory_order_acquire);
+    HashNode* node = FindNode(buckets, key, hash);
+    if (node != nullptr) {  // key mapping already exists in unique index
+        result = node->m_sentinel;
+    } else {
+        // a stripe already copied by a running migration keeps both arrays up to date until the switch
+        HashBuckets* target = GetMigratedTarget(stripe, buckets);
+        node = NewNode(key, hash, sentinel);
+        HashNode* copy = (node != nullptr && target != nullptr) ? NewNode(key, hash, sentinel) : nullptr;
+        if (node == nullptr || (target != nullptr && copy == nullptr)) {
+            lock.unlock();
+            if (node != nullptr) {
+                m_nodePool->Release(node);
+            }
+            MOT_REPORT_ERROR(MOT_ERROR_OOM, "Index Insert", "Failed to allocate hash node");
+            return nullptr;
+        }
+        if (copy != nullptr) {
+            LinkNode(target, copy);
+        }
+        LinkNode(buckets, node);
+        inserted = true;
+    }
+    lock.unlock();
+
+    if (inserted) {
+        if (m_count.fetch_add(1, std::memory_order_relaxed) + 1 > (buckets->m_mask + 1) * MAX_LOAD_FACTOR) {
+            Grow();
+        }
+        MigrateStep();
+    }
+    return result;
+}
+
+Sentinel* HashPrimaryIndex::IndexReadImpl(const Key* key, uint32_t pid) const
+{
+    HashBuckets* buckets = m_buckets.load(std::memory_order_acquire);
+    HashNode* node = FindNode(buckets, key, HashKey(key->GetKeyBuf(), key->GetKeyLength()));
+    return (node != nullptr) ? node->m_sentinel : nullptr;
+}
+
+void HashPrimaryIndex::IndexReadBatchImpl(
+    const Key* const* keys, uint32_t count, Sentinel** sentinels, uint32_t pid) const
+{
+    uint64_t hashes[READ_BATCH_SIZE];
+    HashNode* nodes[READ_BATCH_SIZE];
+    HashBuckets* buckets = m_buckets.load(std::memory_order_acquire);
+    std::atomic<HashNode*>* heads = buckets->GetHeads();
+
+    for (uint32_t base = 0; base < count; base += READ_BATCH_SIZE) {
+        uint32_t batchSize = std::min(count - base, READ_BATCH_SIZE);
+        for (uint32_t i = 0; i < batchSize; ++i) {
+            hashes[i] = HashKey(keys[base + i]->GetKeyBuf(), keys[base + i]->GetKeyLength());
+            Prefetch(&heads[hashes[i] & buckets->m_mask]);
+        }
+        for (uint32_t i = 0; i < batchSize; ++i) {
+            nodes[i] = heads[hashes[i] & buckets->m_mask].load(std::memory_order_acquire);
+            if (nodes[i] != nullptr) {
+                Prefetch(nodes[i]);
+            }
+        }
+        for (uint32_t i = 0; i < batchSize; ++i) {
+            HashNode* node = FindInChain(nodes[i], keys[base + i], hashes[i]);
+            sentinels[base + i] = (node != nullptr) ? node->m_sentinel : nullptr;
+        }
+    }
+}
+
+Sentinel* HashPrimaryIndex::IndexRemoveImpl(const Key* key, uint32_t pid)
+{
+    uint64_t hash = HashKey(key->GetKeyBuf(), key->GetKeyLength());
+    Sentinel* sentinel = nullptr;
+    HashNode* copy = nullptr;
+
+    const uint64_t stripe = hash & (LOCK_STRIPES - 1);
+    spin_lock& lock = m_stripeLocks[stripe].m_lock;
+    lock.lock();
+    HashBuckets* buckets = m_buckets.load(std::memory_order_acquire);
+    HashNode* node = UnlinkNode(buckets, key, hash);
+    if (node != nullptr) {
+        sentinel = node->m_sentinel;
+        HashBuckets* target = GetMigratedTarget(stripe, buckets);
+        if (target != nullptr) {
+            copy = UnlinkNode(target, key, hash);
+        }
+    }
+    lock.unlock();
+
+    if (sentinel != nullptr) {
+        m_count.fetch_sub(1, std::memory_order_relaxed);
+        GcManager* gcSession = MOTEngine::GetInstance()->GetCurrentGcSession();
+        MOT_ASSERT(gcSession != nullptr);
+        gcSession->GcRecordObject(GetIndexId(), m_nodePool, node, DeallocateNodeCallBack, m_nodePool->m_size);
+        // the grow target may be published already, so its copy is retired the same way
+        if (copy != nullptr) {
+            gcSession->GcRecordObject(GetIndexId(), m_nodePool, copy, DeallocateNodeCallBack, m_nodePool->m_size);
+        }
+        MigrateStep();
+    }
+    return sentinel;
+}
+
+bool HashPrimaryIndex::CopyStripe(HashBuckets* buckets, HashBuckets* grown, uint64_t stripe)
+{
+    // the old chains stay untouched for concurrent readers, so the entries are copied rather than relinked. the
+    // buckets of a stripe keep it in the larger array, so no other stripe's inserts touch the chains built here
+    std::atomic<HashNode*>* oldHeads = buckets->GetHeads();
+    for (uint64_t i = stripe; i <= buckets->m_mask; i += LOCK_STRIPES) {
+        HashNode* node = oldHeads[i].load(std::memory_order_relaxed);
+        while (node != nullptr) {
+            HashNode* copy = static_cast<HashNode*>(m_nodePool->Alloc());
+            if (copy == nullptr) {
+                return false;
+            }
+            errno_t erc = memcpy_s(copy, m_nodePool->m_size, node, sizeof(HashNode) + sizeof(Key) + ALIGN8(m_keyLength));
+            securec_check(erc, "\0", "\0");
+            LinkNode(grown, copy);
+            node = node->m_next.load(std::memory_order_relaxed);
+        }
+    }
+    return true;
+}
+
+void HashPrimaryIndex::Grow()
+{
+    bool expected = false;
+    if (!m_growing.compare_exchange_strong(expected, true)) {
+        return;  // a grow is already migrating
+    }
+
+    HashBuckets* buckets = m_buckets.load(std::memory_order_acquire);
+    uint64_t bucketCount = buckets->m_mask + 1;
+    if (m_count.load(std::memory_order_relaxed) <= bucketCount * MAX_LOAD_FACTOR) {
+        m_growing.store(false);
+        return;
+    }
+    HashBuckets* grown = AllocBuckets(bucketCount * 2, m_nodePool);
+    if (grown == nullptr) {
+        MOT_LOG_WARN("Failed to grow hash index %s to %" PRIu64 " buckets", m_name.c_str(), bucketCount * 2);
+        m_growing.store(false);
+        return;
+    }
+    m_migrateLock.lock();
+    m_migrateStripe = 0;
+    m_growTarget.store(grown, std::memory_order_release);
+    m_migrateLock.unlock();
+}
+
+void HashPrimaryIndex::MigrateStep()
+{
+    if (m_growTarget.load(std::memory_order_acquire) == nullptr) {
+        return;
+    }
+    // whoever is migrating already moves the grow along, so this operation goes on without waiting for it
+    if (!m_migrateLock.try_lock()) {
+        return;
+    }
+    HashBuckets* grown = m_growTarget.load(std::memory_order_acquire);
+    if (grown == nullptr) {
+        m_migrateLock.unlock();
+        return;
+    }
+
+    // only one stripe is locked at a time, inserts and removals of the other stripes go on meanwhile
+    HashBuckets* buckets = m_buckets.load(std::memory_order_acquire);
+    uint64_t end = std::min(m_migrateStripe + MIGRATE_STRIPES_PER_STEP, LOCK_STRIPES);
+    bool copied = true;
+    while (m_migrateStripe < end && copied) {
+        StripeLock& stripeLock = m_stripeLocks[m_migrateStripe];
+        stripeLock.m_lock.lock();
+        copied = CopyStripe(buckets, grown, m_migrateStripe);
+        stripeLock.m_migrated = copied;
+        stripeLock.m_lock.unlock();
+        ++m_migrateStripe;
+    }
+    if (!copied || m_migrateStripe == LOCK_STRIPES) {
+        FinishGrow(buckets, grown, copied);
+    }
+    m_migrateLock.unlock();
+}
+
+void HashPrimaryIndex::FinishGrow(HashBuckets* buckets, HashBuckets* grown, bool copied)
+{
+    if (copied) {
+        m_buckets.store(grown, std::memory_order_release);
+    }
+
+    // once every stripe lock was taken again, no insert or removal that still saw the old array is in flight
+    for (uint64_t i = 0; i < LOCK_STRIPES; ++i) {
+        m_stripeLocks[i].m_lock.lock();
+        m_stripeLocks[i].m_migrated = false;
+        m_stripeLocks[i].m_lock.unlock();
+    }
+    m_growTarget.store(nullptr, std::memory_order_release);
+
+    if (copied) {
+        MOT_LOG_DEBUG("Hash index %s grew to %" PRIu64 " buckets", m_name.c_str(), grown->m_mask + 1);
+        GcManager* gcSession = MOTEngine::GetInstance()->GetCurrentGcSession();
+        MOT_ASSERT(gcSession != nullptr);
+        gcSession->GcRecordObject(GetIndexId(), buckets, nullptr, DeallocateBucketsCallBack, buckets->GetSize());
+    } else {
+        MOT_LOG_WARN("Failed to grow hash index %s: out of memory", m_name.c_str());
+        // nobody has seen the new array, so it and the nodes copied or inserted into it are released right away
+        (void)DeallocateBucketsCallBack(grown, nullptr, false);
+    }
+    m_growing.store(false);
+}
+
+uint32_t HashPrimaryIndex::DeallocateNodeCallBack(void* pool, void* ptr, bool dropIndex)
+{
+    // If dropIndex == true, all index's pools are going to be cleaned, so we skip the release here
+    ObjAllocInterface* nodePool = (ObjAllocInterface*)pool;
+    if (dropIndex == false) {
+        nodePool->Release(ptr);
+    }
+    return nodePool->m_size;
+}
+
+uint32_t HashPrimaryIndex::DeallocateBucketsCallBack(void* buckets, void* ptr, bool dropIndex)
+{
+    HashBuckets* retired = (HashBuckets*)buckets;
+    uint32_t size = (uint32_t)retired->GetSize();
+    // If dropIndex == true, the node pool is going to be cleaned, so only the array itself is freed
+    if (dropIndex == false) {
+        std::atomic<HashNode*>* heads = retired->GetHeads();
+        for (uint64_t i = 0; i <= retired->m_mask; ++i) {
+            HashNode* node = heads[i].load(std::memory_order_relaxed);
+            while (node != nullptr) {
+                HashNode* next = node->m_next.load(std::memory_order_relaxed);
+                if (retired->m_nodePool != nullptr) {
+                    retired->m_nodePool->Release(node);
+                    size += retired->m_nodePool->m_size;
+                }
+                node = next;
+            }
+        }
+    }
+    MemGlobalFree(retired);
+    return size;
+}
+
+uint64_t HashPrimaryIndex::GetIndexSize()
+{
+    PoolStatsSt stats;
+
+    errno_t erc = memset_s(&stats, sizeof(PoolStatsSt), 0, sizeof(PoolStatsSt));
+    securec_check(erc, "\0", "\0");
+    stats.m_type = PoolStatsT::POOL_STATS_ALL;
+    m_keyPool->GetStats(stats);
+    uint64_t res = stats.m_poolCount * stats.m_poolGrossSize;
+    uint64_t netto = (stats.m_totalObjCount - stats.m_freeObjCount) * stats.m_objSize;
+
+    erc = memset_s(&stats, sizeof(PoolStatsSt), 0, sizeof(PoolStatsSt));
+    securec_check(erc, "\0", "\0");
+    stats.m_type = PoolStatsT::POOL_STATS_ALL;
+    m_sentinelPool->GetStats(stats);
+    res += stats.m_poolCount * stats.m_poolGrossSize;
+    netto += (stats.m_totalObjCount - stats.m_freeObjCount) * stats.m_objSize;
+
+    erc = memset_s(&stats, sizeof(PoolStatsSt), 0, sizeof(PoolStatsSt));
+    securec_check(erc, "\0", "\0");
+    stats.m_type = PoolStatsT::POOL_STATS_ALL;
+    m_nodePool->GetStats(stats);
+    res += stats.m_poolCount * stats.m_poolGrossSize;
+    netto += (stats.m_totalObjCount - stats.m_freeObjCount) * stats.m_objSize;
+
+    uint64_t bucketsSize = m_buckets.load(std::memory_order_acquire)->GetSize();
+    res += bucketsSize;
+    netto += bucketsSize;
+
+    MOT_LOG_INFO("Index %s memory size: gross: %lu, netto: %lu", m_name.c_str(), res, netto);
+    return res;
+}
+
+// Iterator API
+IndexIterator* HashPrimaryIndex::Begin(uint32_t pid, bool passive) const
+{
+    HashBuckets* buckets = m_buckets.load(std::memory_order_acquire);
+    std::atomic<HashNode*>* heads = buckets->GetHeads();
+    uint64_t bucket = 0;
+    HashNode* node = heads[0].load(std::memory_order_acquire);
+    while (node == nullptr && bucket < buckets->m_mask) {
+        node = heads[++bucket].load(std::memory_order_acquire);
+    }
+
+    IndexIterator* itr = new (std::nothrow) HashIterator(buckets, bucket, node, false);
+    if (itr == nullptr) {
+        MOT_REPORT_ERROR(MOT_ERROR_OOM, "Index Begin", "Failed to create hash iterator");
+    }
+    return itr;
+}
+
+void HashPrimaryIndex::Sample(uint32_t count, uint64_t seed, std::vector<Sentinel*>& sentinels, uint32_t pid) const
+{
+    sentinels.clear();
+    if (GetSize() == 0) {
+        return;
+    }
+
+    HashBuckets* buckets = m_buckets.load(std::memory_order_acquire);
+    std::atomic<HashNode*>* heads = buckets->GetHeads();
+    std::mt19937_64 random(seed);
+    std::unordered_set<Sentinel*> collected;
+    // a position hits an entry with probability load factor / SAMPLE_CHAIN_LENGTH
+    uint64_t attempts = (uint64_t)count * SAMPLE_ATTEMPTS_PER_ENTRY * SAMPLE_CHAIN_LENGTH;
+    for (uint64_t i = 0; i < attempts && sentinels.size() < count; i++) {
+        uint64_t offset = random() % SAMPLE_CHAIN_LENGTH;
+        HashNode* node = heads[random() & buckets->m_mask].load(std::memory_order_acquire);
+        while (node != nullptr && offset > 0) {
+            node = node->m_next.load(std::memory_order_acquire);
+            offset--;
+        }
+        if (node != nullptr && collected.insert(node->m_sentinel).second) {
+            sentinels.push_back(node->m_sentinel);
+        }
+    }
+}
+
+IndexIterator* HashPrimaryIndex::Search(
+    const Key* key, bool matchKey, bool forward, uint32_t pid, bool& found, bool passive) const
+{
+    HashBuckets* buckets = m_buckets.load(std::memory_order_acquire);
+    HashNode* node = nullptr;
+    if (matchKey) {
+        node = FindNode(buckets, key, HashKey(key->GetKeyBuf(), key->GetKeyLength()));
+    }
+    found = (node != nullptr);
+
+    IndexIterator* itr = new (std::nothrow) HashIterator(buckets, 0, node, true);
+    if (itr == nullptr) {
+        MOT_REPORT_ERROR(MOT_ERROR_OOM, "Index Search", "Failed to create hash iterator");
+    }
+    return itr;
+}
+}  // namespace MOT
@@ -0,0 +1,403 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * -------------------------------------------------------------------------
+ *
+ * hash_index.h
+ *    Primary index implementation using a concurrent resizable hash table.
+ *
+ * IDENTIFICATION
+ *    src/gausskernel/storage/mot/core/src/storage/index/hash_index.h
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef HASH_PRIMARY_INDEX_H
+#define HASH_PRIMARY_INDEX_H
+
+#include <atomic>
+#include "index.h"
+#include "utilities.h"
+#include "spin_lock.h"
+
+namespace MOT {
+/**
+ * @class HashPrimaryIndex.
+ * @brief Unique index implementation using a concurrent resizable hash table.
+ * @detail Lookups are lock-free. Inserts and removals lock one of a fixed set of bucket stripes. When the average
+ * chain grows too long the table doubles: the insert crossing the load factor only allocates a new bucket array,
+ * and each following insert or removal copies the live nodes of a few more stripes into it, holding only that
+ * stripe's lock, so no single operation pays for the whole table. Inserts and removals of an already copied stripe
+ * update both arrays. Once the last stripe is copied the new array is published atomically, so readers and
+ * iterators still walking the old array see intact chains until the GC reclaims it. Key order is not kept, so the
+ * index serves only exact lookups of the full key and unordered full scans.
+ */
+class HashPrimaryIndex : public Index {
+private:
+    /**
+     * @struct HashNode
+     * @brief A bucket chain entry. The key of the entry follows the node in memory.
+     */
+    struct HashNode {
+        /** @var The next node in the bucket chain. */
+        std::atomic<HashNode*> m_next;
+
+        /** @var The full hash code of the key. */
+        uint64_t m_hash;
+
+        /** @var The indexed sentinel. */
+        Sentinel* m_sentinel;
+
+        inline Key* GetKey()
+        {
+            return reinterpret_cast<Key*>(this + 1);
+        }
+    };
+
+    /**
+     * @struct HashBuckets
+     * @brief A bucket array. The bucket heads follow the header in memory.
+     */
+    struct HashBuckets {
+        /** @var The number of buckets minus one. */
+        uint64_t m_mask;
+
+        /** @var The pool of the chained nodes, used to release them when the array is retired. */
+        ObjAllocInterface* m_nodePool;
+
+        inline std::atomic<HashNode*>* GetHeads()
+        {
+            return reinterpret_cast<std::atomic<HashNode*>*>(this + 1);
+        }
+
+        inline uint64_t GetSize() const
+        {
+            return sizeof(HashBuckets) + (m_mask + 1) * sizeof(std::atomic<HashNode*>);
+        }
+    };
+
+    /**
+     * @class HashIterator
+     * @brief A forward iterator over the entries of a hash index, in bucket order.
+     */
+    class HashIterator : public IndexIterator {
+    public:
+        /**
+         * @brief Constructor.
+         * @param buckets The bucket array to iterate.
+         * @param bucket The bucket of the first node.
+         * @param node The first node, or null for an exhausted iterator.
+         * @param single Specifies whether the iterator stops after the first node.
+         */
+        HashIterator(HashBuckets* buckets, uint64_t bucket, HashNode* node, bool single)
+            : IndexIterator(IteratorType::ITERATOR_TYPE_FORWARD, false),
+              m_buckets(buckets),
+              m_bucket(bucket),
+              m_node(node),
+              m_single(single)
+        {}
+
+        /**
+         * @brief Destructor.
+         */
+        virtual ~HashIterator()
+        {
+            m_node = nullptr;
+        }
+
+        virtual bool IsValid() const
+        {
+            return m_node != nullptr;
+        }
+
+        virtual void Invalidate()
+        {
+            m_node = nullptr;
+        }
+
+        virtual const void* GetKey() const
+        {
+            return m_node->GetKey();
+        }
+
+        virtual Row* GetRow() const
+        {
+            return m_node->m_sentinel->GetData();
+        }
+
+        virtual Sentinel* GetPrimarySentinel() const
+        {
+            return m_node->m_sentinel;
+        }
+
+        /**
+         * @brief Moves forwards the iterator to the next item.
+         */
+        virtual void Next();
+
+        /**
+         * @brief Moves backwards the iterator to the previous item.
+         * @detail Not supported by hash indexes.
+         */
+        virtual void Prev()
+        {
+            MOT_ASSERT(false);
+        }
+
+        virtual bool Equals(const IndexIterator* rhs) const
+        {
+            return m_node == static_cast<const HashIterator*>(rhs)->m_node;
+        }
+
+        /**
+         * Serializes the iterator into a buffer.
+         * @detail Not implemented
+         */
+        virtual void Serialize(serialize_func_t serializeFunc, unsigned char* buff) const
+        {}
+
+        /**
+         * Deserializes the iterator from a buffer.
+         * @detail Not implemented
+         */
+        virtual void Deserialize(deserialize_func_t deserializeFunc, unsigned char* buff)
+        {}
+
+    private:
+        /** @var The iterated bucket array. */
+        HashBuckets* m_buckets;
+
+        /** @var The bucket of the current node. */
+        uint64_t m_bucket;
+
+        /** @var The current node. */
+        HashNode* m_node;
+
+        /** @var Specifies whether the iterator stops after the first node. */
+        bool m_single;
+    };
+
+public:
+    /**
+     * @brief Default constructor.
+     */
+    HashPrimaryIndex()
+        : Index(MOT::IndexOrder::INDEX_ORDER_PRIMARY, IndexingMethod::INDEXING_METHOD_HASH),
+          m_buckets(nullptr),
+          m_growTarget(nullptr),
+          m_migrateStripe(0),
+          m_nodePool(nullptr),
+          m_count(0),
+          m_growing(false),
+          m_initialized(false)
+    {}
+
+    /**
+     * @brief Destructor.
+     */
+    virtual ~HashPrimaryIndex()
+    {
+        if (m_initialized) {
+            m_initialized = false;
+            DestroyTable();
+        }
+    }
+
+    /**
+     * @brief Calculate the Index memory consumption.
+     * @return The amount of memory the Index consumes.
+     */
+    virtual uint64_t GetIndexSize() override;
+
+    /**
+     * @brief Retrieves the number of rows stored in the index.
+     * @return The number of rows stored in the index.
+     */
+    virtual uint64_t GetSize() const
+    {
+        return m_count.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Destroy the table and init index again.
+     */
+    virtual RC ReInitIndex()
+    {
+        m_initialized = false;
+        DestroyTable();
+
+        return IndexInitImpl(nullptr);
+    }
+
+    // Iterator API
+    virtual IndexIterator* Begin(uint32_t pid, bool passive = false) const;
+
+    /**
+     * @brief Searches for a key in the index.
+     * @detail Hash indexes keep no key order, so the resulting iterator yields at most the entry matching the key
+     * exactly, and only if matchKey is set. The FDW (MOTAdaptor::GetBestMatchIndex) and JIT planners pick a hash
+     * index only for equality on every key column, range and prefix quals are served by a full scan instead.
+     */
+    virtual IndexIterator* Search(
+        const Key* key, bool matchKey, bool forward, uint32_t pid, bool& found, bool passive = false) const;
+
+    /**
+     * @brief Collects the sentinels of entries at random positions of the index, for sampling.
+     * @detail A position is a random bucket and a random chain offset below SAMPLE_CHAIN_LENGTH, and is rejected if
+     * the chain is shorter. Entries are equally likely only while no chain is longer than SAMPLE_CHAIN_LENGTH: the
+     * entries past that offset of a longer chain are never collected. Doubling the table at MAX_LOAD_FACTOR keeps
+     * such chains rare for well spread keys, but many keys hashing to one bucket leave them out of the sample.
+     */
+    virtual void Sample(uint32_t count, uint64_t seed, std::vector<Sentinel*>& sentinels, uint32_t pid) const;
+
+    /**
+     * @brief Static callback function for deallocating a removed node.
+     * @param pool Pool to deallocate from.
+     * @param ptr The node.
+     * @param dropIndex Indicates if this callback is part of drop index process.
+     * @return Size of memory that was deallocated.
+     */
+    static uint32_t DeallocateNodeCallBack(void* pool, void* ptr, bool dropIndex);
+
+    /**
+     * @brief Static callback function for deallocating a bucket array replaced by a larger one, together with the
+     * nodes chained in it.
+     * @param buckets The bucket array.
+     * @param ptr Unused.
+     * @param dropIndex Indicates if this callback is part of drop index process.
+     * @return Size of memory that was deallocated.
+     */
+    static uint32_t DeallocateBucketsCallBack(void* buckets, void* ptr, bool dropIndex);
+
+protected:
+    /**
+     * @brief Implements index initialization.
+     * @param args Null-terminated list of any additional arguments.
+     * @return Return code denoting success or error.
+     */
+    virtual RC IndexInitImpl(void** args);
+
+    virtual Sentinel* IndexInsertImpl(const Key* key, Sentinel* sentinel, bool& inserted, uint32_t pid);
+
+    virtual Sentinel* IndexReadImpl(const Key* key, uint32_t pid) const;
+
+    /**
+     * @brief Reads the sentinels of several keys.
+     * @detail The lookups advance in lock step: all bucket heads are prefetched, then all first chain nodes, and
+     * only then are the chains walked.
+     */
+    virtual void IndexReadBatchImpl(const Key* const* keys, uint32_t count, Sentinel** sentinels, uint32_t pid) const;
+
+    virtual Sentinel* IndexRemoveImpl(const Key* key, uint32_t pid);
+
+private:
+    /** @var The number of buckets of a new index. Must be a multiple of LOCK_STRIPES. */
+    static constexpr uint64_t INITIAL_BUCKETS = 1024;
+
+    /** @var The number of bucket lock stripes. A bucket keeps its stripe when the table grows. */
+    static constexpr uint64_t LOCK_STRIPES = 256;
+
+    /** @var The average chain length above which the table doubles. */
+    static constexpr uint64_t MAX_LOAD_FACTOR = 2;
+
+    /** @var The number of stripes an insert or removal copies into the grow target. */
+    static constexpr uint64_t MIGRATE_STRIPES_PER_STEP = 4;
+
+    /** @var The chain length up to which Sample() draws entries uniformly. */
+    static constexpr uint64_t SAMPLE_CHAIN_LENGTH = 4 * MAX_LOAD_FACTOR;
+
+    /** @struct StripeLock @brief A bucket stripe lock on its own cache line. */
+    struct alignas(CACHE_LINE_SIZE) StripeLock {
+        spin_lock m_lock;
+
+        /** @var Set once MigrateStep() copied the stripe into m_growTarget, guarded by m_lock. */
+        bool m_migrated = false;
+    };
+
+    /** @var The current bucket array. */
+    std::atomic<HashBuckets*> m_buckets;
+
+    /** @var The bucket array a running migration fills, null otherwise. */
+    std::atomic<HashBuckets*> m_growTarget;
+
+    /** @var The next stripe to copy into m_growTarget, guarded by m_migrateLock. */
+    uint64_t m_migrateStripe;
+
+    /** @var Serializes the migration steps, taken with try_lock so that no insert or removal waits on another. */
+    spin_lock m_migrateLock;
+
+    /** @var Memory pool for nodes and their keys. */
+    ObjAllocInterface* m_nodePool;
+
+    /** @var The number of entries. */
+    std::atomic<uint64_t> m_count;
+
+    /** @var Set from the start of a grow until its new array is published or dropped. */
+    std::atomic<bool> m_growing;
+
+    /** @var Determine if object is initialized or not. */
+    bool m_initialized;
+
+    /** @var The bucket stripe locks serializing inserts and removals. */
+    StripeLock m_stripeLocks[LOCK_STRIPES];
+
+    static uint64_t HashKey(const uint8_t* buf, uint16_t len);
+
+    static HashBuckets* AllocBuckets(uint64_t bucketCount, ObjAllocInterface* nodePool);
+
+    static HashNode* FindNode(HashBuckets* buckets, const Key* key, uint64_t hash);
+
+    static HashNode* FindInChain(HashNode* node, const Key* key, uint64_t hash);
+
+    /** @brief Allocates a node for a key, null if out of memory. */
+    HashNode* NewNode(const Key* key, uint64_t hash, Sentinel* sentinel);
+
+    /** @brief Pushes a node to the head of its bucket chain. Caller holds the node's stripe lock. */
+    static void LinkNode(HashBuckets* buckets, HashNode* node);
+
+    /** @brief Unlinks the node of a key from its bucket chain, null if absent. Caller holds the key's stripe lock. */
+    static HashNode* UnlinkNode(HashBuckets* buckets, const Key* key, uint64_t hash);
+
+    /**
+     * @brief Retrieves the array a running migration already copied a stripe into. Caller holds the stripe lock.
+     * @param stripe The stripe.
+     * @param buckets The current bucket array.
+     * @return The grow target if the stripe was copied into it and it is not current yet, otherwise null.
+     */
+    HashBuckets* GetMigratedTarget(uint64_t stripe, HashBuckets* buckets) const;
+
+    /** @brief Copies the chains of one stripe into a larger bucket array. Caller holds the stripe lock. */
+    bool CopyStripe(HashBuckets* buckets, HashBuckets* grown, uint64_t stripe);
+
+    /** @brief Starts doubling the bucket array, the stripes are copied by the following migration steps. */
+    void Grow();
+
+    /** @brief Copies the next few stripes into the grow target, and finishes the grow after the last one. */
+    void MigrateStep();
+
+    /**
+     * @brief Ends a grow. Caller holds m_migrateLock.
+     * @param buckets The current bucket array.
+     * @param grown The grow target.
+     * @param copied Whether every stripe was copied. The new array is published if so, and dropped otherwise.
+     */
+    void FinishGrow(HashBuckets* buckets, HashBuckets* grown, bool copied);
+
+    /** @brief Frees the bucket array and the node pool. */
+    void DestroyTable();
+
+    DECLARE_CLASS_LOGGER()
+};
+}  // namespace MOT
+
+#endif /* HASH_PRIMARY_INDEX_H */
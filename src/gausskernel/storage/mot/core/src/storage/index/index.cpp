@@ -22,6 +22,9 @@
  * -------------------------------------------------------------------------
  */
 
+#include <algorithm>
+#include <random>
+#include <unordered_set>
 #include "index.h"
 #include "row.h"
 #include "sentinel.h"
@@ -31,6 +34,9 @@
 namespace MOT {
 IMPLEMENT_CLASS_LOGGER(Index, Storage);
 
+constexpr uint32_t Index::READ_BATCH_SIZE;
+constexpr uint32_t Index::SAMPLE_ATTEMPTS_PER_ENTRY;
+
 std::atomic<uint32_t> MOT::Index::m_indexCounter(0);
 
 uint64_t Index::GetSize() const
@@ -120,6 +126,77 @@ IndexIterator* Index::ReverseUpperBound(const Key* key, uint32_t pid) const
     return itr;
 }
 
+void Index::Sample(uint32_t count, uint64_t seed, std::vector<Sentinel*>& sentinels, uint32_t pid) const
+{
+    sentinels.clear();
+    uint16_t keyLength = (uint16_t)GetKeyLength();
+    MaxKey low;
+    MaxKey high;
+    low.InitKey(keyLength);
+    high.InitKey(keyLength);
+
+    // the sampled key range spans the lowest and the highest key of the index
+    IndexIterator* itr = Begin(pid);
+    if (itr == nullptr || !itr->IsValid()) {
+        delete itr;
+        return;
+    }
+    low.CpKey(*reinterpret_cast<const Key*>(itr->GetKey()));
+    delete itr;
+
+    bool found = false;
+    MaxKey key;
+    key.InitKey(keyLength);
+    (void)key.FillPattern(0xFF, keyLength, 0);
+    itr = Search(&key, true, false, pid, found);
+    if (itr == nullptr || !itr->IsValid()) {
+        delete itr;
+        return;
+    }
+    high.CpKey(*reinterpret_cast<const Key*>(itr->GetKey()));
+    delete itr;
+
+    // keys are drawn on the first bytes in which the lowest and the highest key differ, the rest is random
+    const uint8_t* lowBuf = low.GetKeyBuf();
+    const uint8_t* highBuf = high.GetKeyBuf();
+    uint16_t prefix = 0;
+    while (prefix < keyLength && lowBuf[prefix] == highBuf[prefix]) {
+        prefix++;
+    }
+    uint16_t span = (uint16_t)std::min<int>(sizeof(uint64_t), keyLength - prefix);
+    uint64_t lowValue = 0;
+    uint64_t highValue = 0;
+    for (uint16_t i = 0; i < span; i++) {
+        lowValue = (lowValue << 8) | lowBuf[prefix + i];
+        highValue = (highValue << 8) | highBuf[prefix + i];
+    }
+
+    std::mt19937_64 random(seed);
+    std::unordered_set<Sentinel*> collected;
+    uint64_t attempts = (uint64_t)count * SAMPLE_ATTEMPTS_PER_ENTRY;
+    for (uint64_t i = 0; i < attempts && sentinels.size() < count; i++) {
+        uint64_t range = highValue - lowValue;
+        uint64_t value = (range == UINT64_MAX) ? random() : lowValue + random() % (range + 1);
+        key.InitKey(keyLength);
+        (void)key.FillValue(lowBuf, prefix, 0);
+        for (uint16_t j = 0; j < span; j++) {
+            key.GetKeyBuf()[prefix + j] = (uint8_t)(value >> (8 * (span - j - 1)));
+        }
+        for (uint16_t j = prefix + span; j < keyLength; j++) {
+            key.GetKeyBuf()[j] = (uint8_t)random();
+        }
+
+        itr = Search(&key, true, true, pid, found);
+        if (itr != nullptr && itr->IsValid()) {
+            Sentinel* sentinel = itr->GetPrimarySentinel();
+            if (sentinel != nullptr && collected.insert(sentinel).second) {
+                sentinels.push_back(sentinel);
+            }
+        }
+        delete itr;
+    }
+}
+
 RC Index::IndexInitImpl(void** args)
 {
     return RC_OK;
@@ -127,7 +204,6 @@ RC Index::IndexInitImpl(void** args)
 
 void Index::BuildKey(Table* table, const Row* row, Key* key)
 {
-    uint16_t offset = 0;
     uint8_t* data = const_cast<uint8_t*>(row->GetData());
     uint8_t* buf = key->GetKeyBuf();
 
@@ -140,23 +216,7 @@ void Index::BuildKey(Table* table, const Row* row, Key* key)
         buf = (const_cast<Row*>(row))->GetInternalKeyBuff(GetIndexOrder());
         key->CpKey(buf, m_keyLength);
     } else {
-        for (int i = 0; i < m_numKeyFields; i++) {
-            Column* col = table->GetField(m_columnKeyFields[i]);
-
-            if (BITMAP_GET(data, (col->m_id - 1))) {
-                uintptr_t val = 0;
-                size_t len = 0;
-
-                col->Unpack(data, &val, len);
-                col->PackKey(buf + offset, val, len);
-            } else {
-                MOT_ASSERT((offset + m_lengthKeyFields[i]) <= m_keyLength);
-                // NOTE: we should consider different data types and fill NULL value according to a data type
-                erc = memset_s(buf + offset, m_keyLength - offset, 0x00, m_lengthKeyFields[i]);
-                securec_check(erc, "\0", "\0");
-            }
-            offset += m_lengthKeyFields[i];
-        }
+        PackKeyFields(table, data, buf);
     }
 
     if (!m_unique) {
@@ -167,6 +227,115 @@ void Index::BuildKey(Table* table, const Row* row, Key* key)
     }
 }
 
+void Index::PackKeyFields(Table* table, const uint8_t* data, uint8_t* buf) const
+{
+    uint16_t offset = 0;
+    uint8_t* rowData = const_cast<uint8_t*>(data);
+
+    for (int i = 0; i < m_numKeyFields; i++) {
+        Column* col = table->GetField(m_columnKeyFields[i]);
+
+        if (BITMAP_GET(rowData, (col->m_id - 1))) {
+            uintptr_t val = 0;
+            size_t len = 0;
+
+            col->Unpack(rowData, &val, len);
+            col->PackKey(buf + offset, val, len);
+        } else {
+            MOT_ASSERT((offset + m_lengthKeyFields[i]) <= m_keyLength);
+            // NOTE: we should consider different data types and fill NULL value according to a data type
+            errno_t erc = memset_s(buf + offset, m_keyLength - offset, 0x00, m_lengthKeyFields[i]);
+            securec_check(erc, "\0", "\0");
+        }
+        offset += m_lengthKeyFields[i];
+    }
+}
+
+void Index::UpdateStatistics(const uint8_t* const* rows, uint32_t numRows, double totalRows)
+{
+    // an empty sample says nothing about key distinctness, keep the previous statistics (if any)
+    if (numRows == 0 && !IsFakePrimary()) {
+        return;
+    }
+
+    IndexStatistics stats = {};
+    uint32_t prefixLen[MAX_KEY_COLUMNS] = {0};
+    uint32_t keyFieldsLen = 0;
+
+    stats.m_numRows = (totalRows < numRows) ? numRows : totalRows;
+    for (int i = 0; i < m_numKeyFields; i++) {
+        keyFieldsLen += m_lengthKeyFields[i];
+        prefixLen[i] = keyFieldsLen;
+    }
+
+    if (IsFakePrimary()) {
+        // surrogate keys are all distinct
+        for (int i = 0; i < m_numKeyFields; i++) {
+            stats.m_distinctPrefix[i] = stats.m_numRows;
+        }
+    } else {
+        // sorted keys are also sorted by any prefix, so equal prefixes are adjacent
+        std::vector<std::string> keys(numRows, std::string(m_keyLength, '\0'));
+        for (uint32_t r = 0; r < numRows; r++) {
+            PackKeyFields(m_table, rows[r], reinterpret_cast<uint8_t*>(&keys[r][0]));
+        }
+        std::sort(keys.begin(), keys.end());
+
+        double n = numRows;
+        for (int i = 0; i < m_numKeyFields; i++) {
+            // d distinct values in the sample, f1 of them seen exactly once
+            double d = 0;
+            double f1 = 0;
+            uint32_t groupStart = 0;
+            for (uint32_t r = 1; r <= numRows; r++) {
+                if (r == numRows || keys[r].compare(0, prefixLen[i], keys[groupStart], 0, prefixLen[i]) != 0) {
+                    d += 1;
+                    if (r - groupStart == 1) {
+                        f1 += 1;
+                    }
+                    groupStart = r;
+                }
+            }
+
+            double distinct = d;
+            if (n < stats.m_numRows) {
+                if (f1 == n) {
+                    // all distinct in the sample, assume unique
+                    distinct = stats.m_numRows;
+                } else {
+                    distinct = (n * d) / ((n - f1) + f1 * n / stats.m_numRows);
+                }
+            }
+            if (distinct < d) {
+                distinct = d;
+            } else if (distinct > stats.m_numRows) {
+                distinct = stats.m_numRows;
+            }
+            stats.m_distinctPrefix[i] = distinct;
+        }
+    }
+
+    if (m_unique && m_numKeyFields > 0) {
+        stats.m_distinctPrefix[m_numKeyFields - 1] = stats.m_numRows;
+    }
+
+    m_statsLock.lock();
+    m_stats = stats;
+    m_hasStats = true;
+    m_statsLock.unlock();
+}
+
+bool Index::GetStatistics(IndexStatistics& stats) const
+{
+    m_statsLock.lock();
+    bool hasStats = m_hasStats;
+    if (hasStats) {
+        stats = m_stats;
+    }
+    m_statsLock.unlock();
+    return hasStats;
+}
+
 void Index::BuildErrorMsg(Table* table, const Row* row, char* destBuf, size_t len)
 {
     errno_t erc;
@@ -340,6 +509,37 @@ Sentinel* Index::IndexReadHeader(const Key* key, uint32_t pid) const
     return sentinel;
 }
 
+uint32_t Index::IndexReadBatch(const Key* const* keys, uint32_t count, Sentinel** sentinels, uint32_t pid) const
+{
+    uint32_t found = 0;
+    IndexReadBatchImpl(keys, count, sentinels, pid);
+
+    // the caller goes on to the rows: start loading all sentinels first, then the rows they point to
+    for (uint32_t i = 0; i < count; ++i) {
+        if (sentinels[i] != nullptr) {
+            Prefetch(sentinels[i]);
+            ++found;
+        }
+    }
+    for (uint32_t i = 0; i < count; ++i) {
+        if (sentinels[i] != nullptr) {
+            Row* row = sentinels[i]->GetData();
+            if (row != nullptr) {
+                Prefetch(row);
+            }
+        }
+    }
+
+    return found;
+}
+
+void Index::IndexReadBatchImpl(const Key* const* keys, uint32_t count, Sentinel** sentinels, uint32_t pid) const
+{
+    for (uint32_t i = 0; i < count; ++i) {
+        sentinels[i] = IndexReadImpl(keys[i], pid);
+    }
+}
+
 Sentinel* Index::IndexRemove(const Key* key, uint32_t pid)
 {
     Sentinel* sentinel = IndexRemoveImpl(key, pid);
@@ -32,13 +32,27 @@
 #include "txn.h"
 #include "object_pool.h"
 #include "utilities.h"
+#include "spin_lock.h"
 
 #include <string>
+#include <vector>
 using namespace std;
 
 namespace MOT {
 #define NON_UNIQUE_INDEX_SUFFIX_LEN 8
 
+/**
+ * @struct IndexStatistics
+ * @brief Cardinality estimates of an index, refreshed by ANALYZE and rebuilt by recovery from a sample of the table.
+ */
+struct IndexStatistics {
+    /** @var The estimated number of rows of the table when the statistics were taken. */
+    double m_numRows;
+
+    /** @var The estimated number of distinct values of the first i + 1 key columns. */
+    double m_distinctPrefix[MAX_KEY_COLUMNS];
+};
+
 /**
  * @class Index
  * @brief This base class for primary and secondary index.
@@ -428,6 +442,18 @@ public:
      */
     virtual IndexIterator* ReverseUpperBound(const Key* key, uint32_t pid) const;
 
+    /**
+     * @brief Collects the primary sentinels of entries at random positions of the index, for sampling.
+     * @detail The default implementation draws keys uniformly between the lowest and the highest key of the index,
+     * and takes the first entry at or after each drawn key. Entries that follow sparse key ranges are therefore more
+     * likely to be collected. The cost is proportional to the number of entries collected, not to the index size.
+     * @param count The number of distinct entries to collect.
+     * @param seed The seed of the random positions.
+     * @param[out] sentinels The collected sentinels. Fewer than requested may be collected if the index is small.
+     * @param pid The logical identifier of the requesting thread.
+     */
+    virtual void Sample(uint32_t count, uint64_t seed, std::vector<Sentinel*>& sentinels, uint32_t pid) const;
+
     // Key API
     /**
      * @brief Builds a key from a row according to index specification.
@@ -443,6 +469,25 @@ public:
      */
     virtual void BuildErrorMsg(Table* table, const Row* row, char* destBuf, size_t len);
 
+    // Statistics API
+    /**
+     * @brief Refreshes the statistics of the index from a sample of the rows of its table.
+     * @detail The number of distinct values of every key column prefix is estimated from the sample with the
+     * Duj1 estimator of Haas and Stokes, which ANALYZE also uses for column statistics. An empty sample leaves the
+     * statistics unchanged.
+     * @param rows The data of the sampled rows.
+     * @param numRows The number of sampled rows.
+     * @param totalRows The estimated number of rows of the table.
+     */
+    void UpdateStatistics(const uint8_t* const* rows, uint32_t numRows, double totalRows);
+
+    /**
+     * @brief Retrieves the statistics of the index.
+     * @param[out] stats Receives the statistics.
+     * @return False if the index was not analyzed yet.
+     */
+    bool GetStatistics(IndexStatistics& stats) const;
+
 protected:
     /**
      * @brief Derived classes should override this method to perform any further required
@@ -638,6 +683,24 @@ public:
     Row* IndexRead(const Key* key, uint32_t pid) const;
     Sentinel* IndexReadHeader(const Key* key, uint32_t pid) const;
 
+    /** @var The number of keys an index implementation looks up together in IndexReadBatch(). */
+    static constexpr uint32_t READ_BATCH_SIZE = 32;
+
+    /** @var The number of random positions Sample() draws per requested entry before it gives up. */
+    static constexpr uint32_t SAMPLE_ATTEMPTS_PER_ENTRY = 4;
+
+    /**
+     * @brief Reads the sentinels of several keys from the index.
+     * @detail The lookups are interleaved as far as the index implementation allows, and the found sentinels and
+     * their rows are prefetched, so the cache misses of the batch overlap instead of being paid one key at a time.
+     * @param keys The keys to search.
+     * @param count The number of keys.
+     * @param[out] sentinels Receives the sentinel of each key, or null pointer if the key was not found.
+     * @param pid The logical identifier of the requesting thread.
+     * @return The number of keys found.
+     */
+    uint32_t IndexReadBatch(const Key* const* keys, uint32_t count, Sentinel** sentinels, uint32_t pid) const;
+
     /**
      * @brief Reads a single row from the index.
      * @param key A pointer to the key to search.
@@ -699,6 +762,22 @@ protected:
 
     Table* m_table;
 
+    /** @var The statistics of the index, valid once m_hasStats is set. */
+    IndexStatistics m_stats = {};
+
+    bool m_hasStats = false;
+
+    /** @var Protects the statistics against concurrent ANALYZE and planning. */
+    mutable spin_lock m_statsLock;
+
+    /**
+     * @brief Packs the key columns of a row into a buffer, as they are laid out in the key.
+     * @param table The table of the row.
+     * @param data The data of the row.
+     * @param buf The buffer to pack into, at least the key length.
+     */
+    void PackKeyFields(Table* table, const uint8_t* data, uint8_t* buf) const;
+
     /**
      * @brief Inserts a single row into the actual data structure that implements the index.
      * @param key Pointer to the key.
@@ -720,6 +799,16 @@ protected:
      */
     virtual Sentinel* IndexReadImpl(const Key* key, uint32_t pid) const = 0;
 
+    /**
+     * @brief Reads the sentinels of several keys from the actual data structure that implements the index.
+     * @detail The default implementation looks the keys up one at a time.
+     * @param keys The keys to search.
+     * @param count The number of keys.
+     * @param[out] sentinels Receives the sentinel of each key, or null pointer if the key was not found.
+     * @param pid The logical identifier of the requesting thread.
+     */
+    virtual void IndexReadBatchImpl(const Key* const* keys, uint32_t count, Sentinel** sentinels, uint32_t pid) const;
+
     /**
      * @brief Removes a row from the actual data structure that implements the index.
      * @param key A pointer to the key.
@@ -36,4 +36,18 @@ const char* IndexTreeFlavorToString(const IndexTreeFlavor& indexTreeFlavor)
 
     return "InvalidFlavor";
 }
+
+const char* IndexingMethodToString(const IndexingMethod& indexingMethod)
+{
+    switch (indexingMethod) {
+        case IndexingMethod::INDEXING_METHOD_TREE:
+            return "tree";
+        case IndexingMethod::INDEXING_METHOD_HASH:
+            return "hash";
+        default:
+            return "invalid";
+    }
+
+    return "invalid";
+}
 }  // namespace MOT
@@ -131,7 +131,70 @@ enum class IndexingMethod : uint32_t {
     /**
      * @var Denotes tree-based indexing.
      */
-    INDEXING_METHOD_TREE
+    INDEXING_METHOD_TREE,
+
+    /**
+     * @var Denotes hash-based indexing. Hash indexes are unique and serve only exact lookups of the full key and
+     * unordered full scans.
+     */
+    INDEXING_METHOD_HASH,
+
+    /**
+     * @var Denotes an invalid indexing method.
+     */
+    INDEXING_METHOD_INVALID
+};
+
+/**
+ * @brief Convert indexing method in string representation to enum representation.
+ * @return enum IndexingMethod which representing the given char *.
+ */
+inline IndexingMethod IndexingMethodFromString(const char* method)
+{
+    if (strcmp(method, "tree") == 0) {
+        return IndexingMethod::INDEXING_METHOD_TREE;
+    } else if (strcmp(method, "hash") == 0) {
+        return IndexingMethod::INDEXING_METHOD_HASH;
+    }
+
+    return IndexingMethod::INDEXING_METHOD_INVALID;
+}
+
+/**
+ * @brief Convert indexing method in enum representation to string representation.
+ * @return Char * which representing the given enum IndexingMethod.
+ */
+const char* IndexingMethodToString(const IndexingMethod& indexingMethod);
+
+/**
+ * @class TypeFormatter<IndexingMethod>
+ * @brief Specialization of TypeFormatter<T> with [ T = IndexingMethod ].
+ */
+template <>
+class TypeFormatter<IndexingMethod> {
+public:
+    /**
+     * @brief Converts a value to string.
+     * @param value The value to convert.
+     * @param[out] stringValue The resulting string.
+     */
+    static inline const char* ToString(const IndexingMethod& value, mot_string& stringValue)
+    {
+        stringValue = IndexingMethodToString(value);
+        return stringValue.c_str();
+    }
+
+    /**
+     * @brief Converts a string to a value.
+     * @param The string to convert.
+     * @param[out] The resulting value.
+     * @return Boolean value denoting whether the conversion succeeded or not.
+     */
+    static inline bool FromString(const char* stringValue, IndexingMethod& value)
+    {
+        value = IndexingMethodFromString(stringValue);
+        return value != IndexingMethod::INDEXING_METHOD_INVALID;
+    }
 };
 
 /**
@@ -45,5 +45,97 @@ void basic_table<P>::find(MOT::Key const* const& key, void*& output, bool& found
     }
 }
 
+/*
+ * Walks the first layer of the tree for a group of keys together, one level per round, and prefetches the node each
+ * key moves to. A round requests the next node of every key before the next round reads any of them, so the cache
+ * misses of the group overlap. Nothing is validated here: the walk is only a hint for the find() calls that follow,
+ * and a key that races with a split merely prefetches a neighbour. Nodes stay valid while the caller's epoch is open.
+ */
+template <typename P>
+void prefetch_find_paths(const basic_table<P>& table, MOT::Key const* const* keys, uint32_t count,
+    const node_base<P>** nodes)
+{
+    typedef typename node_base<P>::key_type key_type;
+
+    const node_base<P>* root = table.root();
+    while (!root->is_root()) {
+        root = root->maybe_parent();
+    }
+    root->prefetch_full();
+    for (uint32_t i = 0; i < count; ++i) {
+        nodes[i] = root;
+    }
+
+    bool descending = true;
+    while (descending) {
+        descending = false;
+        for (uint32_t i = 0; i < count; ++i) {
+            if (nodes[i] == nullptr || nodes[i]->isleaf()) {
+                continue;
+            }
+            const internode<P>* in = static_cast<const internode<P>*>(nodes[i]);
+            key_type ka(reinterpret_cast<const char*>(keys[i]->GetKeyBuf()), ALIGN8(keys[i]->GetKeyLength()));
+            nodes[i] = in->child_[internode<P>::bound_type::upper(ka, *in)];
+            if (nodes[i] != nullptr) {
+                nodes[i]->prefetch_full();
+                descending = true;
+            }
+        }
+    }
+}
+
+/*
+ * Walks from the root to a random entry: on every internode the walk draws one of width + 1 child positions, in every
+ * leaf one of width slots, and it descends into the next layer when the slot holds one. A draw past the children or
+ * entries of the node rejects the walk. Each step therefore picks a given child or entry with probability
+ * 1 / (width + 1) or 1 / width regardless of the node fill, so entries whose paths cross the same number of
+ * internodes and layers are equally likely, and the sparse subtrees a plain random descent favours gain nothing.
+ * Nodes are read like in a lookup and a walk that races with a writer is rejected as well. Returns the value of the
+ * entry reached, or 0 if the walk was rejected.
+ */
+template <typename P, typename R>
+typename P::value_type sample_find_random(const basic_table<P>& table, R& random)
+{
+    typedef typename node_base<P>::nodeversion_type nodeversion_type;
+
+    const node_base<P>* n = table.root();
+    while (true) {
+        while (!n->is_root()) {
+            n = n->maybe_parent();
+        }
+        while (!n->isleaf()) {
+            const internode<P>* in = static_cast<const internode<P>*>(n);
+            nodeversion_type v = in->stable();
+            int pos = (int)(random() % (internode<P>::width + 1));
+            if (pos > in->size()) {
+                return 0;
+            }
+            n = in->child_[pos];
+            if (n == nullptr || in->has_changed(v)) {
+                return 0;
+            }
+        }
+
+        const leaf<P>* lf = static_cast<const leaf<P>*>(n);
+        nodeversion_type v = lf->stable();
+        typename leaf<P>::permuter_type perm = lf->permutation();
+        int pos = (int)(random() % leaf<P>::width);
+        if (pos >= perm.size()) {
+            return 0;
+        }
+        int p = perm[pos];
+        int keylenx = lf->keylenx_[p];
+        fence();
+        typename leaf<P>::leafvalue_type entry = lf->lv_[p];
+        if (lf->has_changed(v) || lf->keylenx_is_unstable_layer(keylenx)) {
+            return 0;
+        }
+        if (!lf->keylenx_is_layer(keylenx)) {
+            return entry.value();
+        }
+        n = entry.layer();
+    }
+}
+
 }  // namespace Masstree
 #endif  // MOT_MASSTREE_GET_HPP
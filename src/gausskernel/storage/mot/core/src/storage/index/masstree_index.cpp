@@ -22,6 +22,9 @@
  * -------------------------------------------------------------------------
  */
 
+#include <algorithm>
+#include <random>
+#include <unordered_set>
 #include "masstree_index.h"
 #include "mot_engine.h"
 #include "utils/timestamp.h"
@@ -31,6 +34,8 @@ IMPLEMENT_TEMPLATE_LOGGER(PrimaryMasstree, Storage)
 
 IMPLEMENT_CLASS_LOGGER(MasstreePrimaryIndex, Storage);
 
+constexpr uint32_t MasstreePrimaryIndex::SAMPLE_WALKS_PER_ENTRY;
+
 RC MasstreePrimaryIndex::IndexInitImpl(void** args)
 {
     if (!InitPools()) {
@@ -99,6 +104,54 @@ Sentinel* MasstreePrimaryIndex::IndexReadImpl(const Key* key, uint32_t pid) cons
     return sentinel;
 }
 
+void MasstreePrimaryIndex::IndexReadBatchImpl(
+    const Key* const* keys, uint32_t count, Sentinel** sentinels, uint32_t pid) const
+{
+    const Masstree::node_base<default_table_params>* nodes[READ_BATCH_SIZE];
+
+    for (uint32_t base = 0; base < count; base += READ_BATCH_SIZE) {
+        uint32_t batchSize = std::min(count - base, READ_BATCH_SIZE);
+        Masstree::prefetch_find_paths(m_index, keys + base, batchSize, nodes);
+        for (uint32_t i = 0; i < batchSize; ++i) {
+            sentinels[base + i] = IndexReadImpl(keys[base + i], pid);
+        }
+    }
+}
+
+void MasstreePrimaryIndex::Sample(uint32_t count, uint64_t seed, std::vector<Sentinel*>& sentinels, uint32_t pid) const
+{
+    sentinels.clear();
+
+    // GetSize() is not maintained by this index, so emptiness is checked through the tree itself
+    IndexIterator* itr = Begin(pid);
+    bool empty = (itr == nullptr || !itr->IsValid());
+    delete itr;
+    if (empty) {
+        return;
+    }
+
+    std::mt19937_64 random(seed);
+    std::unordered_set<Sentinel*> collected;
+    uint64_t walks = (uint64_t)count * SAMPLE_WALKS_PER_ENTRY;
+    for (uint64_t i = 0; i < walks && sentinels.size() < count; i++) {
+        Sentinel* sentinel = reinterpret_cast<Sentinel*>(Masstree::sample_find_random(m_index, random));
+        if (sentinel != nullptr && collected.insert(sentinel).second) {
+            sentinels.push_back(sentinel);
+        }
+    }
+
+    // layers holding few entries reject most walks, complete the sample with key range draws
+    if (sentinels.size() < count) {
+        std::vector<Sentinel*> more;
+        Index::Sample(count, seed, more, pid);
+        for (size_t i = 0; i < more.size() && sentinels.size() < count; i++) {
+            if (collected.insert(more[i]).second) {
+                sentinels.push_back(more[i]);
+            }
+        }
+    }
+}
+
 Sentinel* MasstreePrimaryIndex::IndexRemoveImpl(const Key* key, uint32_t pid)
 {
     bool result = false;
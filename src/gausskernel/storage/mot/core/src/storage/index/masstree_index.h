@@ -326,6 +326,15 @@ public:
     virtual IndexIterator* Search(
         const Key* key, bool matchKey, bool forward, uint32_t pid, bool& found, bool passive = false) const;
 
+    /**
+     * @brief Collects the sentinels of entries reached by random root-to-leaf walks, for sampling.
+     * @detail Each walk draws every child and leaf slot with the same probability whatever the node fill, and is
+     * rejected if it draws past the node end (see Masstree::sample_find_random()). Entries are thus equally likely,
+     * except that entries of deeper layers (long keys sharing 8-byte prefixes) are less likely than those of
+     * shallower ones. If the walks leave the sample short, it is completed with Index::Sample().
+     */
+    virtual void Sample(uint32_t count, uint64_t seed, std::vector<Sentinel*>& sentinels, uint32_t pid) const;
+
     /**
      * @brief Allocate memory from pools.
      * @param size How many bytes are required.
@@ -497,6 +506,14 @@ protected:
 
     virtual Sentinel* IndexReadImpl(const Key* key, uint32_t pid) const;
 
+    /**
+     * @brief Reads the sentinels of several keys.
+     * @detail A descent runs inside the Masstree library and cannot be suspended half way, so each batch first
+     * walks the paths of all its keys level by level and prefetches them (see Masstree::prefetch_find_paths()).
+     * The validated lookups that follow then find their nodes in cache.
+     */
+    virtual void IndexReadBatchImpl(const Key* const* keys, uint32_t count, Sentinel** sentinels, uint32_t pid) const;
+
     virtual Sentinel* IndexRemoveImpl(const Key* key, uint32_t pid);
 
     /** @var The underlying Masstree instance. */
@@ -505,6 +522,9 @@ protected:
 private:
     static constexpr int SUFFIX_SLAB_MIN_BIN = 6;  // 2^6 = 64Bytes
 
+    /** @var The number of random walks Sample() runs per requested entry, most of them end in a rejection. */
+    static constexpr uint32_t SAMPLE_WALKS_PER_ENTRY = 64;
+
     /** @var Memory pool for leafs. */
     ObjAllocInterface* m_leafsPool;
 
@@ -27,6 +27,7 @@
 #include "global.h"
 #include "row.h"
 #include "table.h"
+#include "mm_gc_manager.h"
 
 namespace MOT {
 IMPLEMENT_CLASS_LOGGER(Row, Storage);
@@ -47,11 +48,40 @@ Row::Row(const Row& src)
     securec_check(erc, "\0", "\0");
 }
 
+Row* Row::GetVisibleVersion(uint64_t snapshotCsn)
+{
+    Row* version = this;
+    while (version != nullptr && version->GetCommitSequenceNumber() > snapshotCsn) {
+        version = version->m_olderVersion;
+    }
+    return version;
+}
+
+void Row::RetireOlderVersions(uint64_t oldestSnapshotCsn, GcManager* gc)
+{
+    Row* keep = GetVisibleVersion(oldestSnapshotCsn);
+    if (keep == nullptr) {
+        return;
+    }
+    // readers walking the chain still see the detached versions until the GC epoch passes
+    Row* version = keep->m_olderVersion;
+    keep->m_olderVersion = nullptr;
+    while (version != nullptr) {
+        Row* older = version->m_olderVersion;
+        gc->GcRecordObject(m_table->GetPrimaryIndex()->GetIndexId(),
+            version,
+            nullptr,
+            Row::RowDtor,
+            ROW_SIZE_FROM_POOL(m_table));
+        version = older;
+    }
+}
+
 void Row::SetValueVariable(int id, const void* ptr, uint32_t size)
 {
     const uint64_t fieldSize = m_table->GetFieldSize(id);
-    MOT_ASSERT(size < fieldSize);
-    errno_t erc = memcpy_s(&m_data[fieldSize], fieldSize, ptr, size);
+    MOT_ASSERT(size <= fieldSize);
+    errno_t erc = memcpy_s(&m_data[m_table->GetFieldOffset(id)], fieldSize, ptr, size);
     securec_check(erc, "\0", "\0");
 }
 
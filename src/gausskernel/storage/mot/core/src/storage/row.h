@@ -41,6 +41,7 @@ namespace MOT {
 class OccTransactionManager;
 class CheckpointWorkerPool;
 class RecoveryOps;
+class GcManager;
 
 /**
  * @class Row
@@ -580,6 +581,9 @@ protected:
     /** @var the row id. */
     uint64_t m_rowId;
 
+    /** @var The next older version of the row, kept while a snapshot may still read it (see enable_row_versions). */
+    Row* m_olderVersion = nullptr;
+
     /** @var The key type. */
     KeyType m_keyType;
 
@@ -635,6 +639,34 @@ public:
     inline void SetCSN(uint64_t csn) {
         m_rowHeader.SetCSN(csn);
     }
+
+    /** @brief Retrieves the next older version of this row, nullptr if none is kept. */
+    inline Row* GetOlderVersion() const
+    {
+        return m_olderVersion;
+    }
+
+    /** @brief Links the version this row replaces. */
+    inline void SetOlderVersion(Row* row)
+    {
+        m_olderVersion = row;
+    }
+
+    /**
+     * @brief Retrieves the version of the row a snapshot sees.
+     * @param snapshotCsn The snapshot CSN.
+     * @return The newest version in the chain starting at this row committed at or before snapshotCsn, or nullptr if
+     * the row did not exist at the snapshot (or the version was already retired).
+     */
+    Row* GetVisibleVersion(uint64_t snapshotCsn);
+
+    /**
+     * @brief Detaches the versions older than the one visible at oldestSnapshotCsn and retires them to the GC. Must
+     * be called only by the thread that installs versions of this row.
+     * @param oldestSnapshotCsn The oldest snapshot CSN still in use.
+     * @param gc The GC session of the calling thread.
+     */
+    void RetireOlderVersions(uint64_t oldestSnapshotCsn, GcManager* gc);
 };
 }  // namespace MOT
 
@@ -64,7 +64,11 @@ public:
         S_STATUS_MASK = ~S_STATUS_BITS
     };
 
-    enum StableRowFlags : uint64_t { STABLE_BIT = 1UL << 63, PRE_ALLOC_BIT = 1UL << 62 };
+    enum StableRowFlags : uint64_t {
+        STABLE_BIT = 1UL << 63,
+        PRE_ALLOC_BIT = 1UL << 62,
+        DELTA_DIRTY_BIT = 1UL << 60  // two bits, one per checkpoint parity
+    };
 
     inline bool IsCommited() const
     {
@@ -322,6 +326,30 @@ public:
         }
     }
 
+    /**
+     * @brief Retrieves whether the row was modified since the previous checkpoint of the given parity.
+     * @param parity The parity of the checkpoint sequence number.
+     */
+    inline bool GetDeltaDirty(bool parity) const
+    {
+        return (m_stable & (DELTA_DIRTY_BIT << (uint32_t)parity)) != 0;
+    }
+
+    /**
+     * @brief Marks the row as modified (or not) since the previous checkpoint of the given parity.
+     * @param parity The parity of the checkpoint sequence number.
+     * @param val The dirty status.
+     */
+    inline void SetDeltaDirty(bool parity, bool val)
+    {
+        uint64_t bit = DELTA_DIRTY_BIT << (uint32_t)parity;
+        if (val == true) {
+            m_stable |= bit;
+        } else {
+            m_stable &= ~bit;
+        }
+    }
+
     void SetLockOwner(uint64_t tid)
     {
         MOT_ASSERT(m_status & S_LOCK_BIT);
@@ -112,6 +112,52 @@ bool Table::Init(const char* tableName, const char* longName, unsigned int field
     return true;
 }
 
+static inline uint32_t CatalogHash(uint32_t hash, const void* data, size_t length)
+{
+    // FNV-1a, identical on every node
+    const uint8_t* bytes = (const uint8_t*)data;
+    for (size_t i = 0; i < length; ++i) {
+        hash = (hash ^ bytes[i]) * 16777619U;
+    }
+    return hash;
+}
+
+static constexpr uint32_t CATALOG_HASH_SEED = 2166136261U;
+
+static inline uint64_t CatalogHash64(uint64_t hash, const void* data, size_t length)
+{
+    // 64-bit FNV-1a, so that the names of a catalog do not collide in practice
+    const uint8_t* bytes = (const uint8_t*)data;
+    for (size_t i = 0; i < length; ++i) {
+        hash = (hash ^ bytes[i]) * 1099511628211ULL;
+    }
+    return hash;
+}
+
+static constexpr uint64_t CATALOG_HASH64_SEED = 14695981039346656037ULL;
+
+uint64_t Table::ComputeCatalogId(const char* longName, size_t length)
+{
+    uint64_t catalogId = CatalogHash64(CATALOG_HASH64_SEED, longName, length);
+    return (catalogId != 0) ? catalogId : 1;  // zero means no identifier on the wire
+}
+
+void Table::ComputeCatalogIdentity()
+{
+    m_catalogId = ComputeCatalogId(m_longTableName.c_str(), m_longTableName.length());
+
+    uint32_t version = CATALOG_HASH_SEED;
+    for (uint32_t i = 0; i < m_fieldCnt; ++i) {
+        const Column* column = m_columns[i];
+        uint32_t type = (uint32_t)column->m_type;
+        version = CatalogHash(version, &type, sizeof(type));
+        version = CatalogHash(version, &column->m_size, sizeof(column->m_size));
+        version = CatalogHash(version, column->m_name, column->m_nameLen);
+    }
+    version = CatalogHash(version, &m_tupleSize, sizeof(m_tupleSize));
+    m_schemaVersion = (version != 0) ? version : 1;
+}
+
 bool Table::InitRowPool(bool local)
 {
     bool result = true;
@@ -387,6 +433,39 @@ bool Table::CreateSecondaryIndexData(MOT::Index* index, TxnManager* txn)
     return ret;
 }
 
+void Table::UpdateIndexStatistics(uint32_t sampleSize, uint32_t pid)
+{
+    uint64_t numRows = GetRowCount();
+    if (numRows == 0 || m_numIndexes == 0) {
+        return;
+    }
+
+    std::vector<Sentinel*> sentinels;
+    if (numRows <= sampleSize) {
+        IndexIterator* itr = m_indexes[0]->Begin(pid);
+        while (itr != nullptr && itr->IsValid()) {
+            sentinels.push_back(itr->GetPrimarySentinel());
+            itr->Next();
+        }
+        delete itr;
+    } else {
+        m_indexes[0]->Sample(sampleSize, m_tableExId, sentinels, pid);
+    }
+
+    std::vector<const uint8_t*> rows;
+    rows.reserve(sentinels.size());
+    for (Sentinel* sentinel : sentinels) {
+        Row* row = (sentinel != nullptr) ? sentinel->GetData() : nullptr;
+        if (row != nullptr) {
+            rows.push_back(row->GetData());
+        }
+    }
+
+    for (uint16_t i = 0; i < m_numIndexes; i++) {
+        m_indexes[i]->UpdateStatistics(rows.data(), (uint32_t)rows.size(), (double)numRows);
+    }
+}
+
 RC Table::InsertRowNonTransactional(Row* row, uint64_t tid, Key* k, bool skipSecIndex)
 {
     RC rc = RC_OK;
@@ -425,6 +504,7 @@ RC Table::InsertRowNonTransactional(Row* row, uint64_t tid, Key* k, bool skipSec
         return MOT_GET_LAST_ERROR_RC();
     } else {
         row->SetPrimarySentinel(res);
+        UpdateRowCount(1);
     }
 
     // add secondary indexes
@@ -507,6 +587,7 @@ Row* Table::RemoveRow(Row* row, uint64_t tid, GcManager* gc)
 {
     MaxKey key;
     Row* OutputRow = nullptr;
+    bool destroyRow = false;
     uint32_t numIndexes = GetNumIndexes();
     Sentinel* currSentinel = nullptr;
     // Build keys and mark sentinels for delete
@@ -522,6 +603,7 @@ Row* Table::RemoveRow(Row* row, uint64_t tid, GcManager* gc)
                 RC rc = currSentinel->RefCountUpdate(DEC, tid);
                 if (rc == RC::RC_INDEX_DELETE) {
                     currSentinel = ix->IndexRemove(&key, tid);
+                    UpdateRowCount(-1);
                     if (likely(gc != nullptr)) {
                         gc->GcRecordObject(
                             ix->GetIndexId(), currSentinel, nullptr, ix->SentinelDtor, SENTINEL_SIZE(ix));
@@ -531,7 +613,8 @@ Row* Table::RemoveRow(Row* row, uint64_t tid, GcManager* gc)
                             MOT_LOG_ERROR("RemoveRow called without GC when not recovering");
                             return nullptr;
                         }
-                        DestroyRow(row);
+                        // the secondary keys are still built from the row, so it is destroyed last
+                        destroyRow = true;
                         ix->SentinelDtor(currSentinel, nullptr, false);
                     }
                 }
@@ -562,6 +645,9 @@ Row* Table::RemoveRow(Row* row, uint64_t tid, GcManager* gc)
         MOT_ASSERT(currSentinel != nullptr);
         MOT_ASSERT(currSentinel->IsCommited() == true);
     }
+    if (destroyRow) {
+        DestroyRow(row);
+    }
     return OutputRow;
 }
 
@@ -597,6 +683,45 @@ Row* Table::RemoveKeyFromIndex(Row* row, Sentinel* sentinel, uint64_t tid, GcMan
     return OutputRow;
 }
 
+void Table::RecordDeletedKey(const Key* key, uint64_t checkpointSeq)
+{
+    uint16_t keyLen = key->GetKeyLength();
+    m_deletedKeysLock.lock();
+    size_t offset = m_deletedKeys.size();
+    m_deletedKeys.resize(offset + sizeof(uint64_t) + sizeof(uint16_t) + keyLen);
+    uint8_t* rec = m_deletedKeys.data() + offset;
+    *(uint64_t*)rec = checkpointSeq;
+    *(uint16_t*)(rec + sizeof(uint64_t)) = keyLen;
+    errno_t erc = memcpy_s(rec + sizeof(uint64_t) + sizeof(uint16_t), keyLen, key->GetKeyBuf(), keyLen);
+    securec_check(erc, "\0", "\0");
+    m_deletedKeysLock.unlock();
+}
+
+uint64_t Table::TakeDeletedKeys(uint64_t checkpointSeq, std::vector<uint8_t>& keys)
+{
+    uint64_t numKeys = 0;
+    std::vector<uint8_t> later;
+    keys.clear();
+    m_deletedKeysLock.lock();
+    size_t offset = 0;
+    while (offset < m_deletedKeys.size()) {
+        const uint8_t* rec = m_deletedKeys.data() + offset;
+        uint64_t seq = *(const uint64_t*)rec;
+        uint16_t keyLen = *(const uint16_t*)(rec + sizeof(uint64_t));
+        size_t recLen = sizeof(uint64_t) + sizeof(uint16_t) + keyLen;
+        if (seq <= checkpointSeq) {
+            keys.insert(keys.end(), rec + sizeof(uint64_t), rec + recLen);
+            numKeys++;
+        } else {
+            later.insert(later.end(), rec, rec + recLen);
+        }
+        offset += recLen;
+    }
+    m_deletedKeys.swap(later);
+    m_deletedKeysLock.unlock();
+    return numKeys;
+}
+
 Row* Table::CreateNewRow()
 {
     TryRecordTimestamp(1, startExec);//ADDBY NEU HW
@@ -31,6 +31,7 @@
 #include <iostream>
 #include <memory>
 #include <pthread.h>
+#include <vector>
 #include "global.h"
 #include "sentinel.h"
 #include "surrogate_key_generator.h"
@@ -41,6 +42,7 @@
 #include "serializable.h"
 #include "object_pool.h"
 #include "mm_gc_manager.h"
+#include "spin_lock.h"
 
 namespace MOT {
 class Row;
@@ -532,6 +534,43 @@ public:
         return m_tableExId;
     }
 
+    /**
+     * @brief Retrieves the catalog identifier of the table. The identifier is a 64-bit hash of the long table name,
+     * so nodes sharing a schema agree on it without exchanging their catalogs. Tables whose identifiers collide
+     * nevertheless are detected by the table manager and always encoded by name.
+     */
+    inline uint64_t GetCatalogId() const
+    {
+        return m_catalogId;
+    }
+
+    /** @brief Retrieves the schema version of the table, derived from its column layout. */
+    inline uint32_t GetSchemaVersion() const
+    {
+        return m_schemaVersion;
+    }
+
+    /** @brief Queries whether no other table of the engine has the same catalog identifier. */
+    inline bool IsCatalogIdUnique() const
+    {
+        return m_catalogIdUnique.load(std::memory_order_relaxed);
+    }
+
+    /** @brief Sets whether the catalog identifier is unique (maintained by the table manager). */
+    inline void SetCatalogIdUnique(bool unique)
+    {
+        m_catalogIdUnique.store(unique, std::memory_order_relaxed);
+    }
+
+    /** @brief Computes the catalog identifier and schema version, once all columns are defined. */
+    void ComputeCatalogIdentity();
+
+    /**
+     * @brief Computes the catalog identifier of a long table name.
+     * @return The identifier, which is never zero.
+     */
+    static uint64_t ComputeCatalogId(const char* longName, size_t length);
+
     /**
      * @brief Retrieves the length of the key in the primary index.
      * @return The primary index key length.
@@ -764,17 +803,27 @@ public:
      */
     inline void UpdateRowCount(int32_t diff)
     {
-        m_rowCount += diff;
+        (void)m_rowCount.fetch_add((uint64_t)(int64_t)diff, std::memory_order_relaxed);
     }
 
     /**
      * @brief Returns table row count
      */
-    inline uint32_t GetRowCount() const
+    inline uint64_t GetRowCount() const
     {
-        return m_rowCount;
+        return m_rowCount.load(std::memory_order_relaxed);
     }
 
+    /**
+     * @brief Recomputes the statistics of all indexes of the table from a sample of its rows.
+     * @detail Index statistics are not checkpointed, recovery rebuilds them with this method so that the planner
+     * does not fall back to default selectivities until the next ANALYZE. The rows are read without a transaction,
+     * so the method may only be called while no transaction modifies the table.
+     * @param sampleSize The number of rows to sample. Smaller tables are read in full.
+     * @param pid The logical identifier of the calling thread.
+     */
+    void UpdateIndexStatistics(uint32_t sampleSize, uint32_t pid);
+
     /**
      * @brief Returns table size in memory
      */
@@ -851,6 +900,39 @@ public:
 
     Row* RemoveKeyFromIndex(Row* row, Sentinel* sentinel, uint64_t tid, GcManager* gc);
 
+    /**
+     * @brief Records the primary key of a deleted row for the delta checkpoint of the given sequence number.
+     * @param key The primary key of the deleted row.
+     * @param checkpointSeq The sequence number of the checkpoint that should persist the deletion.
+     */
+    void RecordDeletedKey(const Key* key, uint64_t checkpointSeq);
+
+    /**
+     * @brief Moves the deleted keys recorded for checkpoints up to the given sequence number into a buffer. Keys
+     * recorded for later checkpoints are kept.
+     * @param checkpointSeq The sequence number of the checkpoint being taken.
+     * @param[out] keys The taken keys, each a 16 bit key length followed by the key.
+     * @return The number of taken keys.
+     */
+    uint64_t TakeDeletedKeys(uint64_t checkpointSeq, std::vector<uint8_t>& keys);
+
+    /**
+     * @brief Marks the table to be written in full by the next checkpoint, as it changed in a way the delta
+     * checkpoint does not track (it is new, recovered or truncated).
+     */
+    inline void SetCheckpointFullData()
+    {
+        m_checkpointFullData = true;
+    }
+
+    /**
+     * @brief Retrieves and clears the indication that the table should be written in full by the next checkpoint.
+     */
+    inline bool TestAndClearCheckpointFullData()
+    {
+        return m_checkpointFullData.exchange(false);
+    }
+
 private:
     inline MOT::ObjAllocInterface* GetRowPool()
     {
@@ -930,7 +1012,26 @@ private:
 
     uint64_t _f4;
 
-    uint32_t m_rowCount = 0;
+    /** @var Number of rows in the table, updated concurrently by committing transactions and recovery. */
+    std::atomic<uint64_t> m_rowCount;
+
+    /** @var Guards the deleted keys log. */
+    spin_lock m_deletedKeysLock;
+
+    /** @var Primary keys deleted since the last checkpoint, each prefixed by its checkpoint sequence number. */
+    std::vector<uint8_t> m_deletedKeys;
+
+    /** @var Specifies whether the next checkpoint must write the table in full. */
+    std::atomic<bool> m_checkpointFullData{true};
+
+    /** @var Catalog identifier (see @ref GetCatalogId()). */
+    uint64_t m_catalogId = 0;
+
+    /** @var Schema version (see @ref GetSchemaVersion()). */
+    uint32_t m_schemaVersion = 0;
+
+    /** @var Specifies whether the catalog identifier is unique among the engine tables. */
+    std::atomic<bool> m_catalogIdUnique{false};
 
     DECLARE_CLASS_LOGGER();
 
@@ -0,0 +1,453 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * -------------------------------------------------------------------------
+ *
+ * checkpoint_block_file.cpp
+ *    Block oriented checkpoint data files, with compressed and checksummed blocks.
+ *
+ * IDENTIFICATION
+ *    src/gausskernel/storage/mot/core/src/system/checkpoint/checkpoint_block_file.cpp
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include <cstddef>
+#include "checkpoint_block_file.h"
+#include "mot_error.h"
+
+#include "libintl.h"
+#include "postgres.h"
+#include "port/pg_crc32c.h"
+#include "lz4.h"
+#include "zstd.h"
+
+namespace MOT {
+DECLARE_LOGGER(CheckpointBlockFile, Checkpoint);
+
+/** @var The alignment of the file header page and of the blocks, and of the buffers they are written from. */
+static const size_t BLOCK_ALIGNMENT = 4096;
+
+/** @var The zstd compression level, favoring speed as checkpoints are bound by the time they take. */
+static const int ZSTD_LEVEL = 1;
+
+constexpr size_t CheckpointFileReader::READ_CHUNK_SIZE;
+constexpr uint32_t CheckpointFileReader::MAX_BLOCK_SIZE;
+
+static inline size_t AlignBlock(size_t len)
+{
+    return (len + BLOCK_ALIGNMENT - 1) & ~(BLOCK_ALIGNMENT - 1);
+}
+
+static uint32_t BlockCrc(const CheckpointBlockHeader* header, const char* payload)
+{
+    pg_crc32c crc;
+    INIT_CRC32C(crc);
+    COMP_CRC32C(crc, header, offsetof(CheckpointBlockHeader, m_crc));
+    COMP_CRC32C(crc, payload, header->m_storedLen);
+    FIN_CRC32C(crc);
+    return crc;
+}
+
+/**
+ * @brief Opens a checkpoint data file, with O_DIRECT if requested and the file system accepts it.
+ * @return The file descriptor, or -1 on failure.
+ */
+static int OpenDataFile(const std::string& fileName, int flags, bool directIo)
+{
+    int fd = -1;
+    if (directIo) {
+        fd = open(fileName.c_str(), flags | O_DIRECT, S_IRUSR | S_IWUSR); /* 0600 */
+        if (fd != -1 || errno != EINVAL) {
+            return fd;
+        }
+        MOT_LOG_DEBUG("OpenDataFile: O_DIRECT is not supported for %s, using buffered I/O", fileName.c_str());
+    }
+    return open(fileName.c_str(), flags, S_IRUSR | S_IWUSR);
+}
+
+CheckpointFileWriter::~CheckpointFileWriter()
+{
+    Close();
+    if (m_scratch != nullptr) {
+        free(m_scratch);
+        m_scratch = nullptr;
+    }
+}
+
+bool CheckpointFileWriter::Initialize(uint32_t maxBlockSize, CheckpointCodec codec, bool directIo)
+{
+    size_t bound = maxBlockSize;
+    if (codec == CheckpointCodec::CODEC_LZ4) {
+        bound = (size_t)LZ4_compressBound((int)maxBlockSize);
+    } else if (codec == CheckpointCodec::CODEC_ZSTD) {
+        bound = ZSTD_compressBound(maxBlockSize);
+    }
+    // incompressible blocks are stored as is, so the buffer fits a raw block as well
+    bound = (bound > maxBlockSize) ? bound : maxBlockSize;
+    m_scratchSize = AlignBlock(sizeof(CheckpointBlockHeader) + bound);
+    if (posix_memalign((void**)&m_scratch, BLOCK_ALIGNMENT, m_scratchSize) != 0) {
+        MOT_LOG_ERROR("CheckpointFileWriter::Initialize: failed to allocate %lu bytes", m_scratchSize);
+        m_scratch = nullptr;
+        return false;
+    }
+    m_maxBlockSize = maxBlockSize;
+    m_codec = codec;
+    m_directIo = directIo;
+    return true;
+}
+
+bool CheckpointFileWriter::Open(const std::string& fileName, uint64_t tableId, uint64_t exId)
+{
+    MOT_ASSERT(m_fd == -1);
+    m_fd = OpenDataFile(fileName, O_CREAT | O_TRUNC | O_WRONLY, m_directIo);
+    if (m_fd == -1) {
+        MOT_REPORT_SYSTEM_ERROR(open, "N/A", "Failed to open file %s for writing", fileName.c_str());
+        return false;
+    }
+
+    m_header.m_magic = CP_BLOCK_FILE_MAGIC;
+    m_header.m_tableId = tableId;
+    m_header.m_exId = exId;
+    m_header.m_numOps = 0;
+    if (!WriteHeader()) {
+        Close();
+        return false;
+    }
+    m_offset = BLOCK_ALIGNMENT;
+    return true;
+}
+
+bool CheckpointFileWriter::WriteBlock(const void* data, uint32_t len)
+{
+    MOT_ASSERT(len <= m_maxBlockSize);
+    if (len == 0) {
+        return true;
+    }
+
+    CheckpointBlockHeader* header = (CheckpointBlockHeader*)m_scratch;
+    char* payload = m_scratch + sizeof(CheckpointBlockHeader);
+    size_t capacity = m_scratchSize - sizeof(CheckpointBlockHeader);
+    size_t stored = 0;
+    if (m_codec == CheckpointCodec::CODEC_LZ4) {
+        int res = LZ4_compress_default((const char*)data, payload, (int)len, (int)capacity);
+        stored = (res > 0) ? (size_t)res : 0;
+    } else if (m_codec == CheckpointCodec::CODEC_ZSTD) {
+        stored = ZSTD_compress(payload, capacity, data, len, ZSTD_LEVEL);
+        if (ZSTD_isError(stored)) {
+            stored = 0;
+        }
+    }
+
+    header->m_magic = CP_BLOCK_MAGIC;
+    header->m_rawLen = len;
+    header->m_codec = (uint8_t)m_codec;
+    header->m_reserved[0] = header->m_reserved[1] = header->m_reserved[2] = 0;
+    if (stored == 0 || stored >= len) {
+        // compression failed or did not pay off
+        errno_t erc = memcpy_s(payload, capacity, data, len);
+        securec_check(erc, "\0", "\0");
+        stored = len;
+        header->m_codec = (uint8_t)CheckpointCodec::CODEC_NONE;
+    }
+    header->m_storedLen = (uint32_t)stored;
+    header->m_crc = BlockCrc(header, payload);
+
+    size_t used = sizeof(CheckpointBlockHeader) + stored;
+    size_t total = AlignBlock(used);
+    if (total > used) {
+        errno_t erc = memset_s(m_scratch + used, m_scratchSize - used, 0, total - used);
+        securec_check(erc, "\0", "\0");
+    }
+    if (!WriteAt(m_scratch, total, m_offset)) {
+        return false;
+    }
+    m_offset += total;
+    return true;
+}
+
+bool CheckpointFileWriter::Finish(uint64_t numOps)
+{
+    bool ret = false;
+    do {
+        m_header.m_numOps = numOps;
+        if (!WriteHeader()) {
+            break;
+        }
+        if (CheckpointUtils::FlushFile(m_fd)) {
+            MOT_LOG_ERROR("CheckpointFileWriter::Finish: failed to flush file (id: %lu)", m_header.m_tableId);
+            break;
+        }
+        ret = true;
+    } while (0);
+
+    if (CheckpointUtils::CloseFile(m_fd)) {
+        MOT_LOG_ERROR("CheckpointFileWriter::Finish: failed to close file (id: %lu)", m_header.m_tableId);
+        ret = false;
+    }
+    m_fd = -1;
+    return ret;
+}
+
+void CheckpointFileWriter::Close()
+{
+    if (m_fd != -1) {
+        (void)CheckpointUtils::CloseFile(m_fd);
+        m_fd = -1;
+    }
+}
+
+bool CheckpointFileWriter::WriteAt(const char* data, size_t len, uint64_t offset)
+{
+    size_t written = 0;
+    while (written < len) {
+        ssize_t res = pwrite(m_fd, data + written, len - written, (off_t)(offset + written));
+        if (res == -1 && errno == EINTR) {
+            continue;
+        }
+        if (res <= 0) {
+            MOT_REPORT_SYSTEM_ERROR(pwrite,
+                "N/A",
+                "Failed to write %lu bytes at offset %lu to file descriptor %d",
+                len - written,
+                offset + written,
+                m_fd);
+            return false;
+        }
+        written += (size_t)res;
+    }
+    return true;
+}
+
+bool CheckpointFileWriter::WriteHeader()
+{
+    // the block buffer is free between blocks, and aligned for direct I/O
+    errno_t erc = memset_s(m_scratch, m_scratchSize, 0, BLOCK_ALIGNMENT);
+    securec_check(erc, "\0", "\0");
+    erc = memcpy_s(m_scratch, m_scratchSize, &m_header, sizeof(CheckpointUtils::FileHeader));
+    securec_check(erc, "\0", "\0");
+    return WriteAt(m_scratch, BLOCK_ALIGNMENT, 0);
+}
+
+CheckpointFileReader::~CheckpointFileReader()
+{
+    Close();
+    if (m_chunk != nullptr) {
+        free(m_chunk);
+        m_chunk = nullptr;
+    }
+    if (m_stored != nullptr) {
+        free(m_stored);
+        m_stored = nullptr;
+    }
+    if (m_raw != nullptr) {
+        free(m_raw);
+        m_raw = nullptr;
+    }
+}
+
+bool CheckpointFileReader::Initialize(bool directIo)
+{
+    if (posix_memalign((void**)&m_chunk, BLOCK_ALIGNMENT, READ_CHUNK_SIZE) != 0) {
+        MOT_LOG_ERROR("CheckpointFileReader::Initialize: failed to allocate %lu bytes", READ_CHUNK_SIZE);
+        m_chunk = nullptr;
+        return false;
+    }
+    m_directIo = directIo;
+    return true;
+}
+
+bool CheckpointFileReader::Open(const std::string& fileName)
+{
+    MOT_ASSERT(m_fd == -1);
+    m_fd = OpenDataFile(fileName, O_RDONLY, m_directIo);
+    if (m_fd == -1) {
+        MOT_REPORT_SYSTEM_ERROR(open, "N/A", "Failed to open file %s for reading", fileName.c_str());
+        return false;
+    }
+    m_streamPos = 0;
+    m_chunkLen = 0;
+    m_chunkPos = 0;
+    m_rawLen = 0;
+    m_rawPos = 0;
+
+    if (!ReadStream((char*)&m_header, sizeof(CheckpointUtils::FileHeader))) {
+        MOT_LOG_ERROR("CheckpointFileReader::Open: failed to read the header of file %s", fileName.c_str());
+        Close();
+        return false;
+    }
+
+    if (m_header.m_magic == CP_BLOCK_FILE_MAGIC) {
+        // blocks start after the header page
+        m_blockFormat = true;
+        if (!SkipStream(BLOCK_ALIGNMENT - sizeof(CheckpointUtils::FileHeader))) {
+            Close();
+            return false;
+        }
+    } else if (m_header.m_magic == CP_MGR_MAGIC) {
+        // entries follow the header directly
+        m_blockFormat = false;
+    } else {
+        MOT_LOG_ERROR("CheckpointFileReader::Open: file %s is corrupted", fileName.c_str());
+        Close();
+        return false;
+    }
+    return true;
+}
+
+bool CheckpointFileReader::Read(void* data, size_t len)
+{
+    if (!m_blockFormat) {
+        return ReadStream((char*)data, len);
+    }
+
+    char* dst = (char*)data;
+    while (len > 0) {
+        if (m_rawPos == m_rawLen && !NextBlock()) {
+            return false;
+        }
+        size_t avail = m_rawLen - m_rawPos;
+        size_t toCopy = (len < avail) ? len : avail;
+        errno_t erc = memcpy_s(dst, len, m_raw + m_rawPos, toCopy);
+        securec_check(erc, "\0", "\0");
+        m_rawPos += toCopy;
+        dst += toCopy;
+        len -= toCopy;
+    }
+    return true;
+}
+
+void CheckpointFileReader::Close()
+{
+    if (m_fd != -1) {
+        (void)CheckpointUtils::CloseFile(m_fd);
+        m_fd = -1;
+    }
+}
+
+bool CheckpointFileReader::ReadStream(char* data, size_t len)
+{
+    while (len > 0) {
+        if (m_chunkPos == m_chunkLen) {
+            // the chunks are read whole at aligned offsets, as direct I/O requires
+            ssize_t res = read(m_fd, m_chunk, READ_CHUNK_SIZE);
+            if (res == -1 && errno == EINTR) {
+                continue;
+            }
+            if (res <= 0) {
+                if (res == -1) {
+                    MOT_REPORT_SYSTEM_ERROR(read, "N/A", "Failed to read from file descriptor %d", m_fd);
+                }
+                return false;
+            }
+            m_chunkLen = (size_t)res;
+            m_chunkPos = 0;
+        }
+        size_t avail = m_chunkLen - m_chunkPos;
+        size_t toCopy = (len < avail) ? len : avail;
+        if (data != nullptr) {
+            errno_t erc = memcpy_s(data, len, m_chunk + m_chunkPos, toCopy);
+            securec_check(erc, "\0", "\0");
+            data += toCopy;
+        }
+        m_chunkPos += toCopy;
+        m_streamPos += toCopy;
+        len -= toCopy;
+    }
+    return true;
+}
+
+bool CheckpointFileReader::SkipStream(size_t len)
+{
+    return ReadStream(nullptr, len);
+}
+
+bool CheckpointFileReader::NextBlock()
+{
+    CheckpointBlockHeader header;
+    if (!ReadStream((char*)&header, sizeof(CheckpointBlockHeader))) {
+        MOT_LOG_ERROR("CheckpointFileReader::NextBlock: failed to read block header at offset %lu", m_streamPos);
+        return false;
+    }
+
+    if (header.m_magic != CP_BLOCK_MAGIC || header.m_rawLen == 0 || header.m_rawLen > MAX_BLOCK_SIZE ||
+        header.m_storedLen > MAX_BLOCK_SIZE || header.m_codec >= (uint8_t)CheckpointCodec::CODEC_INVALID) {
+        MOT_LOG_ERROR("CheckpointFileReader::NextBlock: invalid block header at offset %lu (table %lu)",
+            m_streamPos - sizeof(CheckpointBlockHeader),
+            m_header.m_tableId);
+        return false;
+    }
+
+    if (!Reserve(m_stored, m_storedSize, header.m_storedLen) || !Reserve(m_raw, m_rawSize, header.m_rawLen)) {
+        MOT_LOG_ERROR("CheckpointFileReader::NextBlock: failed to allocate block buffers (%u bytes)", header.m_rawLen);
+        return false;
+    }
+
+    if (!ReadStream(m_stored, header.m_storedLen)) {
+        MOT_LOG_ERROR("CheckpointFileReader::NextBlock: failed to read block of %u bytes at offset %lu",
+            header.m_storedLen,
+            m_streamPos);
+        return false;
+    }
+
+    if (BlockCrc(&header, m_stored) != header.m_crc) {
+        MOT_LOG_ERROR("CheckpointFileReader::NextBlock: checksum mismatch in block ending at offset %lu (table %lu)",
+            m_streamPos,
+            m_header.m_tableId);
+        return false;
+    }
+
+    bool decoded = false;
+    CheckpointCodec codec = (CheckpointCodec)header.m_codec;
+    if (codec == CheckpointCodec::CODEC_NONE) {
+        if (header.m_storedLen == header.m_rawLen) {
+            errno_t erc = memcpy_s(m_raw, m_rawSize, m_stored, header.m_rawLen);
+            securec_check(erc, "\0", "\0");
+            decoded = true;
+        }
+    } else if (codec == CheckpointCodec::CODEC_LZ4) {
+        decoded = (LZ4_decompress_safe(m_stored, m_raw, (int)header.m_storedLen, (int)header.m_rawLen) ==
+                   (int)header.m_rawLen);
+    } else {
+        decoded = (ZSTD_decompress(m_raw, header.m_rawLen, m_stored, header.m_storedLen) == header.m_rawLen);
+    }
+    if (!decoded) {
+        MOT_LOG_ERROR("CheckpointFileReader::NextBlock: failed to decompress block of %u bytes (table %lu)",
+            header.m_rawLen,
+            m_header.m_tableId);
+        return false;
+    }
+    m_rawLen = header.m_rawLen;
+    m_rawPos = 0;
+
+    // skip the padding up to the next block
+    return SkipStream(AlignBlock(m_streamPos) - m_streamPos);
+}
+
+bool CheckpointFileReader::Reserve(char*& buf, size_t& size, size_t len)
+{
+    if (size >= len) {
+        return true;
+    }
+    char* newBuf = (char*)malloc(len);
+    if (newBuf == nullptr) {
+        return false;
+    }
+    if (buf != nullptr) {
+        free(buf);
+    }
+    buf = newBuf;
+    size = len;
+    return true;
+}
+}  // namespace MOT
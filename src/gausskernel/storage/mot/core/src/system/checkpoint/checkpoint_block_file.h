@@ -0,0 +1,295 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * -------------------------------------------------------------------------
+ *
+ * checkpoint_block_file.h
+ *    Block oriented checkpoint data files, with compressed and checksummed blocks.
+ *
+ * IDENTIFICATION
+ *    src/gausskernel/storage/mot/core/src/system/checkpoint/checkpoint_block_file.h
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef CHECKPOINT_BLOCK_FILE_H
+#define CHECKPOINT_BLOCK_FILE_H
+
+#include <cstring>
+#include <string>
+#include "global.h"
+#include "checkpoint_utils.h"
+
+/** @brief Magic of the file header of a block file. Files written before carry CP_MGR_MAGIC. */
+const uint64_t CP_BLOCK_FILE_MAGIC = 0xaabbccde;
+
+/** @brief Magic of a block header. */
+const uint32_t CP_BLOCK_MAGIC = 0xb10cb10c;
+
+namespace MOT {
+/**
+ * @enum CheckpointCodec
+ * @brief Defines constants for the compression of checkpoint blocks.
+ */
+enum class CheckpointCodec : uint8_t {
+    /** @var Denotes blocks stored as is. */
+    CODEC_NONE = 0,
+
+    /** @var Denotes LZ4 compressed blocks. */
+    CODEC_LZ4 = 1,
+
+    /** @var Denotes zstd compressed blocks. */
+    CODEC_ZSTD = 2,
+
+    /** @var Denotes an invalid codec. */
+    CODEC_INVALID
+};
+
+/**
+ * @brief Convert a checkpoint codec in string representation to enum representation.
+ * @return enum CheckpointCodec which representing the given char *.
+ */
+inline CheckpointCodec CheckpointCodecFromString(const char* codec)
+{
+    if (strcmp(codec, "none") == 0) {
+        return CheckpointCodec::CODEC_NONE;
+    } else if (strcmp(codec, "lz4") == 0) {
+        return CheckpointCodec::CODEC_LZ4;
+    } else if (strcmp(codec, "zstd") == 0) {
+        return CheckpointCodec::CODEC_ZSTD;
+    }
+
+    return CheckpointCodec::CODEC_INVALID;
+}
+
+/**
+ * @struct CheckpointBlockHeader
+ * @brief Precedes every block of a block file. A block holds whole entries, and is padded with zeros up to the
+ * block alignment.
+ */
+struct CheckpointBlockHeader {
+    uint32_t m_magic;
+
+    /** @var The size of the entries in the block. */
+    uint32_t m_rawLen;
+
+    /** @var The size of the stored (possibly compressed) payload that follows the header. */
+    uint32_t m_storedLen;
+
+    /** @var The codec of the stored payload. */
+    uint8_t m_codec;
+
+    uint8_t m_reserved[3];
+
+    /** @var CRC32C of the header fields above and the stored payload. */
+    uint32_t m_crc;
+};
+
+/**
+ * @class CheckpointFileWriter
+ * @brief Writes a checkpoint data file as a sequence of blocks.
+ * @detail The file header takes the first page of the file and every block is padded to a page boundary, so the
+ * file can be written with O_DIRECT from an aligned buffer. Each block is one large positional write, and the file is
+ * synced to disk only once it is finished.
+ */
+class CheckpointFileWriter {
+public:
+    CheckpointFileWriter()
+        : m_fd(-1),
+          m_offset(0),
+          m_codec(CheckpointCodec::CODEC_NONE),
+          m_directIo(false),
+          m_header(),
+          m_scratch(nullptr),
+          m_scratchSize(0),
+          m_maxBlockSize(0)
+    {}
+
+    ~CheckpointFileWriter();
+
+    /**
+     * @brief Allocates the aligned block buffer.
+     * @param maxBlockSize The maximum size of the entries of a block.
+     * @param codec The codec to compress blocks with.
+     * @param directIo Specifies whether files are opened with O_DIRECT, when the file system supports it.
+     * @return Boolean value denoting success or failure.
+     */
+    bool Initialize(uint32_t maxBlockSize, CheckpointCodec codec, bool directIo);
+
+    /**
+     * @brief Creates a file and writes its header.
+     * @param fileName The file to create.
+     * @param tableId The table id that is checkpointed.
+     * @param exId The table's external table id.
+     * @return Boolean value denoting success or failure.
+     */
+    bool Open(const std::string& fileName, uint64_t tableId, uint64_t exId);
+
+    /**
+     * @brief Compresses and writes a block of entries.
+     * @param data The entries.
+     * @param len The size of the entries, up to the maximum block size.
+     * @return Boolean value denoting success or failure.
+     */
+    bool WriteBlock(const void* data, uint32_t len);
+
+    /**
+     * @brief Updates the file's header, flushes and closes it.
+     * @param numOps The number of entries in the file.
+     * @return Boolean value denoting success or failure.
+     */
+    bool Finish(uint64_t numOps);
+
+    /** @brief Closes the file without finishing it. */
+    void Close();
+
+    bool IsOpen() const
+    {
+        return m_fd != -1;
+    }
+
+private:
+    /** @brief Writes an aligned buffer at an aligned offset. */
+    bool WriteAt(const char* data, size_t len, uint64_t offset);
+
+    /** @brief Writes the file header page. */
+    bool WriteHeader();
+
+    int m_fd;
+
+    /** @var The offset of the next block. */
+    uint64_t m_offset;
+
+    CheckpointCodec m_codec;
+
+    bool m_directIo;
+
+    CheckpointUtils::FileHeader m_header;
+
+    /** @var The aligned buffer blocks are encoded into. */
+    char* m_scratch;
+
+    size_t m_scratchSize;
+
+    uint32_t m_maxBlockSize;
+};
+
+/**
+ * @class CheckpointFileReader
+ * @brief Reads the entries of a checkpoint data file, either a block file or a file written before blocks.
+ * @detail The file is read sequentially in large aligned chunks (with O_DIRECT, when the file system supports it),
+ * and every block is verified against its checksum before it is decompressed.
+ */
+class CheckpointFileReader {
+public:
+    CheckpointFileReader()
+        : m_fd(-1),
+          m_directIo(false),
+          m_blockFormat(false),
+          m_header(),
+          m_streamPos(0),
+          m_chunk(nullptr),
+          m_chunkLen(0),
+          m_chunkPos(0),
+          m_stored(nullptr),
+          m_storedSize(0),
+          m_raw(nullptr),
+          m_rawSize(0),
+          m_rawLen(0),
+          m_rawPos(0)
+    {}
+
+    ~CheckpointFileReader();
+
+    /**
+     * @brief Allocates the aligned read buffer.
+     * @param directIo Specifies whether files are opened with O_DIRECT, when the file system supports it.
+     * @return Boolean value denoting success or failure.
+     */
+    bool Initialize(bool directIo);
+
+    /**
+     * @brief Opens a file and reads its header.
+     * @param fileName The file to open.
+     * @return Boolean value denoting success or failure.
+     */
+    bool Open(const std::string& fileName);
+
+    const CheckpointUtils::FileHeader& GetHeader() const
+    {
+        return m_header;
+    }
+
+    /**
+     * @brief Reads the next bytes of the file's entries.
+     * @param data The buffer to read to.
+     * @param len The number of bytes to read.
+     * @return False if the file ended, or a block is corrupted.
+     */
+    bool Read(void* data, size_t len);
+
+    void Close();
+
+private:
+    /** @var The size of the reads from the file. */
+    static constexpr size_t READ_CHUNK_SIZE = 1UL << 21;
+
+    /** @var The largest block accepted. */
+    static constexpr uint32_t MAX_BLOCK_SIZE = 1U << 26;
+
+    /** @brief Reads bytes of the file, through the chunk buffer. */
+    bool ReadStream(char* data, size_t len);
+
+    /** @brief Skips bytes of the file. */
+    bool SkipStream(size_t len);
+
+    /** @brief Reads, verifies and decompresses the next block. */
+    bool NextBlock();
+
+    /** @brief Grows a buffer to hold at least len bytes. */
+    static bool Reserve(char*& buf, size_t& size, size_t len);
+
+    int m_fd;
+
+    bool m_directIo;
+
+    bool m_blockFormat;
+
+    CheckpointUtils::FileHeader m_header;
+
+    /** @var The offset in the file of the next byte to read. */
+    uint64_t m_streamPos;
+
+    char* m_chunk;
+
+    size_t m_chunkLen;
+
+    size_t m_chunkPos;
+
+    /** @var The stored payload of the current block. */
+    char* m_stored;
+
+    size_t m_storedSize;
+
+    /** @var The entries of the current block. */
+    char* m_raw;
+
+    size_t m_rawSize;
+
+    size_t m_rawLen;
+
+    size_t m_rawPos;
+};
+}  // namespace MOT
+
+#endif  // CHECKPOINT_BLOCK_FILE_H
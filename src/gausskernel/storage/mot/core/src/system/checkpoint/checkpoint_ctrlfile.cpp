@@ -22,6 +22,7 @@
  * -------------------------------------------------------------------------
  */
 
+#include <cstddef>
 #include <string>
 #include "checkpoint_utils.h"
 #include "checkpoint_ctrlfile.h"
@@ -97,7 +98,10 @@ bool CheckpointControlFile::Init()
                 MOT_LOG_ERROR("CheckpointControlFile: init - could not open control file");
                 break;
             }
-            if (CheckpointUtils::ReadFile(fd, (char*)&m_ctrlFileData, sizeof(CtrlFileData)) != sizeof(CtrlFileData)) {
+            // files written before the applied epoch was added end after lastReplayLsn
+            m_ctrlFileData.Init();
+            size_t readSize = CheckpointUtils::ReadFile(fd, (char*)&m_ctrlFileData, sizeof(CtrlFileData));
+            if (readSize != sizeof(CtrlFileData) && readSize != offsetof(CtrlFileElem, lastAppliedEpoch)) {
                 MOT_LOG_ERROR("CheckpointControlFile: init - failed to read data from file");
                 CheckpointUtils::CloseFile(fd);
                 break;
@@ -118,7 +122,7 @@ bool CheckpointControlFile::Init()
     return initialized;
 }
 
-bool CheckpointControlFile::Update(uint64_t id, uint64_t lsn, uint64_t lastReplayLsn)
+bool CheckpointControlFile::Update(uint64_t id, uint64_t lsn, uint64_t lastReplayLsn, uint64_t lastAppliedEpoch)
 {
     int fd = -1;
     bool ret = false;
@@ -132,6 +136,7 @@ bool CheckpointControlFile::Update(uint64_t id, uint64_t lsn, uint64_t lastRepla
         m_ctrlFileData.entry[0].checkpointId = id;
         m_ctrlFileData.entry[0].lsn = lsn;
         m_ctrlFileData.entry[0].lastReplayLsn = lastReplayLsn;
+        m_ctrlFileData.entry[0].lastAppliedEpoch = lastAppliedEpoch;
 
         if (CheckpointUtils::WriteFile(fd, (char*)&m_ctrlFileData, sizeof(CtrlFileData)) != sizeof(CtrlFileData)) {
             MOT_LOG_ERROR("CheckpointControlFile::update - failed to write control file");
@@ -158,6 +163,7 @@ bool CheckpointControlFile::Update(uint64_t id, uint64_t lsn, uint64_t lastRepla
 
 void CheckpointControlFile::Print()
 {
-    MOT_LOG_DEBUG("CheckpointControlFile: [%lu:%lu:%lu]", GetLsn(), GetId(), GetLastReplayLsn());
+    MOT_LOG_DEBUG("CheckpointControlFile: [%lu:%lu:%lu:%lu]", GetLsn(), GetId(), GetLastReplayLsn(),
+        GetLastAppliedEpoch());
 }
 }  // namespace MOT
@@ -43,8 +43,9 @@ public:
     bool Init();
 
     struct CtrlFileElem {
-        CtrlFileElem(uint64_t id = invalidId, uint64_t lsn = invalidId, uint64_t replay = invalidId)
-            : checkpointId(id), lsn(lsn), lastReplayLsn(replay)
+        CtrlFileElem(uint64_t id = invalidId, uint64_t lsn = invalidId, uint64_t replay = invalidId,
+            uint64_t epoch = invalidId)
+            : checkpointId(id), lsn(lsn), lastReplayLsn(replay), lastAppliedEpoch(epoch)
         {}
 
         void Init()
@@ -52,11 +53,15 @@ public:
             checkpointId = invalidId;
             lsn = invalidId;
             lastReplayLsn = invalidId;
+            lastAppliedEpoch = invalidId;
         }
 
         uint64_t checkpointId;
         uint64_t lsn;
         uint64_t lastReplayLsn;
+
+        /** @var Last TaaS epoch fully applied by the storage updaters before the checkpoint was captured. */
+        uint64_t lastAppliedEpoch;
     };
 
     static CheckpointControlFile* GetCtrlFile();
@@ -76,12 +81,18 @@ public:
         return m_ctrlFileData.entry[0].lastReplayLsn;
     }
 
+    uint64_t GetLastAppliedEpoch() const
+    {
+        return m_ctrlFileData.entry[0].lastAppliedEpoch;
+    }
+
     /**
      * @brief Performs a durable update of the checkpoint id in the file
      * @param id The checkpoint's id.
+     * @param lastAppliedEpoch The last fully applied TaaS epoch, or invalidId on nodes that apply no epochs.
      * @return  Boolean value denoting success or failure.
      */
-    bool Update(uint64_t id, uint64_t lsn, uint64_t lastReplayLsn);
+    bool Update(uint64_t id, uint64_t lsn, uint64_t lastReplayLsn, uint64_t lastAppliedEpoch);
 
     bool IsValid() const
     {
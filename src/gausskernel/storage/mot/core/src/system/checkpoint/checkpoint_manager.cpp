@@ -57,7 +57,12 @@ CheckpointManager::CheckpointManager()
       m_id(CheckpointControlFile::invalidId),
       m_inProgressId(CheckpointControlFile::invalidId),
       m_lastReplayLsn(0),
-      m_emptyCheckpoint(false)
+      m_appliedEpoch(CheckpointControlFile::invalidId),
+      m_inProgressAppliedEpoch(CheckpointControlFile::invalidId),
+      m_emptyCheckpoint(false),
+      m_deltaEnabled(GetGlobalConfiguration().m_enableDeltaCheckpoint),
+      m_captureSeq(0),
+      m_deltaForceFull(true)
 {}
 
 bool CheckpointManager::Initialize()
@@ -68,6 +73,12 @@ bool CheckpointManager::Initialize()
         return false;
     }
 
+    // keep the persisted epoch until the storage updaters apply a newer one
+    CheckpointControlFile* ctrlFile = CheckpointControlFile::GetCtrlFile();
+    if (ctrlFile != nullptr) {
+        m_appliedEpoch = ctrlFile->GetLastAppliedEpoch();
+    }
+
     return true;
 }
 
@@ -105,6 +116,13 @@ bool CheckpointManager::CreateSnapShot()
 
     ResetFlags();
 
+    // On a standby, let the redo replay workers finish the transactions handed to them, so the replay LSN captured
+    // below covers exactly the replayed transactions
+    bool isRecovering = MOTEngine::GetInstance()->IsRecovering();
+    if (isRecovering) {
+        GetRecoveryManager()->PauseReplay();
+    }
+
     // Ensure that there are no transactions that started in Checkpoint COMPLETE
     // phase that are not yet completed
     WaitPrevPhaseCommittedTxnComplete();
@@ -131,6 +149,10 @@ bool CheckpointManager::CreateSnapShot()
     MoveToNextPhase();
     m_lock.WrUnlock();
 
+    if (isRecovering) {
+        GetRecoveryManager()->ResumeReplay();
+    }
+
     return !m_errorSet;
 }
 
@@ -177,6 +199,9 @@ bool CheckpointManager::BeginCheckpoint()
         CompleteCheckpoint();
     }
 
+    // The workers of a failed checkpoint may have cleared dirty bits of changes that were not persisted
+    m_deltaForceFull = m_errorSet;
+
     // No locking required here, as the checkpoint workers have already exited.
     UnlockAndClearTables(m_tasksList);
     m_numCpTasks = 0;
@@ -219,6 +244,9 @@ bool CheckpointManager::Abort()
         UnlockAndClearTables(m_finishedTasks);
         m_numCpTasks = 0;
 
+        // The changes tracked for this checkpoint are still pending
+        m_deltaForceFull = true;
+
         // Move to rest
         m_lock.WrLock();
         MoveToNextPhase();
@@ -332,6 +360,10 @@ void CheckpointManager::MoveToNextPhase()
     m_cntBit = !m_cntBit;
 
     if (m_phase == CheckpointPhase::CAPTURE) {
+        // transactions committing from now on belong to the next checkpoint
+        m_captureSeq++;
+        // every epoch up to this one was applied before the capture, so the checkpoint contains it
+        m_inProgressAppliedEpoch = m_appliedEpoch.load(std::memory_order_acquire);
         if (m_redoLogHandler != nullptr) {
             // hold the redo log lock to avoid inserting additional entries to the
             // log. Once snapshot is taken, this lock will be released in SnapshotReady().
@@ -339,6 +371,11 @@ void CheckpointManager::MoveToNextPhase()
             // write all buffer entries before taking the LSN position
             // relevant for asynchronous logging or group commit
             m_redoLogHandler->Flush();
+            // redo logged from now on is replayed on top of this checkpoint (relevant for the native logger)
+            ILogger* logger = m_redoLogHandler->GetLogger();
+            if (logger != nullptr && !logger->RotateLog(m_inProgressId)) {
+                OnError(CheckpointWorkerPool::ErrCodes::FILE_IO, "Failed to rotate the redo log");
+            }
         }
         if (MOTEngine::GetInstance()->IsRecovering()) {
             // We are moving from RESOLVE to CAPTURE phase. No transaction is allowed to commit
@@ -435,6 +472,44 @@ void CheckpointManager::ApplyWrite(TxnManager* txnMan, Row* origRow, AccessType
             MOT_LOG_ERROR("Unknown transaction start phase: %s", CheckpointManager::PhaseToString(startPhase));
             MOT_ASSERT(false);
     }
+
+    if (m_deltaEnabled) {
+        RecordDeltaWrite(origRow, type == DEL, false);
+    }
+}
+
+void CheckpointManager::ApplyStorageWrite(Row* row, bool deleted)
+{
+    if (m_deltaEnabled) {
+        // the stable bits are only changed under the sentinel lock
+        Sentinel* s = row->GetPrimarySentinel();
+        s->Lock(0);
+        RecordDeltaWrite(row, deleted, true);
+        s->Release();
+    }
+}
+
+void CheckpointManager::RecordDeltaWrite(Row* row, bool deleted, bool unordered)
+{
+    Sentinel* s = row->GetPrimarySentinel();
+    MOT_ASSERT(s != nullptr);
+
+    // A transaction commits between the capture phases of consecutive checkpoints, so it belongs to the one after
+    // the last capture. The phase waits guarantee no capture started since the transaction began its commit.
+    uint64_t seq = m_captureSeq + 1;
+    s->SetDeltaDirty((seq & 1) != 0, true);
+    if (unordered) {
+        s->SetDeltaDirty((seq & 1) == 0, true);
+    }
+
+    if (deleted) {
+        MaxKey key;
+        Table* table = row->GetTable();
+        Index* index = table->GetPrimaryIndex();
+        key.InitKey(index->GetKeyLength());
+        index->BuildKey(table, row, &key);
+        table->RecordDeletedKey(&key, seq);
+    }
 }
 
 void CheckpointManager::FillTasksQueue()
@@ -489,6 +564,140 @@ void CheckpointManager::TaskDone(Table* table, uint32_t numSegs, bool success)
     }
 }
 
+bool CheckpointManager::GetDeltaLevels(Table* table, std::vector<DeltaLevel>& levels)
+{
+    levels.clear();
+
+    // always consumed, so a truncate is not carried over to the next checkpoint
+    bool fullData = table->TestAndClearCheckpointFullData();
+    if (!m_deltaEnabled || m_deltaForceFull || fullData) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> guard(m_tasksMutex);
+    DeltaChainMap::iterator it = m_prevChains.find(table->GetTableId());
+    if (it == m_prevChains.end() || it->second.size() >= GetGlobalConfiguration().m_deltaCheckpointFullInterval) {
+        return false;
+    }
+
+    levels = it->second;
+    m_curChains[table->GetTableId()] = levels;
+    return true;
+}
+
+void CheckpointManager::LoadDeltaChains()
+{
+    m_prevChains.clear();
+    m_curChains.clear();
+    if (!m_deltaEnabled || m_deltaForceFull || m_id == CheckpointControlFile::invalidId) {
+        return;
+    }
+
+    int fd = -1;
+    std::string fileName;
+    std::string workingDir;
+    if (!CheckpointUtils::SetWorkingDir(workingDir, m_id)) {
+        return;
+    }
+
+    // The earlier levels the previous checkpoint built on
+    CheckpointUtils::MakeDeltaFilename(fileName, workingDir, m_id);
+    if (CheckpointUtils::IsFileExists(fileName) && !CheckpointUtils::ReadDeltaFile(fileName, m_prevChains)) {
+        MOT_LOG_WARN("LoadDeltaChains: failed to read '%s', checkpointing all tables in full", fileName.c_str());
+        m_prevChains.clear();
+        return;
+    }
+
+    // and its own level
+    CheckpointUtils::MakeMapFilename(fileName, workingDir, m_id);
+    if (!CheckpointUtils::OpenFileRead(fileName, fd)) {
+        m_prevChains.clear();
+        return;
+    }
+
+    CheckpointUtils::MapFileHeader mapFileHeader;
+    bool ret = false;
+    do {
+        if (CheckpointUtils::ReadFile(fd, (char*)&mapFileHeader, sizeof(CheckpointUtils::MapFileHeader)) !=
+                sizeof(CheckpointUtils::MapFileHeader) ||
+            mapFileHeader.m_magic != CP_MGR_MAGIC) {
+            break;
+        }
+
+        uint64_t i = 0;
+        MapFileEntry entry;
+        for (; i < mapFileHeader.m_numEntries; i++) {
+            if (CheckpointUtils::ReadFile(fd, (char*)&entry, sizeof(MapFileEntry)) != sizeof(MapFileEntry)) {
+                break;
+            }
+            m_prevChains[entry.m_tableId].push_back({m_id, entry.m_maxSegId});
+        }
+        ret = (i == mapFileHeader.m_numEntries);
+    } while (0);
+    (void)CheckpointUtils::CloseFile(fd);
+
+    if (!ret) {
+        MOT_LOG_WARN("LoadDeltaChains: failed to read '%s', checkpointing all tables in full", fileName.c_str());
+        m_prevChains.clear();
+    }
+}
+
+bool CheckpointManager::CreateDeltaFile()
+{
+    int fd = -1;
+    std::string fileName;
+    std::string workingDir;
+    bool ret = false;
+
+    do {
+        if (!CheckpointUtils::SetWorkingDir(workingDir, m_inProgressId)) {
+            break;
+        }
+
+        CheckpointUtils::MakeDeltaFilename(fileName, workingDir, m_inProgressId);
+        if (!CheckpointUtils::OpenFileWrite(fileName, fd)) {
+            MOT_LOG_ERROR("CreateDeltaFile: failed to create file '%s'", fileName.c_str());
+            break;
+        }
+
+        CheckpointUtils::DeltaFileHeader deltaFileHeader{CP_MGR_MAGIC, m_curChains.size()};
+        if (CheckpointUtils::WriteFile(fd, (char*)&deltaFileHeader, sizeof(CheckpointUtils::DeltaFileHeader)) !=
+            sizeof(CheckpointUtils::DeltaFileHeader)) {
+            MOT_LOG_ERROR("CreateDeltaFile: failed to write file header");
+            (void)CheckpointUtils::CloseFile(fd);
+            break;
+        }
+
+        bool written = true;
+        for (DeltaChainMap::iterator it = m_curChains.begin(); it != m_curChains.end(); ++it) {
+            CheckpointUtils::DeltaFileEntry entry{it->first, it->second.size()};
+            size_t levelsSize = it->second.size() * sizeof(DeltaLevel);
+            if (CheckpointUtils::WriteFile(fd, (char*)&entry, sizeof(CheckpointUtils::DeltaFileEntry)) !=
+                    sizeof(CheckpointUtils::DeltaFileEntry) ||
+                CheckpointUtils::WriteFile(fd, (char*)it->second.data(), levelsSize) != levelsSize) {
+                MOT_LOG_ERROR("CreateDeltaFile: failed to write entry of table %u", it->first);
+                written = false;
+                break;
+            }
+        }
+
+        if (!written || CheckpointUtils::FlushFile(fd)) {
+            (void)CheckpointUtils::CloseFile(fd);
+            break;
+        }
+
+        if (CheckpointUtils::CloseFile(fd)) {
+            MOT_LOG_ERROR("CreateDeltaFile: failed to close file");
+            break;
+        }
+        ret = true;
+    } while (0);
+
+    m_prevChains.clear();
+    m_curChains.clear();
+    return ret;
+}
+
 void CheckpointManager::CompleteCheckpoint()
 {
     if (m_emptyCheckpoint == true && CreateEmptyCheckpoint() == false) {
@@ -507,6 +716,11 @@ void CheckpointManager::CompleteCheckpoint()
         return;
     }
 
+    if (m_deltaEnabled && !CreateDeltaFile()) {
+        OnError(CheckpointWorkerPool::ErrCodes::FILE_IO, "Failed to create delta chains file");
+        return;
+    }
+
     if (!CreateTpcRecoveryFile()) {
         OnError(CheckpointWorkerPool::ErrCodes::FILE_IO, "Failed to create 2pc recovery file");
         return;
@@ -525,7 +739,7 @@ void CheckpointManager::CompleteCheckpoint()
             break;
         }
 
-        if (!ctrlFile->Update(m_inProgressId, GetLsn(), GetLastReplayLsn())) {
+        if (!ctrlFile->Update(m_inProgressId, GetLsn(), GetLastReplayLsn(), m_inProgressAppliedEpoch)) {
             OnError(CheckpointWorkerPool::ErrCodes::FILE_IO, "Failed to update control file");
             break;
         }
@@ -541,6 +755,9 @@ void CheckpointManager::CompleteCheckpoint()
     }
 
     RemoveOldCheckpoints(m_inProgressId);
+    if (m_redoLogHandler != nullptr && m_redoLogHandler->GetLogger() != nullptr) {
+        m_redoLogHandler->GetLogger()->ReleaseLog(m_inProgressId);
+    }
     MOT_LOG_INFO("Checkpoint [%lu] completed", m_inProgressId);
 }
 
@@ -554,8 +771,14 @@ void CheckpointManager::DestroyCheckpointers()
 
 void CheckpointManager::CreateCheckpointers()
 {
-    m_checkpointers = new (std::nothrow)
-        CheckpointWorkerPool(m_numThreads, !m_availableBit, m_tasksList, m_cpSegThreshold, m_inProgressId, *this);
+    m_checkpointers = new (std::nothrow) CheckpointWorkerPool(m_numThreads,
+        !m_availableBit,
+        m_tasksList,
+        m_cpSegThreshold,
+        m_inProgressId,
+        m_id,
+        m_captureSeq,
+        *this);
 }
 
 void CheckpointManager::Capture()
@@ -567,6 +790,7 @@ void CheckpointManager::Capture()
         m_emptyCheckpoint = true;
         m_checkpointEnded = true;
     } else {
+        LoadDeltaChains();
         DestroyCheckpointers();
         CreateCheckpointers();
         if (m_checkpointers == nullptr) {
@@ -109,6 +109,24 @@ public:
      */
     void ApplyWrite(TxnManager* txnMan, Row* origRow, AccessType type);
 
+    /**
+     * @brief Records a row change applied outside of the commit protocol (by the storage updater) for the next
+     * delta checkpoints.
+     * @param row The changed row.
+     * @param deleted Specifies whether the row was deleted.
+     */
+    void ApplyStorageWrite(Row* row, bool deleted);
+
+    /**
+     * @brief Records the last TaaS epoch fully applied by the storage updaters. The value is persisted in the
+     * control file by the next checkpoint, a restarted storage node resumes applying after it.
+     * @param epoch The epoch.
+     */
+    void SetAppliedEpoch(uint64_t epoch)
+    {
+        m_appliedEpoch.store(epoch, std::memory_order_release);
+    }
+
     /**
      * @brief Checkpoint task completion callback
      * @param checkpointId The checkpoint's id.
@@ -118,6 +136,8 @@ public:
      */
     virtual void TaskDone(Table* table, uint32_t numSegs, bool success);
 
+    virtual bool GetDeltaLevels(Table* table, std::vector<DeltaLevel>& levels);
+
     virtual bool ShouldStop() const
     {
         return m_stopFlag;
@@ -268,8 +288,29 @@ private:
     // last seen recovery lsn
     uint64_t m_lastReplayLsn;
 
+    // Last TaaS epoch fully applied by the storage updaters, invalid on nodes that apply no epochs
+    std::atomic<uint64_t> m_appliedEpoch;
+
+    // The applied epoch captured by the in-progress checkpoint
+    uint64_t m_inProgressAppliedEpoch;
+
     bool m_emptyCheckpoint;
 
+    // Delta checkpoints are enabled (latched on startup, as changes are tracked only while enabled)
+    bool m_deltaEnabled;
+
+    // The number of checkpoints that entered the capture phase, selects the delta dirty bits
+    volatile uint64_t m_captureSeq;
+
+    // The next checkpoint must write all tables in full, as changes were not tracked since the last one
+    bool m_deltaForceFull;
+
+    // The levels of the tables in the previous checkpoint, including its own
+    DeltaChainMap m_prevChains;
+
+    // The earlier levels of the tables checkpointed as deltas by the current checkpoint
+    DeltaChainMap m_curChains;
+
     // this lock guards gs_ctl checkpoint fetching
     pthread_rwlock_t m_fetchLock;
 
@@ -372,6 +413,27 @@ private:
      */
     bool CreateCheckpointMap();
 
+    /**
+     * @brief Loads the delta chains of the previous checkpoint from its map and delta chains files.
+     */
+    void LoadDeltaChains();
+
+    /**
+     * @brief Creates the checkpoint's delta chains file, listing the earlier levels of the tables checkpointed as
+     * deltas.
+     * @return Boolean value denoting success or failure.
+     */
+    bool CreateDeltaFile();
+
+    /**
+     * @brief Marks a row as changed for the next delta checkpoint and records its key if it was deleted.
+     * @param row The changed row.
+     * @param deleted Specifies whether the row was deleted.
+     * @param unordered Specifies whether the change is not ordered against the checkpoint phases, so it may
+     * belong to either of the next two checkpoints.
+     */
+    void RecordDeltaWrite(Row* row, bool deleted, bool unordered);
+
     /**
      * @brief Saves the in-process transaction data for 2pc recovery
      * purposes during the checkpoint.
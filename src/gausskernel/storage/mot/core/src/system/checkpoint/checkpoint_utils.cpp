@@ -141,6 +141,57 @@ bool SeekFile(int fd, uint64_t offset)
     return (rc != -1);
 }
 
+bool LinkFile(std::string fileName, std::string linkName)
+{
+    if (link(fileName.c_str(), linkName.c_str()) == -1) {
+        MOT_REPORT_SYSTEM_ERROR(link, "N/A", "Failed to link file %s to %s", fileName.c_str(), linkName.c_str());
+        return false;
+    }
+    return true;
+}
+
+bool ReadDeltaFile(std::string fileName, DeltaChainMap& chains)
+{
+    int fd = -1;
+    chains.clear();
+    if (!OpenFileRead(fileName, fd)) {
+        return false;
+    }
+
+    bool ret = false;
+    do {
+        DeltaFileHeader header;
+        if (ReadFile(fd, (char*)&header, sizeof(DeltaFileHeader)) != sizeof(DeltaFileHeader) ||
+            header.m_magic != CP_MGR_MAGIC) {
+            MOT_LOG_ERROR("ReadDeltaFile: failed to read the header of file '%s'", fileName.c_str());
+            break;
+        }
+
+        uint64_t i = 0;
+        for (; i < header.m_numEntries; i++) {
+            DeltaFileEntry entry;
+            if (ReadFile(fd, (char*)&entry, sizeof(DeltaFileEntry)) != sizeof(DeltaFileEntry)) {
+                break;
+            }
+            std::vector<DeltaLevel>& levels = chains[(uint32_t)entry.m_tableId];
+            levels.resize(entry.m_numLevels);
+            size_t levelsSize = entry.m_numLevels * sizeof(DeltaLevel);
+            if (ReadFile(fd, (char*)levels.data(), levelsSize) != levelsSize) {
+                break;
+            }
+        }
+
+        if (i != header.m_numEntries) {
+            MOT_LOG_ERROR("ReadDeltaFile: failed to read entry %lu of file '%s'", i, fileName.c_str());
+            break;
+        }
+        ret = true;
+    } while (0);
+
+    (void)CloseFile(fd);
+    return ret;
+}
+
 bool GetWorkingDir(std::string& dir)
 {
     dir.clear();
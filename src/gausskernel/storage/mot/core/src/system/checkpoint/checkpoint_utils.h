@@ -124,6 +124,14 @@ int FlushFile(int fd);
  */
 bool SeekFile(int fd, uint64_t offset);
 
+/**
+ * @brief A wrapper function that creates a hard link to a file.
+ * @param fileName The existing file.
+ * @param linkName The link to create.
+ * @return Boolean value denoting success or failure.
+ */
+bool LinkFile(std::string fileName, std::string linkName);
+
 /**
  * @brief Frees a row's stable version row.
  * @param row The row which stable version needs to be freed.
@@ -180,6 +188,15 @@ static const char* tpcFileSuffix = ".tpc";
 // End file suffix
 static const char* validFileSuffix = ".end";
 
+// Deleted keys file suffix
+static const char* delFileSuffix = ".del";
+
+// Delta chains file suffix
+static const char* deltaFileSuffix = ".dlt";
+
+// Prefix of the files of earlier delta levels linked into a checkpoint dir
+static const char* levelPrefix = "d";
+
 // Max path len
 static const size_t maxPath = 1024;
 
@@ -244,16 +261,33 @@ inline void MakeMapFilename(std::string& fileName, std::string& workingDir, uint
     fileName.append(mapFileSuffix);
 }
 
+/**
+ * @brief Appends the delta level prefix of a file taken by an earlier checkpoint.
+ * @param fileName The filename string to append to.
+ * @param levelId The id of the checkpoint that took the file, or 0 for the checkpoint the directory belongs to.
+ */
+inline void AppendLevelPrefix(std::string& fileName, uint64_t levelId)
+{
+    if (levelId != 0) {
+        fileName.append(levelPrefix);
+        fileName.append(std::to_string(levelId));
+        fileName.append("_");
+    }
+}
+
 /**
  * @brief Creates a checkpoint seg filename
  * @param tableId The tabled id that this file contains.
  * @param fileName The returned filename string.
  * @param workingDir The directory in which the file should be located.
  * @param seg The segment number.
+ * @param levelId The id of the checkpoint that took the segment, if it is an earlier delta level.
  */
-inline void MakeCpFilename(uint64_t tableId, std::string& fileName, std::string& workingDir, int seg = 0)
+inline void MakeCpFilename(
+    uint64_t tableId, std::string& fileName, std::string& workingDir, int seg = 0, uint64_t levelId = 0)
 {
     MakeFilename(fileName, workingDir);
+    AppendLevelPrefix(fileName, levelId);
     fileName.append("tab_");
     fileName.append(std::to_string(tableId));
     fileName.append("_");
@@ -261,6 +295,22 @@ inline void MakeCpFilename(uint64_t tableId, std::string& fileName, std::string&
     fileName.append(cpFileSuffix);
 }
 
+/**
+ * @brief Creates a delta checkpoint deleted keys filename
+ * @param tableId The tabled id that this file contains.
+ * @param fileName The returned filename string.
+ * @param workingDir The directory in which the file should be located.
+ * @param levelId The id of the checkpoint that took the file, if it is an earlier delta level.
+ */
+inline void MakeDelFilename(uint64_t tableId, std::string& fileName, std::string& workingDir, uint64_t levelId = 0)
+{
+    MakeFilename(fileName, workingDir);
+    AppendLevelPrefix(fileName, levelId);
+    fileName.append("tab_");
+    fileName.append(std::to_string(tableId));
+    fileName.append(delFileSuffix);
+}
+
 /**
  * @brief Creates a checkpoint table metadata filename
  * @param tableId The tabled id that this file contains.
@@ -300,6 +350,19 @@ inline void MakeEndFilename(std::string& fileName, std::string& workingDir, uint
     fileName.append(validFileSuffix);
 }
 
+/**
+ * @brief Creates a delta chains filename
+ * @param fileName The returned filename string.
+ * @param workingDir The directory in which the file should be located.
+ * @param cpId The checkpoint id.
+ */
+inline void MakeDeltaFilename(std::string& fileName, std::string& workingDir, uint64_t cpId)
+{
+    MakeFilename(fileName, workingDir);
+    fileName.append(std::to_string(cpId));
+    fileName.append(deltaFileSuffix);
+}
+
 /**
  * @brief Sets the cpu affinity for a given thread
  * @param cpu The cpu that the thread should run on.
@@ -348,6 +411,24 @@ struct TpcEntryHeader {
     uint64_t m_len;
 };
 
+struct DeltaFileHeader {
+    uint64_t m_magic;
+    uint64_t m_numEntries;
+};
+
+struct DeltaFileEntry {
+    uint64_t m_tableId;
+    uint64_t m_numLevels;
+};
+
+/**
+ * @brief Reads the delta chains file of a checkpoint. Tables not in the file were checkpointed in full.
+ * @param fileName The delta chains file.
+ * @param chains The returned earlier levels of each table, oldest first.
+ * @return Boolean value denoting success or failure.
+ */
+bool ReadDeltaFile(std::string fileName, DeltaChainMap& chains);
+
 /**
  * @brief Produces a pretty hex printout of a given buffer to stderr
  * @param msg A text the will be displayed before the hex data printout.
@@ -28,6 +28,7 @@
 #include <sys/time.h>
 #include <time.h>
 #include "checkpoint_utils.h"
+#include "checkpoint_block_file.h"
 #include "checkpoint_worker.h"
 #include "checkpoint_manager.h"
 #include "mot_engine.h"
@@ -49,6 +50,10 @@ void CheckpointWorkerPool::Start()
     if (!CheckpointManager::CreateCheckpointDir(m_workingDir))
         m_cpManager.OnError(ErrCodes::FILE_IO, "failed to create working dir", m_workingDir.c_str());
 
+    if (m_prevCheckpointId != CheckpointControlFile::invalidId &&
+        !CheckpointUtils::SetWorkingDir(m_prevWorkingDir, m_prevCheckpointId))
+        m_cpManager.OnError(ErrCodes::FILE_IO, "failed to setup previous working dir");
+
     WorkerThreads* threads = new (std::nothrow) WorkerThreads();
     if (threads == nullptr) {
         m_cpManager.OnError(ErrCodes::MEMORY, "failed to allocate checkpoint thread pool");
@@ -77,7 +82,7 @@ CheckpointWorkerPool::~CheckpointWorkerPool()
     MOT_LOG_DEBUG("~CheckpointWorkerPool: done");
 }
 
-bool CheckpointWorkerPool::Write(Buffer* buffer, Row* row, int fd)
+bool CheckpointWorkerPool::Write(Buffer* buffer, Row* row, CheckpointFileWriter* file)
 {
     MaxKey key;
     Key* primaryKey = &key;
@@ -86,22 +91,11 @@ bool CheckpointWorkerPool::Write(Buffer* buffer, Row* row, int fd)
     index->BuildKey(row->GetTable(), row, primaryKey);
     if (buffer->Size() + primaryKey->GetKeyLength() + row->GetTupleSize() + sizeof(CheckpointUtils::EntryHeader) >
         buffer->MaxSize()) {
-        // need to flush the buffer before serializing the next row
-        size_t wrSta = CheckpointUtils::WriteFile(fd, (char*)buffer->Data(), buffer->Size());
-        if (wrSta != buffer->Size()) {
-            MOT_LOG_ERROR("CheckpointWorkerPool::write - failed to write %u bytes to [%d] (%d:%s)",
-                buffer->Size(),
-                fd,
-                errno,
-                gs_strerror(errno));
-            return false;
-        }
-
-        if (CheckpointUtils::FlushFile(fd)) {
-            MOT_LOG_ERROR("CheckpointWorkerPool::write - failed to flush [%d]", fd);
+        // need to flush the buffer as a block before serializing the next row
+        if (!FlushBuffer(file, buffer)) {
+            MOT_LOG_ERROR("CheckpointWorkerPool::write - failed to write a block of %u bytes", buffer->Size());
             return false;
         }
-        buffer->Reset();
     }
     CheckpointUtils::EntryHeader entryHeader;
     entryHeader.m_keyLen = primaryKey->GetKeyLength();
@@ -124,7 +118,8 @@ bool CheckpointWorkerPool::Write(Buffer* buffer, Row* row, int fd)
     return true;
 }
 
-int CheckpointWorkerPool::Checkpoint(Buffer* buffer, Sentinel* sentinel, int fd, uint16_t threadId, bool& isDeleted)
+int CheckpointWorkerPool::Checkpoint(Buffer* buffer, Sentinel* sentinel, CheckpointFileWriter* file, uint16_t threadId,
+    bool& isDeleted, bool deltaOnly)
 {
     Row* mainRow = sentinel->GetData();
     Row* stableRow = nullptr;
@@ -157,6 +152,14 @@ int CheckpointWorkerPool::Checkpoint(Buffer* buffer, Sentinel* sentinel, int fd,
     bool statusBit = sentinel->GetStableStatus();
     bool deleted = !sentinel->IsCommited(); /* this currently indicates if the row is deleted or not */
 
+    /*
+     * A delta checkpoint does not write rows that did not change since the previous checkpoint, but still releases
+     * their stable versions and flips their status bits. The dirty bit of this checkpoint is cleared either way.
+     */
+    bool parity = (m_checkpointSeq & 1) != 0;
+    bool skip = deltaOnly && !sentinel->GetDeltaDirty(parity);
+    sentinel->SetDeltaDirty(parity, false);
+
     MOT_ASSERT(sentinel->GetStablePreAllocStatus() == false);
 
     do {
@@ -165,14 +168,14 @@ int CheckpointWorkerPool::Checkpoint(Buffer* buffer, Sentinel* sentinel, int fd,
                 break;
             }
 
-            if (!Write(buffer, stableRow, fd)) {
+            if (!skip && !Write(buffer, stableRow, file)) {
                 wrote = -1;
             } else {
                 if (isDeleted == false) {
                     CheckpointUtils::DestroyStableRow(stableRow);
                     sentinel->SetStable(nullptr);
                 }
-                wrote = 1;
+                wrote = skip ? 0 : 1;
             }
             break;
         } else { /* no stable version */
@@ -182,7 +185,9 @@ int CheckpointWorkerPool::Checkpoint(Buffer* buffer, Sentinel* sentinel, int fd,
                     break;
                 }
                 sentinel->SetStableStatus(!m_na);
-                if (!Write(buffer, mainRow, fd)) {
+                if (skip) {
+                    wrote = 0;
+                } else if (!Write(buffer, mainRow, file)) {
                     wrote = -1;  // we failed to write, set error
                 } else {
                     wrote = 1;
@@ -237,7 +242,7 @@ void CheckpointWorkerPool::WorkerFunc()
     MOT_DECLARE_NON_KERNEL_THREAD();
     MOT_LOG_DEBUG("CheckpointWorkerPool::WorkerFunc");
 
-    Buffer buffer;
+    Buffer buffer(CHECKPOINT_BUFFER_SIZE);
     if (!buffer.Initialize()) {
         MOT_LOG_ERROR("CheckpointWorkerPool::WorkerFunc: Failed to initialize buffer");
         m_cpManager.OnError(ErrCodes::MEMORY, "Memory allocation failure");
@@ -246,6 +251,16 @@ void CheckpointWorkerPool::WorkerFunc()
         return;
     }
 
+    CheckpointCodec codec = CheckpointCodecFromString(GetGlobalConfiguration().m_checkpointCompression.c_str());
+    CheckpointFileWriter file;
+    if (!file.Initialize(buffer.MaxSize(), codec, GetGlobalConfiguration().m_enableCheckpointDirectIo)) {
+        MOT_LOG_ERROR("CheckpointWorkerPool::WorkerFunc: Failed to initialize file writer");
+        m_cpManager.OnError(ErrCodes::MEMORY, "Memory allocation failure");
+        MOT::MOTEngine::GetInstance()->OnCurrentThreadEnding();
+        MOT_LOG_DEBUG("thread exiting");
+        return;
+    }
+
     SessionContext* sessionContext = GetSessionManager()->CreateSessionContext();
     if (sessionContext == nullptr) {
         MOT_LOG_ERROR("CheckpointWorkerPool::WorkerFunc: Failed to initialize Session Context");
@@ -288,6 +303,9 @@ void CheckpointWorkerPool::WorkerFunc()
                 tableId = table->GetTableId();
                 exId = table->GetTableExId();
 
+                std::vector<DeltaLevel> levels;
+                bool isDelta = m_cpManager.GetDeltaLevels(table, levels);
+
                 ErrCodes errCode = WriteTableMetadataFile(table);
                 if (errCode != ErrCodes::SUCCESS) {
                     MOT_LOG_ERROR(
@@ -297,11 +315,24 @@ void CheckpointWorkerPool::WorkerFunc()
                     break;
                 }
 
+                if (isDelta) {
+                    errCode = LinkDeltaLevels(tableId, levels);
+                    if (errCode != ErrCodes::SUCCESS) {
+                        MOT_LOG_ERROR(
+                            "CheckpointWorkerPool::WorkerFunc: failed to link delta levels for table %u", tableId);
+                        m_cpManager.OnError(
+                            errCode, "Failed to link delta levels for table - ", std::to_string(tableId).c_str());
+                        break;
+                    }
+                }
+
                 struct timespec start, end;
                 uint64_t numOps = 0;
+                uint64_t numDeleted = 0;
                 clock_gettime(CLOCK_MONOTONIC, &start);
 
-                errCode = WriteTableDataFile(table, &buffer, deletedList, gcSession, threadId, maxSegId, numOps);
+                errCode = WriteTableDataFile(
+                    table, &buffer, &file, deletedList, gcSession, threadId, maxSegId, numOps, isDelta);
                 if (errCode != ErrCodes::SUCCESS) {
                     MOT_LOG_ERROR(
                         "CheckpointWorkerPool::WorkerFunc: failed to write table data file for table %u", tableId);
@@ -310,6 +341,22 @@ void CheckpointWorkerPool::WorkerFunc()
                     break;
                 }
 
+                if (isDelta) {
+                    errCode = WriteTableDeletedKeysFile(table, &buffer, &file, numDeleted);
+                    if (errCode != ErrCodes::SUCCESS) {
+                        MOT_LOG_ERROR(
+                            "CheckpointWorkerPool::WorkerFunc: failed to write deleted keys file for table %u", tableId);
+                        m_cpManager.OnError(errCode,
+                            "Failed to write deleted keys file for table - ",
+                            std::to_string(tableId).c_str());
+                        break;
+                    }
+                } else {
+                    // a full checkpoint supersedes the deletions recorded so far
+                    std::vector<uint8_t> deletedKeys;
+                    (void)table->TakeDeletedKeys(m_checkpointSeq, deletedKeys);
+                }
+
                 taskSucceeded = true;
                 clock_gettime(CLOCK_MONOTONIC, &end);
                 /*
@@ -317,11 +364,13 @@ void CheckpointWorkerPool::WorkerFunc()
                  * (/1000) is to convert nano seconds to micro seconds
                  */
                 uint64_t deltaUs = (end.tv_sec - start.tv_sec) * 1000000 + (end.tv_nsec - start.tv_nsec) / 1000;
-                MOT_LOG_DEBUG(
-                    "CheckpointWorkerPool::WorkerFunc: checkpoint of table %u completed in %luus, (%lu elements)",
+                MOT_LOG_DEBUG("CheckpointWorkerPool::WorkerFunc: %s checkpoint of table %u completed in %luus, (%lu "
+                              "elements, %lu deleted)",
+                    isDelta ? "delta" : "full",
                     tableId,
                     deltaUs,
-                    numOps);
+                    numOps,
+                    numDeleted);
             } while (0);
 
             m_cpManager.TaskDone(table, maxSegId, taskSucceeded);
@@ -339,53 +388,25 @@ void CheckpointWorkerPool::WorkerFunc()
     MOT_LOG_DEBUG("thread exiting");
 }
 
-bool CheckpointWorkerPool::BeginFile(int& fd, uint32_t tableId, int seg, uint64_t exId)
+bool CheckpointWorkerPool::BeginFile(CheckpointFileWriter* file, uint32_t tableId, int seg, uint64_t exId)
 {
     std::string fileName;
     CheckpointUtils::MakeCpFilename(tableId, fileName, m_workingDir, seg);
-    if (!CheckpointUtils::OpenFileWrite(fileName, fd)) {
+    if (!file->Open(fileName, tableId, exId)) {
         MOT_LOG_ERROR("CheckpointWorkerPool::BeginFile: failed to create file: %s", fileName.c_str());
         return false;
     }
     MOT_LOG_DEBUG("CheckpointWorkerPool::beginFile: %s", fileName.c_str());
-    CheckpointUtils::FileHeader fileHeader{CP_MGR_MAGIC, tableId, exId, 0};
-    if (CheckpointUtils::WriteFile(fd, (char*)&fileHeader, sizeof(CheckpointUtils::FileHeader)) !=
-        sizeof(CheckpointUtils::FileHeader)) {
-        MOT_LOG_ERROR("CheckpointWorkerPool::BeginFile: failed to write file header: %s", fileName.c_str());
-        CheckpointUtils::CloseFile(fd);
-        fd = -1;
-        return false;
-    }
     return true;
 }
 
-bool CheckpointWorkerPool::FinishFile(int& fd, uint32_t tableId, uint64_t numOps, uint64_t exId)
+bool CheckpointWorkerPool::FinishFile(CheckpointFileWriter* file, uint32_t tableId, uint64_t numOps)
 {
-    bool ret = false;
-    do {
-        if (!CheckpointUtils::SeekFile(fd, 0)) {
-            MOT_LOG_ERROR("CheckpointWorkerPool::FinishFile: failed to seek in file (id: %u)", tableId);
-            break;
-        }
-        CheckpointUtils::FileHeader fileHeader{CP_MGR_MAGIC, tableId, exId, numOps};
-        if (CheckpointUtils::WriteFile(fd, (char*)&fileHeader, sizeof(CheckpointUtils::FileHeader)) !=
-            sizeof(CheckpointUtils::FileHeader)) {
-            MOT_LOG_ERROR("CheckpointWorkerPool::FinishFile: failed to write to file (id: %u)", tableId);
-            break;
-        }
-        if (CheckpointUtils::FlushFile(fd)) {
-            MOT_LOG_ERROR("CheckpointWorkerPool::FinishFile: failed to flush file (id: %u)", tableId);
-            break;
-        }
-        if (CheckpointUtils::CloseFile(fd)) {
-            MOT_LOG_ERROR("CheckpointWorkerPool::FinishFile: failed to close file (id: %u)", tableId);
-            break;
-        }
-        fd = -1;
-        ret = true;
-    } while (0);
-
-    return ret;
+    if (!file->Finish(numOps)) {
+        MOT_LOG_ERROR("CheckpointWorkerPool::FinishFile: failed to finish file (id: %u)", tableId);
+        return false;
+    }
+    return true;
 }
 
 bool CheckpointWorkerPool::SetCheckpointId()
@@ -455,10 +476,10 @@ CheckpointWorkerPool::ErrCodes CheckpointWorkerPool::WriteTableMetadataFile(Tabl
     return ErrCodes::SUCCESS;
 }
 
-bool CheckpointWorkerPool::FlushBuffer(int fd, Buffer* buffer)
+bool CheckpointWorkerPool::FlushBuffer(CheckpointFileWriter* file, Buffer* buffer)
 {
     if (buffer->Size() > 0) {  // there is data in the buffer that needs to be written
-        if (CheckpointUtils::WriteFile(fd, (char*)buffer->Data(), buffer->Size()) != buffer->Size()) {
+        if (!file->WriteBlock(buffer->Data(), buffer->Size())) {
             return false;
         }
         buffer->Reset();
@@ -467,11 +488,11 @@ bool CheckpointWorkerPool::FlushBuffer(int fd, Buffer* buffer)
 }
 
 CheckpointWorkerPool::ErrCodes CheckpointWorkerPool::WriteTableDataFile(Table* table, Buffer* buffer,
-    Sentinel** deletedList, GcManager* gcSession, uint16_t threadId, uint32_t& maxSegId, uint64_t& numOps)
+    CheckpointFileWriter* file, Sentinel** deletedList, GcManager* gcSession, uint16_t threadId, uint32_t& maxSegId,
+    uint64_t& numOps, bool isDelta)
 {
     uint32_t tableId = table->GetTableId();
     uint64_t exId = table->GetTableExId();
-    int fd = -1;
     uint16_t deletedListLocation = 0;
     uint64_t currFileOps = 0;
     uint32_t curSegLen = 0;
@@ -491,7 +512,7 @@ CheckpointWorkerPool::ErrCodes CheckpointWorkerPool::WriteTableDataFile(Table* t
         return ErrCodes::INDEX;
     }
 
-    if (!BeginFile(fd, tableId, maxSegId, exId)) {
+    if (!BeginFile(file, tableId, maxSegId, exId)) {
         MOT_LOG_ERROR(
             "CheckpointWorkerPool::WriteTableDataFile: failed to create data file %u for table %u", maxSegId, tableId);
         delete it;
@@ -508,7 +529,7 @@ CheckpointWorkerPool::ErrCodes CheckpointWorkerPool::WriteTableDataFile(Table* t
             it->Next();
             continue;
         }
-        int ckptStatus = Checkpoint(buffer, sentinel, fd, threadId, isDeleted);
+        int ckptStatus = Checkpoint(buffer, sentinel, file, threadId, isDeleted, isDelta);
         if (isDeleted) {
             deletedList[deletedListLocation++] = sentinel;
             ExecuteMicroGcTransaction(deletedList, gcSession, table, deletedListLocation, DELETE_LIST_SIZE);
@@ -517,7 +538,7 @@ CheckpointWorkerPool::ErrCodes CheckpointWorkerPool::WriteTableDataFile(Table* t
             currFileOps++;
             curSegLen += table->GetTupleSize() + sizeof(CheckpointUtils::EntryHeader);
             if (m_checkpointSegsize > 0 && curSegLen >= m_checkpointSegsize) {
-                if (!FlushBuffer(fd, buffer)) {
+                if (!FlushBuffer(file, buffer)) {
                     MOT_LOG_ERROR(
                         "CheckpointWorkerPool::WriteTableDataFile: failed to write remaining buffer data (%u bytes) to "
                             "data file %u for table %u",
@@ -528,8 +549,7 @@ CheckpointWorkerPool::ErrCodes CheckpointWorkerPool::WriteTableDataFile(Table* t
                     break;
                 }
 
-                /* FinishFile will reset the fd to -1 on success. */
-                if (!FinishFile(fd, tableId, currFileOps, exId)) {
+                if (!FinishFile(file, tableId, currFileOps)) {
                     MOT_LOG_ERROR("CheckpointWorkerPool::WriteTableDataFile: failed to close data file %u for table %u",
                         maxSegId,
                         tableId);
@@ -540,7 +560,7 @@ CheckpointWorkerPool::ErrCodes CheckpointWorkerPool::WriteTableDataFile(Table* t
                 maxSegId++;
                 numOps += currFileOps;
 
-                if (!BeginFile(fd, tableId, maxSegId, exId)) {
+                if (!BeginFile(file, tableId, maxSegId, exId)) {
                     MOT_LOG_ERROR(
                         "CheckpointWorkerPool::WriteTableDataFile: failed to create data file %u for table %u",
                         maxSegId,
@@ -570,32 +590,118 @@ CheckpointWorkerPool::ErrCodes CheckpointWorkerPool::WriteTableDataFile(Table* t
     table->ClearThreadMemoryCache();
 
     if (errCode != ErrCodes::SUCCESS) {
-        if (fd != -1) {
-            (void)CheckpointUtils::CloseFile(fd);
-        }
+        file->Close();
         return errCode;
     }
 
-    if (!FlushBuffer(fd, buffer)) {
+    if (!FlushBuffer(file, buffer)) {
         MOT_LOG_ERROR(
             "CheckpointWorkerPool::WriteTableDataFile: failed to write remaining buffer data (%u bytes) to "
                 "data file %u for table %u",
             buffer->Size(),
             maxSegId,
             tableId);
-        (void)CheckpointUtils::CloseFile(fd);
+        file->Close();
         return ErrCodes::FILE_IO;
     }
 
-    /* FinishFile will reset the fd to -1 on success. */
-    if (!FinishFile(fd, tableId, currFileOps, exId)) {
+    if (!FinishFile(file, tableId, currFileOps)) {
         MOT_LOG_ERROR(
             "CheckpointWorkerPool::WriteTableDataFile: failed to close data file %u for table %u", maxSegId, tableId);
-        (void)CheckpointUtils::CloseFile(fd);
         return ErrCodes::FILE_IO;
     }
 
     numOps += currFileOps;
     return ErrCodes::SUCCESS;
 }
+
+CheckpointWorkerPool::ErrCodes CheckpointWorkerPool::WriteTableDeletedKeysFile(
+    Table* table, Buffer* buffer, CheckpointFileWriter* file, uint64_t& numKeys)
+{
+    uint32_t tableId = table->GetTableId();
+    uint64_t exId = table->GetTableExId();
+
+    std::vector<uint8_t> keys;
+    numKeys = table->TakeDeletedKeys(m_checkpointSeq, keys);
+
+    std::string fileName;
+    CheckpointUtils::MakeDelFilename(tableId, fileName, m_workingDir);
+    if (!file->Open(fileName, tableId, exId)) {
+        MOT_LOG_ERROR("CheckpointWorkerPool::WriteTableDeletedKeysFile: failed to create file: %s", fileName.c_str());
+        return ErrCodes::FILE_IO;
+    }
+
+    ErrCodes errCode = ErrCodes::SUCCESS;
+    do {
+        // deleted keys are entries without data
+        size_t offset = 0;
+        while (offset < keys.size()) {
+            uint16_t keyLen = *(uint16_t*)(keys.data() + offset);
+            uint8_t* keyBuf = keys.data() + offset + sizeof(uint16_t);
+            if (buffer->Size() + sizeof(CheckpointUtils::EntryHeader) + keyLen > buffer->MaxSize() &&
+                !FlushBuffer(file, buffer)) {
+                errCode = ErrCodes::FILE_IO;
+                break;
+            }
+            CheckpointUtils::EntryHeader entryHeader{0, 0, 0, keyLen};
+            if (!buffer->Append(&entryHeader, sizeof(CheckpointUtils::EntryHeader)) ||
+                !buffer->Append(keyBuf, keyLen)) {
+                errCode = ErrCodes::MEMORY;
+                break;
+            }
+            offset += sizeof(uint16_t) + keyLen;
+        }
+
+        if (errCode != ErrCodes::SUCCESS) {
+            break;
+        }
+
+        if (!FlushBuffer(file, buffer)) {
+            errCode = ErrCodes::FILE_IO;
+            break;
+        }
+    } while (0);
+
+    if (errCode != ErrCodes::SUCCESS) {
+        MOT_LOG_ERROR("CheckpointWorkerPool::WriteTableDeletedKeysFile: failed to write file: %s", fileName.c_str());
+        buffer->Reset();
+        file->Close();
+        return errCode;
+    }
+
+    if (!file->Finish(numKeys)) {
+        MOT_LOG_ERROR("CheckpointWorkerPool::WriteTableDeletedKeysFile: failed to close file: %s", fileName.c_str());
+        return ErrCodes::FILE_IO;
+    }
+    return errCode;
+}
+
+CheckpointWorkerPool::ErrCodes CheckpointWorkerPool::LinkDeltaLevels(
+    uint32_t tableId, const std::vector<DeltaLevel>& levels)
+{
+    std::string fileName;
+    std::string linkName;
+    for (size_t i = 0; i < levels.size(); i++) {
+        uint64_t levelId = levels[i].m_checkpointId;
+        // the files of the previous checkpoint's own level carry no level prefix in its directory
+        uint64_t srcLevelId = (levelId == m_prevCheckpointId) ? 0 : levelId;
+        for (uint64_t seg = 0; seg <= levels[i].m_maxSegId; seg++) {
+            CheckpointUtils::MakeCpFilename(tableId, fileName, m_prevWorkingDir, (int)seg, srcLevelId);
+            CheckpointUtils::MakeCpFilename(tableId, linkName, m_workingDir, (int)seg, levelId);
+            if (!CheckpointUtils::LinkFile(fileName, linkName)) {
+                return ErrCodes::FILE_IO;
+            }
+        }
+
+        // the first level is a full checkpoint, without deleted keys
+        if (i > 0) {
+            CheckpointUtils::MakeDelFilename(tableId, fileName, m_prevWorkingDir, srcLevelId);
+            CheckpointUtils::MakeDelFilename(tableId, linkName, m_workingDir, levelId);
+            if (!CheckpointUtils::LinkFile(fileName, linkName)) {
+                return ErrCodes::FILE_IO;
+            }
+        }
+    }
+    return ErrCodes::SUCCESS;
+}
 }  // namespace MOT
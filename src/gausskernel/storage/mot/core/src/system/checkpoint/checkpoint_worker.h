@@ -31,13 +31,29 @@
 #include <vector>
 #include <pthread.h>
 #include <list>
+#include <map>
 #include "global.h"
 #include "buffer.h"
 #include "mm_gc_manager.h"
 
 namespace MOT {
+class CheckpointFileWriter;
+
 const int CHECKPOINT_BUFFER_SIZE = 4096 * 1000;
 
+/**
+ * @struct DeltaLevel
+ * @brief An earlier checkpoint of a table that a delta checkpoint builds on. The first level of a chain is a full
+ * checkpoint of the table, the next ones hold the rows changed since the level before and the deleted keys.
+ */
+struct DeltaLevel {
+    uint64_t m_checkpointId;
+    uint64_t m_maxSegId;
+};
+
+/** @typedef The earlier levels of the tables of a checkpoint, oldest first, by table id. */
+typedef std::map<uint32_t, std::vector<DeltaLevel>> DeltaChainMap;
+
 /**
  * @class CheckpointManagerCallbacks
  * @brief This class describes the interface for callback methods
@@ -54,6 +70,14 @@ public:
      */
     virtual void TaskDone(Table* table, uint32_t numSegs, bool success) = 0;
 
+    /**
+     * @brief Decides whether a table is checkpointed as a delta over earlier checkpoints.
+     * @param table The table's pointer.
+     * @param levels The returned earlier levels the delta builds on, oldest first.
+     * @return True if only the rows changed since the previous checkpoint should be written.
+     */
+    virtual bool GetDeltaLevels(Table* table, std::vector<DeltaLevel>& levels) = 0;
+
     /**
      * @brief Checks if the thread should terminate it work
      * @return True if the the thread should stop.
@@ -78,8 +102,16 @@ public:
  */
 class CheckpointWorkerPool {
 public:
-    CheckpointWorkerPool(int n, bool b, std::list<Table*>& l, uint32_t s, uint64_t id, CheckpointManagerCallbacks& m)
-        : m_numWorkers(n), m_tasksList(l), m_checkpointId(id), m_na(b), m_cpManager(m), m_checkpointSegsize(s)
+    CheckpointWorkerPool(int n, bool b, std::list<Table*>& l, uint32_t s, uint64_t id, uint64_t prevId, uint64_t seq,
+        CheckpointManagerCallbacks& m)
+        : m_numWorkers(n),
+          m_tasksList(l),
+          m_checkpointId(id),
+          m_prevCheckpointId(prevId),
+          m_checkpointSeq(seq),
+          m_na(b),
+          m_cpManager(m),
+          m_checkpointSegsize(s)
     {
         Start();
     }
@@ -99,24 +131,26 @@ private:
     void WorkerFunc();
 
     /**
-     * @brief Appends a row to the buffer. The buffer will be flushed in case it is full.
+     * @brief Appends a row to the buffer. The buffer will be flushed as a block in case it is full.
      * @param buffer The buffer to fill.
      * @param row The row to write.
-     * @param fd The file descriptor to write to.
+     * @param file The file to write to.
      * @return Boolean value denoting success or failure.
      */
-    bool Write(Buffer* buffer, Row* row, int fd);
+    bool Write(Buffer* buffer, Row* row, CheckpointFileWriter* file);
 
     /**
      * @brief Checkpoints a row, according to whether a stable version exists or not.
      * @param buffer The buffer to fill.
      * @param sentinel The sentinel that holds to row.
-     * @param fd The file descriptor to write to.
+     * @param file The file to write to.
      * @param threadId The thread id.
      * @param isDeleted The row delete status.
+     * @param deltaOnly Specifies whether the row is written only if it changed since the previous checkpoint.
      * @return -1 on error, 0 if nothing was written and 1 if the row was written.
      */
-    int Checkpoint(Buffer* buffer, Sentinel* sentinel, int fd, uint16_t threadId, bool& isDeleted);
+    int Checkpoint(Buffer* buffer, Sentinel* sentinel, CheckpointFileWriter* file, uint16_t threadId, bool& isDeleted,
+        bool deltaOnly);
 
     /**
      * @brief Pops a task (table pointer) from the tasks queue.
@@ -132,23 +166,22 @@ private:
 
     /**
      * @brief Initializes a checkpoint file
-     * @param fd The returned file descriptor of the file.
+     * @param file The file writer to open the file with.
      * @param tableId The table id that is checkpointed.
      * @param seg The table's segment number
      * @param exId The table's external table id
      * @return Boolean value denoting success or failure.
      */
-    bool BeginFile(int& fd, uint32_t tableId, int seg, uint64_t exId);
+    bool BeginFile(CheckpointFileWriter* file, uint32_t tableId, int seg, uint64_t exId);
 
     /**
      * @brief Updates the file's header flushes and closes it.
-     * @param fd The file descriptor of the file.
+     * @param file The file writer of the file.
      * @param tableId The table id that is checkpointed.
      * @param numOps The number of operation that were save in the file.
-     * @param exId The table's external table id
      * @return Boolean value denoting success or failure.
      */
-    bool FinishFile(int& fd, uint32_t tableId, uint64_t numOps, uint64_t exId);
+    bool FinishFile(CheckpointFileWriter* file, uint32_t tableId, uint64_t numOps);
 
     void ExecuteMicroGcTransaction(
         Sentinel** deletedList, GcManager* gcSession, Table* table, uint16_t& deletedCounter, uint16_t limit);
@@ -164,17 +197,44 @@ private:
      * @brief Writes table data to the data file.
      * @param table The table's pointer.
      * @param buffer The buffer to fill.
+     * @param file The file writer of the data files.
      * @param deletedList Array to collect the sentinels deleted rows to be cleaned.
      * @param gcSession GC manager object.
      * @param threadId The thread id.
      * @param maxSegId The maximum segment ID of the table.
      * @param numOps The number of rows written.
+     * @param isDelta Specifies whether only the rows changed since the previous checkpoint are written.
+     * @return Returns the error code of type ErrCodes.
+     */
+    ErrCodes WriteTableDataFile(Table* table, Buffer* buffer, CheckpointFileWriter* file, Sentinel** deletedList,
+        GcManager* gcSession, uint16_t threadId, uint32_t& maxSegId, uint64_t& numOps, bool isDelta);
+
+    /**
+     * @brief Writes the keys deleted from the table since the previous checkpoint to the deleted keys file.
+     * @param table The table's pointer.
+     * @param buffer The buffer to fill.
+     * @param file The file writer of the deleted keys file.
+     * @param numKeys The number of keys written.
+     * @return Returns the error code of type ErrCodes.
+     */
+    ErrCodes WriteTableDeletedKeysFile(Table* table, Buffer* buffer, CheckpointFileWriter* file, uint64_t& numKeys);
+
+    /**
+     * @brief Links the files of the earlier levels of a delta checkpoint from the previous checkpoint directory, so
+     * every checkpoint directory holds all the files needed to recover from it.
+     * @param tableId The table id.
+     * @param levels The earlier levels, oldest first.
      * @return Returns the error code of type ErrCodes.
      */
-    ErrCodes WriteTableDataFile(Table* table, Buffer* buffer, Sentinel** deletedList, GcManager* gcSession,
-        uint16_t threadId, uint32_t& maxSegId, uint64_t& numOps);
+    ErrCodes LinkDeltaLevels(uint32_t tableId, const std::vector<DeltaLevel>& levels);
 
-    bool FlushBuffer(int fd, Buffer* buffer);
+    /**
+     * @brief Writes the buffered entries as a block of the file.
+     * @param file The file to write to.
+     * @param buffer The buffer to flush.
+     * @return Boolean value denoting success or failure.
+     */
+    bool FlushBuffer(CheckpointFileWriter* file, Buffer* buffer);
 
     // Workers
     void* m_workers;
@@ -193,6 +253,15 @@ private:
     // Checkpoint's id
     uint64_t m_checkpointId;
 
+    // The previous checkpoint's id, holding the earlier delta levels
+    uint64_t m_prevCheckpointId;
+
+    // The directory of the previous checkpoint
+    std::string m_prevWorkingDir;
+
+    // Checkpoint's sequence number, its parity selects the delta dirty bit
+    uint64_t m_checkpointSeq;
+
     // The current NotAvailable bit
     bool m_na;
 
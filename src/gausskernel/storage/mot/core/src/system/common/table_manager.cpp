@@ -31,6 +31,7 @@ bool TableManager::AddTable(Table* table)
 {
     MOT_LOG_INFO(
         "Adding table %s with external id: %" PRIu64, table->GetLongTableName().c_str(), table->GetTableExId());
+    table->ComputeCatalogIdentity();
     m_rwLock.WrLock();
     InternalTableMap::iterator it = m_tablesById.find(table->GetTableId());
     if (it != m_tablesById.end()) {
@@ -43,10 +44,65 @@ bool TableManager::AddTable(Table* table)
     m_tablesById[table->GetTableId()] = table;
     m_tablesByExId[table->GetTableExId()] = table;
     m_tablesByName[table->GetLongTableName()] = table;
+    AddCatalogId(table);
+    (void)m_catalogVersion.fetch_add(1, std::memory_order_release);
     m_rwLock.WrUnlock();
     return true;
 }
 
+void TableManager::AddCatalogId(Table* table)
+{
+    uint64_t catalogId = table->GetCatalogId();
+    CatalogTableMap::iterator it = m_tablesByCatalogId.find(catalogId);
+    if (it == m_tablesByCatalogId.end()) {
+        m_tablesByCatalogId[catalogId] = table;
+        table->SetCatalogIdUnique(true);
+        return;
+    }
+
+    MOT_LOG_WARN("Catalog id %" PRIu64 " of table %s is shared with another table, rows of these tables are "
+                 "encoded by name",
+        catalogId,
+        table->GetLongTableName().c_str());
+    if (it->second != nullptr) {
+        it->second->SetCatalogIdUnique(false);
+        it->second = nullptr;
+    }
+    table->SetCatalogIdUnique(false);
+}
+
+void TableManager::RemoveCatalogId(Table* table)
+{
+    uint64_t catalogId = table->GetCatalogId();
+    CatalogTableMap::iterator it = m_tablesByCatalogId.find(catalogId);
+    if (it == m_tablesByCatalogId.end()) {
+        return;
+    }
+
+    if (it->second == table) {
+        (void)m_tablesByCatalogId.erase(it);
+        return;
+    }
+
+    if (it->second == nullptr) {
+        // identifier was ambiguous, check whether it is now owned by a single table
+        Table* owner = nullptr;
+        uint32_t ownerCount = 0;
+        for (InternalTableMap::iterator itr = m_tablesById.begin(); itr != m_tablesById.end(); ++itr) {
+            if (itr->second->GetCatalogId() == catalogId) {
+                owner = itr->second;
+                ++ownerCount;
+            }
+        }
+        if (ownerCount == 0) {
+            (void)m_tablesByCatalogId.erase(it);
+        } else if (ownerCount == 1) {
+            it->second = owner;
+            owner->SetCatalogIdUnique(true);
+        }
+    }
+}
+
 void TableManager::ClearTablesThreadMemoryCache()
 {
     m_rwLock.RdLock();
@@ -74,5 +130,47 @@ void TableManager::ClearAllTables()
     m_tablesById.clear();
     m_tablesByName.clear();
     m_tablesByExId.clear();
+    m_tablesByCatalogId.clear();
+    (void)m_catalogVersion.fetch_add(1, std::memory_order_release);
+}
+
+void TableCatalogCache::Validate()
+{
+    uint64_t catalogVersion = m_tableManager->GetCatalogVersion();
+    if (catalogVersion != m_catalogVersion) {
+        m_tablesByCatalogId.clear();
+        m_tablesByName.clear();
+        m_catalogVersion = catalogVersion;
+    }
+}
+
+Table* TableCatalogCache::GetTable(uint64_t catalogId)
+{
+    Validate();
+    std::unordered_map<uint64_t, Table*>::iterator it = m_tablesByCatalogId.find(catalogId);
+    if (it != m_tablesByCatalogId.end()) {
+        return it->second;
+    }
+
+    Table* table = m_tableManager->GetTableByCatalogId(catalogId);
+    if (table != nullptr) {
+        m_tablesByCatalogId[catalogId] = table;
+    }
+    return table;
+}
+
+Table* TableCatalogCache::GetTable(const std::string& name)
+{
+    Validate();
+    std::unordered_map<std::string, Table*>::iterator it = m_tablesByName.find(name);
+    if (it != m_tablesByName.end()) {
+        return it->second;
+    }
+
+    Table* table = m_tableManager->GetTable(name);
+    if (table != nullptr) {
+        m_tablesByName[name] = table;
+    }
+    return table;
 }
 }  // namespace MOT
@@ -31,9 +31,12 @@
 #include "rw_lock.h"
 
 #include <stdint.h>
+#include <atomic>
 #include <map>
 #include <list>
 #include <mutex>
+#include <string>
+#include <unordered_map>
 
 namespace MOT {
 /**
@@ -42,7 +45,7 @@ namespace MOT {
  */
 class TableManager {
 public:
-    TableManager()
+    TableManager() : m_catalogVersion(0)
     {}
     ~TableManager()
     {}
@@ -180,6 +183,32 @@ public:
         return GetTable(nameStr);
     }
 
+    /**
+     * @brief Retrieves a table by its catalog identifier (see @ref Table::GetCatalogId).
+     * @param catalogId The catalog identifier of the table to retrieve.
+     * @return The table object or null pointer if not found, or if the identifier is shared by several tables.
+     */
+    inline Table* GetTableByCatalogId(uint64_t catalogId)
+    {
+        Table* table = nullptr;
+        m_rwLock.RdLock();
+        CatalogTableMap::iterator it = m_tablesByCatalogId.find(catalogId);
+        if (it != m_tablesByCatalogId.end()) {
+            table = it->second;
+        }
+        m_rwLock.RdUnlock();
+        return table;
+    }
+
+    /**
+     * @brief Retrieves the catalog version, which changes each time a table is added or dropped.
+     * @return The catalog version.
+     */
+    inline uint64_t GetCatalogVersion() const
+    {
+        return m_catalogVersion.load(std::memory_order_acquire);
+    }
+
     /**
      * @brief Adds the pointers of all tables into a list.
      * @param[out] tablesQueue Receives all the tables.
@@ -216,11 +245,27 @@ private:
         m_tablesById.erase(table->GetTableId());
         m_tablesByExId.erase(table->GetTableExId());
         m_tablesByName.erase(table->GetLongTableName());
+        RemoveCatalogId(table);
+        (void)m_catalogVersion.fetch_add(1, std::memory_order_release);
         m_rwLock.WrUnlock();
         sessionContext->GetTxnManager()->RemoveTableFromStat(table);
         return table->DropImpl();
     }
 
+    /**
+     * @brief Registers the catalog identifier of a newly added table. If the identifier is already taken, it is
+     * marked as ambiguous and tables sharing it can be resolved only by name. Caller must hold the write lock.
+     * @param table The table being added.
+     */
+    void AddCatalogId(Table* table);
+
+    /**
+     * @brief Unregisters the catalog identifier of a dropped table (already removed from the internal identifier
+     * map). Caller must hold the write lock.
+     * @param table The table being dropped.
+     */
+    void RemoveCatalogId(Table* table);
+
     /** @typedef internal table map */
     typedef std::map<uint32_t, Table*> InternalTableMap;
 
@@ -239,11 +284,66 @@ private:
     /* @var Table map indexed by name. */
     NameTableMap m_tablesByName;
 
-    /** @var Synchronize table insert/delete in 3 concurrent maps. */
+    /** @typedef catalog identifier table map (null value denotes an ambiguous identifier) */
+    typedef std::map<uint64_t, Table*> CatalogTableMap;
+
+    /** @var Table map indexed by catalog identifier. */
+    CatalogTableMap m_tablesByCatalogId;
+
+    /** @var Synchronize table insert/delete in 4 concurrent maps. */
     RwLock m_rwLock;
 
+    /** @var Catalog version, incremented on each table addition or removal. */
+    std::atomic<uint64_t> m_catalogVersion;
+
     DECLARE_CLASS_LOGGER()
 };
+
+/**
+ * @class TableCatalogCache
+ * @brief A single-threaded cache of table lookups by catalog identifier and by name. Hits do not take the table
+ * manager lock. The cache is flushed whenever the catalog version of the table manager changes (i.e. on DDL).
+ * @note Each thread should use its own cache object.
+ */
+class TableCatalogCache {
+public:
+    explicit TableCatalogCache(TableManager* tableManager)
+        : m_tableManager(tableManager), m_catalogVersion(tableManager->GetCatalogVersion())
+    {}
+
+    ~TableCatalogCache()
+    {}
+
+    /**
+     * @brief Retrieves a table by its catalog identifier.
+     * @param catalogId The catalog identifier.
+     * @return The table object or null pointer if not found (or ambiguous).
+     */
+    Table* GetTable(uint64_t catalogId);
+
+    /**
+     * @brief Retrieves a table by its long name.
+     * @param name The long table name.
+     * @return The table object or null pointer if not found.
+     */
+    Table* GetTable(const std::string& name);
+
+private:
+    /** @brief Flushes the cache if the catalog changed since it was last validated. */
+    void Validate();
+
+    /** @var The table manager. */
+    TableManager* m_tableManager;
+
+    /** @var The catalog version with which the cache contents are consistent. */
+    uint64_t m_catalogVersion;
+
+    /** @var Cached tables by catalog identifier. */
+    std::unordered_map<uint64_t, Table*> m_tablesByCatalogId;
+
+    /** @var Cached tables by name. */
+    std::unordered_map<std::string, Table*> m_tablesByName;
+};
 }  // namespace MOT
 
 #endif /* TABLE_MANAGER_H */
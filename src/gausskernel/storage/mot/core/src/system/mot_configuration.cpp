@@ -46,6 +46,9 @@ constexpr uint64_t MOTConfiguration::SCALE_SECONDS;
 // redo-log configuration members
 constexpr bool MOTConfiguration::DEFAULT_ENABLE_REDO_LOG;
 constexpr LoggerType MOTConfiguration::DEFAULT_LOGGER_TYPE;
+constexpr uint32_t MOTConfiguration::DEFAULT_NATIVE_LOG_STREAMS;
+constexpr uint32_t MOTConfiguration::MIN_NATIVE_LOG_STREAMS;
+constexpr uint32_t MOTConfiguration::MAX_NATIVE_LOG_STREAMS;
 constexpr RedoLogHandlerType MOTConfiguration::DEFAULT_REDO_LOG_HANDLER_TYPE;
 constexpr uint32_t MOTConfiguration::DEFAULT_ASYNC_REDO_LOG_BUFFER_ARRAY_COUNT;
 constexpr uint32_t MOTConfiguration::MIN_ASYNC_REDO_LOG_BUFFER_ARRAY_COUNT;
@@ -58,6 +61,11 @@ constexpr const char* MOTConfiguration::DEFAULT_GROUP_COMMIT_TIMEOUT;
 constexpr uint64_t MOTConfiguration::DEFAULT_GROUP_COMMIT_TIMEOUT_USEC;
 constexpr uint64_t MOTConfiguration::MIN_GROUP_COMMIT_TIMEOUT_USEC;
 constexpr uint64_t MOTConfiguration::MAX_GROUP_COMMIT_TIMEOUT_USEC;
+constexpr bool MOTConfiguration::DEFAULT_ENABLE_ADAPTIVE_GROUP_COMMIT;
+constexpr const char* MOTConfiguration::DEFAULT_GROUP_COMMIT_LATENCY_SLO;
+constexpr uint64_t MOTConfiguration::DEFAULT_GROUP_COMMIT_LATENCY_SLO_USEC;
+constexpr uint64_t MOTConfiguration::MIN_GROUP_COMMIT_LATENCY_SLO_USEC;
+constexpr uint64_t MOTConfiguration::MAX_GROUP_COMMIT_LATENCY_SLO_USEC;
 // checkpoint configuration members
 constexpr bool MOTConfiguration::DEFAULT_ENABLE_CHECKPOINT;
 constexpr bool MOTConfiguration::DEFAULT_ENABLE_INCREMENTAL_CHECKPOINT;
@@ -69,10 +77,19 @@ constexpr uint64_t MOTConfiguration::MAX_CHECKPOINT_SEGSIZE_BYTES;
 constexpr uint32_t MOTConfiguration::DEFAULT_CHECKPOINT_WORKERS;
 constexpr uint32_t MOTConfiguration::MIN_CHECKPOINT_WORKERS;
 constexpr uint32_t MOTConfiguration::MAX_CHECKPOINT_WORKERS;
+constexpr bool MOTConfiguration::DEFAULT_ENABLE_DELTA_CHECKPOINT;
+constexpr uint32_t MOTConfiguration::DEFAULT_DELTA_CHECKPOINT_FULL_INTERVAL;
+constexpr uint32_t MOTConfiguration::MIN_DELTA_CHECKPOINT_FULL_INTERVAL;
+constexpr uint32_t MOTConfiguration::MAX_DELTA_CHECKPOINT_FULL_INTERVAL;
+constexpr const char* MOTConfiguration::DEFAULT_CHECKPOINT_COMPRESSION;
+constexpr bool MOTConfiguration::DEFAULT_ENABLE_CHECKPOINT_DIRECT_IO;
 // recovery configuration members
 constexpr uint32_t MOTConfiguration::DEFAULT_CHECKPOINT_RECOVERY_WORKERS;
 constexpr uint32_t MOTConfiguration::MIN_CHECKPOINT_RECOVERY_WORKERS;
 constexpr uint32_t MOTConfiguration::MAX_CHECKPOINT_RECOVERY_WORKERS;
+constexpr uint32_t MOTConfiguration::DEFAULT_REDO_RECOVERY_WORKERS;
+constexpr uint32_t MOTConfiguration::MIN_REDO_RECOVERY_WORKERS;
+constexpr uint32_t MOTConfiguration::MAX_REDO_RECOVERY_WORKERS;
 constexpr bool MOTConfiguration::DEFAULT_ENABLE_LOG_RECOVERY_STATS;
 // machine configuration members
 constexpr uint16_t MOTConfiguration::DEFAULT_NUMA_NODES;
@@ -138,6 +155,7 @@ constexpr uint64_t MOTConfiguration::MAX_MIN_MOT_SESSION_MEMORY_KB;
 constexpr MemReserveMode MOTConfiguration::DEFAULT_RESERVE_MEMORY_MODE;
 constexpr MemStorePolicy MOTConfiguration::DEFAULT_STORE_MEMORY_POLICY;
 constexpr MemAllocPolicy MOTConfiguration::DEFAULT_CHUNK_ALLOC_POLICY;
+constexpr MemHugePageMode MOTConfiguration::DEFAULT_CHUNK_HUGE_PAGE_MODE;
 constexpr uint32_t MOTConfiguration::DEFAULT_CHUNK_PREALLOC_WORKER_COUNT;
 constexpr uint32_t MOTConfiguration::MIN_CHUNK_PREALLOC_WORKER_COUNT;
 constexpr uint32_t MOTConfiguration::MAX_CHUNK_PREALLOC_WORKER_COUNT;
@@ -179,6 +197,11 @@ constexpr uint32_t MOTConfiguration::MAX_MOT_CODEGEN_LIMIT;
 // storage configuration
 constexpr bool MOTConfiguration::DEFAULT_ALLOW_INDEX_ON_NULLABLE_COLUMN;
 constexpr IndexTreeFlavor MOTConfiguration::DEFAULT_INDEX_TREE_FLAVOR;
+constexpr bool MOTConfiguration::DEFAULT_ENABLE_ROW_VERSIONS;
+constexpr IndexingMethod MOTConfiguration::DEFAULT_PRIMARY_INDEXING_METHOD;
+constexpr bool MOTConfiguration::DEFAULT_ENABLE_VECTORIZED_SCAN;
+constexpr bool MOTConfiguration::DEFAULT_ENABLE_COMPACT_ROW_ENCODING;
+constexpr bool MOTConfiguration::DEFAULT_ENABLE_REMOTE_READ;
 // general configuration members
 constexpr const char* MOTConfiguration::DEFAULT_CFG_MONITOR_PERIOD;
 constexpr uint64_t MOTConfiguration::DEFAULT_CFG_MONITOR_PERIOD_SECONDS;
@@ -245,6 +268,19 @@ static bool ParseIndexTreeFlavor(const std::string& cfgName, const std::string&
     return result;
 }
 
+static bool ParseIndexingMethod(const std::string& cfgName, const std::string& variableName,
+    const std::string& newValue, IndexingMethod* variableValue)
+{
+    bool result = (cfgName == variableName);
+    if (result) {
+        *variableValue = IndexingMethodFromString(newValue.c_str());
+        if (*variableValue == IndexingMethod::INDEXING_METHOD_INVALID) {
+            result = false;
+        }
+    }
+    return result;
+}
+
 static bool ParseRedoLogHandlerType(const std::string& cfgName, const std::string& variableName,
     const std::string& newValue, RedoLogHandlerType* variableValue)
 {
@@ -353,6 +389,16 @@ static bool ParseChunkAllocPolicy(const std::string& cfgName, const std::string&
     return result;
 }
 
+static bool ParseChunkHugePageMode(const std::string& cfgName, const std::string& variableName,
+    const std::string& newValue, MemHugePageMode* variableValue)
+{
+    bool result = (cfgName == variableName);
+    if (result) {
+        *variableValue = MemHugePageModeFromString(newValue.c_str());
+    }
+    return result;
+}
+
 bool MOTConfiguration::FindNumaNodes(int* maxNodes)
 {
     int error = MotSysNumaAvailable();
@@ -441,17 +487,25 @@ void MOTConfiguration::SetMaskToAllCoresinNumaSocket2(cpu_set_t& mask, int nodeI
 MOTConfiguration::MOTConfiguration()
     : m_enableRedoLog(DEFAULT_ENABLE_REDO_LOG),
       m_loggerType(DEFAULT_LOGGER_TYPE),
+      m_nativeLogStreams(DEFAULT_NATIVE_LOG_STREAMS),
       m_redoLogHandlerType(DEFAULT_REDO_LOG_HANDLER_TYPE),
       m_asyncRedoLogBufferArrayCount(DEFAULT_ASYNC_REDO_LOG_BUFFER_ARRAY_COUNT),
       m_enableGroupCommit(DEFAULT_ENABLE_GROUP_COMMIT),
       m_groupCommitSize(DEFAULT_GROUP_COMMIT_SIZE),
       m_groupCommitTimeoutUSec(DEFAULT_GROUP_COMMIT_TIMEOUT_USEC),
+      m_enableAdaptiveGroupCommit(DEFAULT_ENABLE_ADAPTIVE_GROUP_COMMIT),
+      m_groupCommitLatencySloUSec(DEFAULT_GROUP_COMMIT_LATENCY_SLO_USEC),
       m_enableCheckpoint(DEFAULT_ENABLE_CHECKPOINT),
       m_enableIncrementalCheckpoint(DEFAULT_ENABLE_INCREMENTAL_CHECKPOINT),
       m_checkpointDir(DEFAULT_CHECKPOINT_DIR),
       m_checkpointSegThreshold(DEFAULT_CHECKPOINT_SEGSIZE_BYTES),
       m_checkpointWorkers(DEFAULT_CHECKPOINT_WORKERS),
+      m_enableDeltaCheckpoint(DEFAULT_ENABLE_DELTA_CHECKPOINT),
+      m_deltaCheckpointFullInterval(DEFAULT_DELTA_CHECKPOINT_FULL_INTERVAL),
+      m_checkpointCompression(DEFAULT_CHECKPOINT_COMPRESSION),
+      m_enableCheckpointDirectIo(DEFAULT_ENABLE_CHECKPOINT_DIRECT_IO),
       m_checkpointRecoveryWorkers(DEFAULT_CHECKPOINT_RECOVERY_WORKERS),
+      m_redoRecoveryWorkers(DEFAULT_REDO_RECOVERY_WORKERS),
       m_abortBufferEnable(true),
       m_preAbort(true),
       m_validationLock(TxnValidation::TXN_VALIDATION_NO_WAIT),
@@ -490,6 +544,7 @@ MOTConfiguration::MOTConfiguration()
       m_reserveMemoryMode(DEFAULT_RESERVE_MEMORY_MODE),
       m_storeMemoryPolicy(DEFAULT_STORE_MEMORY_POLICY),
       m_chunkAllocPolicy(DEFAULT_CHUNK_ALLOC_POLICY),
+      m_chunkHugePageMode(DEFAULT_CHUNK_HUGE_PAGE_MODE),
       m_chunkPreallocWorkerCount(DEFAULT_CHUNK_PREALLOC_WORKER_COUNT),
       m_highRedMarkPercent(DEFAULT_HIGH_RED_MARK_PERCENT),
       m_sessionLargeBufferStoreSizeMB(DEFAULT_SESSION_LARGE_BUFFER_STORE_SIZE_MB),
@@ -505,6 +560,11 @@ MOTConfiguration::MOTConfiguration()
       m_codegenLimit(DEFAULT_MOT_CODEGEN_LIMIT),
       m_allowIndexOnNullableColumn(DEFAULT_ALLOW_INDEX_ON_NULLABLE_COLUMN),
       m_indexTreeFlavor(DEFAULT_INDEX_TREE_FLAVOR),
+      m_enableRowVersions(DEFAULT_ENABLE_ROW_VERSIONS),
+      m_primaryIndexingMethod(DEFAULT_PRIMARY_INDEXING_METHOD),
+      m_enableVectorizedScan(DEFAULT_ENABLE_VECTORIZED_SCAN),
+      m_enableCompactRowEncoding(DEFAULT_ENABLE_COMPACT_ROW_ENCODING),
+      m_enableRemoteRead(DEFAULT_ENABLE_REMOTE_READ),
       m_configMonitorPeriodSeconds(DEFAULT_CFG_MONITOR_PERIOD_SECONDS),
       m_runInternalConsistencyValidation(DEFAULT_RUN_INTERNAL_CONSISTENCY_VALIDATION),
       m_totalMemoryMb(DEFAULT_TOTAL_MEMORY_MB),
@@ -546,17 +606,25 @@ bool MOTConfiguration::SetFlag(const std::string& name, const std::string& value
 
     if (ParseBool(name, "enable_redo_log", value, &m_enableRedoLog)) {
     } else if (ParseLoggerType(name, "logger_type", value, &m_loggerType)) {
+    } else if (ParseUint32(name, "native_log_streams", value, &m_nativeLogStreams)) {
     } else if (ParseRedoLogHandlerType(name, "redo_log_handler_type", value, &m_redoLogHandlerType)) {
     } else if (ParseUint32(name, "async_log_buffer_count", value, &m_asyncRedoLogBufferArrayCount)) {
     } else if (ParseBool(name, "enable_group_commit", value, &m_enableGroupCommit)) {
     } else if (ParseUint64(name, "group_commit_size", value, &m_groupCommitSize)) {
     } else if (ParseUint64(name, "group_commit_timeout_usec", value, &m_groupCommitTimeoutUSec)) {
+    } else if (ParseBool(name, "enable_adaptive_group_commit", value, &m_enableAdaptiveGroupCommit)) {
+    } else if (ParseUint64(name, "group_commit_latency_slo_usec", value, &m_groupCommitLatencySloUSec)) {
     } else if (ParseBool(name, "enable_checkpoint", value, &m_enableCheckpoint)) {
     } else if (ParseBool(name, "enable_incremental_checkpoint", value, &m_enableIncrementalCheckpoint)) {
     } else if (ParseString(name, "checkpoint_dir", value, &m_checkpointDir)) {
     } else if (ParseUint64(name, "checkpoint_segsize", value, &m_checkpointSegThreshold)) {
     } else if (ParseUint32(name, "checkpoint_workers", value, &m_checkpointWorkers)) {
+    } else if (ParseBool(name, "enable_delta_checkpoint", value, &m_enableDeltaCheckpoint)) {
+    } else if (ParseUint32(name, "delta_checkpoint_full_interval", value, &m_deltaCheckpointFullInterval)) {
+    } else if (ParseString(name, "checkpoint_compression", value, &m_checkpointCompression)) {
+    } else if (ParseBool(name, "enable_checkpoint_direct_io", value, &m_enableCheckpointDirectIo)) {
     } else if (ParseUint32(name, "checkpoint_recovery_workers", value, &m_checkpointRecoveryWorkers)) {
+    } else if (ParseUint32(name, "redo_recovery_workers", value, &m_redoRecoveryWorkers)) {
     } else if (ParseBool(name, "abort_buffer_enable", value, &m_abortBufferEnable)) {
     } else if (ParseBool(name, "pre_abort", value, &m_preAbort)) {
     } else if (ParseValidation(name, "validation_lock", value, &m_validationLock)) {
@@ -590,6 +658,7 @@ bool MOTConfiguration::SetFlag(const std::string& name, const std::string& value
     } else if (ParseMemoryReserveMode(name, "reserve_memory_mode", value, &m_reserveMemoryMode)) {
     } else if (ParseMemoryStorePolicy(name, "store_memory_policy", value, &m_storeMemoryPolicy)) {
     } else if (ParseChunkAllocPolicy(name, "chunk_alloc_policy", value, &m_chunkAllocPolicy)) {
+    } else if (ParseChunkHugePageMode(name, "chunk_huge_pages", value, &m_chunkHugePageMode)) {
     } else if (ParseUint32(name, "chunk_prealloc_worker_count", value, &m_chunkPreallocWorkerCount)) {
     } else if (ParseUint32(name, "high_red_mark_percent", value, &m_highRedMarkPercent)) {
     } else if (ParseUint64(name, "session_large_buffer_store_size_mb", value, &m_sessionLargeBufferStoreSizeMB)) {
@@ -604,6 +673,11 @@ bool MOTConfiguration::SetFlag(const std::string& name, const std::string& value
     } else if (ParseUint32(name, "mot_codegen_limit", value, &m_codegenLimit)) {
     } else if (ParseBool(name, "allow_index_on_nullable_column", value, &m_allowIndexOnNullableColumn)) {
     } else if (ParseIndexTreeFlavor(name, "index_tree_flavor", value, &m_indexTreeFlavor)) {
+    } else if (ParseBool(name, "enable_row_versions", value, &m_enableRowVersions)) {
+    } else if (ParseIndexingMethod(name, "primary_index_method", value, &m_primaryIndexingMethod)) {
+    } else if (ParseBool(name, "enable_vectorized_scan", value, &m_enableVectorizedScan)) {
+    } else if (ParseBool(name, "enable_compact_row_encoding", value, &m_enableCompactRowEncoding)) {
+    } else if (ParseBool(name, "enable_remote_read", value, &m_enableRemoteRead)) {
     } else if (ParseUint64(name, "config_monitor_period_seconds", value, &m_configMonitorPeriodSeconds)) {
     } else if (ParseBool(name, "run_internal_consistency_validation", value, &m_runInternalConsistencyValidation)) {
     } else {
@@ -845,6 +919,7 @@ void MOTConfiguration::LoadMemConfig()
     UPDATE_USER_CFG(m_reserveMemoryMode, "reserve_memory_mode", DEFAULT_RESERVE_MEMORY_MODE);
     UPDATE_USER_CFG(m_storeMemoryPolicy, "store_memory_policy", DEFAULT_STORE_MEMORY_POLICY);
     UPDATE_USER_CFG(m_chunkAllocPolicy, "chunk_alloc_policy", DEFAULT_CHUNK_ALLOC_POLICY);
+    UPDATE_USER_CFG(m_chunkHugePageMode, "chunk_huge_pages", DEFAULT_CHUNK_HUGE_PAGE_MODE);
     UPDATE_INT_CFG(m_chunkPreallocWorkerCount,
         "chunk_prealloc_worker_count",
         DEFAULT_CHUNK_PREALLOC_WORKER_COUNT,
@@ -885,8 +960,13 @@ void MOTConfiguration::LoadConfig()
     // logger configuration
     if (m_loadExtraParams) {
         UPDATE_BOOL_CFG(m_enableRedoLog, "enable_redo_log", DEFAULT_ENABLE_REDO_LOG);
-        UPDATE_USER_CFG(m_loggerType, "logger_type", DEFAULT_LOGGER_TYPE);
     }
+    UPDATE_USER_CFG(m_loggerType, "logger_type", DEFAULT_LOGGER_TYPE);
+    UPDATE_INT_CFG(m_nativeLogStreams,
+        "native_log_streams",
+        DEFAULT_NATIVE_LOG_STREAMS,
+        MIN_NATIVE_LOG_STREAMS,
+        MAX_NATIVE_LOG_STREAMS);
 
     // Even though we allow loading this unexposed parameter (redo_log_handler_type), in reality it is always
     // overridden by the external configuration loader GaussdbConfigLoader (so in effect whatever is defined in
@@ -911,6 +991,14 @@ void MOTConfiguration::LoadConfig()
         SCALE_MICROS,
         MIN_GROUP_COMMIT_TIMEOUT_USEC,
         MAX_GROUP_COMMIT_TIMEOUT_USEC);
+    UPDATE_BOOL_CFG(
+        m_enableAdaptiveGroupCommit, "enable_adaptive_group_commit", DEFAULT_ENABLE_ADAPTIVE_GROUP_COMMIT);
+    UPDATE_TIME_CFG(m_groupCommitLatencySloUSec,
+        "group_commit_latency_slo",
+        DEFAULT_GROUP_COMMIT_LATENCY_SLO,
+        SCALE_MICROS,
+        MIN_GROUP_COMMIT_LATENCY_SLO_USEC,
+        MAX_GROUP_COMMIT_LATENCY_SLO_USEC);
 
     // Checkpoint configuration
     if (m_loadExtraParams) {
@@ -936,6 +1024,23 @@ void MOTConfiguration::LoadConfig()
         DEFAULT_CHECKPOINT_WORKERS,
         MIN_CHECKPOINT_WORKERS,
         MAX_CHECKPOINT_WORKERS);
+    UPDATE_BOOL_CFG(m_enableDeltaCheckpoint, "enable_delta_checkpoint", DEFAULT_ENABLE_DELTA_CHECKPOINT);
+    UPDATE_INT_CFG(m_deltaCheckpointFullInterval,
+        "delta_checkpoint_full_interval",
+        DEFAULT_DELTA_CHECKPOINT_FULL_INTERVAL,
+        MIN_DELTA_CHECKPOINT_FULL_INTERVAL,
+        MAX_DELTA_CHECKPOINT_FULL_INTERVAL);
+    UPDATE_STRING_CFG(m_checkpointCompression, "checkpoint_compression", DEFAULT_CHECKPOINT_COMPRESSION);
+    if (m_checkpointCompression != "none" && m_checkpointCompression != "lz4" && m_checkpointCompression != "zstd") {
+        if (m_suppressLog == 0) {
+            MOT_LOG_WARN("Invalid checkpoint_compression '%s', using '%s'",
+                m_checkpointCompression.c_str(),
+                DEFAULT_CHECKPOINT_COMPRESSION);
+        }
+        UpdateStringConfigItem(m_checkpointCompression, DEFAULT_CHECKPOINT_COMPRESSION, "checkpoint_compression");
+    }
+    UPDATE_BOOL_CFG(
+        m_enableCheckpointDirectIo, "enable_checkpoint_direct_io", DEFAULT_ENABLE_CHECKPOINT_DIRECT_IO);
 
     // Recovery configuration
     UPDATE_INT_CFG(m_checkpointRecoveryWorkers,
@@ -943,6 +1048,11 @@ void MOTConfiguration::LoadConfig()
         DEFAULT_CHECKPOINT_RECOVERY_WORKERS,
         MIN_CHECKPOINT_RECOVERY_WORKERS,
         MAX_CHECKPOINT_RECOVERY_WORKERS);
+    UPDATE_INT_CFG(m_redoRecoveryWorkers,
+        "redo_recovery_workers",
+        DEFAULT_REDO_RECOVERY_WORKERS,
+        MIN_REDO_RECOVERY_WORKERS,
+        MAX_REDO_RECOVERY_WORKERS);
 
     // Tx configuration - not configurable yet
     if (m_loadExtraParams) {
@@ -1021,6 +1131,12 @@ void MOTConfiguration::LoadConfig()
             m_allowIndexOnNullableColumn, "allow_index_on_nullable_column", DEFAULT_ALLOW_INDEX_ON_NULLABLE_COLUMN);
         UPDATE_USER_CFG(m_indexTreeFlavor, "index_tree_flavor", DEFAULT_INDEX_TREE_FLAVOR);
     }
+    UPDATE_BOOL_CFG(m_enableRowVersions, "enable_row_versions", DEFAULT_ENABLE_ROW_VERSIONS);
+    UPDATE_USER_CFG(m_primaryIndexingMethod, "primary_index_method", DEFAULT_PRIMARY_INDEXING_METHOD);
+    UPDATE_BOOL_CFG(m_enableVectorizedScan, "enable_vectorized_scan", DEFAULT_ENABLE_VECTORIZED_SCAN);
+    UPDATE_BOOL_CFG(
+        m_enableCompactRowEncoding, "enable_compact_row_encoding", DEFAULT_ENABLE_COMPACT_ROW_ENCODING);
+    UPDATE_BOOL_CFG(m_enableRemoteRead, "enable_remote_read", DEFAULT_ENABLE_REMOTE_READ);
 
     // general configuration
     if (m_loadExtraParams) {
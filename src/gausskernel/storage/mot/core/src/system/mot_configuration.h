@@ -139,9 +139,12 @@ public:
     /** Enable redo log mechanism. */
     bool m_enableRedoLog;
 
-    /** The type of logger being used (not configurable). */
+    /** The type of logger being used (envelope WAL or native MOT log files). */
     LoggerType m_loggerType;
 
+    /** The number of log streams written in parallel by the native logger (zero for one per NUMA node). */
+    uint32_t m_nativeLogStreams;
+
     /** Determines the redo log handler type (not configurable, but derived). */
     RedoLogHandlerType m_redoLogHandlerType;
 
@@ -160,6 +163,15 @@ public:
     /** @var Timeout in micro-seconds of timed group commit flush policies. */
     uint64_t m_groupCommitTimeoutUSec;
 
+    /**
+     * @var Enables sizing commit groups from the observed commit arrival rate and log flush latency. The group size
+     * and timeout configured above then serve as upper bounds.
+     */
+    bool m_enableAdaptiveGroupCommit;
+
+    /** @var Target commit latency in micro-seconds (group wait plus log flush) of adaptive group commit. */
+    uint64_t m_groupCommitLatencySloUSec;
+
     /**********************************************************************/
     // Checkpoint configuration
     /**********************************************************************/
@@ -178,6 +190,18 @@ public:
     /** @var number of worker threads to spawn to perform checkpoint. */
     uint32_t m_checkpointWorkers;
 
+    /** @var Enable delta checkpoints, persisting only the rows changed since the previous checkpoint. */
+    bool m_enableDeltaCheckpoint;
+
+    /** @var The number of checkpoints a table is chained over before it is written in full again. */
+    uint32_t m_deltaCheckpointFullInterval;
+
+    /** @var The codec checkpoint data blocks are compressed with (none, lz4 or zstd). */
+    std::string m_checkpointCompression;
+
+    /** @var Write and read checkpoint data files with direct I/O, bypassing the page cache. */
+    bool m_enableCheckpointDirectIo;
+
     /**********************************************************************/
     // Recovery configuration
     /**********************************************************************/
@@ -185,6 +209,9 @@ public:
     /** @var Specifies the number of workers used to recover from checkpoint. */
     uint32_t m_checkpointRecoveryWorkers;
 
+    /** @var Specifies the number of workers used to replay the redo log. A single worker replays on the caller. */
+    uint32_t m_redoRecoveryWorkers;
+
     /**********************************************************************/
     // Transaction management variables (not configurable)
     /**********************************************************************/
@@ -310,6 +337,9 @@ public:
     /** @var Specifies the chunk allocation policy for the global chunk pools. */
     MemAllocPolicy m_chunkAllocPolicy;
 
+    /** @var Specifies whether chunks of the global and local chunk pools are mapped with huge pages. */
+    MemHugePageMode m_chunkHugePageMode;
+
     /** @var The number of worker threads used to allocate memory chunks for initial memory reservation. */
     uint32_t m_chunkPreallocWorkerCount;
 
@@ -364,6 +394,21 @@ public:
     /** @var Specifies the tree flavor for tree indexes. */
     IndexTreeFlavor m_indexTreeFlavor;
 
+    /** @var Specifies whether replaced rows are kept as versions for snapshot reads. */
+    bool m_enableRowVersions;
+
+    /** @var Specifies the indexing method of primary keys (tree or hash). */
+    IndexingMethod m_primaryIndexingMethod;
+
+    /** @var Specifies whether read-only scans may be planned as vectorized batch scans. */
+    bool m_enableVectorizedScan;
+
+    /** @var Specifies whether TaaS rows of tables with a unique catalog id are encoded without the table name. */
+    bool m_enableCompactRowEncoding;
+
+    /** @var Specifies whether unique primary key lookups of keys missing locally are served by a storage node. */
+    bool m_enableRemoteRead;
+
     /**********************************************************************/
     // General configuration
     /**********************************************************************/
@@ -422,6 +467,11 @@ public:
     /** @var Default logger type. */
     static constexpr LoggerType DEFAULT_LOGGER_TYPE = LoggerType::EXTERNAL_LOGGER;
 
+    /** @var Default number of native log streams. */
+    static constexpr uint32_t DEFAULT_NATIVE_LOG_STREAMS = 0;
+    static constexpr uint32_t MIN_NATIVE_LOG_STREAMS = 0;
+    static constexpr uint32_t MAX_NATIVE_LOG_STREAMS = 256;
+
     /** @var Default redo log handler type. */
     static constexpr RedoLogHandlerType DEFAULT_REDO_LOG_HANDLER_TYPE = RedoLogHandlerType::SYNC_REDO_LOG_HANDLER;
 
@@ -444,6 +494,17 @@ public:
     static constexpr uint64_t MIN_GROUP_COMMIT_TIMEOUT_USEC = 100;
     static constexpr uint64_t MAX_GROUP_COMMIT_TIMEOUT_USEC = 200000;  // 200 ms
 
+    /** @var Default enable adaptive group commit. */
+    static constexpr bool DEFAULT_ENABLE_ADAPTIVE_GROUP_COMMIT = false;
+
+    /** @var Default adaptive group commit latency target. */
+    static constexpr const char* DEFAULT_GROUP_COMMIT_LATENCY_SLO = "2 ms";
+
+    /** @var Default adaptive group commit latency target in micro-seconds. */
+    static constexpr uint64_t DEFAULT_GROUP_COMMIT_LATENCY_SLO_USEC = 2000;
+    static constexpr uint64_t MIN_GROUP_COMMIT_LATENCY_SLO_USEC = 100;
+    static constexpr uint64_t MAX_GROUP_COMMIT_LATENCY_SLO_USEC = 200000;  // 200 ms
+
     /** ------------------ Default Checkpoint Configuration ------------ */
     /** @var Default enable checkpoint. */
     static constexpr bool DEFAULT_ENABLE_CHECKPOINT = true;
@@ -465,12 +526,31 @@ public:
     static constexpr uint32_t MIN_CHECKPOINT_WORKERS = 1;
     static constexpr uint32_t MAX_CHECKPOINT_WORKERS = 1024;
 
+    /** @var Default enable delta checkpoint. */
+    static constexpr bool DEFAULT_ENABLE_DELTA_CHECKPOINT = false;
+
+    /** @var Default number of chained checkpoints between full checkpoints of a table. */
+    static constexpr uint32_t DEFAULT_DELTA_CHECKPOINT_FULL_INTERVAL = 8;
+    static constexpr uint32_t MIN_DELTA_CHECKPOINT_FULL_INTERVAL = 1;
+    static constexpr uint32_t MAX_DELTA_CHECKPOINT_FULL_INTERVAL = 64;
+
+    /** @var Default checkpoint block compression. */
+    static constexpr const char* DEFAULT_CHECKPOINT_COMPRESSION = "lz4";
+
+    /** @var Default enable checkpoint direct I/O. */
+    static constexpr bool DEFAULT_ENABLE_CHECKPOINT_DIRECT_IO = true;
+
     /** ------------------ Default Recovery Configuration ------------ */
     /** @var Default number of workers used in recovery from checkpoint. */
     static constexpr uint32_t DEFAULT_CHECKPOINT_RECOVERY_WORKERS = 3;
     static constexpr uint32_t MIN_CHECKPOINT_RECOVERY_WORKERS = 1;
     static constexpr uint32_t MAX_CHECKPOINT_RECOVERY_WORKERS = 1024;
 
+    /** @var Default number of workers used to replay the redo log. */
+    static constexpr uint32_t DEFAULT_REDO_RECOVERY_WORKERS = 1;
+    static constexpr uint32_t MIN_REDO_RECOVERY_WORKERS = 1;
+    static constexpr uint32_t MAX_REDO_RECOVERY_WORKERS = 64;
+
     /** @var Default enable log recovery statistics. */
     static constexpr bool DEFAULT_ENABLE_LOG_RECOVERY_STATS = false;
 
@@ -606,6 +686,7 @@ public:
 
     /** @var Default chunk allocation policy for global chunk pools. */
     static constexpr MemAllocPolicy DEFAULT_CHUNK_ALLOC_POLICY = MEM_ALLOC_POLICY_AUTO;
+    static constexpr MemHugePageMode DEFAULT_CHUNK_HUGE_PAGE_MODE = MEM_HUGE_PAGE_NONE;
 
     /** @var Default number of workers used to pre-allocate initial memory.  */
     static constexpr uint32_t DEFAULT_CHUNK_PREALLOC_WORKER_COUNT = 8;
@@ -678,6 +759,21 @@ public:
     /** @var The default tree flavor for tree indexes. */
     static constexpr IndexTreeFlavor DEFAULT_INDEX_TREE_FLAVOR = IndexTreeFlavor::INDEX_TREE_FLAVOR_MASSTREE;
 
+    /** @var Default enable row versions. */
+    static constexpr bool DEFAULT_ENABLE_ROW_VERSIONS = false;
+
+    /** @var The default indexing method of primary keys. */
+    static constexpr IndexingMethod DEFAULT_PRIMARY_INDEXING_METHOD = IndexingMethod::INDEXING_METHOD_TREE;
+
+    /** @var Default enable vectorized scan. */
+    static constexpr bool DEFAULT_ENABLE_VECTORIZED_SCAN = true;
+
+    /** @var Default enable compact row encoding. */
+    static constexpr bool DEFAULT_ENABLE_COMPACT_ROW_ENCODING = false;
+
+    /** @var Default enable remote read. */
+    static constexpr bool DEFAULT_ENABLE_REMOTE_READ = false;
+
     /** ------------------ Default General Configuration ------------ */
     /** @var Default configuration monitor period in seconds. */
     static constexpr const char* DEFAULT_CFG_MONITOR_PERIOD = "5 seconds";
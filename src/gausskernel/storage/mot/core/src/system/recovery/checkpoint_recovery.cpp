@@ -26,6 +26,7 @@
 #include "mot_engine.h"
 #include "checkpoint_recovery.h"
 #include "checkpoint_utils.h"
+#include "checkpoint_block_file.h"
 #include "irecovery_manager.h"
 #include "redo_log_transaction_iterator.h"
 
@@ -137,6 +138,29 @@ bool CheckpointRecovery::PerformRecovery()
         }
     }
 
+    RunWorkers();
+
+    // apply the delta levels on top of the full checkpoints, a round at a time
+    for (size_t round = 0; round < m_deltaRounds.size(); ++round) {
+        if (m_errorSet) {
+            for (Task* task : m_deltaRounds[round]) {
+                delete task;
+            }
+            continue;
+        }
+        MOT_LOG_DEBUG("CheckpointRecovery: %s delta level %lu",
+            (round % 2 == 0) ? "purging rows of" : "loading rows of",
+            round / 2 + 1);
+        m_tasksList.swap(m_deltaRounds[round]);
+        RunWorkers();
+    }
+    m_deltaRounds.clear();
+
+    return true;
+}
+
+void CheckpointRecovery::RunWorkers()
+{
     std::vector<std::thread> threadPool;
     for (uint32_t i = 0; i < m_numWorkers; ++i) {
         threadPool.push_back(std::thread(CheckpointRecoveryWorker, this));
@@ -153,7 +177,39 @@ bool CheckpointRecovery::PerformRecovery()
             worker.join();
         }
     }
+}
+
+bool CheckpointRecovery::AddLevelTasks(uint32_t tableId, uint64_t levelId, uint32_t maxSegId, uint32_t depth)
+{
+    std::list<Task*>* loadTasks = &m_tasksList;
+    std::list<Task*>* purgeTasks = nullptr;
+    if (depth > 0) {
+        if (m_deltaRounds.size() < 2 * depth) {
+            m_deltaRounds.resize(2 * depth);
+        }
+        purgeTasks = &m_deltaRounds[2 * depth - 2];
+        loadTasks = &m_deltaRounds[2 * depth - 1];
+        Task* purgeTask = new (std::nothrow) Task(tableId, 0, levelId, TASK_PURGE_DELETED);
+        if (purgeTask == nullptr) {
+            return false;
+        }
+        purgeTasks->push_back(purgeTask);
+    }
 
+    for (uint32_t seg = 0; seg <= maxSegId; seg++) {
+        if (purgeTasks != nullptr) {
+            Task* purgeTask = new (std::nothrow) Task(tableId, seg, levelId, TASK_PURGE_KEYS);
+            if (purgeTask == nullptr) {
+                return false;
+            }
+            purgeTasks->push_back(purgeTask);
+        }
+        Task* loadTask = new (std::nothrow) Task(tableId, seg, levelId, TASK_LOAD);
+        if (loadTask == nullptr) {
+            return false;
+        }
+        loadTasks->push_back(loadTask);
+    }
     return true;
 }
 
@@ -185,6 +241,16 @@ int CheckpointRecovery::FillTasksFromMapFile()
         return -1;
     }
 
+    // the earlier levels of the tables checkpointed as deltas, if any
+    std::string deltaFile;
+    DeltaChainMap chains;
+    CheckpointUtils::MakeDeltaFilename(deltaFile, m_workingDir, m_checkpointId);
+    if (CheckpointUtils::IsFileExists(deltaFile) && !CheckpointUtils::ReadDeltaFile(deltaFile, chains)) {
+        MOT_LOG_ERROR("CheckpointRecovery::fillTasksFromMapFile: failed to read delta file '%s'", deltaFile.c_str());
+        CheckpointUtils::CloseFile(fd);
+        return -1;
+    }
+
     CheckpointManager::MapFileEntry entry;
     for (uint64_t i = 0; i < mapFileHeader.m_numEntries; i++) {
         if (CheckpointUtils::ReadFile(fd, (char*)&entry, sizeof(CheckpointManager::MapFileEntry)) !=
@@ -196,14 +262,16 @@ int CheckpointRecovery::FillTasksFromMapFile()
             return -1;
         }
         m_tableIds.insert(entry.m_tableId);
-        for (uint32_t i = 0; i <= entry.m_maxSegId; i++) {
-            Task* recoveryTask = new (std::nothrow) Task(entry.m_tableId, i);
-            if (recoveryTask == nullptr) {
-                CheckpointUtils::CloseFile(fd);
-                MOT_LOG_ERROR("CheckpointRecovery::fillTasksFromMapFile: failed to allocate task object");
-                return -1;
-            }
-            m_tasksList.push_back(recoveryTask);
+        std::vector<DeltaLevel>& levels = chains[entry.m_tableId];
+        uint32_t depth = 0;
+        bool added = true;
+        for (; depth < levels.size() && added; depth++) {
+            added = AddLevelTasks(entry.m_tableId, levels[depth].m_checkpointId, levels[depth].m_maxSegId, depth);
+        }
+        if (!added || !AddLevelTasks(entry.m_tableId, 0, entry.m_maxSegId, depth)) {
+            CheckpointUtils::CloseFile(fd);
+            MOT_LOG_ERROR("CheckpointRecovery::fillTasksFromMapFile: failed to allocate task object");
+            return -1;
         }
     }
 
@@ -360,12 +428,19 @@ void CheckpointRecovery::CheckpointRecoveryWorker(CheckpointRecovery* checkpoint
             RC_MEMORY_ALLOCATION_ERROR, "CheckpointRecovery::WorkerFunc failed to allocate row buffer");
     }
 
+    CheckpointFileReader reader;
+    if (!reader.Initialize(GetGlobalConfiguration().m_enableCheckpointDirectIo)) {
+        MOT_LOG_ERROR("CheckpointRecovery::WorkerFunc: failed to allocate read buffer");
+        checkpointRecovery->OnError(
+            RC_MEMORY_ALLOCATION_ERROR, "CheckpointRecovery::WorkerFunc failed to allocate read buffer");
+    }
+
     RC status = RC_OK;
     while (checkpointRecovery->ShouldStopWorkers() == false) {
         CheckpointRecovery::Task* task = checkpointRecovery->GetTask();
         if (task != nullptr) {
             bool hadError = false;
-            if (!checkpointRecovery->RecoverTableRows(task, keyData, entryData, maxCsn, sState, status)) {
+            if (!checkpointRecovery->RecoverTableRows(task, &reader, keyData, entryData, maxCsn, sState, status)) {
                 MOT_LOG_ERROR("CheckpointRecovery::WorkerFunc recovery of table %lu's data failed", task->m_tableId);
                 checkpointRecovery->OnError(status,
                     "CheckpointRecovery::WorkerFunc failed to recover table: ",
@@ -398,15 +473,14 @@ void CheckpointRecovery::CheckpointRecoveryWorker(CheckpointRecovery* checkpoint
     MOT_LOG_DEBUG("CheckpointRecovery::WorkerFunc end [%u] on cpu %lu", (unsigned)MOTCurrThreadId, sched_getcpu());
 }
 
-bool CheckpointRecovery::RecoverTableRows(
-    Task* task, char* keyData, char* entryData, uint64_t& maxCsn, SurrogateState& sState, RC& status)
+bool CheckpointRecovery::RecoverTableRows(Task* task, CheckpointFileReader* reader, char* keyData, char* entryData,
+    uint64_t& maxCsn, SurrogateState& sState, RC& status)
 {
     if (task == nullptr) {
         MOT_LOG_ERROR("CheckpointRecovery::RecoverTableRows: no task given");
         return false;
     }
 
-    int fd = -1;
     uint32_t seg = task->m_segId;
     uint32_t tableId = task->m_tableId;
 
@@ -418,23 +492,20 @@ bool CheckpointRecovery::RecoverTableRows(
     }
 
     std::string fileName;
-    CheckpointUtils::MakeCpFilename(tableId, fileName, m_workingDir, seg);
-    if (!CheckpointUtils::OpenFileRead(fileName, fd)) {
-        MOT_LOG_ERROR("CheckpointRecovery::RecoverTableRows: failed to open file: %s", fileName.c_str());
-        return false;
+    if (task->m_type == TASK_PURGE_DELETED) {
+        CheckpointUtils::MakeDelFilename(tableId, fileName, m_workingDir, task->m_levelId);
+    } else {
+        CheckpointUtils::MakeCpFilename(tableId, fileName, m_workingDir, seg, task->m_levelId);
     }
-
-    CheckpointUtils::FileHeader fileHeader;
-    size_t reader = CheckpointUtils::ReadFile(fd, (char*)&fileHeader, sizeof(CheckpointUtils::FileHeader));
-    if (reader != sizeof(CheckpointUtils::FileHeader)) {
-        MOT_LOG_ERROR("CheckpointRecovery::RecoverTableRows: failed to read file header, reader %lu", reader);
-        CheckpointUtils::CloseFile(fd);
+    if (!reader->Open(fileName)) {
+        MOT_LOG_ERROR("CheckpointRecovery::RecoverTableRows: failed to open file: %s", fileName.c_str());
         return false;
     }
 
-    if (fileHeader.m_magic != CP_MGR_MAGIC || fileHeader.m_tableId != tableId) {
+    const CheckpointUtils::FileHeader& fileHeader = reader->GetHeader();
+    if (fileHeader.m_tableId != tableId) {
         MOT_LOG_ERROR("CheckpointRecovery::RecoverTableRows: file: %s is corrupted", fileName.c_str());
-        CheckpointUtils::CloseFile(fd);
+        reader->Close();
         return false;
     }
 
@@ -442,23 +513,23 @@ bool CheckpointRecovery::RecoverTableRows(
     if (tableExId != fileHeader.m_exId) {
         MOT_LOG_ERROR(
             "CheckpointRecovery::RecoverTableRows: exId mismatch: my %lu - pkt %lu", tableExId, fileHeader.m_exId);
+        reader->Close();
         return false;
     }
 
-    if (IsMemoryLimitReached(m_numWorkers, GetGlobalConfiguration().m_checkpointSegThreshold)) {
+    if (task->m_type == TASK_LOAD &&
+        IsMemoryLimitReached(m_numWorkers, GetGlobalConfiguration().m_checkpointSegThreshold)) {
         MOT_LOG_ERROR("CheckpointRecovery::RecoverTableRows: Memory hard limit reached. Cannot recover datanode");
+        reader->Close();
         return false;
     }
 
     CheckpointUtils::EntryHeader entry;
     for (uint64_t i = 0; i < fileHeader.m_numOps; i++) {
-        reader = CheckpointUtils::ReadFile(fd, (char*)&entry, sizeof(CheckpointUtils::EntryHeader));
-        if (reader != sizeof(CheckpointUtils::EntryHeader)) {
-            MOT_LOG_ERROR(
-                "CheckpointRecovery::RecoverTableRows: failed to read entry header (elem: %lu / %lu), reader %lu",
+        if (!reader->Read(&entry, sizeof(CheckpointUtils::EntryHeader))) {
+            MOT_LOG_ERROR("CheckpointRecovery::RecoverTableRows: failed to read entry header (elem: %lu / %lu)",
                 i,
-                fileHeader.m_numOps,
-                reader);
+                fileHeader.m_numOps);
             status = RC_ERROR;
             break;
         }
@@ -474,28 +545,27 @@ bool CheckpointRecovery::RecoverTableRows(
             break;
         }
 
-        reader = CheckpointUtils::ReadFile(fd, keyData, entry.m_keyLen);
-        if (reader != entry.m_keyLen) {
-            MOT_LOG_ERROR(
-                "CheckpointRecovery::RecoverTableRows: failed to read entry key (elem: %lu / %lu), reader %lu",
+        if (!reader->Read(keyData, entry.m_keyLen)) {
+            MOT_LOG_ERROR("CheckpointRecovery::RecoverTableRows: failed to read entry key (elem: %lu / %lu)",
                 i,
-                fileHeader.m_numOps,
-                reader);
+                fileHeader.m_numOps);
             status = RC_ERROR;
             break;
         }
 
-        reader = CheckpointUtils::ReadFile(fd, entryData, entry.m_dataLen);
-        if (reader != entry.m_dataLen) {
-            MOT_LOG_ERROR(
-                "CheckpointRecovery::RecoverTableRows: failed to read entry data (elem: %lu / %lu), reader %lu",
+        if (!reader->Read(entryData, entry.m_dataLen)) {
+            MOT_LOG_ERROR("CheckpointRecovery::RecoverTableRows: failed to read entry data (elem: %lu / %lu)",
                 i,
-                fileHeader.m_numOps,
-                reader);
+                fileHeader.m_numOps);
             status = RC_ERROR;
             break;
         }
 
+        if (task->m_type != TASK_LOAD) {
+            RemoveRow(table, keyData, entry.m_keyLen, MOTCurrThreadId);
+            continue;
+        }
+
         InsertRow(table,
             keyData,
             entry.m_keyLen,
@@ -516,13 +586,15 @@ bool CheckpointRecovery::RecoverTableRows(
         if (entry.m_csn > maxCsn)
             maxCsn = entry.m_csn;
     }
-    CheckpointUtils::CloseFile(fd);
+    reader->Close();
 
-    MOT_LOG_DEBUG("[%u] CheckpointRecovery::RecoverTableRows table %u:%u, %lu rows recovered (%s)",
+    MOT_LOG_DEBUG("[%u] CheckpointRecovery::RecoverTableRows table %u:%u (level %lu), %lu rows %s (%s)",
         MOTCurrThreadId,
         tableId,
         seg,
+        task->m_levelId,
         fileHeader.m_numOps,
+        (task->m_type == TASK_LOAD) ? "recovered" : "purged",
         (status == RC_OK) ? "OK" : "Error");
     return (status == RC_OK);
 }
@@ -593,6 +665,17 @@ void CheckpointRecovery::InsertRow(Table* table, char* keyData, uint16_t keyLen,
     }
 }
 
+void CheckpointRecovery::RemoveRow(Table* table, char* keyData, uint16_t keyLen, uint32_t tid)
+{
+    MaxKey key;
+    key.CpKey((const uint8_t*)keyData, keyLen);
+    // a key deleted by a delta level may have been inserted after the level before it
+    Row* row = table->GetPrimaryIndex()->IndexRead(&key, tid);
+    if (row != nullptr) {
+        (void)table->RemoveRow(row, tid);
+    }
+}
+
 bool CheckpointRecovery::RecoverInProcessTxns()
 {
     int fd = -1;
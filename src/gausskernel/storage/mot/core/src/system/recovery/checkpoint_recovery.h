@@ -28,12 +28,15 @@
 #include <set>
 #include <list>
 #include <mutex>
+#include <vector>
 #include "global.h"
 #include "spin_lock.h"
 #include "table.h"
 #include "surrogate_state.h"
 
 namespace MOT {
+class CheckpointFileReader;
+
 class CheckpointRecovery {
 public:
     CheckpointRecovery()
@@ -66,17 +69,29 @@ public:
         return m_stopWorkers;
     }
 
+    /**
+     * @enum TaskType
+     * @brief Loads the rows of a segment file, or removes the rows whose keys are in a segment file (the rows a
+     * delta level replaces) or in a deleted keys file.
+     */
+    enum TaskType : uint32_t { TASK_LOAD = 0, TASK_PURGE_KEYS = 1, TASK_PURGE_DELETED = 2 };
+
     /**
      * @struct Task
-     * @brief Describes a checkpoint recovery task by its table id and
-     * segment file number.
+     * @brief Describes a checkpoint recovery task by its table id,
+     * segment file number and delta level.
      */
     struct Task {
-        explicit Task(uint32_t tableId = 0, uint32_t segId = 0) : m_tableId(tableId), m_segId(segId)
+        explicit Task(uint32_t tableId = 0, uint32_t segId = 0, uint64_t levelId = 0, TaskType type = TASK_LOAD)
+            : m_tableId(tableId), m_segId(segId), m_type(type), m_levelId(levelId)
         {}
 
         uint32_t m_tableId;
         uint32_t m_segId;
+        TaskType m_type;
+
+        /** @var The checkpoint that took the files of an earlier delta level, or 0 for the recovered one. */
+        uint64_t m_levelId;
     };
 
     /**
@@ -88,6 +103,7 @@ public:
     /**
      * @brief Reads and inserts rows from a checkpoint file
      * @param task The task (tableid / segment) to recover from.
+     * @param reader The file reader of the recovering thread.
      * @param keyData A key buffer.
      * @param entryData A row buffer..
      * @param maxCsn The returned maxCsn encountered during the recovery.
@@ -96,8 +112,17 @@ public:
      * @param status RC returned from the Insert function.
      * @return Boolean value denoting success or failure.
      */
-    bool RecoverTableRows(
-        Task* task, char* keyData, char* entryData, uint64_t& maxCsn, SurrogateState& sState, RC& status);
+    bool RecoverTableRows(Task* task, CheckpointFileReader* reader, char* keyData, char* entryData, uint64_t& maxCsn,
+        SurrogateState& sState, RC& status);
+
+    /**
+     * @brief Removes a row, if it exists, in a non transactional manner.
+     * @param table the table's object pointer.
+     * @param keyData key's data buffer.
+     * @param keyLen key's data buffer len.
+     * @param tid the thread id of the recovering thread.
+     */
+    void RemoveRow(Table* table, char* keyData, uint16_t keyLen, uint32_t tid);
 
     uint64_t GetLsn() const
     {
@@ -127,6 +152,21 @@ private:
      */
     int FillTasksFromMapFile();
 
+    /**
+     * @brief Adds the tasks recovering one level of a table.
+     * @param tableId The table id.
+     * @param levelId The checkpoint that took the level, or 0 for the recovered one.
+     * @param maxSegId The maximum segment ID of the level.
+     * @param depth The level's position in the table's delta chain, 0 for the full checkpoint.
+     * @return Boolean value denoting success or failure.
+     */
+    bool AddLevelTasks(uint32_t tableId, uint64_t levelId, uint32_t maxSegId, uint32_t depth);
+
+    /**
+     * @brief Runs the workers until the tasks queue is empty.
+     */
+    void RunWorkers();
+
     /**
      * @brief Checks if there are any more tasks left in the queue
      * @return Int value where 0 means failure and 1 success
@@ -213,6 +253,12 @@ private:
     std::set<uint32_t> m_tableIds;
 
     std::list<Task*> m_tasksList;
+
+    /**
+     * @var The tasks applying delta levels. Round 2k-1 purges the rows replaced or deleted by the delta levels at
+     * depth k, round 2k loads their rows. Each round starts once the previous one is done.
+     */
+    std::vector<std::list<Task*>> m_deltaRounds;
 };
 }  // namespace MOT
 
@@ -59,6 +59,24 @@ public:
         return RC_ERROR;
     }
 
+    /**
+     * @brief Removes a transaction from the map without deleting it.
+     * @return The transaction's segments, owned by the caller from now on, or null if the transaction is not found.
+     */
+    RedoLogTransactionSegments* DetachTransaction(uint64_t internalId, uint64_t externalId)
+    {
+        const std::lock_guard<std::mutex> lock(m_lock);
+        auto it = m_map.find(internalId);
+        if (it == m_map.end()) {
+            return nullptr;
+        }
+        RedoLogTransactionSegments* segments = it->second;
+        m_map.erase(it);
+        m_extToInt.erase(externalId);
+        m_numEntries--;
+        return segments;
+    }
+
     /* Attention: Caller's should acquire the lock by calling Lock() method, before calling this method. */
     template <typename T>
     RC ForEachTransactionNoLock(const T& func)
@@ -85,6 +85,13 @@ public:
     virtual void SetLastReplayLsn(uint64_t lastReplayLsn) = 0;
     virtual uint64_t GetLastReplayLsn() const = 0;
 
+    /**
+     * @brief waits until the redo transactions handed to the replay workers are
+     * replayed and holds back further ones, until ResumeReplay() is called.
+     */
+    virtual void PauseReplay() = 0;
+    virtual void ResumeReplay() = 0;
+
     virtual bool IsErrorSet() const = 0;
     virtual void AddSurrogateArrayToList(SurrogateState& surrogate) = 0;
     virtual void SetCsn(uint64_t csn) = 0;
@@ -22,6 +22,7 @@
  * -------------------------------------------------------------------------
  */
 
+#include <algorithm>
 #include <list>
 #include <atomic>
 #include <thread>
@@ -31,11 +32,14 @@
 #include "checkpoint_manager.h"
 #include "spin_lock.h"
 #include "redo_log_transaction_iterator.h"
+#include "native_logger.h"
 #include "mot_engine.h"
 
 namespace MOT {
 DECLARE_LOGGER(RecoveryManager, Recovery);
 
+constexpr uint32_t RecoveryManager::STATS_SAMPLE_SIZE;
+
 bool RecoveryManager::Initialize()
 {
     // in a thread-pooled envelope the affinity could be disabled, so we use task affinity here
@@ -90,11 +94,32 @@ bool RecoveryManager::RecoverDbStart()
 
     m_lsn = m_checkpointRecovery.GetLsn();
     m_recoverFromCkptDone = true;
+
+    uint32_t numWorkers = GetGlobalConfiguration().m_redoRecoveryWorkers;
+    if (numWorkers > 1 && !m_replayPool.Start(numWorkers)) {
+        return false;
+    }
+
+    if (m_enableLogStats && m_logStats != nullptr) {
+        m_logStats->StartReplay(m_replayPool.IsActive() ? m_replayPool.GetNumWorkers() : 1);
+    }
     return true;
 }
 
 bool RecoveryManager::RecoverDbEnd()
 {
+    // the native redo log is replayed after the envelope redo, so that the clog tells which transactions committed
+    MOTConfiguration& cfg = GetGlobalConfiguration();
+    if (cfg.m_enableRedoLog && cfg.m_loggerType == LoggerType::NATIVE_LOGGER && !RecoverNativeLog()) {
+        m_errorSet = true;
+    }
+
+    // wait for the transactions still queued on the replay workers
+    m_replayPool.Stop();
+    if (m_replayPool.IsErrorSet()) {
+        m_errorSet = true;
+    }
+
     if (MOTEngine::GetInstance()->GetInProcessTransactions().GetNumTxns() != 0) {
         MOT_LOG_ERROR("MOT recovery: There are uncommitted or incomplete transactions, "
             "ignoring and clearing those log segments.");
@@ -113,6 +138,10 @@ bool RecoveryManager::RecoverDbEnd()
     m_surrogateList.clear();
     ApplySurrogate();
 
+    if (!m_errorSet) {
+        UpdateTableStatistics();
+    }
+
     if (m_enableLogStats && m_logStats != nullptr) {
         m_logStats->Print();
     }
@@ -128,6 +157,8 @@ void RecoveryManager::CleanUp()
         return;
     }
 
+    m_replayPool.Stop();
+
     if (m_logStats != nullptr) {
         delete m_logStats;
         m_logStats = nullptr;
@@ -151,6 +182,11 @@ bool RecoveryManager::ApplyLogSegmentFromData(char* data, size_t len, uint64_t r
     bool result = false;
     char* curData = data;
 
+    if (m_replayPool.IsErrorSet()) {
+        MOT_LOG_ERROR("ApplyLogSegmentFromData - a redo replay worker failed");
+        return false;
+    }
+
     while (data + len > curData) {
         // obtain LogSegment from buffer
         RedoLogTransactionIterator iterator(curData, len);
@@ -211,6 +247,25 @@ bool RecoveryManager::ApplyLogSegmentFromData(char* data, size_t len, uint64_t r
     return true;
 }
 
+bool RecoveryManager::RecoverNativeLog()
+{
+    NativeLogReader reader;
+    if (!reader.Open(CheckpointControlFile::GetCtrlFile()->GetId())) {
+        MOT_LOG_ERROR("RecoverNativeLog - failed to open the native redo log");
+        return false;
+    }
+
+    char* data = nullptr;
+    uint32_t size = 0;
+    while (reader.Next(data, size)) {
+        if (!ApplyLogSegmentFromData(data, size)) {
+            MOT_LOG_ERROR("RecoverNativeLog - failed to apply a redo record");
+            return false;
+        }
+    }
+    return !reader.IsErrorSet();
+}
+
 bool RecoveryManager::CommitRecoveredTransaction(uint64_t externalTransactionId)
 {
     uint64_t internalId = 0;
@@ -224,20 +279,15 @@ bool RecoveryManager::OperateOnRecoveredTransaction(
     uint64_t internalTransactionId, uint64_t externalTransactionId, RecoveryOps::RecoveryOpState rState)
 {
     RC status = RC_OK;
-    if (rState != RecoveryOps::RecoveryOpState::ABORT) {
-        auto operateLambda = [this](RedoLogTransactionSegments* segments, uint64_t id) -> RC {
-            RC redoStatus = RC_OK;
-            LogSegment* segment = segments->GetSegment(segments->GetCount() - 1);
-            uint64_t csn = segment->m_controlBlock.m_csn;
-            for (uint32_t i = 0; i < segments->GetCount(); i++) {
-                segment = segments->GetSegment(i);
-                redoStatus = RedoSegment(segment, csn, id, RecoveryOps::RecoveryOpState::COMMIT);
-                if (redoStatus != RC_OK) {
-                    MOT_LOG_ERROR("OperateOnRecoveredTransaction failed with rc %d", redoStatus);
-                    return redoStatus;
-                }
-            }
-            return redoStatus;
+    if (rState != RecoveryOps::RecoveryOpState::ABORT && m_replayPool.IsActive()) {
+        RedoLogTransactionSegments* segments = MOTEngine::GetInstance()->GetInProcessTransactions().DetachTransaction(
+            internalTransactionId, externalTransactionId);
+        if (segments == nullptr || !m_replayPool.Dispatch(segments, m_sState)) {
+            status = RC_ERROR;
+        }
+    } else if (rState != RecoveryOps::RecoveryOpState::ABORT) {
+        auto operateLambda = [this](RedoLogTransactionSegments* segments, uint64_t) -> RC {
+            return ReplayTransaction(segments, m_sState);
         };
 
         status = MOTEngine::GetInstance()->GetInProcessTransactions().ForUniqueTransaction(
@@ -250,8 +300,29 @@ bool RecoveryManager::OperateOnRecoveredTransaction(
     return true;
 }
 
-RC RecoveryManager::RedoSegment(
-    LogSegment* segment, uint64_t csn, uint64_t transactionId, RecoveryOps::RecoveryOpState rState)
+RC RecoveryManager::ReplayTransaction(RedoLogTransactionSegments* segments, SurrogateState& sState)
+{
+    RC redoStatus = RC_OK;
+    LogSegment* segment = segments->GetSegment(segments->GetCount() - 1);
+    uint64_t csn = segment->m_controlBlock.m_csn;
+    for (uint32_t i = 0; i < segments->GetCount(); i++) {
+        segment = segments->GetSegment(i);
+        redoStatus = RedoSegment(
+            segment, csn, segments->GetTransactionId(), RecoveryOps::RecoveryOpState::COMMIT, sState);
+        if (redoStatus != RC_OK) {
+            MOT_LOG_ERROR("ReplayTransaction failed with rc %d", redoStatus);
+            return redoStatus;
+        }
+    }
+
+    if (m_enableLogStats && m_logStats != nullptr) {
+        m_logStats->IncReplay(segments->GetSize());
+    }
+    return redoStatus;
+}
+
+RC RecoveryManager::RedoSegment(LogSegment* segment, uint64_t csn, uint64_t transactionId,
+    RecoveryOps::RecoveryOpState rState, SurrogateState& sState)
 {
     RC status = RC_OK;
     uint8_t* endPosition = (uint8_t*)(segment->m_data + segment->m_len);
@@ -260,8 +331,8 @@ RC RecoveryManager::RedoSegment(
     bool wasCommit = false;
 
     while (operationData < endPosition) {
-        // redo log recovery - single threaded
-        if (IsRecoveryMemoryLimitReached(NUM_REDO_RECOVERY_THREADS)) {
+        // redo log recovery - the dispatcher and the replay workers
+        if (IsRecoveryMemoryLimitReached(m_replayPool.GetNumWorkers() + 1)) {
             status = RC_ERROR;
             MOT_LOG_ERROR("Memory hard limit reached. Cannot recover datanode");
             break;
@@ -279,7 +350,7 @@ RC RecoveryManager::RedoSegment(
         }
 
         operationData += RecoveryOps::RecoverLogOperation(
-            MOTCurrTxn, operationData, csn, transactionId, MOTCurrThreadId, m_sState, status, wasCommit);
+            MOTCurrTxn, operationData, csn, transactionId, MOTCurrThreadId, sState, status, wasCommit);
 
         // check operation result status
         if (status != RC_OK) {
@@ -293,10 +364,7 @@ RC RecoveryManager::RedoSegment(
         }
     }
 
-    // single threaded, no need for locking or CAS
-    if (csn > m_maxRecoveredCsn) {
-        m_maxRecoveredCsn = csn;
-    }
+    SetCsn(csn);
     if (status != RC_OK) {
         MOT_LOG_ERROR("RecoveryManager::redoSegment: got error %u on tid %lu", status, transactionId);
     }
@@ -334,6 +402,17 @@ void RecoveryManager::LogStats::Print()
             m_tableStats[i]->m_deletes.load());
     }
     MOT_LOG_ERROR("Overall tcls: %lu", m_commits.load());
+
+    uint64_t elapsedMs = (uint64_t)std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - m_replayStart).count();
+    uint64_t elapsed = std::max(elapsedMs, (uint64_t)1);
+    MOT_LOG_ERROR("Redo replay: %lu transactions, %lu bytes in %lu ms on %u workers (%lu txn/sec, %lu KB/sec)",
+        m_replayedTxns.load(),
+        m_replayedBytes.load(),
+        elapsedMs,
+        m_numWorkers,
+        m_replayedTxns.load() * 1000 / elapsed,
+        m_replayedBytes.load() * 1000 / 1024 / elapsed);
 }
 
 void RecoveryManager::SetCsn(uint64_t csn)
@@ -374,6 +453,16 @@ void RecoveryManager::ApplySurrogate()
     }
 }
 
+void RecoveryManager::UpdateTableStatistics()
+{
+    std::list<Table*> tables;
+    (void)GetTableManager()->AddTablesToList(tables);
+    for (Table* table : tables) {
+        table->UpdateIndexStatistics(STATS_SAMPLE_SIZE, MOTCurrThreadId);
+        table->Unlock();
+    }
+}
+
 bool RecoveryManager::IsMotTransactionId(LogSegment* segment)
 {
     MOT_ASSERT(segment);
@@ -25,6 +25,7 @@
 #ifndef RECOVERY_MANAGER_H
 #define RECOVERY_MANAGER_H
 
+#include <chrono>
 #include <vector>
 #include "checkpoint_ctrlfile.h"
 #include "redo_log_global.h"
@@ -36,6 +37,7 @@
 #include "surrogate_state.h"
 #include "checkpoint_recovery.h"
 #include "recovery_ops.h"
+#include "redo_replay_pool.h"
 
 namespace MOT {
 /**
@@ -57,7 +59,8 @@ public:
           m_errorSet(false),
           m_clogCallback(nullptr),
           m_threadId(AllocThreadId()),
-          m_maxConnections(GetGlobalConfiguration().m_maxConnections)
+          m_maxConnections(GetGlobalConfiguration().m_maxConnections),
+          m_replayPool(this)
     {}
 
     ~RecoveryManager() override
@@ -128,8 +131,9 @@ public:
 
     inline void SetLastReplayLsn(uint64_t replayLsn) override
     {
-        if (m_lastReplayLsn < replayLsn) {
-            m_lastReplayLsn = replayLsn;
+        // transactions may commit out of log order on the replay workers
+        uint64_t currentLsn = m_lastReplayLsn;
+        while (currentLsn < replayLsn && !m_lastReplayLsn.compare_exchange_weak(currentLsn, replayLsn)) {
         }
     }
 
@@ -138,6 +142,24 @@ public:
         return m_lastReplayLsn;
     }
 
+    void PauseReplay() override
+    {
+        m_replayPool.PauseReplay();
+    }
+
+    void ResumeReplay() override
+    {
+        m_replayPool.ResumeReplay();
+    }
+
+    /**
+     * @brief replays all the segments of a committed transaction.
+     * @param segments the transaction's segments.
+     * @param sState the surrogate state of the replaying thread.
+     * @return RC value denoting the operation's status
+     */
+    RC ReplayTransaction(RedoLogTransactionSegments* segments, SurrogateState& sState);
+
     /**
      * @class LogStats
      * @brief A per-table recovery stats collector
@@ -172,7 +194,7 @@ public:
             uint64_t m_id;
         };
 
-        LogStats() : m_commits(0), m_numEntries(0)
+        LogStats() : m_commits(0), m_replayedTxns(0), m_replayedBytes(0), m_numEntries(0), m_numWorkers(1)
         {}
 
         ~LogStats()
@@ -213,6 +235,22 @@ public:
             ++m_commits;
         }
 
+        inline void IncReplay(uint64_t bytes)
+        {
+            ++m_replayedTxns;
+            m_replayedBytes += bytes;
+        }
+
+        /**
+         * @brief Marks the start of the redo log replay, used to report the replay throughput.
+         * @param numWorkers The number of redo replay workers.
+         */
+        void StartReplay(uint32_t numWorkers)
+        {
+            m_numWorkers = numWorkers;
+            m_replayStart = std::chrono::steady_clock::now();
+        }
+
         /**
          * @brief Prints the stats data to the log
          */
@@ -234,9 +272,17 @@ public:
 
         std::atomic<uint64_t> m_commits;
 
+        std::atomic<uint64_t> m_replayedTxns;
+
+        std::atomic<uint64_t> m_replayedBytes;
+
         spin_lock m_slock;
 
         uint64_t m_numEntries;
+
+        uint32_t m_numWorkers;
+
+        std::chrono::steady_clock::time_point m_replayStart;
     };
 
     LogStats* m_logStats;
@@ -244,8 +290,6 @@ public:
     std::map<uint64_t, RecoveryOps::TableInfo*> m_preCommitedTables;
 
 private:
-    static constexpr uint32_t NUM_REDO_RECOVERY_THREADS = 1;
-
     /**
      * @brief performs a redo on a segment, which is either a recovery op
      * or a segment that belongs to a 2pc recovered transaction.
@@ -253,9 +297,11 @@ private:
      * @param csn the segment's csn
      * @param transactionId the transaction id of the segment
      * @param rState the operation to perform on the segment.
+     * @param sState the surrogate state of the replaying thread.
      * @return RC value denoting the operation's status
      */
-    RC RedoSegment(LogSegment* segment, uint64_t csn, uint64_t transactionId, RecoveryOps::RecoveryOpState rState);
+    RC RedoSegment(LogSegment* segment, uint64_t csn, uint64_t transactionId, RecoveryOps::RecoveryOpState rState,
+        SurrogateState& sState);
 
     /**
      * @brief inserts a segment in to the in-process transactions map
@@ -308,13 +354,27 @@ private:
      */
     void ApplySurrogate();
 
+    /**
+     * @brief Rebuilds the index statistics of all recovered tables, which checkpoints do not keep.
+     */
+    void UpdateTableStatistics();
+
+    /** @var The number of rows sampled per table for the index statistics, as ANALYZE does by default. */
+    static constexpr uint32_t STATS_SAMPLE_SIZE = 30000;
+
+    /**
+     * @brief Replays the redo written by the native logger since the recovered checkpoint.
+     * @return Boolean value denoting success or failure.
+     */
+    bool RecoverNativeLog();
+
     bool m_initialized;
 
     bool m_recoverFromCkptDone;
 
     uint64_t m_lsn;
 
-    uint64_t m_lastReplayLsn;
+    std::atomic<uint64_t> m_lastReplayLsn;
 
     std::atomic<uint32_t> m_tid;
 
@@ -339,6 +399,8 @@ private:
     uint16_t m_maxConnections;
 
     CheckpointRecovery m_checkpointRecovery;
+
+    RedoReplayPool m_replayPool;
 };
 }  // namespace MOT
 
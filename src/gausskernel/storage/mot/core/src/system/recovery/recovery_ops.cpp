@@ -82,6 +82,78 @@ uint32_t RecoveryOps::RecoverLogOperation(TxnManager* txn, uint8_t* data, uint64
     }
 }
 
+uint32_t RecoveryOps::PeekLogOperation(
+    TxnManager* txn, uint8_t* data, uint64_t& exId, uint8_t*& keyData, uint16_t& keyLen)
+{
+    uint64_t tableId = 0;
+    uint64_t rowId = 0;
+    uint64_t rowLength = 0;
+    uint8_t* start = data;
+
+    exId = 0;
+    keyData = nullptr;
+    keyLen = 0;
+
+    OperationCode opCode = *static_cast<OperationCode*>((void*)data);
+    data += sizeof(OperationCode);
+    switch (opCode) {
+        case CREATE_ROW:
+            Extract(data, tableId);
+            Extract(data, exId);
+            Extract(data, rowId);
+            Extract(data, keyLen);
+            keyData = ExtractPtr(data, keyLen);
+            Extract(data, rowLength);
+            return (uint32_t)(data - start) + rowLength;
+        case OVERWRITE_ROW:
+            Extract(data, tableId);
+            Extract(data, exId);
+            Extract(data, keyLen);
+            keyData = ExtractPtr(data, keyLen);
+            Extract(data, rowLength);
+            return (uint32_t)(data - start) + rowLength;
+        case REMOVE_ROW:
+            Extract(data, tableId);
+            Extract(data, exId);
+            Extract(data, keyLen);
+            keyData = ExtractPtr(data, keyLen);
+            return (uint32_t)(data - start);
+        case UPDATE_ROW: {
+            Extract(data, tableId);
+            Extract(data, exId);
+            Extract(data, keyLen);
+            keyData = ExtractPtr(data, keyLen);
+            // the length of a delta update depends on the sizes of the updated columns
+            Table* table = txn->GetTableByExternalId(exId);
+            if (table == nullptr) {
+                return 0;
+            }
+            uint16_t numColumns = table->GetFieldCount() - 1;
+            BitmapSet updatedColumns(ExtractPtr(data, BitmapSet::GetLength(numColumns)), numColumns);
+            BitmapSet validColumns(ExtractPtr(data, BitmapSet::GetLength(numColumns)), numColumns);
+            BitmapSet::BitmapSetIterator updatedColumnsIt(updatedColumns);
+            BitmapSet::BitmapSetIterator validColumnsIt(validColumns);
+            while (!updatedColumnsIt.End()) {
+                if (updatedColumnsIt.IsSet() && validColumnsIt.IsSet()) {
+                    data += table->GetField(updatedColumnsIt.GetPosition() + 1)->m_size;
+                }
+                validColumnsIt.Next();
+                updatedColumnsIt.Next();
+            }
+            return (uint32_t)(data - start);
+        }
+        case COMMIT_TX:
+        case COMMIT_PREPARED_TX:
+        case PARTIAL_REDO_TX:
+        case PREPARE_TX:
+        case ROLLBACK_TX:
+        case ROLLBACK_PREPARED_TX:
+            return sizeof(EndSegmentBlock);
+        default:
+            return 0;
+    }
+}
+
 uint32_t RecoveryOps::RecoverLogOperationCreateTable(
     TxnManager* txn, uint8_t* data, RC& status, RecoveryOpState state, uint64_t transactionId)
 {
@@ -97,6 +97,18 @@ public:
     static uint32_t RecoverLogOperation(TxnManager* txn, uint8_t* data, uint64_t csn, uint64_t transactionId,
         uint32_t tid, SurrogateState& sState, RC& status, bool& wasCommit);
 
+    /**
+     * @brief Retrieves the row a recovery operation modifies, without performing the operation.
+     * @param transaction manager object, used to look up the table.
+     * @param data the buffer holding the operation.
+     * @param[out] exId the external id of the modified table, or 0 for a transaction control operation.
+     * @param[out] keyData the key of the modified row.
+     * @param[out] keyLen the length of the key of the modified row.
+     * @return Int value denoting the number of bytes the operation takes, or 0 for a DDL operation, an unknown
+     * operation or an operation whose table is not found.
+     */
+    static uint32_t PeekLogOperation(TxnManager* txn, uint8_t* data, uint64_t& exId, uint8_t*& keyData, uint16_t& keyLen);
+
     /**
      * @brief Starts a new transaction for recovery operations.
      * @param transaction manager object.
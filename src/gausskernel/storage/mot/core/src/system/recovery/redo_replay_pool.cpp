@@ -0,0 +1,249 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * -------------------------------------------------------------------------
+ *
+ * redo_replay_pool.cpp
+ *    Replays committed redo transactions on a pool of workers partitioned by key.
+ *
+ * IDENTIFICATION
+ *    src/gausskernel/storage/mot/core/src/system/recovery/redo_replay_pool.cpp
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include <algorithm>
+#include "mot_engine.h"
+#include "redo_replay_pool.h"
+#include "recovery_manager.h"
+
+namespace MOT {
+DECLARE_LOGGER(RedoReplayPool, Recovery);
+
+constexpr uint32_t RedoReplayPool::MAX_WORKERS;
+constexpr uint32_t RedoReplayPool::MAX_QUEUED_TRANSACTIONS;
+
+bool RedoReplayPool::Start(uint32_t numWorkers)
+{
+    numWorkers = std::min(numWorkers, MAX_WORKERS);
+    m_errorSet = false;
+    for (uint32_t i = 0; i < numWorkers; ++i) {
+        Worker* worker = new (std::nothrow) Worker();
+        if (worker == nullptr) {
+            MOT_REPORT_ERROR(MOT_ERROR_OOM, "Redo Replay Initialization", "Failed to allocate replay worker %u", i);
+            Stop();
+            return false;
+        }
+        m_workers.push_back(worker);
+        worker->m_thread = std::thread(WorkerMain, this, worker);
+    }
+    m_numWorkers = numWorkers;
+    MOT_LOG_INFO("RedoReplayPool: started %u redo replay workers", m_numWorkers);
+    return true;
+}
+
+void RedoReplayPool::Stop()
+{
+    std::lock_guard<std::mutex> lock(m_dispatchLock);
+    if (m_workers.empty()) {
+        return;
+    }
+
+    for (Worker* worker : m_workers) {
+        std::lock_guard<std::mutex> workerLock(worker->m_lock);
+        worker->m_stop = true;
+        worker->m_cv.notify_all();
+    }
+    for (Worker* worker : m_workers) {
+        if (worker->m_thread.joinable()) {
+            worker->m_thread.join();
+        }
+        delete worker;
+    }
+    m_workers.clear();
+    m_numWorkers = 0;
+}
+
+bool RedoReplayPool::Dispatch(RedoLogTransactionSegments* segments, SurrogateState& sState)
+{
+    std::lock_guard<std::mutex> lock(m_dispatchLock);
+    if (m_errorSet) {
+        delete segments;
+        return false;
+    }
+
+    uint64_t mask = 0;
+    if (!MapTransaction(segments, mask)) {
+        // DDL, or an operation on a table unknown yet: wait for all the workers
+        Drain(~(uint64_t)0);
+    } else if (mask != 0 && (mask & (mask - 1)) == 0) {
+        Worker* worker = m_workers[__builtin_ctzll(mask)];
+        std::unique_lock<std::mutex> workerLock(worker->m_lock);
+        worker->m_cv.wait(workerLock, [worker] { return worker->m_tasks.size() < MAX_QUEUED_TRANSACTIONS; });
+        worker->m_tasks.push_back(segments);
+        worker->m_cv.notify_all();
+        return true;
+    } else {
+        // the transaction spans several workers, replay it once they are done with the transactions preceding it
+        Drain(mask);
+    }
+
+    uint64_t transactionId = segments->GetTransactionId();
+    RC status = m_recoveryManager->ReplayTransaction(segments, sState);
+    delete segments;
+    if (status != RC_OK) {
+        OnError(status, transactionId);
+        return false;
+    }
+    return true;
+}
+
+void RedoReplayPool::PauseReplay()
+{
+    m_dispatchLock.lock();
+    Drain(~(uint64_t)0);
+}
+
+void RedoReplayPool::ResumeReplay()
+{
+    m_dispatchLock.unlock();
+}
+
+void RedoReplayPool::WorkerMain(RedoReplayPool* pool, Worker* worker)
+{
+    // since this is a non-kernel thread we must set-up our own u_sess struct for the current thread
+    MOT_DECLARE_NON_KERNEL_THREAD();
+
+    MOTEngine* engine = MOTEngine::GetInstance();
+    SessionContext* sessionContext = GetSessionManager()->CreateSessionContext();
+
+    // in a thread-pooled envelope the affinity could be disabled, so we use task affinity here
+    if (GetGlobalConfiguration().m_enableNuma && !GetTaskAffinity().SetAffinity(MOTCurrThreadId)) {
+        MOT_LOG_WARN("Failed to set affinity of redo replay worker, recovery performance may be affected");
+    }
+
+    SurrogateState sState;
+    bool ready = (sessionContext != nullptr && sState.IsValid());
+    if (!ready) {
+        MOT_LOG_ERROR("RedoReplayPool::WorkerMain: failed to allocate worker resources");
+        pool->OnError(RC_MEMORY_ALLOCATION_ERROR, 0);
+    }
+
+    // queued transactions are consumed even after an error, so the dispatcher never waits forever
+    while (true) {
+        RedoLogTransactionSegments* segments = nullptr;
+        {
+            std::unique_lock<std::mutex> lock(worker->m_lock);
+            worker->m_cv.wait(lock, [worker] { return !worker->m_tasks.empty() || worker->m_stop; });
+            if (worker->m_tasks.empty()) {
+                break;
+            }
+            segments = worker->m_tasks.front();
+        }
+
+        if (ready && !pool->m_errorSet) {
+            RC status = pool->m_recoveryManager->ReplayTransaction(segments, sState);
+            if (status != RC_OK) {
+                pool->OnError(status, segments->GetTransactionId());
+            }
+        }
+        delete segments;
+
+        std::lock_guard<std::mutex> lock(worker->m_lock);
+        worker->m_tasks.pop_front();
+        worker->m_cv.notify_all();
+    }
+
+    if (sState.IsValid() && sState.IsEmpty() == false) {
+        (GetRecoveryManager())->AddSurrogateArrayToList(sState);
+    }
+
+    if (sessionContext != nullptr) {
+        GetSessionManager()->DestroySessionContext(sessionContext);
+    }
+    engine->OnCurrentThreadEnding();
+}
+
+bool RedoReplayPool::MapTransaction(RedoLogTransactionSegments* segments, uint64_t& mask) const
+{
+    TxnManager* txn = MOTCurrTxn;
+    Table* table = nullptr;
+    uint64_t lastExId = 0;
+    mask = 0;
+
+    for (uint32_t i = 0; i < segments->GetCount(); i++) {
+        LogSegment* segment = segments->GetSegment(i);
+        uint8_t* data = (uint8_t*)segment->m_data;
+        uint8_t* endPosition = (uint8_t*)(segment->m_data + segment->m_len);
+        while (data < endPosition) {
+            uint64_t exId = 0;
+            uint8_t* keyData = nullptr;
+            uint16_t keyLength = 0;
+            uint32_t length = RecoveryOps::PeekLogOperation(txn, data, exId, keyData, keyLength);
+            if (length == 0) {
+                return false;
+            }
+            if (keyData != nullptr) {
+                if (table == nullptr || exId != lastExId) {
+                    table = txn->GetTableByExternalId(exId);
+                    if (table == nullptr) {
+                        return false;
+                    }
+                    lastExId = exId;
+                }
+                mask |= (uint64_t)1 << MapRow(table, exId, keyData, keyLength);
+            }
+            data += length;
+        }
+    }
+    return true;
+}
+
+uint32_t RedoReplayPool::MapRow(Table* table, uint64_t tableExId, const uint8_t* keyData, uint16_t keyLength) const
+{
+    // FNV-1a over the table id and the primary key
+    constexpr uint64_t fnvPrime = 1099511628211ULL;
+    uint64_t hash = 14695981039346656037ULL;
+    hash = (hash ^ tableExId) * fnvPrime;
+
+    // rows of different primary keys may still collide on a unique secondary key, so such tables stay on one worker
+    for (uint16_t i = 1; i < table->GetNumIndexes(); i++) {
+        if (table->GetIndex(i)->GetUnique()) {
+            return (uint32_t)(hash % m_numWorkers);
+        }
+    }
+
+    for (uint16_t i = 0; i < keyLength; i++) {
+        hash = (hash ^ keyData[i]) * fnvPrime;
+    }
+    return (uint32_t)(hash % m_numWorkers);
+}
+
+void RedoReplayPool::Drain(uint64_t mask)
+{
+    for (uint32_t i = 0; i < m_workers.size(); i++) {
+        if ((mask & ((uint64_t)1 << i)) == 0) {
+            continue;
+        }
+        Worker* worker = m_workers[i];
+        std::unique_lock<std::mutex> lock(worker->m_lock);
+        worker->m_cv.wait(lock, [worker] { return worker->m_tasks.empty(); });
+    }
+}
+
+void RedoReplayPool::OnError(RC status, uint64_t transactionId)
+{
+    MOT_LOG_ERROR("RedoReplayPool: replay of transaction %lu failed with rc %d", transactionId, status);
+    m_errorSet = true;
+}
+}  // namespace MOT
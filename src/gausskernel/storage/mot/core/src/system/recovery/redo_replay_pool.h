@@ -0,0 +1,164 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * -------------------------------------------------------------------------
+ *
+ * redo_replay_pool.h
+ *    Replays committed redo transactions on a pool of workers partitioned by key.
+ *
+ * IDENTIFICATION
+ *    src/gausskernel/storage/mot/core/src/system/recovery/redo_replay_pool.h
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef REDO_REPLAY_POOL_H
+#define REDO_REPLAY_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "global.h"
+#include "redo_log_transaction_segments.h"
+#include "surrogate_state.h"
+
+namespace MOT {
+class RecoveryManager;
+class Table;
+
+/**
+ * @class RedoReplayPool
+ * @brief Replays committed redo transactions on a pool of workers.
+ * @detail Every row a transaction modifies is mapped to a worker by its table and primary key (or by its table alone,
+ * if the table has a unique secondary index). A transaction whose rows all map to the same worker is queued on it,
+ * so transactions touching the same keys are replayed by one worker in log order. Any other transaction is a
+ * barrier: the dispatcher waits until the workers it maps to are idle and replays it by itself. Transactions
+ * carrying DDL operations wait for all the workers.
+ */
+class RedoReplayPool {
+public:
+    explicit RedoReplayPool(RecoveryManager* recoveryManager)
+        : m_recoveryManager(recoveryManager), m_numWorkers(0), m_errorSet(false)
+    {}
+
+    ~RedoReplayPool()
+    {
+        Stop();
+    }
+
+    /**
+     * @brief Starts the replay workers.
+     * @param numWorkers The number of workers to start.
+     * @return Boolean value denoting success or failure.
+     */
+    bool Start(uint32_t numWorkers);
+
+    /**
+     * @brief Waits until all the queued transactions are replayed and stops the workers.
+     */
+    void Stop();
+
+    bool IsActive() const
+    {
+        return m_numWorkers > 0;
+    }
+
+    uint32_t GetNumWorkers() const
+    {
+        return m_numWorkers;
+    }
+
+    bool IsErrorSet() const
+    {
+        return m_errorSet;
+    }
+
+    /**
+     * @brief Replays a committed transaction, either on a worker or on the calling thread.
+     * @param segments The transaction. The pool takes ownership of it and deletes it once replayed.
+     * @param sState The surrogate state of the calling thread.
+     * @return Boolean value denoting success or failure.
+     */
+    bool Dispatch(RedoLogTransactionSegments* segments, SurrogateState& sState);
+
+    /**
+     * @brief Waits until all the dispatched transactions are replayed and holds back further ones, so the set of
+     * replayed transactions is a prefix of the log. Must be followed by ResumeReplay() on the same thread.
+     */
+    void PauseReplay();
+
+    /**
+     * @brief Lets transactions be dispatched again after PauseReplay().
+     */
+    void ResumeReplay();
+
+private:
+    /** @var The maximum number of workers, bounded by the width of the worker mask. */
+    static constexpr uint32_t MAX_WORKERS = 64;
+
+    /** @var The number of queued transactions per worker above which the dispatcher waits. */
+    static constexpr uint32_t MAX_QUEUED_TRANSACTIONS = 1024;
+
+    /**
+     * @struct Worker
+     * @brief A replay worker and its transaction queue. A transaction stays at the queue front until it is replayed.
+     */
+    struct Worker {
+        Worker() : m_stop(false)
+        {}
+
+        std::mutex m_lock;
+
+        std::condition_variable m_cv;
+
+        std::deque<RedoLogTransactionSegments*> m_tasks;
+
+        bool m_stop;
+
+        std::thread m_thread;
+    };
+
+    static void WorkerMain(RedoReplayPool* pool, Worker* worker);
+
+    /**
+     * @brief Maps the rows a transaction modifies to workers.
+     * @param segments The transaction.
+     * @param[out] mask The workers the transaction maps to.
+     * @return False if the transaction must wait for all the workers.
+     */
+    bool MapTransaction(RedoLogTransactionSegments* segments, uint64_t& mask) const;
+
+    uint32_t MapRow(Table* table, uint64_t tableExId, const uint8_t* keyData, uint16_t keyLength) const;
+
+    /** @brief Waits until the masked workers have no queued transactions. */
+    void Drain(uint64_t mask);
+
+    void OnError(RC status, uint64_t transactionId);
+
+    RecoveryManager* m_recoveryManager;
+
+    std::vector<Worker*> m_workers;
+
+    uint32_t m_numWorkers;
+
+    std::atomic<bool> m_errorSet;
+
+    /** @var Serializes dispatching, held between PauseReplay() and ResumeReplay(). */
+    std::mutex m_dispatchLock;
+};
+}  // namespace MOT
+
+#endif /* REDO_REPLAY_POOL_H */
@@ -41,7 +41,9 @@ DbSessionThreadStatistics::DbSessionThreadStatistics(uint64_t threadId, void* in
       m_commitTxnCount(MakeName("commit-txn", threadId).c_str()),
       m_rollbackTxnCount(MakeName("rollback-txn", threadId).c_str()),
       m_commitPreparedTxnCount(MakeName("commit-prepared-txn", threadId).c_str()),
-      m_rollbackPreparedTxnCount(MakeName("rollback-prepared-txn", threadId).c_str())
+      m_rollbackPreparedTxnCount(MakeName("rollback-prepared-txn", threadId).c_str()),
+      m_commitTime(MakeName("txn-commit-time", threadId).c_str(), "us"),
+      m_taasRoundTripTime(MakeName("taas-round-trip-time", threadId).c_str(), "us")
 {
     RegisterStatistics(&m_txnCount);
     RegisterStatistics(&m_rowPerTxnCount);
@@ -52,6 +54,8 @@ DbSessionThreadStatistics::DbSessionThreadStatistics(uint64_t threadId, void* in
     RegisterStatistics(&m_rollbackTxnCount);
     RegisterStatistics(&m_commitPreparedTxnCount);
     RegisterStatistics(&m_rollbackPreparedTxnCount);
+    RegisterStatistics(&m_commitTime);
+    RegisterStatistics(&m_taasRoundTripTime);
 }
 
 TypedStatisticsGenerator<DbSessionThreadStatistics, EmptyGlobalStatistics> DbSessionStatisticsProvider::m_generator;
@@ -26,6 +26,7 @@
 #define DB_SESSION_STATISTICS_H
 
 #include "frequency_statistic_variable.h"
+#include "histogram_statistic_variable.h"
 #include "iconfig_change_listener.h"
 #include "numeric_statistic_variable.h"
 #include "statistics_provider.h"
@@ -103,6 +104,18 @@ public:
         m_rollbackPreparedTxnCount.AddSample();
     }
 
+    /** @brief Updates the transaction commit time statistics. */
+    inline void AddCommitTime(uint64_t commitTimeUsec)
+    {
+        m_commitTime.AddSample(commitTimeUsec);
+    }
+
+    /** @brief Updates the TaaS commit round trip time statistics. */
+    inline void AddTaasRoundTripTime(uint64_t roundTripUsec)
+    {
+        m_taasRoundTripTime.AddSample(roundTripUsec);
+    }
+
 private:
     /** @var The transaction count statistic variable. */
     FrequencyStatisticVariable m_txnCount;
@@ -130,6 +143,12 @@ private:
 
     /** @var The rolled-back-prepared-transaction count statistic variable. */
     FrequencyStatisticVariable m_rollbackPreparedTxnCount;
+
+    /** @var The transaction commit time (redo log and row updates) statistic variable. */
+    HistogramStatisticVariable m_commitTime;
+
+    /** @var The time from submitting a transaction to TaaS until its verdict arrives. */
+    HistogramStatisticVariable m_taasRoundTripTime;
 };
 
 /**
@@ -235,6 +254,24 @@ public:
         }
     }
 
+    /** @brief Records a transaction commit time. */
+    inline void AddCommitTime(uint64_t commitTimeUsec)
+    {
+        DbSessionThreadStatistics* dbts = GetCurrentThreadStatistics<DbSessionThreadStatistics>();
+        if (dbts != nullptr) {
+            dbts->AddCommitTime(commitTimeUsec);
+        }
+    }
+
+    /** @brief Records a TaaS commit round trip time. */
+    inline void AddTaasRoundTripTime(uint64_t roundTripUsec)
+    {
+        DbSessionThreadStatistics* dbts = GetCurrentThreadStatistics<DbSessionThreadStatistics>();
+        if (dbts != nullptr) {
+            dbts->AddTaasRoundTripTime(roundTripUsec);
+        }
+    }
+
     /**
      * @brief Derives classes should react to a notification that configuration changed. New
      * configuration is accessible via the ConfigManager.
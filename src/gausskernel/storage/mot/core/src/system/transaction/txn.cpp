@@ -34,6 +34,7 @@
 #include "txn.h"
 #include "txn_access.h"
 #include "txn_insert_action.h"
+#include "snapshot_registry.h"
 #include "db_session_statistics.h"
 #include "utilities.h"
 #include "mm_api.h"
@@ -124,6 +125,10 @@ Row* TxnManager::RowLookup(const AccessType type, Sentinel* const& originalSenti
         case RC::RC_LOCAL_ROW_FOUND:
             return local_row;
         case RC::RC_LOCAL_ROW_NOT_FOUND:
+            if (m_snapshotCsn != 0 && type == AccessType::RD) {
+                // the version may predate a delete that left the sentinel uncommitted
+                return m_accessMgr->GetSnapshotRow(originalSentinel, m_snapshotCsn);
+            }
             if (likely(originalSentinel->IsCommited() == true)) {
                 // For Read-Only Txn return the Commited row
                 if (GetTxnIsoLevel() == READ_COMMITED and type == AccessType::RD) {
@@ -192,6 +197,31 @@ RC TxnManager::StartTransaction(uint64_t transactionId, int isolationLevel)
     return RC_OK;
 }
 
+bool TxnManager::BeginSnapshot()
+{
+    if (!GetGlobalConfiguration().m_enableRowVersions || m_snapshotSlot != SnapshotRegistry::INVALID_SLOT) {
+        return m_snapshotSlot != SnapshotRegistry::INVALID_SLOT;
+    }
+    uint64_t snapshotCsn = 0;
+    m_snapshotSlot = SnapshotRegistry::GetInstance().Acquire(snapshotCsn);
+    if (m_snapshotSlot == SnapshotRegistry::INVALID_SLOT) {
+        MOT_LOG_WARN("No snapshot slot available, transaction reads the latest row versions");
+        return false;
+    }
+    // CSN 0 is reserved for "latest", nothing is visible at it anyway
+    m_snapshotCsn = (snapshotCsn == 0) ? 1 : snapshotCsn;
+    return true;
+}
+
+void TxnManager::EndSnapshot()
+{
+    if (m_snapshotSlot != SnapshotRegistry::INVALID_SLOT) {
+        SnapshotRegistry::GetInstance().Release(m_snapshotSlot);
+        m_snapshotSlot = SnapshotRegistry::INVALID_SLOT;
+    }
+    m_snapshotCsn = 0;
+}
+
 void TxnManager::LiteRollback()
 {
     if (m_txnDdlAccess->Size() > 0) {
@@ -328,40 +358,74 @@ RC TxnManager::ValidateCommit()
     //然后在CommitInternal中进行写集更新并锁住row
     //最后释放header和row的锁
     //返回并清除
-    // return m_occManager.ValidateOcc(this); 
+    // return m_occManager.ValidateOcc(this);
 
+    RC rc = SubmitCommit();
+    if (rc == RC_WAIT) {
+        rc = WaitCommit();
+    }
+    return rc;
+}
 
-    //ADDBY TAAS
-    uint32_t readSetSize = 0; 
+RC TxnManager::SubmitCommit()
+{
+    uint32_t readSetSize = 0;
     m_occManager.updateInsertSetSize(this, readSetSize);
 
-    if(readSetSize == 0) {
+    if (readSetSize == 0) {
         return RC_OK;
     }
-//    if(m_occManager.GetRowSetSize(this) == 0) { //建表
-//        return RC_OK;
-//    }
 
-    auto time1 = now_to_us();
-    this->commit_state = RC::RC_WAIT;
-    if(!MOTAdaptor::InsertTxntoLocalChangeSet(this)) {
+    commit_submit_time = now_to_us();
+    {
+        std::lock_guard<std::mutex> lock(commit_mutex);
+        commit_state = RC::RC_WAIT;
+    }
+    // the verdict may be delivered by CompleteCommit() before this call returns
+    if (!MOTAdaptor::InsertTxntoLocalChangeSet(this)) {
         return RC::RC_ABORT;
     }
-    std::mutex _mutex;
-    std::unique_lock<std::mutex> _lock(_mutex);
-    cv.wait(_lock, [this](){
-        // MOT_LOG_INFO("被唤醒, 检查条件");
-        return commit_state != RC::RC_WAIT;
-    });
-    auto time2 = now_to_us();
-    MOT_LOG_INFO("csn %llu 成功被唤醒 time %llu %llu", GetCommitSequenceNumber(), time2, time2 - time1);
-    return commit_state;
+    return RC::RC_WAIT;
+}
+
+RC TxnManager::WaitCommit(uint64_t timeoutUs)
+{
+    std::unique_lock<std::mutex> lock(commit_mutex);
+    auto verdictArrived = [this]() { return commit_state != RC::RC_WAIT; };
+    if (timeoutUs == 0) {
+        cv.wait(lock, verdictArrived);
+    } else if (!cv.wait_for(lock, std::chrono::microseconds(timeoutUs), verdictArrived)) {
+        return RC::RC_WAIT;
+    }
+    RC rc = commit_state;
+    lock.unlock();
+
+    MOT::DbSessionStatisticsProvider::GetInstance().AddTaasRoundTripTime(now_to_us() - commit_submit_time);
+    return rc;
+}
+
+void TxnManager::CompleteCommit(RC rc)
+{
+    {
+        std::lock_guard<std::mutex> lock(commit_mutex);
+        if (commit_state != RC::RC_WAIT) {
+            return;
+        }
+        commit_state = rc;
+    }
+    cv.notify_all();
 }
 
 void TxnManager::RecordCommit()
 {
+    MOT::DbSessionStatisticsProvider& sessionStats = MOT::DbSessionStatisticsProvider::GetInstance();
+    bool collectStats = sessionStats.IsEnabled();
+    uint64_t startTime = collectStats ? GetSysClock() : 0;
     CommitInternal();
-    MOT::DbSessionStatisticsProvider::GetInstance().AddCommitTxn();
+    sessionStats.AddCommitTxn();
+    if (collectStats) {
+        sessionStats.AddCommitTime(CpuCyclesLevelTime::CyclesToMicroseconds(GetSysClock() - startTime));
+    }
 }
 
 RC TxnManager::Commit()
@@ -449,6 +513,7 @@ void TxnManager::Cleanup()
     m_internalTransactionId++;
     m_internalStmtCount = 0;
     m_redoLog.Reset();
+    EndSnapshot();
     GcSessionEnd();
     ClearErrorStack();
     m_accessMgr->ClearTableCache();
@@ -658,13 +723,15 @@ void TxnManager::CleanDDLChanges()
                 indexArr = (MOTIndexArr*)ddl_access->GetEntry();
                 table = indexArr->GetTable();
                 if (indexArr->GetNumIndexes() > 0) {
-                    table->m_rowCount = 0;
+                    table->m_rowCount.store(0, std::memory_order_relaxed);
                     for (int i = 0; i < indexArr->GetNumIndexes(); i++) {
                         index = indexArr->GetIndex(i);
                         table->DeleteIndex(index);
                     }
                 }
                 table->FreeObjectPool(indexArr->GetRowPool());
+                // the removed rows are not tracked by the delta checkpoint
+                table->SetCheckpointFullData();
                 delete indexArr;
                 break;
             case DDL_ACCESS_CREATE_INDEX:
@@ -744,7 +811,12 @@ TxnManager::TxnManager(SessionContext* session_context)
       m_isolationLevel(READ_COMMITED),
       m_isLightSession(false),
       m_errIx(nullptr),
-      m_err(RC_OK)
+      m_err(RC_OK),
+      commit_state(RC_OK),
+      commit_submit_time(0),
+      commit_node(0),
+      m_snapshotCsn(0),
+      m_snapshotSlot(SnapshotRegistry::INVALID_SLOT)
 {
     m_key = nullptr;
     m_state = TxnState::TXN_START;
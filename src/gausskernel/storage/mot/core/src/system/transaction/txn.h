@@ -44,6 +44,7 @@
 #include "commit_sequence_number.h"
 
 #include <condition_variable>
+#include <mutex>
 
 namespace MOT {
 class MOTContext;
@@ -161,12 +162,46 @@ public:
      */
     RC StartTransaction(uint64_t transactionId, int isolationLevel);
 
+    /**
+     * @brief Makes the reads of this transaction see the row versions committed up to the stable CSN, instead of
+     * the latest ones. Snapshot reads are not validated, so a read-only transaction using them never aborts. Ends
+     * with the transaction.
+     * @return True if a snapshot was taken, false if row versions are disabled or all snapshot slots are taken.
+     */
+    bool BeginSnapshot();
+
+    /** @brief Retrieves the snapshot CSN of the transaction, 0 if it reads the latest row versions. */
+    inline uint64_t GetSnapshotCsn() const
+    {
+        return m_snapshotCsn;
+    }
+
     /**
      * @brief Performs pre-commit validation (OCC validation).
      * @return Result code denoting success or failure.
      */
     RC ValidateCommit();
 
+    /**
+     * @brief Hands the transaction off to the TaaS commit pipeline without waiting for its verdict.
+     * @return RC_WAIT if the transaction is in flight, RC_OK if there is nothing to certify, or
+     * RC_ABORT if the hand-off failed.
+     */
+    RC SubmitCommit();
+
+    /**
+     * @brief Waits for the verdict of a transaction previously handed off with SubmitCommit().
+     * @param timeoutUs Maximum time to wait in microseconds, 0 waits until the verdict arrives.
+     * @return Result code denoting success or failure, RC_WAIT if the wait timed out.
+     */
+    RC WaitCommit(uint64_t timeoutUs = 0);
+
+    /**
+     * @brief Delivers the TaaS verdict of an in-flight transaction and wakes up its waiter.
+     * @param rc RC_OK if the transaction committed, RC_ABORT otherwise.
+     */
+    void CompleteCommit(RC rc);
+
     /**
      * @brief Performs the actual commit (write redo and apply changes).
      */
@@ -576,7 +611,18 @@ public:
     
     //ADDBY TAAS
     RC commit_state;
+    std::mutex commit_mutex;
     std::condition_variable cv;
+    uint64_t commit_submit_time;
+    uint64_t commit_node; // txn node the change set was routed to
+
+    /** @var Snapshot CSN of the transaction, 0 reads the latest row versions. */
+    uint64_t m_snapshotCsn;
+
+    /** @var Slot of the snapshot in the SnapshotRegistry. */
+    uint32_t m_snapshotSlot;
+
+    void EndSnapshot();
     RC TaasLogCommit();
     Key* GetTxnKey(MOT::Index* index, void* buf);
     
@@ -702,6 +702,21 @@ Row* TxnAccess::GetReadCommitedRow(Sentinel* sentinel)
     } else
         return nullptr;
 }
+Row* TxnAccess::GetSnapshotRow(Sentinel* sentinel, uint64_t snapshotCsn)
+{
+    TransactionId last_tid;
+    Row* row = sentinel->GetData();
+    if (row == nullptr) {
+        return nullptr;
+    }
+    Row* version = row->GetVisibleVersion(snapshotCsn);
+    // deleted versions fail the copy
+    if (version == nullptr || version->GetRow(AccessType::RD, this, m_rowZero, last_tid) != RC::RC_OK) {
+        return nullptr;
+    }
+    return m_rowZero;
+}
+
 RC TxnAccess::GenerateDeletes(Access* element)
 {
     RC rc = RC_OK;
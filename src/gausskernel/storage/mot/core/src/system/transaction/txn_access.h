@@ -187,6 +187,14 @@ public:
      */
     Row* GetReadCommitedRow(Sentinel* sentinel);
 
+    /**
+     * @brief For snapshot reads we return a copy of the row version visible at the snapshot
+     * @param sentinel The row-header
+     * @param snapshotCsn The snapshot CSN
+     * @return row zero with the version copy, nullptr if the row is not visible at the snapshot
+     */
+    Row* GetSnapshotRow(Sentinel* sentinel, uint64_t snapshotCsn);
+
     /**
      * @brief Undo insert operation if possible after delete
      * @param element Current row to be deleted
@@ -27,6 +27,7 @@
 #include "commit_group.h"
 #include "utilities.h"
 #include "group_synchronous_redo_log_handler.h"
+#include "log_statistics.h"
 
 namespace MOT {
 DECLARE_LOGGER(CommitGroup, RedoLog);
@@ -76,8 +77,14 @@ int CommitGroup::AddToGroup(RedoLogBuffer* buffer)
 void CommitGroup::LogGroup()
 {
     ILogger* logger = m_handler->GetLogger();
+    std::chrono::steady_clock::time_point flushStart = std::chrono::steady_clock::now();
     logger->AddToLog(m_groupData, m_groupSize);
     logger->FlushLog();
+    std::chrono::nanoseconds flushTime = std::chrono::steady_clock::now() - flushStart;
+    m_handler->ReportFlush((uint64_t)flushTime.count());
+    LogStatisticsProvider& logStats = LogStatisticsProvider::GetInstance();
+    logStats.AddLogFlushTime((uint64_t)flushTime.count() / 1000);
+    logStats.AddGroupCommitSize(m_groupSize);
     m_commited = true;
     MOT_LOG_DEBUG("group committed. num entries: %d, handler id: %d", m_groupSize, m_handlerId);
 }
@@ -59,6 +59,12 @@ public:
         return m_groupSize;
     }
 
+    /** @brief Retrieves the size at which the group closes (fixed when the group is created). */
+    inline uint64_t GetMaxGroupSize() const
+    {
+        return m_maxGroupCommitSize;
+    }
+
     /**
      * @brief Flushes the group to the logger
      */
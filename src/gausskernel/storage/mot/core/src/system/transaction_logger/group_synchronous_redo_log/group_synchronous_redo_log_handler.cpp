@@ -26,17 +26,46 @@
 #include "group_synchronous_redo_log_handler.h"
 #include "utilities.h"
 #include "mot_configuration.h"
+#include "log_statistics.h"
 
 namespace MOT {
 DECLARE_LOGGER(GroupSyncRedoLogHandler, RedoLog)
 
-GroupSyncRedoLogHandler::GroupSyncRedoLogHandler(const uint8_t socketId) : m_id(socketId), m_currentGroup(nullptr)
+// moving averages give each new sample a weight of 1/8
+static const uint32_t GROUP_COMMIT_AVG_SHIFT = 3;
+
+static inline uint64_t GetNanos()
+{
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+static inline void UpdateAverage(std::atomic<uint64_t>& average, uint64_t sample)
+{
+    // concurrent updates may get lost, which is harmless for an estimate
+    uint64_t current = average.load(std::memory_order_relaxed);
+    uint64_t next = (current == 0) ? sample
+                                   : current - (current >> GROUP_COMMIT_AVG_SHIFT) + (sample >> GROUP_COMMIT_AVG_SHIFT);
+    average.store(next, std::memory_order_relaxed);
+}
+
+GroupSyncRedoLogHandler::GroupSyncRedoLogHandler(const uint8_t socketId)
+    : m_id(socketId),
+      m_currentGroup(nullptr),
+      m_groupCommitSize(GetGlobalConfiguration().m_groupCommitSize),
+      m_groupTimeoutUSec(GetGlobalConfiguration().m_groupCommitTimeoutUSec),
+      m_lastArrivalNanos(0),
+      m_avgArrivalGapNanos(0),
+      m_avgFlushNanos(0)
 {
-    m_groupCommitSize = GetGlobalConfiguration().m_groupCommitSize;
-    m_groupTimeout = std::chrono::microseconds(GetGlobalConfiguration().m_groupCommitTimeoutUSec);
     MOT_LOG_INFO("Group commit initialized with group size %u and timeout %u micro-seconds",
-        (unsigned)m_groupCommitSize,
+        (unsigned)GetGlobalConfiguration().m_groupCommitSize,
         (unsigned)GetGlobalConfiguration().m_groupCommitTimeoutUSec);
+    if (GetGlobalConfiguration().m_enableAdaptiveGroupCommit) {
+        MOT_LOG_INFO("Adaptive group commit enabled with latency target %u micro-seconds",
+            (unsigned)GetGlobalConfiguration().m_groupCommitLatencySloUSec);
+    }
 }
 
 GroupSyncRedoLogHandler::~GroupSyncRedoLogHandler()
@@ -64,23 +93,85 @@ void GroupSyncRedoLogHandler::DestroyBuffer(RedoLogBuffer* buffer)
 void GroupSyncRedoLogHandler::CloseGroup(std::shared_ptr<CommitGroup> group)
 {
     std::shared_ptr<CommitGroup> nullGroup(nullptr);
-    std::atomic_compare_exchange_weak(&m_currentGroup, &group, nullGroup);
+    if (!std::atomic_compare_exchange_strong(&m_currentGroup, &group, nullGroup)) {
+        // the group was already closed by another member, which also set up the next groups
+        return;
+    }
+    if (GetGlobalConfiguration().m_enableAdaptiveGroupCommit) {
+        AdaptGroupParams();
+        return;
+    }
     uint64_t curGroupCommitSize = GetGlobalConfiguration().m_groupCommitSize;
-    std::chrono::microseconds curGroupCommitTimeoutUSec =
-        std::chrono::microseconds(GetGlobalConfiguration().m_groupCommitTimeoutUSec);
-    if (curGroupCommitSize != m_groupCommitSize) {
-        m_groupCommitSize = curGroupCommitSize;
-        MOT_LOG_DEBUG("closeGroup: group commit size changed to %lu", m_groupCommitSize);
+    uint64_t curGroupCommitTimeoutUSec = GetGlobalConfiguration().m_groupCommitTimeoutUSec;
+    if (curGroupCommitSize != m_groupCommitSize.load(std::memory_order_relaxed)) {
+        m_groupCommitSize.store(curGroupCommitSize, std::memory_order_relaxed);
+        MOT_LOG_DEBUG("closeGroup: group commit size changed to %" PRIu64, curGroupCommitSize);
     }
-    if (curGroupCommitTimeoutUSec != m_groupTimeout) {
-        m_groupTimeout = curGroupCommitTimeoutUSec;
-        MOT_LOG_DEBUG(
-            "closeGroup: group commit timeout changed to %lu", GetGlobalConfiguration().m_groupCommitTimeoutUSec);
+    if (curGroupCommitTimeoutUSec != m_groupTimeoutUSec.load(std::memory_order_relaxed)) {
+        m_groupTimeoutUSec.store(curGroupCommitTimeoutUSec, std::memory_order_relaxed);
+        MOT_LOG_DEBUG("closeGroup: group commit timeout changed to %" PRIu64, curGroupCommitTimeoutUSec);
+    }
+}
+
+void GroupSyncRedoLogHandler::ReportArrival(uint64_t nowNanos)
+{
+    uint64_t prevNanos = m_lastArrivalNanos.exchange(nowNanos, std::memory_order_relaxed);
+    if (prevNanos == 0 || prevNanos >= nowNanos) {
+        return;
+    }
+
+    // an idle period longer than the latency target tells nothing more than the target itself, and capping it lets
+    // the average recover quickly when load returns
+    uint64_t sloNanos = GetGlobalConfiguration().m_groupCommitLatencySloUSec * 1000;
+    UpdateAverage(m_avgArrivalGapNanos, std::min(nowNanos - prevNanos, sloNanos));
+}
+
+void GroupSyncRedoLogHandler::ReportFlush(uint64_t flushNanos)
+{
+    UpdateAverage(m_avgFlushNanos, flushNanos);
+}
+
+void GroupSyncRedoLogHandler::AdaptGroupParams()
+{
+    MOTConfiguration& cfg = GetGlobalConfiguration();
+    uint64_t maxGroupSize = std::min(cfg.m_groupCommitSize, (uint64_t)MAX_GROUP_SIZE);
+    uint64_t maxTimeoutNanos = cfg.m_groupCommitTimeoutUSec * 1000;
+    uint64_t sloNanos = cfg.m_groupCommitLatencySloUSec * 1000;
+    uint64_t arrivalGapNanos = m_avgArrivalGapNanos.load(std::memory_order_relaxed);
+    uint64_t flushNanos = m_avgFlushNanos.load(std::memory_order_relaxed);
+
+    uint64_t groupSize = maxGroupSize;
+    uint64_t timeoutNanos = maxTimeoutNanos;
+    if (arrivalGapNanos != 0) {
+        // the leader may wait whatever the expected flush leaves of the latency target
+        uint64_t budgetNanos = (sloNanos > flushNanos) ? std::min(sloNanos - flushNanos, maxTimeoutNanos) : 0;
+        groupSize = std::min(1 + budgetNanos / arrivalGapNanos, maxGroupSize);
+        timeoutNanos = std::min((groupSize - 1) * arrivalGapNanos, budgetNanos);
+    }
+
+    uint64_t timeoutUSec = (timeoutNanos + 999) / 1000;
+    if (groupSize != m_groupCommitSize.load(std::memory_order_relaxed) ||
+        timeoutUSec != m_groupTimeoutUSec.load(std::memory_order_relaxed)) {
+        m_groupCommitSize.store(groupSize, std::memory_order_relaxed);
+        m_groupTimeoutUSec.store(timeoutUSec, std::memory_order_relaxed);
+        MOT_LOG_DEBUG("Adaptive group commit: group size %" PRIu64 ", timeout %" PRIu64
+                      " micro-seconds (arrival gap %" PRIu64 " ns, flush %" PRIu64 " ns)",
+            groupSize,
+            timeoutUSec,
+            arrivalGapNanos,
+            flushNanos);
     }
 }
 
 RedoLogBuffer* GroupSyncRedoLogHandler::WriteToLog(RedoLogBuffer* buffer)
 {
+    bool adaptive = GetGlobalConfiguration().m_enableAdaptiveGroupCommit;
+    bool collectStats = LogStatisticsProvider::GetInstance().IsEnabled();
+    uint64_t startNanos = (adaptive || collectStats) ? GetNanos() : 0;
+    if (adaptive) {
+        ReportArrival(startNanos);
+    }
+
     // CAS requires and actual shared_ptr
     std::shared_ptr<CommitGroup> nullGroup(nullptr);
     std::shared_ptr<CommitGroup> joinedGroup(nullptr);
@@ -98,7 +189,7 @@ RedoLogBuffer* GroupSyncRedoLogHandler::WriteToLog(RedoLogBuffer* buffer)
             // success means that I am the leader
             leader = true;
             joinedGroup = myGroup;
-        } else if (m_groupCommitSize == 1) {
+        } else if (GetGroupCommitSize() == 1) {
             // no point in trying to join a group of size 1 that already has a leader
             cpu_relax();
             continue;
@@ -142,7 +233,7 @@ RedoLogBuffer* GroupSyncRedoLogHandler::WriteToLog(RedoLogBuffer* buffer)
         }
 
         joined = true;
-        if (groupIndex == (int)m_groupCommitSize) {
+        if (groupIndex == (int)joinedGroup->GetMaxGroupSize()) {
             // I am the last to join the group
             // The group will be closed anyhow by the group leader but for
             // optimization, maybe we can close the group earlier (HERE)
@@ -153,6 +244,9 @@ RedoLogBuffer* GroupSyncRedoLogHandler::WriteToLog(RedoLogBuffer* buffer)
     }
 
     joinedGroup->Commit(leader, joinedGroup);
+    if (collectStats) {
+        LogStatisticsProvider::GetInstance().AddGroupCommitWait((GetNanos() - startNanos) / 1000);
+    }
     return buffer;
 }
 
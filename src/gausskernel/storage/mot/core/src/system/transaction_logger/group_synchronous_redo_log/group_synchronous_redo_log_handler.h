@@ -66,29 +66,59 @@ public:
     void Flush();
 
     /**
-     * @brief initializes group params
+     * @brief Closes a group for new members. The thread that actually removes the group from the handler also
+     * computes the size and timeout of the next groups, so they are never written concurrently.
      * @param group the group to work on
      */
     void CloseGroup(std::shared_ptr<CommitGroup> group);
 
     inline uint64_t GetGroupCommitSize()
     {
-        return m_groupCommitSize;
+        return m_groupCommitSize.load(std::memory_order_relaxed);
     }
-    inline std::chrono::microseconds& GetGroupTimeout()
+    inline std::chrono::microseconds GetGroupTimeout()
     {
-        return m_groupTimeout;
+        return std::chrono::microseconds(m_groupTimeoutUSec.load(std::memory_order_relaxed));
     }
     inline void SetId(uint8_t handlerId)
     {
         m_id = handlerId;
     }
 
+    /**
+     * @brief Reports the time it took a group leader to write and flush its group, feeding adaptive group commit.
+     * @param flushNanos The flush time in nano-seconds.
+     */
+    void ReportFlush(uint64_t flushNanos);
+
 private:
+    /** @brief Samples the time since the previous transaction arrived, feeding adaptive group commit. */
+    void ReportArrival(uint64_t nowNanos);
+
+    /**
+     * @brief Computes the size and timeout of the next groups. With adaptive group commit the leader waits only as
+     * long as the expected flush time leaves of the latency target, and only for as many transactions as are expected
+     * to arrive meanwhile. The configured size and timeout are upper bounds.
+     */
+    void AdaptGroupParams();
+
     uint8_t m_id;  // in segmented group handler, represents the socket id, otherwise 0
     std::shared_ptr<CommitGroup> m_currentGroup;
-    uint64_t m_groupCommitSize;
-    std::chrono::microseconds m_groupTimeout;
+
+    /** @var Size of the next groups, read by every committer when it creates a group. */
+    std::atomic<uint64_t> m_groupCommitSize;
+
+    /** @var Timeout in micro-seconds of the next groups, read by every committer when it creates a group. */
+    std::atomic<uint64_t> m_groupTimeoutUSec;
+
+    /** @var Time stamp in nano-seconds of the last transaction arrival (adaptive group commit). */
+    std::atomic<uint64_t> m_lastArrivalNanos;
+
+    /** @var Moving average of the time between transaction arrivals, or zero if not sampled yet. */
+    std::atomic<uint64_t> m_avgArrivalGapNanos;
+
+    /** @var Moving average of the group flush time, or zero if not sampled yet. */
+    std::atomic<uint64_t> m_avgFlushNanos;
 };
 } /* namespace MOT */
 
@@ -89,6 +89,24 @@ public:
     /** Close the logger and the underlying I/O object. */
     virtual void CloseLog() = 0;
 
+    /**
+     * Marks the redo point of a checkpoint. Called while no transaction can write to the log, so that everything
+     * logged afterwards is replayed on top of the checkpoint.
+     * @param checkpointId The identifier of the checkpoint being taken.
+     * @return True if succeeded, otherwise false.
+     */
+    virtual bool RotateLog(uint64_t checkpointId)
+    {
+        return true;
+    }
+
+    /**
+     * Releases the redo covered by a completed checkpoint.
+     * @param checkpointId The identifier of the completed checkpoint.
+     */
+    virtual void ReleaseLog(uint64_t checkpointId)
+    {}
+
     /** For testing purposes. */
     virtual void ClearLog() = 0;
 };
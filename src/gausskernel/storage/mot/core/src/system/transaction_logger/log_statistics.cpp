@@ -39,10 +39,16 @@ LogThreadStatistics::LogThreadStatistics(uint64_t threadId, void* inplaceBuffer)
     : ThreadStatistics(threadId, inplaceBuffer),
       m_txnBuffersDrained(MakeName("txn-buffers-drained", threadId).c_str()),
       m_txnBytesDrained(MakeName("txn-bytes-drained", threadId).c_str()),
-      m_bytesWritten(MakeName("log-bytes-written", threadId).c_str())
+      m_bytesWritten(MakeName("log-bytes-written", threadId).c_str()),
+      m_groupCommitSize(MakeName("group-commit-size", threadId).c_str()),
+      m_groupCommitWait(MakeName("group-commit-wait", threadId).c_str(), "us"),
+      m_logFlushTime(MakeName("log-flush-time", threadId).c_str(), "us")
 {
     RegisterStatistics(&m_txnBuffersDrained);
     RegisterStatistics(&m_txnBytesDrained);
+    RegisterStatistics(&m_groupCommitSize);
+    RegisterStatistics(&m_groupCommitWait);
+    RegisterStatistics(&m_logFlushTime);
 }
 
 LogGlobalStatistics::LogGlobalStatistics(GlobalStatistics::NamingScheme namingScheme)
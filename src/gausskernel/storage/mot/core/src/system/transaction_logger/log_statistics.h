@@ -26,6 +26,7 @@
 #define LOG_STATISTICS_H
 
 #include "frequency_statistic_variable.h"
+#include "histogram_statistic_variable.h"
 #include "rate_statistic_variable.h"
 #include "iconfig_change_listener.h"
 #include "numeric_statistic_variable.h"
@@ -56,10 +57,34 @@ public:
         m_bytesWritten.AddSample(bytes);
     }
 
+    inline void AddGroupCommitSize(uint64_t groupSize)
+    {
+        m_groupCommitSize.AddSample(groupSize);
+    }
+
+    inline void AddGroupCommitWait(uint64_t waitUSec)
+    {
+        m_groupCommitWait.AddSample(waitUSec);
+    }
+
+    inline void AddLogFlushTime(uint64_t flushUSec)
+    {
+        m_logFlushTime.AddSample(flushUSec);
+    }
+
 private:
     FrequencyStatisticVariable m_txnBuffersDrained;
     DataRateStatisticVariable m_txnBytesDrained;
     DataRateStatisticVariable m_bytesWritten;
+
+    /** @var The number of transactions in each commit group (sampled by group leaders). */
+    HistogramStatisticVariable m_groupCommitSize;
+
+    /** @var The time transactions spend in group commit, from joining a group until it is flushed. */
+    HistogramStatisticVariable m_groupCommitWait;
+
+    /** @var The time it takes to write and flush redo to the logger (once per group in group commit). */
+    HistogramStatisticVariable m_logFlushTime;
 };
 
 class LogGlobalStatistics : public GlobalStatistics {
@@ -121,6 +146,30 @@ public:
         }
     }
 
+    inline void AddGroupCommitSize(uint64_t groupSize)
+    {
+        LogThreadStatistics* lts = GetCurrentThreadStatistics<LogThreadStatistics>();
+        if (lts != nullptr) {
+            lts->AddGroupCommitSize(groupSize);
+        }
+    }
+
+    inline void AddGroupCommitWait(uint64_t waitUSec)
+    {
+        LogThreadStatistics* lts = GetCurrentThreadStatistics<LogThreadStatistics>();
+        if (lts != nullptr) {
+            lts->AddGroupCommitWait(waitUSec);
+        }
+    }
+
+    inline void AddLogFlushTime(uint64_t flushUSec)
+    {
+        LogThreadStatistics* lts = GetCurrentThreadStatistics<LogThreadStatistics>();
+        if (lts != nullptr) {
+            lts->AddLogFlushTime(flushUSec);
+        }
+    }
+
     inline void AddLogFlush()
     {
         LogGlobalStatistics* lts = GetGlobalStatistics<LogGlobalStatistics>();
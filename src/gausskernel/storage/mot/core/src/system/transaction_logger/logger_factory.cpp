@@ -23,8 +23,10 @@
  */
 
 #include "logger_factory.h"
+#include "native_logger.h"
 #include "mot_configuration.h"
 #include "utilities.h"
+#include "mot_error.h"
 
 namespace MOT {
 DECLARE_LOGGER(LoggerFactory, Logger)
@@ -41,6 +43,19 @@ ILogger* LoggerFactory::CreateLogger()
             case LoggerType::EXTERNAL_LOGGER:
                 return nullptr;
 
+            case LoggerType::NATIVE_LOGGER: {
+                NativeLogger* logger = new (std::nothrow) NativeLogger();
+                if (logger == nullptr) {
+                    MOT_REPORT_ERROR(MOT_ERROR_OOM, "Logger Initialization", "Failed to allocate native logger");
+                    return nullptr;
+                }
+                if (!logger->Initialize()) {
+                    delete logger;
+                    return nullptr;
+                }
+                return logger;
+            }
+
             default:
                 return nullptr;
         }
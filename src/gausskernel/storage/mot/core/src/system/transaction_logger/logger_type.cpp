@@ -30,9 +30,10 @@ namespace MOT {
 DECLARE_LOGGER(LoggerType, Logger)
 
 static const char* EXTERNAL_LOGGER_STR = "external";
+static const char* NATIVE_LOGGER_STR = "native";
 static const char* INVALID_LOGGER_STR = "INVALID";
 
-static const char* loggerNames[] = {EXTERNAL_LOGGER_STR, INVALID_LOGGER_STR};
+static const char* loggerNames[] = {EXTERNAL_LOGGER_STR, NATIVE_LOGGER_STR, INVALID_LOGGER_STR};
 
 extern LoggerType LoggerTypeFromString(const char* loggerTypeName)
 {
@@ -40,6 +41,8 @@ extern LoggerType LoggerTypeFromString(const char* loggerTypeName)
 
     if (strcmp(loggerTypeName, EXTERNAL_LOGGER_STR) == 0) {
         loggerType = LoggerType::EXTERNAL_LOGGER;
+    } else if (strcmp(loggerTypeName, NATIVE_LOGGER_STR) == 0) {
+        loggerType = LoggerType::NATIVE_LOGGER;
     } else {
         MOT_LOG_ERROR("Invalid logger type: %s", loggerTypeName);
     }
@@ -35,6 +35,9 @@ namespace MOT {
 enum class LoggerType : uint32_t { /** @var Denotes ExternalLogger provided by envelope. */
     EXTERNAL_LOGGER = 0,
 
+    /** @var Denotes NativeLogger writing MOT log files. */
+    NATIVE_LOGGER,
+
     /** @var Invalid logger value. */
     INVALID_LOGGER
 };
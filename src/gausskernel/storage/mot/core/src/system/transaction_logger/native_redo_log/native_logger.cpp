@@ -0,0 +1,730 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * -------------------------------------------------------------------------
+ *
+ * native_logger.cpp
+ *    Redo logger writing MOT log files in parallel streams, bypassing the envelope WAL.
+ *
+ * IDENTIFICATION
+ *    src/gausskernel/storage/mot/core/src/system/transaction_logger/
+ *        native_redo_log/native_logger.cpp
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include <algorithm>
+#include <map>
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "native_logger.h"
+#include "redo_log_writer.h"
+#include "checkpoint_utils.h"
+#include "checkpoint_ctrlfile.h"
+#include "mot_configuration.h"
+#include "session_context.h"
+#include "thread_id.h"
+#include "debug_utils.h"
+#include "mot_error.h"
+
+#include "postgres.h"
+#include "port/pg_crc32c.h"
+
+namespace MOT {
+DECLARE_LOGGER(NativeLogger, RedoLog)
+
+// generation files are named mot_redo_<generation>.gen, stream files are named mot_redo_<generation>_<stream>.log
+static const char* NATIVE_LOG_PREFIX = "mot_redo_";
+static const char* NATIVE_LOG_GENERATION_SUFFIX = ".gen";
+static const char* NATIVE_LOG_STREAM_SUFFIX = ".log";
+
+static const uint32_t NATIVE_LOG_RECORD_MAGIC = 0x4d4f5452;
+static const uint64_t NATIVE_LOG_GENERATION_MAGIC = 0x4d4f5447454e0001;
+
+/** @var Records are padded so that the redo data of each record is 8-byte aligned in the loaded file. */
+static const size_t NATIVE_LOG_RECORD_ALIGNMENT = 8;
+static const size_t NATIVE_LOG_INITIAL_BUFFER_SIZE = 64 * 1024;
+
+/** @struct NativeLogRecordHeader The header preceding each redo record in a stream file. */
+struct NativeLogRecordHeader {
+    uint32_t m_magic;
+
+    /** @var The size of the redo data following the header (without padding). */
+    uint32_t m_size;
+
+    /** @var The commit sequence number of the logged transaction, by which records are replayed. */
+    uint64_t m_csn;
+
+    /** @var CRC32C of the fields above and the redo data. */
+    uint32_t m_crc;
+
+    uint32_t m_reserved;
+};
+
+/** @struct NativeLogGenerationHeader The contents of a generation file. */
+struct NativeLogGenerationHeader {
+    uint64_t m_magic;
+
+    /** @var The checkpoint whose redo point started the generation, or invalidId if started by a restart. */
+    uint64_t m_checkpointId;
+};
+
+static inline size_t RecordSize(uint32_t dataSize)
+{
+    size_t size = sizeof(NativeLogRecordHeader) + dataSize;
+    return (size + NATIVE_LOG_RECORD_ALIGNMENT - 1) & ~(NATIVE_LOG_RECORD_ALIGNMENT - 1);
+}
+
+static uint32_t RecordCrc(const NativeLogRecordHeader* header, const char* data)
+{
+    pg_crc32c crc;
+    INIT_CRC32C(crc);
+    COMP_CRC32C(crc, header, offsetof(NativeLogRecordHeader, m_crc));
+    COMP_CRC32C(crc, data, header->m_size);
+    FIN_CRC32C(crc);
+    return crc;
+}
+
+// a serialized redo buffer is a length-prefixed transaction segment that ends with its EndSegmentBlock
+static uint64_t GetRecordCsn(const uint8_t* data, uint32_t size)
+{
+    uint32_t txnLength = 0;
+    EndSegmentBlock endSegment;
+    if (size < sizeof(txnLength)) {
+        return 0;
+    }
+    errno_t erc = memcpy_s(&txnLength, sizeof(txnLength), data, sizeof(txnLength));
+    securec_check(erc, "\0", "\0");
+    if (txnLength > size || txnLength < sizeof(txnLength) + sizeof(EndSegmentBlock)) {
+        return 0;
+    }
+    erc = memcpy_s(&endSegment, sizeof(endSegment), data + txnLength - sizeof(EndSegmentBlock), sizeof(endSegment));
+    securec_check(erc, "\0", "\0");
+    return endSegment.m_csn;
+}
+
+static void MakeGenerationFileName(std::string& fileName, const std::string& logDir, uint64_t generation)
+{
+    fileName = logDir;
+    fileName.append(NATIVE_LOG_PREFIX);
+    fileName.append(std::to_string(generation));
+    fileName.append(NATIVE_LOG_GENERATION_SUFFIX);
+}
+
+static void MakeStreamFileName(std::string& fileName, const std::string& logDir, uint64_t generation, uint32_t stream)
+{
+    fileName = logDir;
+    fileName.append(NATIVE_LOG_PREFIX);
+    fileName.append(std::to_string(generation));
+    fileName.append("_");
+    fileName.append(std::to_string(stream));
+    fileName.append(NATIVE_LOG_STREAM_SUFFIX);
+}
+
+/**
+ * @brief Parses the name of a native log file.
+ * @param name The file name.
+ * @param[out] generation The generation of the file.
+ * @param[out] stream The stream of a stream file (unchanged for a generation file).
+ * @param[out] isGenerationFile Whether this is a generation file or a stream file.
+ * @return True if this is a native log file, otherwise false.
+ */
+static bool ParseLogFileName(const char* name, uint64_t& generation, uint32_t& stream, bool& isGenerationFile)
+{
+    size_t prefixLen = strlen(NATIVE_LOG_PREFIX);
+    if (strncmp(name, NATIVE_LOG_PREFIX, prefixLen) != 0 || !isdigit((unsigned char)name[prefixLen])) {
+        return false;
+    }
+
+    char* end = nullptr;
+    generation = strtoull(name + prefixLen, &end, 10);
+    if (strcmp(end, NATIVE_LOG_GENERATION_SUFFIX) == 0) {
+        isGenerationFile = true;
+        return true;
+    }
+
+    if (end[0] != '_' || !isdigit((unsigned char)end[1])) {
+        return false;
+    }
+    const char* streamStr = end + 1;
+    unsigned long streamId = strtoul(streamStr, &end, 10);
+    if (strcmp(end, NATIVE_LOG_STREAM_SUFFIX) != 0) {
+        return false;
+    }
+    stream = (uint32_t)streamId;
+    isGenerationFile = false;
+    return true;
+}
+
+static bool SyncDir(const std::string& dirName)
+{
+    int fd = open(dirName.c_str(), O_RDONLY | O_DIRECTORY);
+    if (fd == -1) {
+        MOT_REPORT_SYSTEM_ERROR(open, "Native Redo Log", "Failed to open directory %s", dirName.c_str());
+        return false;
+    }
+    bool result = (fsync(fd) == 0);
+    if (!result) {
+        MOT_REPORT_SYSTEM_ERROR(fsync, "Native Redo Log", "Failed to sync directory %s", dirName.c_str());
+    }
+    (void)close(fd);
+    return result;
+}
+
+static bool WriteAll(int fd, const char* data, size_t size, const std::string& fileName)
+{
+    while (size > 0) {
+        ssize_t written = write(fd, data, size);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            MOT_REPORT_SYSTEM_ERROR(write, "Native Redo Log", "Failed to write to %s", fileName.c_str());
+            return false;
+        }
+        data += written;
+        size -= (size_t)written;
+    }
+    return true;
+}
+
+static bool ReadAll(int fd, char* data, size_t size, const std::string& fileName)
+{
+    while (size > 0) {
+        ssize_t bytesRead = read(fd, data, size);
+        if (bytesRead < 0 && errno == EINTR) {
+            continue;
+        }
+        if (bytesRead <= 0) {
+            MOT_REPORT_SYSTEM_ERROR(read, "Native Redo Log", "Failed to read from %s", fileName.c_str());
+            return false;
+        }
+        data += bytesRead;
+        size -= (size_t)bytesRead;
+    }
+    return true;
+}
+
+static bool WriteGenerationFile(const std::string& logDir, uint64_t generation, uint64_t checkpointId)
+{
+    std::string fileName;
+    MakeGenerationFileName(fileName, logDir, generation);
+    int fd = open(fileName.c_str(), O_CREAT | O_TRUNC | O_WRONLY, S_IRUSR | S_IWUSR); /* 0600 */
+    if (fd == -1) {
+        MOT_REPORT_SYSTEM_ERROR(open, "Native Redo Log", "Failed to create %s", fileName.c_str());
+        return false;
+    }
+
+    NativeLogGenerationHeader header = {NATIVE_LOG_GENERATION_MAGIC, checkpointId};
+    bool result = WriteAll(fd, (const char*)&header, sizeof(header), fileName) &&
+                  (CheckpointUtils::FlushFile(fd) == 0);
+    (void)CheckpointUtils::CloseFile(fd);
+    return result && SyncDir(logDir);
+}
+
+static uint64_t ReadGenerationFile(const std::string& logDir, uint64_t generation)
+{
+    std::string fileName;
+    MakeGenerationFileName(fileName, logDir, generation);
+    NativeLogGenerationHeader header = {0, CheckpointControlFile::invalidId};
+    int fd = open(fileName.c_str(), O_RDONLY);
+    if (fd == -1 || !ReadAll(fd, (char*)&header, sizeof(header), fileName) ||
+        header.m_magic != NATIVE_LOG_GENERATION_MAGIC) {
+        // a crash while rotating the log, the checkpoint that started the generation was not completed
+        MOT_LOG_WARN("Ignoring invalid native redo log generation file %s", fileName.c_str());
+        header.m_checkpointId = CheckpointControlFile::invalidId;
+    }
+    if (fd != -1) {
+        (void)close(fd);
+    }
+    return header.m_checkpointId;
+}
+
+/**
+ * @brief Lists the native log generations found in a directory.
+ * @param logDir The log directory.
+ * @param[out] generations Maps each generation to the checkpoint that started it.
+ * @return True if succeeded, otherwise false.
+ */
+static bool ListGenerations(const std::string& logDir, std::map<uint64_t, uint64_t>& generations)
+{
+    DIR* dir = opendir(logDir.c_str());
+    if (dir == nullptr) {
+        MOT_REPORT_SYSTEM_ERROR(opendir, "Native Redo Log", "Failed to open directory %s", logDir.c_str());
+        return false;
+    }
+
+    struct dirent* entry = nullptr;
+    while ((entry = readdir(dir)) != nullptr) {
+        uint64_t generation = 0;
+        uint32_t stream = 0;
+        bool isGenerationFile = false;
+        if (ParseLogFileName(entry->d_name, generation, stream, isGenerationFile) && isGenerationFile) {
+            generations[generation] = CheckpointControlFile::invalidId;
+        }
+    }
+    (void)closedir(dir);
+
+    for (std::map<uint64_t, uint64_t>::iterator it = generations.begin(); it != generations.end(); ++it) {
+        it->second = ReadGenerationFile(logDir, it->first);
+    }
+    return true;
+}
+
+static bool ReserveBuffer(char*& buffer, size_t& capacity, size_t required)
+{
+    if (required <= capacity) {
+        return true;
+    }
+    size_t newCapacity = std::max(std::max(capacity * 2, required), NATIVE_LOG_INITIAL_BUFFER_SIZE);
+    char* newBuffer = (char*)realloc(buffer, newCapacity);
+    if (newBuffer == nullptr) {
+        return false;
+    }
+    buffer = newBuffer;
+    capacity = newCapacity;
+    return true;
+}
+
+NativeLogger::NativeLogger() : m_generation(0), m_streamCount(0), m_streamPerNode(false), m_streams(nullptr)
+{}
+
+NativeLogger::~NativeLogger()
+{
+    if (m_streams != nullptr) {
+        for (uint32_t i = 0; i < m_streamCount; ++i) {
+            CloseStream(&m_streams[i]);
+            free(m_streams[i].m_buffer);
+            free(m_streams[i].m_flushBuffer);
+        }
+        delete[] m_streams;
+        m_streams = nullptr;
+    }
+}
+
+bool NativeLogger::Initialize()
+{
+    MOTConfiguration& cfg = GetGlobalConfiguration();
+    if (!CheckpointUtils::GetWorkingDir(m_logDir)) {
+        MOT_LOG_ERROR("Native redo log: failed to get the log directory");
+        return false;
+    }
+
+    m_streamPerNode = (cfg.m_nativeLogStreams == 0);
+    m_streamCount = m_streamPerNode ? std::max((uint32_t)cfg.m_numaNodes, (uint32_t)1) : cfg.m_nativeLogStreams;
+    m_streams = new (std::nothrow) LogStream[m_streamCount];
+    if (m_streams == nullptr) {
+        MOT_REPORT_ERROR(MOT_ERROR_OOM, "Native Redo Log", "Failed to allocate %u log streams", m_streamCount);
+        return false;
+    }
+    for (uint32_t i = 0; i < m_streamCount; ++i) {
+        m_streams[i].m_id = i;
+    }
+
+    // never append to the files of a previous run, a crash may have left a torn record at their end
+    std::map<uint64_t, uint64_t> generations;
+    if (!ListGenerations(m_logDir, generations)) {
+        return false;
+    }
+    m_generation = generations.empty() ? 1 : (generations.rbegin()->first + 1);
+    if (!WriteGenerationFile(m_logDir, m_generation, CheckpointControlFile::invalidId)) {
+        return false;
+    }
+
+    MOT_LOG_INFO("Native redo log: writing generation %" PRIu64 " in %u streams (%s) under %s",
+        m_generation,
+        m_streamCount,
+        m_streamPerNode ? "per NUMA node" : "per thread",
+        m_logDir.c_str());
+    return true;
+}
+
+NativeLogger::LogStream* NativeLogger::SelectStream()
+{
+    int node = m_streamPerNode ? MOTCurrentNumaNodeId : -1;
+    uint32_t index = 0;
+    if (node >= 0) {
+        index = (uint32_t)node;
+    } else if (MOTCurrThreadId != INVALID_THREAD_ID) {
+        index = (uint32_t)MOTCurrThreadId;
+    }
+    return &m_streams[index % m_streamCount];
+}
+
+uint64_t NativeLogger::AddToLog(uint8_t* data, uint32_t size)
+{
+    NativeLogRecordHeader header;
+    header.m_magic = NATIVE_LOG_RECORD_MAGIC;
+    header.m_size = size;
+    header.m_csn = GetRecordCsn(data, size);
+    header.m_reserved = 0;
+    header.m_crc = RecordCrc(&header, (const char*)data);
+    size_t recordSize = RecordSize(size);
+
+    LogStream* stream = SelectStream();
+    std::lock_guard<std::mutex> guard(stream->m_lock);
+    if (!ReserveBuffer(stream->m_buffer, stream->m_bufferCapacity, stream->m_bufferSize + recordSize)) {
+        MOT_REPORT_PANIC(MOT_ERROR_OOM,
+            "Native Redo Log",
+            "Failed to allocate %zu bytes for native redo log stream %u, aborting",
+            stream->m_bufferSize + recordSize,
+            stream->m_id);
+        MOTAbort();
+    }
+
+    char* record = stream->m_buffer + stream->m_bufferSize;
+    errno_t erc = memcpy_s(record, recordSize, &header, sizeof(header));
+    securec_check(erc, "\0", "\0");
+    if (size > 0) {
+        erc = memcpy_s(record + sizeof(header), recordSize - sizeof(header), data, size);
+        securec_check(erc, "\0", "\0");
+    }
+    size_t padding = recordSize - sizeof(header) - size;
+    if (padding > 0) {
+        erc = memset_s(record + sizeof(header) + size, padding, 0, padding);
+        securec_check(erc, "\0", "\0");
+    }
+    stream->m_bufferSize += recordSize;
+    stream->m_appendLsn += recordSize;
+    return size;
+}
+
+void NativeLogger::FlushLog()
+{
+    LogStream* stream = SelectStream();
+    std::unique_lock<std::mutex> lock(stream->m_lock);
+    if (!FlushStream(stream, lock)) {
+        // the commit cannot be made durable, just like a failed WAL write
+        MOT_REPORT_PANIC(MOT_ERROR_SYSTEM_FAILURE,
+            "Native Redo Log",
+            "Failed to flush native redo log stream %u, aborting",
+            stream->m_id);
+        MOTAbort();
+    }
+}
+
+bool NativeLogger::FlushStream(LogStream* stream, std::unique_lock<std::mutex>& lock)
+{
+    uint64_t targetLsn = stream->m_appendLsn;
+    while (stream->m_flushedLsn < targetLsn) {
+        if (stream->m_flushing) {
+            // records appended after the flush in progress started are written by the next flush
+            stream->m_flushedCV.wait(lock);
+            continue;
+        }
+
+        // lead a group made of all the records appended so far, appending goes on in the other buffer meanwhile
+        stream->m_flushing = true;
+        uint64_t flushLsn = stream->m_appendLsn;
+        size_t size = stream->m_bufferSize;
+        std::swap(stream->m_buffer, stream->m_flushBuffer);
+        std::swap(stream->m_bufferCapacity, stream->m_flushBufferCapacity);
+        stream->m_bufferSize = 0;
+        lock.unlock();
+
+        bool result = WriteStream(stream, stream->m_flushBuffer, size);
+
+        lock.lock();
+        stream->m_flushing = false;
+        if (result) {
+            stream->m_flushedLsn = flushLsn;
+        }
+        stream->m_flushedCV.notify_all();
+        if (!result) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool NativeLogger::WriteStream(LogStream* stream, const char* data, size_t size)
+{
+    std::string fileName;
+    MakeStreamFileName(fileName, m_logDir, m_generation, stream->m_id);
+    if (stream->m_fd == -1) {
+        stream->m_fd = open(fileName.c_str(), O_CREAT | O_WRONLY | O_APPEND, S_IRUSR | S_IWUSR); /* 0600 */
+        if (stream->m_fd == -1) {
+            MOT_REPORT_SYSTEM_ERROR(open, "Native Redo Log", "Failed to open %s", fileName.c_str());
+            return false;
+        }
+        if (!SyncDir(m_logDir)) {
+            return false;
+        }
+    }
+
+    return WriteAll(stream->m_fd, data, size, fileName) && (CheckpointUtils::FlushFile(stream->m_fd) == 0);
+}
+
+void NativeLogger::CloseStream(LogStream* stream)
+{
+    if (stream->m_fd != -1) {
+        (void)CheckpointUtils::CloseFile(stream->m_fd);
+        stream->m_fd = -1;
+    }
+}
+
+void NativeLogger::CloseLog()
+{
+    for (uint32_t i = 0; i < m_streamCount; ++i) {
+        LogStream* stream = &m_streams[i];
+        std::unique_lock<std::mutex> lock(stream->m_lock);
+        if (!FlushStream(stream, lock)) {
+            MOT_LOG_ERROR("Native redo log: failed to flush stream %u on close", stream->m_id);
+        }
+        CloseStream(stream);
+    }
+}
+
+void NativeLogger::ClearLog()
+{}
+
+bool NativeLogger::RotateLog(uint64_t checkpointId)
+{
+    // no transaction writes to the log now, so every record flushed so far is included in the checkpoint
+    for (uint32_t i = 0; i < m_streamCount; ++i) {
+        LogStream* stream = &m_streams[i];
+        std::unique_lock<std::mutex> lock(stream->m_lock);
+        if (!FlushStream(stream, lock)) {
+            MOT_LOG_ERROR("Native redo log: failed to flush stream %u at checkpoint %" PRIu64, i, checkpointId);
+            return false;
+        }
+    }
+
+    uint64_t generation = m_generation + 1;
+    if (!WriteGenerationFile(m_logDir, generation, checkpointId)) {
+        MOT_LOG_ERROR("Native redo log: failed to start generation %" PRIu64 " at checkpoint %" PRIu64,
+            generation,
+            checkpointId);
+        return false;
+    }
+
+    for (uint32_t i = 0; i < m_streamCount; ++i) {
+        CloseStream(&m_streams[i]);
+    }
+    m_generation = generation;
+    MOT_LOG_INFO("Native redo log: generation %" PRIu64 " started at checkpoint %" PRIu64, generation, checkpointId);
+    return true;
+}
+
+void NativeLogger::ReleaseLog(uint64_t checkpointId)
+{
+    std::map<uint64_t, uint64_t> generations;
+    if (!ListGenerations(m_logDir, generations)) {
+        return;
+    }
+
+    uint64_t releaseGeneration = 0;
+    for (std::map<uint64_t, uint64_t>::iterator it = generations.begin(); it != generations.end(); ++it) {
+        if (it->second == checkpointId) {
+            releaseGeneration = it->first;
+            break;
+        }
+    }
+    if (releaseGeneration == 0) {
+        MOT_LOG_WARN("Native redo log: no generation was started at checkpoint %" PRIu64, checkpointId);
+        return;
+    }
+
+    DIR* dir = opendir(m_logDir.c_str());
+    if (dir == nullptr) {
+        MOT_REPORT_SYSTEM_ERROR(opendir, "Native Redo Log", "Failed to open directory %s", m_logDir.c_str());
+        return;
+    }
+
+    // stream files go first, so that an interrupted release never leaves a generation with missing streams
+    std::vector<std::string> generationFiles;
+    struct dirent* entry = nullptr;
+    while ((entry = readdir(dir)) != nullptr) {
+        uint64_t generation = 0;
+        uint32_t stream = 0;
+        bool isGenerationFile = false;
+        if (!ParseLogFileName(entry->d_name, generation, stream, isGenerationFile) ||
+            generation >= releaseGeneration) {
+            continue;
+        }
+        std::string fileName = m_logDir + entry->d_name;
+        if (isGenerationFile) {
+            generationFiles.push_back(fileName);
+        } else if (unlink(fileName.c_str()) != 0) {
+            MOT_LOG_WARN("Native redo log: failed to remove %s", fileName.c_str());
+        }
+    }
+    (void)closedir(dir);
+
+    for (size_t i = 0; i < generationFiles.size(); ++i) {
+        if (unlink(generationFiles[i].c_str()) != 0) {
+            MOT_LOG_WARN("Native redo log: failed to remove %s", generationFiles[i].c_str());
+        }
+    }
+    MOT_LOG_INFO("Native redo log: released generations preceding %" PRIu64, releaseGeneration);
+}
+
+NativeLogReader::NativeLogReader() : m_nextGeneration(0), m_nextRecord(0), m_errorSet(false)
+{}
+
+NativeLogReader::~NativeLogReader()
+{
+    Clear();
+}
+
+bool NativeLogReader::Open(uint64_t checkpointId)
+{
+    if (!CheckpointUtils::GetWorkingDir(m_logDir)) {
+        MOT_LOG_ERROR("Native redo log: failed to get the log directory");
+        m_errorSet = true;
+        return false;
+    }
+
+    std::map<uint64_t, uint64_t> generations;
+    if (!ListGenerations(m_logDir, generations)) {
+        m_errorSet = true;
+        return false;
+    }
+
+    std::map<uint64_t, uint64_t>::iterator start = generations.begin();
+    if (checkpointId != CheckpointControlFile::invalidId) {
+        while (start != generations.end() && start->second != checkpointId) {
+            ++start;
+        }
+        if (start == generations.end()) {
+            // the checkpoint was taken while the envelope WAL was used as redo log
+            MOT_LOG_WARN("Native redo log: no generation follows checkpoint %" PRIu64 ", nothing to replay",
+                checkpointId);
+            return true;
+        }
+    }
+
+    for (std::map<uint64_t, uint64_t>::iterator it = start; it != generations.end(); ++it) {
+        m_generations.push_back(it->first);
+    }
+    MOT_LOG_INFO("Native redo log: replaying %u generations", (unsigned)m_generations.size());
+    return true;
+}
+
+bool NativeLogReader::Next(char*& data, uint32_t& size)
+{
+    while (m_nextRecord >= m_records.size()) {
+        Clear();
+        if (m_errorSet || m_nextGeneration >= m_generations.size()) {
+            return false;
+        }
+        if (!LoadGeneration(m_generations[m_nextGeneration++])) {
+            m_errorSet = true;
+            return false;
+        }
+    }
+
+    Record& record = m_records[m_nextRecord++];
+    data = record.m_data;
+    size = record.m_size;
+    return true;
+}
+
+bool NativeLogReader::LoadGeneration(uint64_t generation)
+{
+    DIR* dir = opendir(m_logDir.c_str());
+    if (dir == nullptr) {
+        MOT_REPORT_SYSTEM_ERROR(opendir, "Native Redo Log", "Failed to open directory %s", m_logDir.c_str());
+        return false;
+    }
+
+    std::map<uint32_t, std::string> streamFiles;
+    struct dirent* entry = nullptr;
+    while ((entry = readdir(dir)) != nullptr) {
+        uint64_t fileGeneration = 0;
+        uint32_t stream = 0;
+        bool isGenerationFile = false;
+        if (ParseLogFileName(entry->d_name, fileGeneration, stream, isGenerationFile) && !isGenerationFile &&
+            fileGeneration == generation) {
+            streamFiles[stream] = m_logDir + entry->d_name;
+        }
+    }
+    (void)closedir(dir);
+
+    for (std::map<uint32_t, std::string>::iterator it = streamFiles.begin(); it != streamFiles.end(); ++it) {
+        if (!LoadStream(it->second)) {
+            return false;
+        }
+    }
+
+    // records of one transaction share a stream, so a stable sort keeps them in their logging order
+    std::stable_sort(m_records.begin(), m_records.end(), [](const Record& lhs, const Record& rhs) {
+        return lhs.m_csn < rhs.m_csn;
+    });
+    MOT_LOG_INFO("Native redo log: generation %" PRIu64 " has %u records in %u streams",
+        generation,
+        (unsigned)m_records.size(),
+        (unsigned)streamFiles.size());
+    return true;
+}
+
+bool NativeLogReader::LoadStream(const std::string& fileName)
+{
+    int fd = -1;
+    if (!CheckpointUtils::OpenFileRead(fileName, fd)) {
+        return false;
+    }
+
+    struct stat fileStat;
+    if (fstat(fd, &fileStat) != 0) {
+        MOT_REPORT_SYSTEM_ERROR(fstat, "Native Redo Log", "Failed to get the size of %s", fileName.c_str());
+        (void)CheckpointUtils::CloseFile(fd);
+        return false;
+    }
+
+    size_t fileSize = (size_t)fileStat.st_size;
+    char* buffer = (char*)malloc(std::max(fileSize, (size_t)1));
+    if (buffer == nullptr) {
+        MOT_REPORT_ERROR(
+            MOT_ERROR_OOM, "Native Redo Log", "Failed to allocate %zu bytes for %s", fileSize, fileName.c_str());
+        (void)CheckpointUtils::CloseFile(fd);
+        return false;
+    }
+    m_files.push_back(buffer);
+    bool result = ReadAll(fd, buffer, fileSize, fileName);
+    (void)CheckpointUtils::CloseFile(fd);
+    if (!result) {
+        return false;
+    }
+
+    size_t offset = 0;
+    while (offset + sizeof(NativeLogRecordHeader) <= fileSize) {
+        NativeLogRecordHeader header;
+        errno_t erc = memcpy_s(&header, sizeof(header), buffer + offset, sizeof(header));
+        securec_check(erc, "\0", "\0");
+        char* data = buffer + offset + sizeof(header);
+        if (header.m_magic != NATIVE_LOG_RECORD_MAGIC || header.m_size > fileSize - offset - sizeof(header) ||
+            RecordCrc(&header, data) != header.m_crc) {
+            // a record torn by a crash was never acknowledged, nothing after it was acknowledged either
+            MOT_LOG_WARN("Native redo log: %s ends with a torn record at offset %zu", fileName.c_str(), offset);
+            break;
+        }
+        m_records.push_back({header.m_csn, data, header.m_size});
+        offset += RecordSize(header.m_size);
+    }
+    return true;
+}
+
+void NativeLogReader::Clear()
+{
+    for (size_t i = 0; i < m_files.size(); ++i) {
+        free(m_files[i]);
+    }
+    m_files.clear();
+    m_records.clear();
+    m_nextRecord = 0;
+}
+}  // namespace MOT
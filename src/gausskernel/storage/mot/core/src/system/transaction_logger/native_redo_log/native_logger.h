@@ -0,0 +1,210 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * -------------------------------------------------------------------------
+ *
+ * native_logger.h
+ *    Redo logger writing MOT log files in parallel streams, bypassing the envelope WAL.
+ *
+ * IDENTIFICATION
+ *    src/gausskernel/storage/mot/core/src/system/transaction_logger/
+ *        native_redo_log/native_logger.h
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef NATIVE_LOGGER_H
+#define NATIVE_LOGGER_H
+
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "ilogger.h"
+#include "utilities.h"
+
+namespace MOT {
+/**
+ * @class NativeLogger
+ * @brief A redo logger writing its own log files instead of the envelope WAL. The log is split into streams (one per
+ * NUMA node, or a configured number of streams shared by session threads), each with its own file and its own group
+ * commit: a committing thread that finds no flush in progress writes and syncs everything appended to its stream so
+ * far, while threads arriving meanwhile wait for the next flush. Every checkpoint starts a new generation of log
+ * files, and generations preceding a completed checkpoint are removed. Recovery replays the generations following
+ * the last checkpoint, the records of each generation in commit sequence number order (see @ref NativeLogReader).
+ * @note Redo written by this logger does not reach the envelope WAL, so it is not replicated to standby nodes.
+ */
+class NativeLogger : public ILogger {
+public:
+    NativeLogger();
+    ~NativeLogger() override;
+
+    /**
+     * @brief Initializes the logger. Log files are written in the checkpoint directory, starting a new generation.
+     * @return True if succeeded, otherwise false.
+     */
+    bool Initialize();
+
+    uint64_t AddToLog(uint8_t* data, uint32_t size) override;
+
+    /** @brief Waits until everything the calling thread appended to its stream is durable. */
+    void FlushLog() override;
+
+    void CloseLog() override;
+
+    void ClearLog() override;
+
+    /** @brief Starts a new log generation, redo of which is replayed on top of the given checkpoint. */
+    bool RotateLog(uint64_t checkpointId) override;
+
+    /** @brief Removes the log generations preceding the given checkpoint. */
+    void ReleaseLog(uint64_t checkpointId) override;
+
+private:
+    /** @struct LogStream One log file with its append buffer and group commit state. */
+    struct LogStream {
+        /** @var Protects all stream members. */
+        std::mutex m_lock;
+
+        /** @var Signaled when a flush ends. */
+        std::condition_variable m_flushedCV;
+
+        /** @var Records appended since the last flush started. */
+        char* m_buffer = nullptr;
+        size_t m_bufferSize = 0;
+        size_t m_bufferCapacity = 0;
+
+        /** @var The buffer being written by the flushing thread (swapped with the append buffer). */
+        char* m_flushBuffer = nullptr;
+        size_t m_flushBufferCapacity = 0;
+
+        /** @var Total bytes appended to the stream. */
+        uint64_t m_appendLsn = 0;
+
+        /** @var Total bytes known to be durable. */
+        uint64_t m_flushedLsn = 0;
+
+        /** @var Specifies whether a thread is currently writing the stream. */
+        bool m_flushing = false;
+
+        /** @var The log file of the current generation, or -1 if not opened yet. */
+        int m_fd = -1;
+
+        /** @var The stream index. */
+        uint32_t m_id = 0;
+    };
+
+    /** @brief Selects the stream of the calling thread. */
+    LogStream* SelectStream();
+
+    /**
+     * @brief Makes all records appended to a stream durable, joining a flush in progress when there is one.
+     * @param stream The stream to flush, locked by the caller through the given lock.
+     * @param lock The stream lock.
+     * @return True if succeeded, otherwise false.
+     */
+    bool FlushStream(LogStream* stream, std::unique_lock<std::mutex>& lock);
+
+    /** @brief Writes a buffer to the file of the current generation of a stream and syncs it. */
+    bool WriteStream(LogStream* stream, const char* data, size_t size);
+
+    /** @brief Closes the file of a stream. */
+    void CloseStream(LogStream* stream);
+
+    /** @var The directory of the log files. */
+    std::string m_logDir;
+
+    /** @var The current log generation, only changed while no transaction writes to the log. */
+    uint64_t m_generation;
+
+    /** @var The number of streams. */
+    uint32_t m_streamCount;
+
+    /** @var Specifies whether streams are selected by the NUMA node of the committing thread. */
+    bool m_streamPerNode;
+
+    /** @var The streams. */
+    LogStream* m_streams;
+};
+
+/**
+ * @class NativeLogReader
+ * @brief Reads the redo records written by @ref NativeLogger to replay them on top of a checkpoint. Generations are
+ * read one after the other. The records of all the streams of a generation are loaded and sorted by commit sequence
+ * number, so that conflicting transactions (which are logged while holding their row locks) are replayed in their
+ * commit order. A torn record at the end of a stream (never acknowledged to the client) ends that stream.
+ */
+class NativeLogReader {
+public:
+    NativeLogReader();
+    ~NativeLogReader();
+
+    /**
+     * @brief Finds the log generations to replay.
+     * @param checkpointId The identifier of the recovered checkpoint, or @ref CheckpointControlFile::invalidId if
+     * there is no checkpoint.
+     * @return True if succeeded, otherwise false.
+     */
+    bool Open(uint64_t checkpointId);
+
+    /**
+     * @brief Retrieves the next record to replay.
+     * @param[out] data Receives the record data, valid until the next call.
+     * @param[out] size Receives the record size.
+     * @return True if a record was retrieved, or false if there are no more records or an error occurred (see
+     * @ref IsErrorSet).
+     */
+    bool Next(char*& data, uint32_t& size);
+
+    inline bool IsErrorSet() const
+    {
+        return m_errorSet;
+    }
+
+private:
+    /** @struct Record A loaded record. */
+    struct Record {
+        uint64_t m_csn;
+        char* m_data;
+        uint32_t m_size;
+    };
+
+    /** @brief Loads and sorts the records of a generation. */
+    bool LoadGeneration(uint64_t generation);
+
+    /** @brief Loads the records of one stream file. */
+    bool LoadStream(const std::string& fileName);
+
+    /** @brief Releases the loaded records. */
+    void Clear();
+
+    /** @var The directory of the log files. */
+    std::string m_logDir;
+
+    /** @var The generations to replay, in order. */
+    std::vector<uint64_t> m_generations;
+    size_t m_nextGeneration;
+
+    /** @var The contents of the stream files of the current generation. */
+    std::vector<char*> m_files;
+
+    /** @var The records of the current generation, in replay order. */
+    std::vector<Record> m_records;
+    size_t m_nextRecord;
+
+    bool m_errorSet;
+};
+}  // namespace MOT
+
+#endif /* NATIVE_LOGGER_H */
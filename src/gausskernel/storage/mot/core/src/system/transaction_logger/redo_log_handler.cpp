@@ -72,6 +72,17 @@ RedoLogHandler* RedoLogHandlerFactory::CreateRedoLogHandler()
             "Failed to allocate memory for redo log handler, aborting");
     }
 
+    // the external logger is set later by the envelope, any other logger must exist by now
+    if ((handler != nullptr) && (cfg.m_loggerType != LoggerType::EXTERNAL_LOGGER) &&
+        (handler->GetLogger() == nullptr)) {
+        MOT_REPORT_PANIC(MOT_ERROR_INTERNAL,
+            "Redo Log Handler Initialization",
+            "Failed to create %s logger, aborting",
+            LoggerTypeToString(cfg.m_loggerType));
+        delete handler;
+        handler = nullptr;
+    }
+
     return handler;
 }
 
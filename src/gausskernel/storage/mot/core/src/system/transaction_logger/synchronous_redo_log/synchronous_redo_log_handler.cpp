@@ -27,6 +27,8 @@
 #include "txn.h"
 #include "global.h"
 #include "utilities.h"
+#include "cycles.h"
+#include "log_statistics.h"
 
 namespace MOT {
 SynchronousRedoLogHandler::SynchronousRedoLogHandler()
@@ -56,8 +58,14 @@ void SynchronousRedoLogHandler::DestroyBuffer(RedoLogBuffer* buffer)
 
 RedoLogBuffer* SynchronousRedoLogHandler::WriteToLog(RedoLogBuffer* buffer)
 {
+    LogStatisticsProvider& logStats = LogStatisticsProvider::GetInstance();
+    bool collectStats = logStats.IsEnabled();
+    uint64_t startTime = collectStats ? GetSysClock() : 0;
     m_logger->AddToLog(buffer);
     m_logger->FlushLog();
+    if (collectStats) {
+        logStats.AddLogFlushTime(CpuCyclesLevelTime::CyclesToMicroseconds(GetSysClock() - startTime));
+    }
     return buffer;
 }
 
@@ -68,6 +68,7 @@ const ::PROTOBUF_NAMESPACE_ID::uint32 TableStruct_client_2eproto::offsets[] PROT
   PROTOBUF_FIELD_OFFSET(::proto::ClientReadRequest, client_ip_),
   PROTOBUF_FIELD_OFFSET(::proto::ClientReadRequest, txn_id_),
   PROTOBUF_FIELD_OFFSET(::proto::ClientReadRequest, rows_),
+  PROTOBUF_FIELD_OFFSET(::proto::ClientReadRequest, snapshot_epoch_),
   ~0u,  // no _has_bits_
   PROTOBUF_FIELD_OFFSET(::proto::ClientReadResponse, _internal_metadata_),
   ~0u,  // no _extensions_
@@ -79,7 +80,7 @@ const ::PROTOBUF_NAMESPACE_ID::uint32 TableStruct_client_2eproto::offsets[] PROT
 };
 static const ::PROTOBUF_NAMESPACE_ID::internal::MigrationSchema schemas[] PROTOBUF_SECTION_VARIABLE(protodesc_cold) = {
   { 0, -1, sizeof(::proto::ClientReadRequest)},
-  { 8, -1, sizeof(::proto::ClientReadResponse)},
+  { 9, -1, sizeof(::proto::ClientReadResponse)},
 };
 
 static ::PROTOBUF_NAMESPACE_ID::Message const * const file_default_instances[] = {
@@ -89,9 +90,10 @@ static ::PROTOBUF_NAMESPACE_ID::Message const * const file_default_instances[] =
 
 const char descriptor_table_protodef_client_2eproto[] PROTOBUF_SECTION_VARIABLE(protodesc_cold) =
   "\n\014client.proto\022\005proto\032\021transaction.proto"
-  "\032\nnode.proto\"P\n\021ClientReadRequest\022\021\n\tcli"
+  "\032\nnode.proto\"h\n\021ClientReadRequest\022\021\n\tcli"
   "ent_ip\030\001 \001(\t\022\016\n\006txn_id\030\002 \001(\004\022\030\n\004rows\030\003 \003"
-  "(\0132\n.proto.Row\"]\n\022ClientReadResponse\022\035\n\006"
+  "(\0132\n.proto.Row\022\026\n\016snapshot_epoch\030\004 \001(\004\"]\n\022Cl"
+  "ientReadResponse\022\035\n\006"
   "result\030\001 \001(\0162\r.proto.Result\022\016\n\006txn_id\030\002 "
   "\001(\004\022\030\n\004rows\030\003 \003(\0132\n.proto.RowB\016Z\014./taas_"
   "protob\006proto3"
@@ -107,7 +109,7 @@ static ::PROTOBUF_NAMESPACE_ID::internal::SCCInfoBase*const descriptor_table_cli
 static ::PROTOBUF_NAMESPACE_ID::internal::once_flag descriptor_table_client_2eproto_once;
 static bool descriptor_table_client_2eproto_initialized = false;
 const ::PROTOBUF_NAMESPACE_ID::internal::DescriptorTable descriptor_table_client_2eproto = {
-  &descriptor_table_client_2eproto_initialized, descriptor_table_protodef_client_2eproto, "client.proto", 253,
+  &descriptor_table_client_2eproto_initialized, descriptor_table_protodef_client_2eproto, "client.proto", 277,
   &descriptor_table_client_2eproto_once, descriptor_table_client_2eproto_sccs, descriptor_table_client_2eproto_deps, 2, 2,
   schemas, file_default_instances, TableStruct_client_2eproto::offsets,
   file_level_metadata_client_2eproto, 2, file_level_enum_descriptors_client_2eproto, file_level_service_descriptors_client_2eproto,
@@ -142,14 +144,18 @@ ClientReadRequest::ClientReadRequest(const ClientReadRequest& from)
   if (!from._internal_client_ip().empty()) {
     client_ip_.AssignWithDefault(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), from.client_ip_);
   }
-  txn_id_ = from.txn_id_;
+  ::memcpy(&txn_id_, &from.txn_id_,
+    static_cast<size_t>(reinterpret_cast<char*>(&snapshot_epoch_) -
+    reinterpret_cast<char*>(&txn_id_)) + sizeof(snapshot_epoch_));
   // @@protoc_insertion_point(copy_constructor:proto.ClientReadRequest)
 }
 
 void ClientReadRequest::SharedCtor() {
   ::PROTOBUF_NAMESPACE_ID::internal::InitSCC(&scc_info_ClientReadRequest_client_2eproto.base);
   client_ip_.UnsafeSetDefault(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited());
-  txn_id_ = PROTOBUF_ULONGLONG(0);
+  ::memset(&txn_id_, 0, static_cast<size_t>(
+      reinterpret_cast<char*>(&snapshot_epoch_) -
+      reinterpret_cast<char*>(&txn_id_)) + sizeof(snapshot_epoch_));
 }
 
 ClientReadRequest::~ClientReadRequest() {
@@ -178,7 +184,9 @@ void ClientReadRequest::Clear() {
 
   rows_.Clear();
   client_ip_.ClearToEmptyNoArena(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited());
-  txn_id_ = PROTOBUF_ULONGLONG(0);
+  ::memset(&txn_id_, 0, static_cast<size_t>(
+      reinterpret_cast<char*>(&snapshot_epoch_) -
+      reinterpret_cast<char*>(&txn_id_)) + sizeof(snapshot_epoch_));
   _internal_metadata_.Clear();
 }
 
@@ -217,6 +225,13 @@ const char* ClientReadRequest::_InternalParse(const char* ptr, ::PROTOBUF_NAMESP
           } while (::PROTOBUF_NAMESPACE_ID::internal::ExpectTag<26>(ptr));
         } else goto handle_unusual;
         continue;
+      // uint64 snapshot_epoch = 4;
+      case 4:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<::PROTOBUF_NAMESPACE_ID::uint8>(tag) == 32)) {
+          snapshot_epoch_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint(&ptr);
+          CHK_(ptr);
+        } else goto handle_unusual;
+        continue;
       default: {
       handle_unusual:
         if ((tag & 7) == 4 || tag == 0) {
@@ -267,6 +282,12 @@ failure:
       InternalWriteMessage(3, this->_internal_rows(i), target, stream);
   }
 
+  // uint64 snapshot_epoch = 4;
+  if (this->snapshot_epoch() != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::WriteUInt64ToArray(4, this->_internal_snapshot_epoch(), target);
+  }
+
   if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
     target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormat::InternalSerializeUnknownFieldsToArray(
         _internal_metadata_.unknown_fields(), target, stream);
@@ -304,6 +325,13 @@ size_t ClientReadRequest::ByteSizeLong() const {
         this->_internal_txn_id());
   }
 
+  // uint64 snapshot_epoch = 4;
+  if (this->snapshot_epoch() != 0) {
+    total_size += 1 +
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::UInt64Size(
+        this->_internal_snapshot_epoch());
+  }
+
   if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
     return ::PROTOBUF_NAMESPACE_ID::internal::ComputeUnknownFieldsSize(
         _internal_metadata_, total_size, &_cached_size_);
@@ -343,6 +371,9 @@ void ClientReadRequest::MergeFrom(const ClientReadRequest& from) {
   if (from.txn_id() != 0) {
     _internal_set_txn_id(from._internal_txn_id());
   }
+  if (from.snapshot_epoch() != 0) {
+    _internal_set_snapshot_epoch(from._internal_snapshot_epoch());
+  }
 }
 
 void ClientReadRequest::CopyFrom(const ::PROTOBUF_NAMESPACE_ID::Message& from) {
@@ -370,6 +401,7 @@ void ClientReadRequest::InternalSwap(ClientReadRequest* other) {
   client_ip_.Swap(&other->client_ip_, &::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(),
     GetArenaNoVirtual());
   swap(txn_id_, other->txn_id_);
+  swap(snapshot_epoch_, other->snapshot_epoch_);
 }
 
 ::PROTOBUF_NAMESPACE_ID::Metadata ClientReadRequest::GetMetadata() const {
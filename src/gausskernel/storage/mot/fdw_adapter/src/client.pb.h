@@ -181,6 +181,7 @@ class ClientReadRequest :
     kRowsFieldNumber = 3,
     kClientIpFieldNumber = 1,
     kTxnIdFieldNumber = 2,
+    kSnapshotEpochFieldNumber = 4,
   };
   // repeated .proto.Row rows = 3;
   int rows_size() const;
@@ -225,6 +226,15 @@ class ClientReadRequest :
   void _internal_set_txn_id(::PROTOBUF_NAMESPACE_ID::uint64 value);
   public:
 
+  // uint64 snapshot_epoch = 4;
+  void clear_snapshot_epoch();
+  ::PROTOBUF_NAMESPACE_ID::uint64 snapshot_epoch() const;
+  void set_snapshot_epoch(::PROTOBUF_NAMESPACE_ID::uint64 value);
+  private:
+  ::PROTOBUF_NAMESPACE_ID::uint64 _internal_snapshot_epoch() const;
+  void _internal_set_snapshot_epoch(::PROTOBUF_NAMESPACE_ID::uint64 value);
+  public:
+
   // @@protoc_insertion_point(class_scope:proto.ClientReadRequest)
  private:
   class _Internal;
@@ -233,6 +243,7 @@ class ClientReadRequest :
   ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::proto::Row > rows_;
   ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr client_ip_;
   ::PROTOBUF_NAMESPACE_ID::uint64 txn_id_;
+  ::PROTOBUF_NAMESPACE_ID::uint64 snapshot_epoch_;
   mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
   friend struct ::TableStruct_client_2eproto;
 };
@@ -522,6 +533,26 @@ ClientReadRequest::rows() const {
   return rows_;
 }
 
+// uint64 snapshot_epoch = 4;
+inline void ClientReadRequest::clear_snapshot_epoch() {
+  snapshot_epoch_ = PROTOBUF_ULONGLONG(0);
+}
+inline ::PROTOBUF_NAMESPACE_ID::uint64 ClientReadRequest::_internal_snapshot_epoch() const {
+  return snapshot_epoch_;
+}
+inline ::PROTOBUF_NAMESPACE_ID::uint64 ClientReadRequest::snapshot_epoch() const {
+  // @@protoc_insertion_point(field_get:proto.ClientReadRequest.snapshot_epoch)
+  return _internal_snapshot_epoch();
+}
+inline void ClientReadRequest::_internal_set_snapshot_epoch(::PROTOBUF_NAMESPACE_ID::uint64 value) {
+  
+  snapshot_epoch_ = value;
+}
+inline void ClientReadRequest::set_snapshot_epoch(::PROTOBUF_NAMESPACE_ID::uint64 value) {
+  _internal_set_snapshot_epoch(value);
+  // @@protoc_insertion_point(field_set:proto.ClientReadRequest.snapshot_epoch)
+}
+
 // -------------------------------------------------------------------
 
 // ClientReadResponse
@@ -0,0 +1,260 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * -------------------------------------------------------------------------
+ *
+ * mot_commit_table.h
+ *    Registries of requests waiting for a TaaS reply. Header only and free of engine dependencies, so that
+ *    src/test/examples/motcommittable.cpp can exercise them.
+ *
+ * IDENTIFICATION
+ *    src/gausskernel/storage/mot/fdw_adapter/src/mot_commit_table.h
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef MOT_COMMIT_TABLE_H
+#define MOT_COMMIT_TABLE_H
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <unordered_map>
+
+template<typename key, typename value>
+class ConcurrentHashMap {
+public:
+    typedef typename std::unordered_map<key, value>::iterator map_iterator;
+    typedef typename std::unordered_map<key, value>::size_type size_type;
+
+    bool insert(key &k, value &v, value *p) {
+        std::mutex& _mutex_temp = GetMutexRef(k);
+        std::unordered_map<key, value>& _map_temp = GetMapRef(k);
+        std::unique_lock<std::mutex> lock(_mutex_temp);
+        map_iterator iter = _map_temp.find(k);
+        if (iter == _map_temp.end()) {
+            _map_temp[k] = v;
+            *p = nullptr;
+        } else {
+            *p = _map_temp[k];
+            _map_temp[k] = v;
+        }
+        return true;
+    }
+
+    void insert(key &k, value &v) {
+        std::mutex& _mutex_temp = GetMutexRef(k);
+        std::unordered_map<key, value>& _map_temp = GetMapRef(k);
+        std::unique_lock<std::mutex> lock(_mutex_temp);
+        _map_temp[k] = v;
+    }
+
+    void remove(key &k, value &v) {
+        std::mutex& _mutex_temp = GetMutexRef(k);
+        std::unordered_map<key, value>& _map_temp = GetMapRef(k);
+        std::unique_lock<std::mutex> lock(_mutex_temp);
+        map_iterator iter = _map_temp.find(k);
+        if (iter != _map_temp.end()) {
+            if (iter->second == v) {
+                _map_temp.erase(iter);
+            }
+        }
+    }
+
+    void remove(key &k) {
+        std::mutex& _mutex_temp = GetMutexRef(k);
+        std::unordered_map<key, value>& _map_temp = GetMapRef(k);
+        std::unique_lock<std::mutex> lock(_mutex_temp);
+        map_iterator iter = _map_temp.find(k);
+        if (iter != _map_temp.end()) {
+            _map_temp.erase(iter);
+        }
+    }
+
+    void clear() {
+        for(uint64_t i = 0; i < _N; i ++){
+            std::unique_lock<std::mutex> lock(_mutex[i]);
+            _map[i].clear();
+        }
+    }
+
+    void unsafe_clear() {
+        for(uint64_t i = 0; i < _N; i ++){
+            _map[i].clear();
+        }
+    }
+
+    bool contain(key &k, value &v){
+        std::unordered_map<key, value>& _map_temp = GetMapRef(k);
+        std::mutex& _mutex_temp = GetMutexRef(k);
+        std::unique_lock<std::mutex> lock(_mutex_temp);
+        map_iterator iter = _map_temp.find(k);
+        if(iter != _map_temp.end()){
+            if(iter->second == v){
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool contain(key &k){
+        std::unordered_map<key, value>& _map_temp = GetMapRef(k);
+        std::mutex& _mutex_temp = GetMutexRef(k);
+        std::unique_lock<std::mutex> lock(_mutex_temp);
+        map_iterator iter = _map_temp.find(k);
+        if(iter != _map_temp.end()){
+            return true;
+        }
+        return false;
+    }
+
+    bool unsafe_contain(key &k, value &v){
+        std::unordered_map<key, value>& _map_temp = GetMapRef(k);
+        map_iterator iter = _map_temp.find(k);
+        if(iter != _map_temp.end()){
+            if(iter->second == v){
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool get_value(key &k, value &v) {
+        std::unordered_map<key, value>& _map_temp = GetMapRef(k);
+        std::mutex& _mutex_temp = GetMutexRef(k);
+        std::unique_lock<std::mutex> lock(_mutex_temp);
+        map_iterator iter = _map_temp.find(k);
+        if(iter != _map_temp.end()) {
+            v = iter->second;
+            return true;
+        }
+        else {
+            return false;
+        }
+    }
+
+    bool unsafe_get_value(key &k, value &v) {
+        std::unordered_map<key, value>& _map_temp = GetMapRef(k);
+        map_iterator iter = _map_temp.find(k);
+        if(iter != _map_temp.end()) {
+            v = iter->second;
+            return true;
+        }
+        else {
+            return false;
+        }
+    }
+
+    size_type size() {
+        size_type ans = 0;
+        for(uint64_t i = 0; i < _N; i ++){
+            std::unique_lock<std::mutex> lock(_mutex[i]);
+            ans += _map[i].size();
+        }
+        return ans;
+    }
+
+protected:
+    inline std::unordered_map<key, value>& GetMapRef(const key k){ return _map[(_hash(k) % _N)]; }
+    inline std::unordered_map<key, value>& GetMapRef(const key k) const { return _map[(_hash(k) % _N)]; }
+    inline std::mutex& GetMutexRef(const key k) { return _mutex[(_hash(k) % _N)]; }
+    inline std::mutex& GetMutexRef(const key k) const {return _mutex[(_hash(k) % _N)]; }
+
+private:
+    const static uint64_t _N = 101;//521 997 1217 12281 122777 prime
+    std::hash<key> _hash;
+    std::unordered_map<key, value> _map[_N];
+    std::mutex _mutex[_N];
+};
+
+// Registry of commits waiting for a txn node reply, indexed by csn. The csns are handed out by local_csn in
+// increasing order, so a preallocated ring indexed by csn % _N is collision free as long as fewer than _N commits
+// are in flight. Each slot's csn word is both the tag and the lock: claim and complete are one CAS each, with
+// no mutex and no allocation on the commit path. A pending entry is never displaced: the csns are global, so a
+// reply slower than the next _N commits finds its slot reused, and such entries go to a mutex protected overflow
+// map instead. The overflow is only consulted while it is not empty.
+template<typename value>
+class PendingCommitTable {
+public:
+    // register v under csn k
+    void insert(uint64_t k, value v) {
+        Slot& slot = _slot[k & _Mask];
+        uint64_t expected = _Empty;
+        while (!slot.csn.compare_exchange_weak(expected, _Busy, std::memory_order_acquire)) {
+            if (expected != _Busy) {
+                // the slot still belongs to an older pending csn
+                std::unique_lock<std::mutex> lock(_overflowMutex);
+                _overflow[k] = v;
+                _overflowCount.fetch_add(1, std::memory_order_release);
+                return;
+            }
+            expected = _Empty; // claimed or completed right now, retry
+        }
+        slot.val = v;
+        slot.csn.store(k, std::memory_order_release);
+    }
+
+    // complete csn k, returns the registered value or nullptr if k is not pending (already completed)
+    value take(uint64_t k) {
+        Slot& slot = _slot[k & _Mask];
+        uint64_t expected = k;
+        if (slot.csn.compare_exchange_strong(expected, _Busy, std::memory_order_acquire)) {
+            value v = slot.val;
+            slot.val = nullptr;
+            slot.csn.store(_Empty, std::memory_order_release);
+            return v;
+        }
+        if (_overflowCount.load(std::memory_order_acquire) == 0) {
+            return nullptr;
+        }
+        std::unique_lock<std::mutex> lock(_overflowMutex);
+        auto iter = _overflow.find(k);
+        if (iter == _overflow.end()) {
+            return nullptr;
+        }
+        value v = iter->second;
+        _overflow.erase(iter);
+        _overflowCount.fetch_sub(1, std::memory_order_release);
+        return v;
+    }
+
+    bool contain(uint64_t k) {
+        if (_slot[k & _Mask].csn.load(std::memory_order_acquire) == k) {
+            return true;
+        }
+        if (_overflowCount.load(std::memory_order_acquire) == 0) {
+            return false;
+        }
+        std::unique_lock<std::mutex> lock(_overflowMutex);
+        return _overflow.find(k) != _overflow.end();
+    }
+
+private:
+    const static uint64_t _N = 65536; // power of 2, commits in flight per client before the overflow map is used
+    const static uint64_t _Mask = _N - 1;
+    const static uint64_t _Empty = 0; // csn 0 is never handed out
+    const static uint64_t _Busy = ~0ULL;
+
+    struct alignas(64) Slot {
+        std::atomic<uint64_t> csn{_Empty};
+        value val{nullptr};
+    };
+    Slot _slot[_N];
+
+    std::mutex _overflowMutex;
+    std::unordered_map<uint64_t, value> _overflow;
+    std::atomic<uint64_t> _overflowCount{0};
+};
+
+#endif /* MOT_COMMIT_TABLE_H */
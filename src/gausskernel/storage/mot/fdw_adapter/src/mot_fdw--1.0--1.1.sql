@@ -0,0 +1,8 @@
+-- complain if script is sourced in psql, rather than via ALTER EXTENSION
+\echo Use "ALTER EXTENSION mot_fdw UPDATE TO '1.1'" to load this file. \quit
+
+CREATE FUNCTION mot_histogram_statistics(OUT provider text, OUT statistic text, OUT units text, OUT samples int8,
+  OUT p50 int8, OUT p90 int8, OUT p99 int8, OUT p999 int8, OUT max int8)
+RETURNS SETOF record
+AS 'MODULE_PATHNAME'
+LANGUAGE C STRICT NOT FENCED;
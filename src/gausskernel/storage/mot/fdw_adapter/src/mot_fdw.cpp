@@ -61,8 +61,11 @@
 #include "catalog/pg_database.h"
 #include "catalog/pg_operator.h"
 #include "catalog/pg_proc.h"
+#include "catalog/pg_type.h"
 #include "mb/pg_wchar.h"
 #include "utils/lsyscache.h"
+#include "utils/builtins.h"
+#include "utils/selfuncs.h"
 #include "miscadmin.h"
 #include "parser/parsetree.h"
 #include "access/sysattr.h"
@@ -78,12 +81,15 @@
 #include "table.h"
 #include "txn.h"
 #include "checkpoint_manager.h"
+#include "statistics_provider.h"
 #include <queue>
 #include "recovery_manager.h"
 #include "redo_log_handler_type.h"
 #include "ext_config_loader.h"
 #include "utilities.h"
 #include "utils/timestamp.h"
+#include "vecexecutor/vecnodes.h"
+#include "vecexecutor/vectorbatch.h"
 
 // allow MOT Engine logging facilities
 DECLARE_LOGGER(ExternalWrapper, FDW);
@@ -114,14 +120,19 @@ static const struct MOTFdwOption valid_options[] = {
     /* Sentinel */
     {NULL, InvalidOid}};
 
+/* Marks the fdw_private of a path that scans the whole table although an index applies */
+#define MOT_FULL_SCAN_PATH 1
+
 /*
  * SQL functions
  */
 extern "C" Datum mot_fdw_handler(PG_FUNCTION_ARGS);
 extern "C" Datum mot_fdw_validator(PG_FUNCTION_ARGS);
+extern "C" Datum mot_histogram_statistics(PG_FUNCTION_ARGS);
 
 PG_FUNCTION_INFO_V1(mot_fdw_handler);
 PG_FUNCTION_INFO_V1(mot_fdw_validator);
+PG_FUNCTION_INFO_V1(mot_histogram_statistics);
 
 /*
  * FDW callback routines
@@ -133,6 +144,7 @@ static ForeignScan* MOTGetForeignPlan(PlannerInfo* root, RelOptInfo* baserel, Oi
 static void MOTExplainForeignScan(ForeignScanState* node, ExplainState* es);
 static void MOTBeginForeignScan(ForeignScanState* node, int eflags);
 static TupleTableSlot* MOTIterateForeignScan(ForeignScanState* node);
+static VectorBatch* MOTVecIterateForeignScan(VecForeignScanState* node);
 static void MOTReScanForeignScan(ForeignScanState* node);
 static void MOTEndForeignScan(ForeignScanState* node);
 static void MOTAddForeignUpdateTargets(Query* parsetree, RangeTblEntry* targetRte, Relation targetRelation);
@@ -182,6 +194,7 @@ void CleanQueryStatesOnError(MOT::TxnManager* txn);
 bool IsMOTExpr(
     RelOptInfo* baserel, MOTFdwStateSt* state, MatchIndexArr* marr, Expr* expr, Expr** result, bool setLocal);
 inline bool IsNotEqualOper(OpExpr* op);
+inline bool GetKeyOperation(OpExpr* op, KEY_OPER& oper);
 
 static int MOTGetFdwType()
 {
@@ -298,6 +311,7 @@ Datum mot_fdw_handler(PG_FUNCTION_ARGS)
     fdwroutine->ExplainForeignScan = MOTExplainForeignScan;
     fdwroutine->BeginForeignScan = MOTBeginForeignScan;
     fdwroutine->IterateForeignScan = MOTIterateForeignScan;
+    fdwroutine->VecIterateForeignScan = MOTVecIterateForeignScan;
     fdwroutine->ReScanForeignScan = MOTReScanForeignScan;
     fdwroutine->EndForeignScan = MOTEndForeignScan;
     fdwroutine->AnalyzeForeignTable = MOTAnalyzeForeignTable;
@@ -389,6 +403,72 @@ Datum mot_fdw_validator(PG_FUNCTION_ARGS)
     PG_RETURN_VOID();
 }
 
+/*
+ * Returns the percentiles of the MOT histogram statistics (latencies of commit, redo flush, TaaS round trip and
+ * jitted query execution), aggregated over all threads since startup. Only histograms of enabled statistics
+ * providers that have samples are returned.
+ */
+Datum mot_histogram_statistics(PG_FUNCTION_ARGS)
+{
+    FuncCallContext* funcctx = NULL;
+    MOT::HistogramSummary* entry = NULL;
+    MemoryContext oldcontext;
+
+    if (SRF_IS_FIRSTCALL()) {
+        TupleDesc tupdesc;
+
+        /* create a function context for cross-call persistence */
+        funcctx = SRF_FIRSTCALL_INIT();
+
+        /* switch to memory context appropriate for multiple function calls */
+        oldcontext = MemoryContextSwitchTo(funcctx->multi_call_memory_ctx);
+
+        /* build tupdesc for result tuples */
+        tupdesc = CreateTemplateTupleDesc(9, false);
+        TupleDescInitEntry(tupdesc, (AttrNumber)1, "provider", TEXTOID, -1, 0);
+        TupleDescInitEntry(tupdesc, (AttrNumber)2, "statistic", TEXTOID, -1, 0);
+        TupleDescInitEntry(tupdesc, (AttrNumber)3, "units", TEXTOID, -1, 0);
+        TupleDescInitEntry(tupdesc, (AttrNumber)4, "samples", INT8OID, -1, 0);
+        TupleDescInitEntry(tupdesc, (AttrNumber)5, "p50", INT8OID, -1, 0);
+        TupleDescInitEntry(tupdesc, (AttrNumber)6, "p90", INT8OID, -1, 0);
+        TupleDescInitEntry(tupdesc, (AttrNumber)7, "p99", INT8OID, -1, 0);
+        TupleDescInitEntry(tupdesc, (AttrNumber)8, "p999", INT8OID, -1, 0);
+        TupleDescInitEntry(tupdesc, (AttrNumber)9, "max", INT8OID, -1, 0);
+        funcctx->tuple_desc = BlessTupleDesc(tupdesc);
+
+        /* total number of tuples to be returned */
+        funcctx->user_fctx = (void*)MOTAdaptor::GetHistogramStatistics(&(funcctx->max_calls));
+
+        (void)MemoryContextSwitchTo(oldcontext);
+    }
+
+    /* stuff done on every call of the function */
+    funcctx = SRF_PERCALL_SETUP();
+    entry = (MOT::HistogramSummary*)funcctx->user_fctx;
+
+    if (funcctx->call_cntr < funcctx->max_calls) {
+        Datum values[9];
+        bool nulls[9] = {false};
+
+        entry += funcctx->call_cntr;
+        values[0] = CStringGetTextDatum(entry->m_provider);
+        values[1] = CStringGetTextDatum(entry->m_name);
+        values[2] = CStringGetTextDatum(entry->m_units);
+        values[3] = Int64GetDatum(entry->m_sampleCount);
+        values[4] = Int64GetDatum(entry->m_p50);
+        values[5] = Int64GetDatum(entry->m_p90);
+        values[6] = Int64GetDatum(entry->m_p99);
+        values[7] = Int64GetDatum(entry->m_p999);
+        values[8] = Int64GetDatum(entry->m_max);
+
+        HeapTuple tuple = heap_form_tuple(funcctx->tuple_desc, values, nulls);
+        SRF_RETURN_NEXT(funcctx, HeapTupleGetDatum(tuple));
+    } else {
+        /* do when there is no more left */
+        SRF_RETURN_DONE(funcctx);
+    }
+}
+
 /*
  * Check if the provided option is one of the valid options.
  * context is the Oid of the catalog holding the object the option is for.
@@ -475,20 +555,113 @@ static void MOTGetForeignRelSize(PlannerInfo* root, RelOptInfo* baserel, Oid for
         }
     }
 
-    baserel->rows = planstate->m_table->GetRowCount();
+    // the row count is maintained by the table, fall back to the last ANALYZE for an empty or unknown count
+    MOT::IndexStatistics stats;
     baserel->tuples = planstate->m_table->GetRowCount();
-    if (baserel->rows == 0)
-        baserel->rows = baserel->tuples = 100000;
-    planstate->m_startupCost = 0.1;
-    planstate->m_totalCost = baserel->rows * planstate->m_startupCost;
+    if (baserel->tuples == 0) {
+        if (planstate->m_table->GetPrimaryIndex()->GetStatistics(stats)) {
+            baserel->tuples = stats.m_numRows;
+        } else {
+            baserel->tuples = 100000;
+        }
+    }
+    baserel->rows = clamp_row_est(
+        baserel->tuples * clauselist_selectivity(root, baserel->baserestrictinfo, baserel->relid, JOIN_INNER, nullptr));
+
+    // a full scan visits every row and evaluates the restrictions on it
+    QualCost qualCost;
+    cost_qual_eval(&qualCost, baserel->baserestrictinfo, root);
+    planstate->m_startupCost = qualCost.startup;
+    planstate->m_totalCost =
+        qualCost.startup + baserel->tuples * (u_sess->attr.attr_sql.cpu_tuple_cost + qualCost.per_tuple);
 
     RelationClose(rel);
 }
 
+/*
+ * Costs a scan of the rows index probes yield: the probes and then every yielded row.
+ */
+static void MOTCostIndexProbes(PlannerInfo* root, RelOptInfo* baserel, MOTFdwStateSt* planstate, MOT::Index* ix,
+    double numProbes, double numRows)
+{
+    QualCost qualCost;
+    double probeCost = u_sess->attr.attr_sql.cpu_operator_cost;
+
+    // a tree probe compares keys along a path, a hash probe hashes the key once
+    if (ix->GetIndexingMethod() == MOT::IndexingMethod::INDEXING_METHOD_TREE && baserel->tuples > 1) {
+        probeCost *= ceil(log(baserel->tuples) / log(2.0));
+    }
+
+    cost_qual_eval(&qualCost, planstate->m_localConds, root);
+    planstate->m_startupCost = qualCost.startup + probeCost * numProbes;
+    planstate->m_totalCost =
+        planstate->m_startupCost + numRows * (u_sess->attr.attr_sql.cpu_tuple_cost + qualCost.per_tuple);
+}
+
+static void MOTCostIndexScan(PlannerInfo* root, RelOptInfo* baserel, MOTFdwStateSt* planstate, MatchIndex* best)
+{
+    MOTCostIndexProbes(root, baserel, planstate, best->m_ix, 1, best->m_cost);
+}
+
+/*
+ * Finds an IN-list over the column of a single column unique index, e.g. "id IN (1, 2, 3)" or "id = ANY($1)". The
+ * listed keys can then be read in one batch instead of scanning the table. The array must not depend on the scanned
+ * row. The clause itself stays a local qual, which rechecks every row returned.
+ */
+static MOT::Index* GetInListIndex(RelOptInfo* baserel, MOTFdwStateSt* planstate, Expr** arrayExpr)
+{
+    ListCell* lc = nullptr;
+
+    foreach (lc, baserel->baserestrictinfo) {
+        RestrictInfo* ri = (RestrictInfo*)lfirst(lc);
+        if (!IsA(ri->clause, ScalarArrayOpExpr)) {
+            continue;
+        }
+
+        ScalarArrayOpExpr* saop = (ScalarArrayOpExpr*)ri->clause;
+        if (!saop->useOr || list_length(saop->args) != 2) {
+            continue;
+        }
+        Expr* l = (Expr*)linitial(saop->args);
+        Expr* r = (Expr*)lsecond(saop->args);
+        while (IsA(l, RelabelType)) {
+            l = ((RelabelType*)l)->arg;
+        }
+        if (!IsA(l, Var) || ((Var*)l)->varno != baserel->relid || contain_var_clause((Node*)r) ||
+            contain_volatile_functions((Node*)r)) {
+            continue;
+        }
+
+        KEY_OPER oper = KEY_OPER::READ_INVALID;
+        OpExpr* op = makeNode(OpExpr);
+        op->opno = saop->opno;
+        bool isEqual = GetKeyOperation(op, oper) && oper == KEY_OPER::READ_KEY_EXACT;
+        pfree(op);
+        if (!isEqual) {
+            continue;
+        }
+
+        AttrNumber attno = ((Var*)l)->varoattno;
+        for (uint16_t i = 0; i < planstate->m_table->GetNumIndexes(); i++) {
+            MOT::Index* ix = planstate->m_table->GetIndex(i);
+            if (ix->GetUnique() && ix->GetNumFields() == 1 && ix->GetColumnKeyFields()[0] == attno) {
+                *arrayExpr = r;
+                return ix;
+            }
+        }
+    }
+
+    return nullptr;
+}
+
 static bool IsOrderingApplicable(PathKey* pathKey, RelOptInfo* rel, MOT::Index* ix, OrderSt* ord)
 {
     bool res = false;
 
+    // hash indexes keep no key order
+    if (ix->GetIndexingMethod() != MOT::IndexingMethod::INDEXING_METHOD_TREE)
+        return res;
+
     if (ord->m_order == SORTDIR_ENUM::SORTDIR_NONE)
         ord->m_order = SORT_STRATEGY(pathKey->pk_strategy);
     else if (ord->m_order != SORT_STRATEGY(pathKey->pk_strategy))
@@ -546,8 +719,13 @@ static void MOTGetForeignPaths(PlannerInfo* root, RelOptInfo* baserel, Oid forei
     ListCell* lc = nullptr;
     MatchIndex* best = nullptr;
     Path* fpReg = nullptr;
+    Path* fpSeq = nullptr;
     Path* fpIx = nullptr;
     bool hasRegularPath = false;
+    MOT::Index* inListIx = nullptr;
+    Expr* inListExpr = nullptr;
+    double fullScanStartupCost = planstate->m_startupCost;
+    double fullScanCost = planstate->m_totalCost;
 
     planstate->m_order = SORTDIR_ENUM::SORTDIR_ASC;
     // first create regular path based on relation restrictions
@@ -564,12 +742,7 @@ static void MOTGetForeignPaths(PlannerInfo* root, RelOptInfo* baserel, Oid forei
     if (best != nullptr) {
         OrderSt ord;
         ord.init();
-        double ntuples = best->m_cost;
-        ntuples = ntuples * clauselist_selectivity(root, bestClause, 0, JOIN_INNER, nullptr);
-        ntuples = clamp_row_est(ntuples);
-        baserel->rows = baserel->tuples = ntuples;
-        planstate->m_startupCost = 0.001;
-        planstate->m_totalCost = best->m_cost;
+        MOTCostIndexScan(root, baserel, planstate, best);
         planstate->m_bestIx = best;
 
         foreach (lc, root->query_pathkeys) {
@@ -588,6 +761,12 @@ static void MOTGetForeignPaths(PlannerInfo* root, RelOptInfo* baserel, Oid forei
             usablePathkeys = nullptr;
         }
         best = nullptr;
+    } else if ((inListIx = GetInListIndex(baserel, planstate, &inListExpr)) != nullptr) {
+        double numKeys = estimate_array_length((Node*)inListExpr);
+
+        MOTCostIndexProbes(root, baserel, planstate, inListIx, numKeys, numKeys);
+        planstate->m_inListIx = inListIx;
+        planstate->m_inListExpr = inListExpr;
     } else if (list_length(root->query_pathkeys) > 0) {
         OrderSt ord;
         ord.init();
@@ -627,6 +806,19 @@ static void MOTGetForeignPaths(PlannerInfo* root, RelOptInfo* baserel, Oid forei
         nullptr,  // private data will be assigned later
         0);
 
+    // the index path is costed on the selectivity estimate of its quals, keep the full scan as a path of its own
+    // so that a wrong estimate does not rule it out
+    if (planstate->m_bestIx != nullptr || planstate->m_inListIx != nullptr) {
+        fpSeq = (Path*)create_foreignscan_path(root,
+            baserel,
+            fullScanStartupCost,
+            fullScanCost,
+            nullptr,
+            nullptr, /* no outer rel either */
+            list_make1_int(MOT_FULL_SCAN_PATH),
+            0);
+    }
+
     foreach (lc, baserel->pathlist) {
         Path* path = (Path*)lfirst(lc);
         if (IsA(path, IndexPath) && path->param_info == nullptr) {
@@ -634,8 +826,11 @@ static void MOTGetForeignPaths(PlannerInfo* root, RelOptInfo* baserel, Oid forei
             break;
         }
     }
-    if (!hasRegularPath)
+    if (!hasRegularPath) {
         add_path(root, baserel, fpReg);
+        if (fpSeq != nullptr)
+            add_path(root, baserel, fpSeq);
+    }
     set_cheapest(baserel);
 
     if (!IS_PGXC_COORDINATOR && list_length(baserel->cheapest_parameterized_paths) > 0) {
@@ -664,13 +859,8 @@ static void MOTGetForeignPaths(PlannerInfo* root, RelOptInfo* baserel, Oid forei
         if (best != nullptr) {
             OrderSt ord;
             ord.init();
-            double ntuples = best->m_cost;
-            ntuples = ntuples * clauselist_selectivity(root, bestClause, 0, JOIN_INNER, nullptr);
-            ntuples = clamp_row_est(ntuples);
-            baserel->rows = baserel->tuples = ntuples;
             planstate->m_paramBestIx = best;
-            planstate->m_startupCost = 0.001;
-            planstate->m_totalCost = best->m_cost;
+            MOTCostIndexScan(root, baserel, planstate, best);
 
             foreach (lc, root->query_pathkeys) {
                 PathKey* pathkey = (PathKey*)lfirst(lc);
@@ -697,6 +887,7 @@ static void MOTGetForeignPaths(PlannerInfo* root, RelOptInfo* baserel, Oid forei
                 0);
 
             fpIx->param_info = bestPath->param_info;
+            fpIx->rows = clamp_row_est(best->m_cost);
         }
     }
 
@@ -713,8 +904,11 @@ static void MOTGetForeignPaths(PlannerInfo* root, RelOptInfo* baserel, Oid forei
 
     list_free(origPath);
     baserel->pathlist = newPath;
-    if (hasRegularPath)
+    if (hasRegularPath) {
         add_path(root, baserel, fpReg);
+        if (fpSeq != nullptr)
+            add_path(root, baserel, fpSeq);
+    }
     if (fpIx != nullptr)
         add_path(root, baserel, fpIx);
     set_cheapest(baserel);
@@ -723,6 +917,34 @@ static void MOTGetForeignPaths(PlannerInfo* root, RelOptInfo* baserel, Oid forei
 /*
  *
  */
+/*
+ * Batch scans serve plain reads that yield many rows: unique key and IN-list lookups, row locking, modifications and
+ * ctid references need the row at a time path.
+ */
+static bool IsVectorizedScanApplicable(PlannerInfo* root, MOTFdwStateSt* planstate, List* tlist)
+{
+    ListCell* lc = nullptr;
+
+    if (!MOT::GetGlobalConfiguration().m_enableVectorizedScan || root->parse->commandType != CMD_SELECT ||
+        planstate->m_hasForUpdate || planstate->m_inListIx != nullptr) {
+        return false;
+    }
+
+    if (planstate->m_bestIx != nullptr && planstate->m_bestIx->m_ixOpers[0] == KEY_OPER::READ_KEY_EXACT &&
+        planstate->m_bestIx->m_ix->GetUnique()) {
+        return false;
+    }
+
+    foreach (lc, tlist) {
+        TargetEntry* tle = (TargetEntry*)lfirst(lc);
+        if (IsA(tle->expr, Var) && ((Var*)tle->expr)->varattno < 0) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
 static ForeignScan* MOTGetForeignPlan(
     PlannerInfo* root, RelOptInfo* baserel, Oid foreigntableid, ForeignPath* best_path, List* tlist, List* scan_clauses)
 {
@@ -739,9 +961,23 @@ static ForeignScan* MOTGetForeignPlan(
         }
         planstate->m_bestIx = planstate->m_paramBestIx;
         planstate->m_paramBestIx = nullptr;
+        planstate->m_inListIx = nullptr;
+    } else if (best_path->fdw_private != nullptr && linitial_int(best_path->fdw_private) == MOT_FULL_SCAN_PATH) {
+        // the index quals become local quals of the full scan below
+        if (planstate->m_bestIx != nullptr) {
+            planstate->m_bestIx->Clean(planstate);
+            pfree(planstate->m_bestIx);
+            planstate->m_bestIx = nullptr;
+        }
+        planstate->m_inListIx = nullptr;
+        planstate->m_inListExpr = nullptr;
     }
 
-    if (planstate->m_bestIx != nullptr) {
+    if (planstate->m_inListIx != nullptr) {
+        // the array is evaluated once per scan, before the batched lookup
+        planstate->m_numExpr = 1;
+        remote = list_make1(planstate->m_inListExpr);
+    } else if (planstate->m_bestIx != nullptr) {
         planstate->m_numExpr = list_length(planstate->m_bestIx->m_remoteConds);
         remote = list_concat(planstate->m_bestIx->m_remoteConds, planstate->m_bestIx->m_remoteCondsOrig);
 
@@ -787,7 +1023,8 @@ static ForeignScan* MOTGetForeignPlan(
         list_free(tmpLocal);
 
     List* quals = planstate->m_localConds;
-    return make_foreignscan(tlist,
+    bool vecOutput = IsVectorizedScanApplicable(root, planstate, tlist);
+    ForeignScan* fscan = make_foreignscan(tlist,
         quals,
         scanRelid,
         remote, /* no expressions to evaluate */
@@ -799,6 +1036,10 @@ static ForeignScan* MOTGetForeignPlan(
         nullptr
 #endif
     );
+
+    // the planner falls back to row output if the rest of the plan can not be vectorized
+    ((Plan*)fscan)->vec_output = vecOutput;
+    return fscan;
 }
 
 /*
@@ -850,6 +1091,9 @@ static void MOTExplainForeignScan(ForeignScanState* node, ExplainState* es)
         /* And add to es->str */
         ExplainPropertyText("Index Cond", exprstr, es);
         es->indent += 2;
+    } else if (festate->m_inListIx != nullptr) {
+        appendStringInfoSpaces(es->str, es->indent);
+        ExplainPropertyText("->  Index Lookup on", festate->m_inListIx->GetName().c_str(), es);
     }
 
     if (isLocal) {
@@ -880,6 +1124,10 @@ static void MOTBeginForeignScan(ForeignScanState* node, int eflags)
             RelationGetRelid(node->ss.ss_currentRelation))
         node->ss.ps.state->es_result_relation_info->ri_FdwState = festate;
     festate->m_currTxn->SetTxnIsoLevel(u_sess->utils_cxt.XactIsoLevel);
+    if (u_sess->attr.attr_common.XactReadOnly) {
+        // read-only transactions read the row versions at the stable CSN (no-op unless enable_row_versions)
+        (void)festate->m_currTxn->BeginSnapshot();
+    }
 
     foreach (t, node->ss.ps.plan->targetlist) {
         TargetEntry* tle = (TargetEntry*)lfirst(t);
@@ -944,6 +1192,30 @@ static void MOTBeginForeignModify(
     festate->m_currTxn->SetTxnIsoLevel(u_sess->utils_cxt.XactIsoLevel);
 }
 
+/*
+ * Serves a unique primary key lookup of a key missing locally from a TaaS storage node. The row has no local
+ * sentinel, so this is only done for scans that neither lock nor modify the row.
+ */
+static TupleTableSlot* IterateForeignScanRemote(ForeignScanState* node, MOTFdwStateSt* festate, TupleTableSlot* slot)
+{
+    std::vector<MOT::Key*> keys(1, &festate->m_stateKey[0]);
+    std::vector<std::string> rows;
+    MOT::RC rc = MOTAdaptor::RemoteRead(festate->m_table, keys, rows);
+    if (rc != MOT::RC_OK) {
+        CleanQueryStatesOnError(festate->m_currTxn);
+        report_pg_error(rc);
+        return nullptr;
+    }
+    node->ss.is_scan_end = true;
+    if (rows.empty() || rows[0].length() != festate->m_table->GetTupleSize()) {
+        return nullptr;
+    }
+    MOTAdaptor::UnpackRow(slot, festate->m_table, festate->m_attrsUsed, (uint8_t*)rows[0].data());
+    ExecStoreVirtualTuple(slot);
+    festate->m_rowsFound++;
+    return slot;
+}
+
 static TupleTableSlot* IterateForeignScanStopAtFirst(
     ForeignScanState* node, MOTFdwStateSt* festate, TupleTableSlot* slot)
 {
@@ -954,6 +1226,10 @@ static TupleTableSlot* IterateForeignScanStopAtFirst(
     MOTAdaptor::CreateKeyBuffer(node->ss.ss_currentRelation, festate, 0);
     MOT::Sentinel* Sentinel =
         festate->m_bestIx->m_ix->IndexReadSentinel(&festate->m_stateKey[0], festate->m_currTxn->GetThdId());
+    if (Sentinel == nullptr && MOT::GetGlobalConfiguration().m_enableRemoteRead &&
+        festate->m_bestIx->m_ix->IsPrimaryKey() && festate->m_internalCmdOper == MOT::AccessType::RD) {
+        return IterateForeignScanRemote(node, festate, slot);
+    }
     MOT::Row* currRow = festate->m_currTxn->RowLookup(festate->m_internalCmdOper, Sentinel, rc);
 
     if (currRow != NULL) {
@@ -990,30 +1266,80 @@ static TupleTableSlot* IterateForeignScanStopAtFirst(
 }
 
 /*
- *
+ * Returns the rows of the keys of an IN-list one by one. All keys are looked up together on the first call.
  */
-static TupleTableSlot* MOTIterateForeignScan(ForeignScanState* node)
+static TupleTableSlot* IterateForeignScanInList(ForeignScanState* node, MOTFdwStateSt* festate, TupleTableSlot* slot)
 {
-    TryRecordTimestamp(1, startExec);//ADDBY NEU HW
-
     MOT::RC rc = MOT::RC_OK;
-    if (node->ss.is_scan_end) {
-        return nullptr;
+
+    if (!festate->m_cursorOpened) {
+        ForeignScan* fscan = (ForeignScan*)node->ss.ps.plan;
+        festate->m_execExprs = (List*)ExecInitExpr((Expr*)fscan->fdw_exprs, (PlanState*)node);
+        festate->m_econtext = node->ss.ps.ps_ExprContext;
+        rc = MOTAdaptor::LookupInList(node->ss.ss_currentRelation, festate);
+        if (rc != MOT::RC_OK) {
+            CleanQueryStatesOnError(festate->m_currTxn);
+            report_pg_error(rc);
+            return nullptr;
+        }
+        festate->m_cursorOpened = true;
     }
 
-    MOT::Row* currRow = nullptr;
-    MOTFdwStateSt* festate = (MOTFdwStateSt*)node->fdw_state;
-    TupleTableSlot* slot = node->ss.ss_ScanTupleSlot;
-    bool found = false;
-    bool stopAtFirst = (festate->m_bestIx && festate->m_bestIx->m_ixOpers[0] == KEY_OPER::READ_KEY_EXACT &&
-                        festate->m_bestIx->m_ix->GetUnique() == true);
+    while (festate->m_inListPos < festate->m_inListCount) {
+        MOT::Sentinel* sentinel = festate->m_inListSentinels[festate->m_inListPos++];
+        if (sentinel == nullptr) {
+            continue;
+        }
+        MOT::Row* currRow = festate->m_currTxn->RowLookup(festate->m_internalCmdOper, sentinel, rc);
+        if (currRow == nullptr) {
+            if (rc != MOT::RC_OK) {
+                if (MOT_IS_SEVERE()) {
+                    MOT_REPORT_ERROR(MOT_ERROR_INTERNAL, "MOTIterateForeignScan", "Failed to lookup row");
+                    MOT_LOG_ERROR_STACK("Failed to lookup row");
+                }
+                CleanQueryStatesOnError(festate->m_currTxn);
+                report_pg_error(rc,
+                    (void*)(festate->m_currTxn->m_errIx != nullptr ? festate->m_currTxn->m_errIx->GetName().c_str()
+                                                                   : "unknown"),
+                    (void*)festate->m_currTxn->m_errMsgBuf);
+                return nullptr;
+            }
+            continue;
+        }
 
-    (void)ExecClearTuple(slot);
+        MOTAdaptor::UnpackRow(slot, festate->m_table, festate->m_attrsUsed, const_cast<uint8_t*>(currRow->GetData()));
+        ExecStoreVirtualTuple(slot);
+        if (festate->m_ctidNum > 0) {
+            HeapTuple resultTup = ExecFetchSlotTuple(slot);
+            MOTRecConvertSt cv;
+            cv.m_u.m_ptr = (uint64_t)currRow->GetPrimarySentinel();
+            resultTup->t_self = cv.m_u.m_self;
+            HeapTupleSetXmin(resultTup, InvalidTransactionId);
+            HeapTupleSetXmax(resultTup, InvalidTransactionId);
+            HeapTupleHeaderSetCmin(resultTup->t_data, InvalidTransactionId);
+        }
+        festate->m_rowsFound++;
+        return slot;
+    }
 
-    if (stopAtFirst) {
-        return IterateForeignScanStopAtFirst(node, festate, slot);
+    // then the rows of the keys missing locally, which have no sentinel
+    if (festate->m_inListRemotePos < festate->m_inListRemoteCount) {
+        uint8_t* data = festate->m_inListRemoteRows + festate->m_inListRemotePos++ * festate->m_table->GetTupleSize();
+        MOTAdaptor::UnpackRow(slot, festate->m_table, festate->m_attrsUsed, data);
+        ExecStoreVirtualTuple(slot);
+        festate->m_rowsFound++;
+        return slot;
     }
 
+    node->ss.is_scan_end = true;
+    return nullptr;
+}
+
+/*
+ * Opens the scan cursor on the first call. Returns false if the scan yields no further rows.
+ */
+static bool MOTOpenScanCursor(ForeignScanState* node, MOTFdwStateSt* festate)
+{
     if (!festate->m_cursorOpened) {
         ForeignScan* fscan = (ForeignScan*)node->ss.ps.plan;
         festate->m_execExprs = (List*)ExecInitExpr((Expr*)fscan->fdw_exprs, (PlanState*)node);
@@ -1023,27 +1349,22 @@ static TupleTableSlot* MOTIterateForeignScan(ForeignScanState* node)
 
         festate->m_cursorOpened = true;
     }
-    /*
-     * The protocol for loading a virtual tuple into a slot is first
-     * ExecClearTuple, then fill the values/isnull arrays, then
-     * ExecStoreVirtualTuple.  If we don't find another row in the file, we
-     * just skip the last step, leaving the slot empty as required.
-     *
-     * We can pass ExprContext = NULL because we read all columns from the
-     * file, so no need to evaluate default expressions.
-     *
-     * We can also pass tupleOid = NULL because we don't allow oids for
-     * foreign tables.
-     */
+
     // festate->cursor[1] might be NULL (in case it is not in use)
-    if (festate->m_cursor[0] == nullptr || !festate->m_cursor[0]->IsValid() ||
-        (festate->m_cursor[1] != nullptr && !festate->m_cursor[1]->IsValid())) {
-        return nullptr;
-    }
+    return !(festate->m_cursor[0] == nullptr || !festate->m_cursor[0]->IsValid() ||
+             (festate->m_cursor[1] != nullptr && !festate->m_cursor[1]->IsValid()));
+}
 
-    do {
+/*
+ * Returns the next row of the scan range visible to the transaction, or null at the end of the scan.
+ */
+static MOT::Row* MOTScanNextRow(ForeignScanState* node, MOTFdwStateSt* festate)
+{
+    MOT::RC rc = MOT::RC_OK;
+
+    while (festate->m_cursor[0]->IsValid()) {
         MOT::Sentinel* Sentinel = festate->m_cursor[0]->GetPrimarySentinel();
-        currRow = festate->m_currTxn->RowLookup(festate->m_internalCmdOper, Sentinel, rc);
+        MOT::Row* currRow = festate->m_currTxn->RowLookup(festate->m_internalCmdOper, Sentinel, rc);
         if (currRow == NULL) {
             if (rc != MOT::RC_OK) {
                 if (MOT_IS_SEVERE()) {
@@ -1066,17 +1387,62 @@ static TupleTableSlot* MOTIterateForeignScan(ForeignScanState* node)
         if (MOTAdaptor::IsScanEnd(festate)) {
             festate->m_cursor[0]->Invalidate();
             node->ss.is_scan_end = true;
-            break;
+            return NULL;
         }
 
-        MOTAdaptor::UnpackRow(slot, festate->m_table, festate->m_attrsUsed, const_cast<uint8_t*>(currRow->GetData()));
-        found = true;
-
         festate->m_cursor[0]->Next();
-        break;
-    } while (festate->m_cursor[0]->IsValid());
+        return currRow;
+    }
+
+    return NULL;
+}
 
-    if (found) {
+/*
+ *
+ */
+static TupleTableSlot* MOTIterateForeignScan(ForeignScanState* node)
+{
+    TryRecordTimestamp(1, startExec);//ADDBY NEU HW
+
+    if (node->ss.is_scan_end) {
+        return nullptr;
+    }
+
+    MOT::Row* currRow = nullptr;
+    MOTFdwStateSt* festate = (MOTFdwStateSt*)node->fdw_state;
+    TupleTableSlot* slot = node->ss.ss_ScanTupleSlot;
+    bool stopAtFirst = (festate->m_bestIx && festate->m_bestIx->m_ixOpers[0] == KEY_OPER::READ_KEY_EXACT &&
+                        festate->m_bestIx->m_ix->GetUnique() == true);
+
+    (void)ExecClearTuple(slot);
+
+    if (festate->m_inListIx != nullptr) {
+        return IterateForeignScanInList(node, festate, slot);
+    }
+
+    if (stopAtFirst) {
+        return IterateForeignScanStopAtFirst(node, festate, slot);
+    }
+
+    if (!MOTOpenScanCursor(node, festate)) {
+        return nullptr;
+    }
+
+    /*
+     * The protocol for loading a virtual tuple into a slot is first
+     * ExecClearTuple, then fill the values/isnull arrays, then
+     * ExecStoreVirtualTuple.  If we don't find another row in the file, we
+     * just skip the last step, leaving the slot empty as required.
+     *
+     * We can pass ExprContext = NULL because we read all columns from the
+     * file, so no need to evaluate default expressions.
+     *
+     * We can also pass tupleOid = NULL because we don't allow oids for
+     * foreign tables.
+     */
+    currRow = MOTScanNextRow(node, festate);
+    if (currRow != nullptr) {
+        MOTAdaptor::UnpackRow(slot, festate->m_table, festate->m_attrsUsed, const_cast<uint8_t*>(currRow->GetData()));
         ExecStoreVirtualTuple(slot);
 
         if (festate->m_ctidNum > 0) {
@@ -1095,6 +1461,35 @@ static TupleTableSlot* MOTIterateForeignScan(ForeignScanState* node)
     }
 }
 
+/*
+ * Returns a batch of up to BatchMaxSize rows, decoded column by column. An empty batch ends the scan.
+ */
+static VectorBatch* MOTVecIterateForeignScan(VecForeignScanState* node)
+{
+    MOTFdwStateSt* festate = (MOTFdwStateSt*)node->fdw_state;
+    VectorBatch* batch = node->m_pScanBatch;
+    MOT::Row* rows[BatchMaxSize];
+    int numRows = 0;
+
+    batch->Reset();
+    if (node->ss.is_scan_end || !MOTOpenScanCursor(node, festate)) {
+        return batch;
+    }
+
+    // collect the rows first, so every column is then decoded in one loop over the batch
+    while (numRows < BatchMaxSize) {
+        MOT::Row* currRow = MOTScanNextRow(node, festate);
+        if (currRow == nullptr) {
+            break;
+        }
+        rows[numRows++] = currRow;
+    }
+
+    MOTAdaptor::UnpackBatch(batch, festate->m_table, festate->m_attrsUsed, rows, numRows);
+    festate->m_rowsFound += numRows;
+    return batch;
+}
+
 /*
  *
  */
@@ -1108,7 +1503,14 @@ static void MOTReScanForeignScan(ForeignScanState* node)
     node->ss.is_scan_end = false;
 
     CleanCursors(festate);
-    if (!stopAtFirst) {
+    if (festate->m_inListIx != nullptr) {
+        // the array may depend on parameters, so the keys are looked up again
+        festate->m_cursorOpened = false;
+        festate->m_inListCount = 0;
+        festate->m_inListPos = 0;
+        festate->m_inListRemoteCount = 0;
+        festate->m_inListRemotePos = 0;
+    } else if (!stopAtFirst) {
         if (festate->m_execExprs == NULL) {
             ForeignScan* fscan = (ForeignScan*)node->ss.ps.plan;
             festate->m_execExprs = (List*)ExecInitExpr((Expr*)fscan->fdw_exprs, (PlanState*)node);
@@ -1153,48 +1555,82 @@ static void MOTAddForeignUpdateTargets(Query* parsetree, RangeTblEntry* targetRt
     parsetree->targetList = lappend(parsetree->targetList, tle);
 }
 
-static int MOTAcquireSampleRowsFunc(Relation relation, int elevel, HeapTuple* rows, int targrows, double* totalrows,
-    double* totaldeadrows, void* additionalData, bool estimateTableRowNum)
+/*
+ * Tables with up to this many times the sample size rows are sampled by a full scan, which also counts their rows
+ * exactly. Larger tables are sampled at random index positions.
+ */
+#define MOT_SAMPLE_SCAN_RATIO 10
+
+/*
+ * Copies the committed image of a row into buf, without adding the row to the transaction's access set.
+ * Returns false if the row is deleted, not yet committed or held by a prepared transaction.
+ */
+static bool MOTCopySampleRow(MOT::Sentinel* sentinel, uint8_t* buf, uint32_t len, uint64_t tid)
 {
-    MOT::RC rc = MOT::RC_OK;
-    int numrows = 0; /* # of sample rows collected */
-    /* for random sampling */
-    double samplerows = 0;                              /* # of rows fetched */
-    double rowstoskip = -1;                             /* # of rows to skip before next sample */
-    double rstate = anl_init_selection_state(targrows); /* random state */
-    MOT::TxnManager* currTxn = GetSafeTxn(__FUNCTION__);
-    MOT::Table* table = currTxn->GetTableByExternalId(RelationGetRelid(relation));
-    if (table == nullptr) {
-        abortParentTransactionParamsNoDetail(
-            ERRCODE_UNDEFINED_TABLE, MOT_TABLE_NOTFOUND, (char*)RelationGetRelationName(relation));
-        return 0;
+    MOT::Row* row = sentinel->GetData();
+    if (row == nullptr) {
+        return false;
     }
-    MOT::IndexIterator* cursor = table->Begin(currTxn->GetThdId());
-    TupleDesc desc = RelationGetDescr(relation);
-    TupleTableSlot* slot = MakeSingleTupleTableSlot(desc);
-    uint8_t attrsUsed[8];
-    int pos = 0;
-    MOT::Row* row = nullptr;
 
-    for (int i = 0; i < desc->natts; i++) {
-        if (!desc->attrs[i]->attisdropped) {
-            BITMAP_SET(attrsUsed, (desc->attrs[i]->attnum - 1));
+    if (!sentinel->TryLock(tid)) {
+        if (row->GetTwoPhaseMode()) {
+            return false;
         }
+        sentinel->Lock(tid);
     }
 
-    while (cursor->IsValid()) {
-        row = NULL;
+    row = sentinel->GetData();
+    bool copied = (row != nullptr && sentinel->IsCommited());
+    if (copied) {
+        errno_t erc = memcpy_s(buf, len, row->GetData(), len);
+        securec_check(erc, "\0", "\0");
+    }
+    sentinel->Release();
+    return copied;
+}
+
+/*
+ * Keeps the data of a sample row for refreshing the index statistics.
+ */
+static void MOTKeepSampleRow(uint8_t** sampleData, int pos, const uint8_t* rowData, uint32_t len)
+{
+    if (sampleData[pos] == nullptr) {
+        sampleData[pos] = (uint8_t*)palloc(len);
+    }
+    errno_t erc = memcpy_s(sampleData[pos], len, rowData, len);
+    securec_check(erc, "\0", "\0");
+}
+
+static HeapTuple MOTMakeSampleTuple(TupleTableSlot* slot, MOT::Table* table, uint8_t* attrsUsed, uint8_t* data)
+{
+    (void)ExecClearTuple(slot);
+    MOTAdaptor::UnpackRow(slot, table, attrsUsed, data);
+    ExecStoreVirtualTuple(slot);
+    return ExecCopySlotTuple(slot);
+}
+
+static int MOTScanSampleRows(MOT::TxnManager* currTxn, MOT::Table* table, TupleTableSlot* slot, uint8_t* attrsUsed,
+    uint8_t* rowData, uint8_t** sampleData, HeapTuple* rows, int targrows, double* samplerows)
+{
+    int numrows = 0;        /* # of sample rows collected */
+    double rowstoskip = -1; /* # of rows to skip before next sample */
+    double rstate = anl_init_selection_state(targrows); /* random state */
+    uint32_t tupleSize = table->GetTupleSize();
+    int pos = 0;
 
-        MOT::Sentinel* Sentinel = cursor->GetPrimarySentinel();
-        row = currTxn->RowLookup(MOT::AccessType::RD, Sentinel, rc);
+    *samplerows = 0;
+    MOT::IndexIterator* cursor = table->Begin(currTxn->GetThdId());
+    while (cursor->IsValid()) {
+        MOT::Sentinel* sentinel = cursor->GetPrimarySentinel();
+        bool copied = MOTCopySampleRow(sentinel, rowData, tupleSize, currTxn->GetThdId());
         cursor->Next();
 
-        if (row == NULL) {
+        if (!copied) {
             continue;
         }
 
         /* Always increment sample row counter. */
-        samplerows += 1;
+        *samplerows += 1;
 
         /*
          * Determine the slot where this sample row should be stored.  Set pos to
@@ -1210,7 +1646,7 @@ static int MOTAcquireSampleRowsFunc(Relation relation, int elevel, HeapTuple* ro
              * analyze.c; see Jeff Vitter's paper.
              */
             if (rowstoskip < 0)
-                rowstoskip = anl_get_next_S(samplerows, targrows, &rstate);
+                rowstoskip = anl_get_next_S(*samplerows, targrows, &rstate);
 
             if (rowstoskip <= 0) {
                 /* Choose a random reservoir element to replace. */
@@ -1230,34 +1666,96 @@ static int MOTAcquireSampleRowsFunc(Relation relation, int elevel, HeapTuple* ro
              * Create sample tuple from current result row, and store it in the
              * position determined above.  The tuple has to be created in anl_cxt.
              */
-            (void)ExecClearTuple(slot);
-            MOTAdaptor::UnpackRow(slot, table, attrsUsed, const_cast<uint8_t*>(row->GetData()));
-            ExecStoreVirtualTuple(slot);
-            rows[pos] = ExecCopySlotTuple(slot);
+            rows[pos] = MOTMakeSampleTuple(slot, table, attrsUsed, rowData);
+            MOTKeepSampleRow(sampleData, pos, rowData, tupleSize);
         }
     }
 
-    /* clean up */
-    ExecDropSingleTupleTableSlot(slot);
+    cursor->Invalidate();
+    cursor->Destroy();
+    delete cursor;
+    return numrows;
+}
+
+static int MOTAcquireSampleRowsFunc(Relation relation, int elevel, HeapTuple* rows, int targrows, double* totalrows,
+    double* totaldeadrows, void* additionalData, bool estimateTableRowNum)
+{
+    int numrows = 0;       /* # of sample rows collected */
+    double samplerows = 0; /* # of rows fetched */
+    MOT::TxnManager* currTxn = GetSafeTxn(__FUNCTION__);
+    MOT::Table* table = currTxn->GetTableByExternalId(RelationGetRelid(relation));
+    if (table == nullptr) {
+        abortParentTransactionParamsNoDetail(
+            ERRCODE_UNDEFINED_TABLE, MOT_TABLE_NOTFOUND, (char*)RelationGetRelationName(relation));
+        return 0;
+    }
+    TupleDesc desc = RelationGetDescr(relation);
+    TupleTableSlot* slot = MakeSingleTupleTableSlot(desc);
+    uint8_t attrsUsed[8];
+    uint8_t* rowData = (uint8_t*)palloc(table->GetTupleSize());
+    uint8_t** sampleData = (uint8_t**)palloc0(sizeof(uint8_t*) * targrows);
+
+    for (int i = 0; i < desc->natts; i++) {
+        if (!desc->attrs[i]->attisdropped) {
+            BITMAP_SET(attrsUsed, (desc->attrs[i]->attnum - 1));
+        }
+    }
+
+    /* hash indexes count their entries, otherwise rely on the row count maintained by the table */
+    MOT::Index* index = table->GetPrimaryIndex();
+    double estimatedRows = (double)index->GetSize();
+    if (estimatedRows == 0) {
+        estimatedRows = (double)table->GetRowCount();
+    }
+
+    if (estimatedRows <= (double)targrows * MOT_SAMPLE_SCAN_RATIO) {
+        numrows = MOTScanSampleRows(currTxn, table, slot, attrsUsed, rowData, sampleData, rows, targrows, &samplerows);
+
+        /* We've retrieved all living tuples. */
+        *totalrows = samplerows;
+    } else {
+        /* Collect the sample at random index positions, in time proportional to the sample size */
+        std::vector<MOT::Sentinel*> sentinels;
+        uint64_t seed = ((uint64_t)random() << 32) | (uint64_t)random();
+        index->Sample((uint32_t)targrows, seed, sentinels, currTxn->GetThdId());
+        for (MOT::Sentinel* sentinel : sentinels) {
+            if (MOTCopySampleRow(sentinel, rowData, table->GetTupleSize(), currTxn->GetThdId())) {
+                rows[numrows] = MOTMakeSampleTuple(slot, table, attrsUsed, rowData);
+                MOTKeepSampleRow(sampleData, numrows, rowData, table->GetTupleSize());
+                numrows++;
+            }
+        }
+        samplerows = sentinels.size();
+        *totalrows = estimatedRows;
+    }
+
+    /* refresh the cardinality estimates the planner costs index scans with */
+    if (!estimateTableRowNum) {
+        for (uint16_t i = 0; i < table->GetNumIndexes(); i++) {
+            table->GetIndex(i)->UpdateStatistics(sampleData, (uint32_t)numrows, *totalrows);
+        }
+    }
 
-    if (cursor != NULL) {
-        cursor->Invalidate();
-        cursor->Destroy();
-        delete cursor;
+    /* clean up */
+    for (int i = 0; i < targrows; i++) {
+        if (sampleData[i] != nullptr) {
+            pfree(sampleData[i]);
+        }
     }
+    pfree(sampleData);
+    pfree(rowData);
+    ExecDropSingleTupleTableSlot(slot);
 
     /* We assume that we have no dead tuple. */
     *totaldeadrows = 0.0;
 
-    /* We've retrieved all living tuples from foreign server. */
-    *totalrows = samplerows;
-
     /*
      * Emit some interesting relation info
      */
     ereport(elevel,
-        (errmsg("\"%s\": table contains %.0f rows, %d rows in sample",
+        (errmsg("\"%s\": table contains %.0f rows, %.0f rows scanned, %d rows in sample",
             RelationGetRelationName(relation),
+            *totalrows,
             samplerows,
             numrows)));
 
@@ -2473,6 +2971,9 @@ void FDWStorageReaderThreadMain(uint64_t id) {
 void FDWStorageUpdaterThreadMain(uint64_t id) { 
     StorageUpdaterThreadMain(id);
 }
+uint64_t FDWStorageMaxApplyLaneNum() {
+    return StorageMaxApplyLaneNum();
+}
 void FDWStorageWorker1ThreadMain(uint64_t id) {
     StorageWorker1ThreadMain(id);
 }
\ No newline at end of file
@@ -22,6 +22,7 @@
  * -------------------------------------------------------------------------
  */
 #include <google/protobuf/io/gzip_stream.h>
+#include <google/protobuf/io/coded_stream.h>
 #include <google/protobuf/io/zero_copy_stream_impl.h>
 #include <google/protobuf/message.h>
 
@@ -36,6 +37,9 @@
 #include "server.pb.h"
 #include "storage.pb.h"
 #include "message.pb.h"
+#include "lz4.h"
+#include "lz4hc.h"
+#include "zstd.h"
 #include "postgres.h"
 #include "access/dfs/dfs_query.h"
 #include "access/sysattr.h"
@@ -45,14 +49,20 @@
 #include "nodes/makefuncs.h"
 #include "parser/parse_type.h"
 #include "utils/syscache.h"
+#include "utils/array.h"
+#include "utils/lsyscache.h"
 #include "executor/executor.h"
+#include "vecexecutor/vectorbatch.h"
 #include "storage/ipc.h"
 #include "commands/dbcommands.h"
 #include "knl/knl_session.h"
+#include "threadpool/threadpool.h"
 
 #include "mot_internal.h"
+#include "mot_commit_table.h"
 #include "row.h"
 #include "log_statistics.h"
+#include "statistics_manager.h"
 #include "spin_lock.h"
 #include "txn.h"
 #include "table.h"
@@ -61,6 +71,7 @@
 #include "sentinel.h"
 #include "txn.h"
 #include "txn_access.h"
+#include "snapshot_registry.h"
 #include "index_factory.h"
 #include "column.h"
 #include "mm_raw_chunk_store.h"
@@ -79,6 +90,7 @@
 #include "sstream"
 #include <fstream>
 #include <atomic>
+#include <algorithm>
 #include <sys/time.h>
 // #include "neu_concurrency_tools/blockingconcurrentqueue.h"
 // #include "neu_concurrency_tools/blocking_mpmc_queue.h"
@@ -269,6 +281,18 @@ static void WakeupWalWriter()
     }
 }
 
+// the native redo log stays on this node, a standby fed by the envelope WAL would miss every MOT change
+static bool IsReplicationConfigured()
+{
+    for (int i = 0; i < GUC_MAX_REPLNODE_NUM; i++) {
+        const char* connInfo = u_sess->attr.attr_storage.ReplConnInfoArr[i];
+        if (connInfo != nullptr && connInfo[0] != '\0') {
+            return true;
+        }
+    }
+    return false;
+}
+
 void MOTAdaptor::Init()
 {
     if (m_initialized) {
@@ -305,6 +329,20 @@ void MOTAdaptor::Init()
         elog(FATAL, "Failed to load configuration for MOT engine.");
     }
 
+    if (motCfg.m_enableRedoLog && motCfg.m_loggerType == MOT::LoggerType::NATIVE_LOGGER &&
+        IsReplicationConfigured()) {
+        m_engine->RemoveConfigLoader(gaussdbConfigLoader);
+        delete gaussdbConfigLoader;
+        gaussdbConfigLoader = nullptr;
+        MOT::MOTEngine::DestroyInstance();
+        ereport(FATAL,
+            (errmodule(MOD_MOT),
+                errcode(ERRCODE_CONFIG_FILE_ERROR),
+                errmsg("MOT logger_type 'native' cannot be used with replication"),
+                errdetail("The native redo log is not shipped to standby nodes, which would miss all MOT changes."),
+                errhint("Set logger_type to 'external' in mot.conf, or remove the replconninfo settings.")));
+    }
+
     // Check max process memory here - we do it anyway to protect ourselves from miscalculations.
     // Attention: the following values are configured during the call to MOTEngine::LoadConfig() just above
     uint64_t globalMemoryKb = MOT::g_memGlobalCfg.m_maxGlobalMemoryMb * KILO_BYTE;
@@ -561,12 +599,44 @@ void MOTAdaptor::DestroyTxn(int status, Datum ptr)
     MOTOnThreadShutdown();
 }
 
+/**
+ * @brief Waits for the TaaS verdict of a transaction handed off by TxnManager::SubmitCommit(). When running under
+ * the thread pool, the wait is reported to the worker's group, so the scheduler can bring up workers for the other
+ * sessions of the group while this one is parked on the network round trip.
+ */
+static MOT::RC WaitTaasCommit(MOT::TxnManager* txn)
+{
+    ThreadPoolGroup* group = IS_THREAD_POOL_WORKER ? t_thrd.threadpool_cxt.group : nullptr;
+    if (group != nullptr) {
+        group->BeginRemoteWait();
+    }
+    WaitState oldStatus = pgstat_report_waitstatus(STATE_WAIT_COMM);
+    MOT::RC rc = txn->WaitCommit(kTxnReplyTimeout_us);
+    if (rc == MOT::RC_WAIT) {
+        // the txn node is slow or gone: route new change sets elsewhere, the verdict of this one still counts
+        MOTAdaptor::ReportCommitTimeout(txn);
+        rc = txn->WaitCommit(kTxnVerdictTimeout_us);
+        if (rc == MOT::RC_WAIT) {
+            rc = MOTAdaptor::AbandonCommit(txn);
+        }
+    }
+    (void)pgstat_report_waitstatus(oldStatus);
+    if (group != nullptr) {
+        group->EndRemoteWait();
+    }
+    return rc;
+}
+
 MOT::RC MOTAdaptor::ValidateCommit()
 {
     EnsureSafeThreadAccessInline();
     MOT::TxnManager* txn = GetSafeTxn(__FUNCTION__);
     if (!IS_PGXC_COORDINATOR) {
-        return txn->ValidateCommit();
+        MOT::RC rc = txn->SubmitCommit();
+        if (rc == MOT::RC_WAIT) {
+            rc = WaitTaasCommit(txn);
+        }
+        return rc;
     } else {
         // Nothing to do in coordinator
         return MOT::RC_OK;
@@ -739,6 +809,11 @@ MatchIndex* MOTAdaptor::GetBestMatchIndex(MOTFdwStateSt* festate, MatchIndexArr*
     for (uint16_t i = 0; i < numIx; i++) {
         if (marr->m_idx[i] != nullptr && marr->m_idx[i]->IsUsable()) {
             double cost = marr->m_idx[i]->GetCost(numClauses);
+            // hash indexes serve only exact lookups of the full key
+            if (marr->m_idx[i]->m_ix->GetIndexingMethod() != MOT::IndexingMethod::INDEXING_METHOD_TREE &&
+                !marr->m_idx[i]->IsPointLookup()) {
+                continue;
+            }
             if (cost < bestCost) {
                 if (bestI < MAX_NUM_INDEXES) {
                     if (marr->m_idx[i]->GetNumMatchedCols() < marr->m_idx[bestI]->GetNumMatchedCols())
@@ -834,6 +909,15 @@ void MOTAdaptor::OpenCursor(Relation rel, MOTFdwStateSt* festate)
             MOT::Index* ix = festate->m_table->GetPrimaryIndex();
             uint16_t keyLength = ix->GetKeyLength();
 
+            // a hash index has no key order to bound the scan with, its iterator is pinned to the bucket
+            // array seen on start instead
+            if (ix->GetIndexingMethod() != MOT::IndexingMethod::INDEXING_METHOD_TREE) {
+                festate->m_forwardDirectionScan = true;
+                festate->m_cursor[0] = festate->m_table->Begin(festate->m_currTxn->GetThdId());
+                festate->m_cursor[1] = nullptr;
+                break;
+            }
+
             if (festate->m_order == SORTDIR_ENUM::SORTDIR_ASC) {
                 fIx = 0;
                 bIx = 1;
@@ -857,7 +941,9 @@ void MOTAdaptor::OpenCursor(Relation rel, MOTFdwStateSt* festate)
 
         for (int i = 0; i < 2; i++) {
             if (i == 1 && festate->m_bestIx->m_end < 0) {
-                if (festate->m_forwardDirectionScan) {
+                if (festate->m_bestIx->m_ix->GetIndexingMethod() != MOT::IndexingMethod::INDEXING_METHOD_TREE) {
+                    festate->m_cursor[1] = nullptr;
+                } else if (festate->m_forwardDirectionScan) {
                     uint8_t* buf = nullptr;
                     MOT::Index* ix = festate->m_bestIx->m_ix;
                     uint16_t keyLength = ix->GetKeyLength();
@@ -1078,8 +1164,17 @@ void MOTAdaptor::ValidateCreateIndex(IndexStmt* stmt, MOT::Table* table, MOT::Tx
         return;
     }
 
-    if (strcmp(stmt->accessMethod, "btree") != 0) {
-        ereport(ERROR, (errmodule(MOD_MOT), errmsg("MOT supports indexes of type BTREE only (btree or btree_art)")));
+    if (strcmp(stmt->accessMethod, "btree") != 0 && strcmp(stmt->accessMethod, "hash") != 0) {
+        ereport(ERROR,
+            (errmodule(MOD_MOT), errmsg("MOT supports indexes of type BTREE or HASH only (btree, btree_art or hash)")));
+        return;
+    }
+
+    if (strcmp(stmt->accessMethod, "hash") == 0 && !stmt->unique && !stmt->primary) {
+        ereport(ERROR,
+            (errmodule(MOD_MOT),
+                errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
+                errmsg("MOT supports unique HASH indexes only")));
         return;
     }
 
@@ -1131,6 +1226,13 @@ MOT::RC MOTAdaptor::CreateIndex(IndexStmt* stmt, ::TransactionId tid)
         index_order = MOT::IndexOrder::INDEX_ORDER_PRIMARY;
     }
 
+    // primary key constraints cannot name an access method, their indexing method comes from the configuration
+    if (strcmp(stmt->accessMethod, "hash") == 0) {
+        indexing_method = MOT::IndexingMethod::INDEXING_METHOD_HASH;
+    } else if (stmt->primary) {
+        indexing_method = MOT::GetGlobalConfiguration().m_primaryIndexingMethod;
+    }
+
     index = MOT::IndexFactory::CreateIndex(index_order, indexing_method, flavor);
     if (index == nullptr) {
         report_pg_error(MOT::RC_ABORT);
@@ -1662,6 +1764,31 @@ MotSessionMemoryDetail* MOTAdaptor::GetSessionMemSize(uint32_t* sessionCount)
     return result;
 }
 
+MOT::HistogramSummary* MOTAdaptor::GetHistogramStatistics(uint32_t* histogramCount)
+{
+    EnsureSafeThreadAccessInline();
+    MOT::HistogramSummary* result = nullptr;
+    *histogramCount = 0;
+
+    MOT::mot_vector<MOT::HistogramSummary> summaries;
+    if (!MOT::StatisticsManager::GetInstance().GetHistogramSummaries(summaries)) {
+        ereport(ERROR, (errcode(ERRCODE_OUT_OF_MEMORY), errmsg("Failed to collect MOT histogram statistics")));
+    }
+
+    uint32_t count = summaries.size();
+    if (count > 0) {
+        result = (MOT::HistogramSummary*)palloc(count * sizeof(MOT::HistogramSummary));
+        if (result != nullptr) {
+            for (uint32_t i = 0; i < count; ++i) {
+                result[i] = summaries[i];
+            }
+            *histogramCount = count;
+        }
+    }
+
+    return result;
+}
+
 void MOTAdaptor::CreateKeyBuffer(Relation rel, MOTFdwStateSt* festate, int start)
 {
     uint8_t* buf = nullptr;
@@ -1775,6 +1902,135 @@ void MOTAdaptor::CreateKeyBuffer(Relation rel, MOTFdwStateSt* festate, int start
     festate->m_bestIx->m_ix->AdjustKey(&festate->m_stateKey[start], pattern);
 }
 
+static int CompareInListKeys(const void* lhs, const void* rhs)
+{
+    const MOT::Key* lhsKey = *(const MOT::Key* const*)lhs;
+    const MOT::Key* rhsKey = *(const MOT::Key* const*)rhs;
+    return memcmp(lhsKey->GetKeyBuf(), rhsKey->GetKeyBuf(), lhsKey->GetKeyLength());
+}
+
+MOT::RC MOTAdaptor::LookupInList(Relation rel, MOTFdwStateSt* festate)
+{
+    EnsureSafeThreadAccessInline();
+    MOT::Index* ix = festate->m_inListIx;
+    int16_t colId = ix->GetColumnKeyFields()[0];
+    MOT::Column* col = festate->m_table->GetField(colId);
+    uint16_t keyLength = ix->GetKeyLength();
+    ExprState* expr = (ExprState*)linitial(festate->m_execExprs);
+    bool isNull = false;
+
+    festate->m_inListCount = 0;
+    festate->m_inListPos = 0;
+    festate->m_inListRemoteCount = 0;
+    festate->m_inListRemotePos = 0;
+    Datum val = ExecEvalExpr(expr, festate->m_econtext, &isNull, nullptr);
+    if (isNull) {
+        return MOT::RC_OK;
+    }
+
+    ArrayType* arr = DatumGetArrayTypeP(val);
+    Oid elemType = ARR_ELEMTYPE(arr);
+    int16 elemLen = 0;
+    bool elemByVal = false;
+    char elemAlign = 0;
+    Datum* elems = nullptr;
+    bool* nulls = nullptr;
+    int numElems = 0;
+    get_typlenbyvalalign(elemType, &elemLen, &elemByVal, &elemAlign);
+    deconstruct_array(arr, elemType, elemLen, elemByVal, elemAlign, &elems, &nulls, &numElems);
+    if (numElems == 0) {
+        return MOT::RC_OK;
+    }
+
+    MOT::MaxKey* keyBufs = (MOT::MaxKey*)palloc(sizeof(MOT::MaxKey) * numElems);
+    MOT::Key** keys = (MOT::Key**)palloc(sizeof(MOT::Key*) * numElems);
+    uint32_t numKeys = 0;
+    for (int i = 0; i < numElems; i++) {
+        if (nulls[i]) {
+            continue;
+        }
+        MOT::MaxKey* key = new (&keyBufs[numKeys]) MOT::MaxKey();
+        key->InitKey(keyLength);
+        DatumToMOTKey(col,
+            elemType,
+            elems[i],
+            rel->rd_att->attrs[colId - 1]->atttypid,
+            key->GetKeyBuf(),
+            ix->GetLengthKeyFields()[0],
+            KEY_OPER::READ_KEY_EXACT,
+            0x00);
+        ix->AdjustKey(key, 0x00);
+        keys[numKeys++] = key;
+    }
+
+    // each row is returned once, however often its key is listed
+    if (numKeys > 1) {
+        qsort(keys, numKeys, sizeof(MOT::Key*), CompareInListKeys);
+        uint32_t numDistinct = 1;
+        for (uint32_t i = 1; i < numKeys; i++) {
+            if (CompareInListKeys(&keys[numDistinct - 1], &keys[i]) != 0) {
+                keys[numDistinct++] = keys[i];
+            }
+        }
+        numKeys = numDistinct;
+    }
+
+    if (festate->m_inListSentinels != nullptr) {
+        pfree(festate->m_inListSentinels);
+    }
+    festate->m_inListSentinels = (MOT::Sentinel**)palloc(sizeof(MOT::Sentinel*) * (numKeys + 1));
+    (void)ix->IndexReadBatch(keys, numKeys, festate->m_inListSentinels, festate->m_currTxn->GetThdId());
+    festate->m_inListCount = numKeys;
+
+    MOT::RC rc = MOT::RC_OK;
+    if (MOT::GetGlobalConfiguration().m_enableRemoteRead && ix->IsPrimaryKey() &&
+        festate->m_internalCmdOper == MOT::AccessType::RD) {
+        rc = ReadInListRemote(festate, keys, numKeys);
+    }
+
+    pfree(keys);
+    pfree(keyBufs);
+    pfree(elems);
+    pfree(nulls);
+    return rc;
+}
+
+MOT::RC MOTAdaptor::ReadInListRemote(MOTFdwStateSt* festate, MOT::Key** keys, uint32_t numKeys)
+{
+    std::vector<MOT::Key*> missing;
+    for (uint32_t i = 0; i < numKeys; i++) {
+        if (festate->m_inListSentinels[i] == nullptr) {
+            missing.push_back(keys[i]);
+        }
+    }
+    if (missing.empty()) {
+        return MOT::RC_OK;
+    }
+
+    std::vector<std::string> rows;
+    MOT::RC rc = RemoteRead(festate->m_table, missing, rows);
+    if (rc != MOT::RC_OK) {
+        return rc;
+    }
+
+    uint32_t tupleSize = festate->m_table->GetTupleSize();
+    if (festate->m_inListRemoteRows != nullptr) {
+        pfree(festate->m_inListRemoteRows);
+    }
+    festate->m_inListRemoteRows = (uint8_t*)palloc(tupleSize * missing.size());
+    for (const std::string& row : rows) {
+        if (row.length() == tupleSize) {
+            errno_t erc = memcpy_s(festate->m_inListRemoteRows + festate->m_inListRemoteCount * tupleSize,
+                tupleSize,
+                row.data(),
+                tupleSize);
+            securec_check(erc, "\0", "\0");
+            festate->m_inListRemoteCount++;
+        }
+    }
+    return MOT::RC_OK;
+}
+
 bool MOTAdaptor::IsScanEnd(MOTFdwStateSt* festate)
 {
     bool res = false;
@@ -1936,6 +2192,71 @@ void MOTAdaptor::MOTToDatum(MOT::Table* table, const Form_pg_attribute attr, uin
     }
 }
 
+void MOTAdaptor::UnpackBatch(
+    VectorBatch* batch, MOT::Table* table, const uint8_t* attrs_used, MOT::Row* const* rows, int numRows)
+{
+    EnsureSafeThreadAccessInline();
+
+    // column count includes null bits field
+    int cols = (int)table->GetFieldCount() - 1;
+
+    for (int i = 0; i < batch->m_cols; i++) {
+        ScalarVector* vec = &(batch->m_arr[i]);
+
+        if (i >= cols || !BITMAP_GET(attrs_used, i)) {
+            for (int j = 0; j < numRows; j++) {
+                SET_NULL(vec->m_flag[j]);
+            }
+            continue;
+        }
+
+        MOT::Column* col = table->GetField(i + 1);
+        for (int j = 0; j < numRows; j++) {
+            uint8_t* data = const_cast<uint8_t*>(rows[j]->GetData());
+            if (!BITMAP_GET(data, i)) {
+                SET_NULL(vec->m_flag[j]);
+                continue;
+            }
+
+            uintptr_t val = 0;
+            size_t len = 0;
+            SET_NOTNULL(vec->m_flag[j]);
+            switch (vec->m_desc.typeId) {
+                case VARCHAROID:
+                case BPCHAROID:
+                case TEXTOID:
+                case CLOBOID:
+                case BYTEAOID:
+                    col->Unpack(data, &val, len);
+                    (void)vec->AddVarCharWithoutHeader((const char*)val, (int)len, j);
+                    break;
+                case NUMERICOID: {
+                    MOT::DecimalSt* d = nullptr;
+                    col->Unpack(data, (uintptr_t*)&d, len);
+                    Datum num = NumericGetDatum(MOTNumericToPG(d));
+                    Datum fast = try_convert_numeric_normal_to_fast(num);
+                    (void)vec->AddVar(fast, j);
+                    if (DatumGetPointer(fast) != DatumGetPointer(num)) {
+                        pfree(DatumGetPointer(fast));
+                    }
+                    pfree(DatumGetPointer(num));
+                    break;
+                }
+                default:
+                    col->Unpack(data, &val, len);
+                    if (vec->m_desc.encoded) {
+                        (void)vec->AddVar((Datum)val, j);
+                    } else {
+                        vec->m_vals[j] = (ScalarValue)val;
+                    }
+                    break;
+            }
+        }
+    }
+
+    batch->FixRowCount(numRows);
+}
+
 void MOTAdaptor::DatumToMOT(MOT::Column* col, Datum datum, Oid type, uint8_t* data)
 {
     EnsureSafeThreadAccessInline();
@@ -2154,6 +2475,14 @@ MOTFdwStateSt* InitializeFdwState(void* fdwState, List** fdwExpr, uint64_t exTab
         cell = lnext(cell);
         state->m_numExpr = ((Const*)lfirst(cell))->constvalue;
         cell = lnext(cell);
+        int inListIxPos = (int)((Const*)lfirst(cell))->constvalue;
+        if (inListIxPos > 0) {
+            MOT::Table* table = GetSafeTxn(__FUNCTION__)->GetTableByExternalId(exTableID);
+            if (table != nullptr) {
+                state->m_inListIx = table->GetIndex(inListIxPos - 1);
+            }
+        }
+        cell = lnext(cell);
 
         int len = BITMAP_GETLEN(state->m_numAttrs);
         state->m_attrsUsed = (uint8_t*)palloc0(len);
@@ -2201,6 +2530,15 @@ void* SerializeFdwState(MOTFdwStateSt* state)
     result = lappend(result, makeConst(INT4OID, -1, InvalidOid, 4, Int32GetDatum(state->m_numAttrs), false, true));
     result = lappend(result, makeConst(INT4OID, -1, InvalidOid, 4, Int32GetDatum(state->m_ctidNum), false, true));
     result = lappend(result, makeConst(INT2OID, -1, InvalidOid, 2, Int16GetDatum(state->m_numExpr), false, true));
+    // the IN-list index is stored as its position plus one, zero stands for none
+    int inListIxPos = 0;
+    for (uint16_t i = 0; state->m_inListIx != nullptr && i < state->m_table->GetNumIndexes(); i++) {
+        if (state->m_table->GetIndex(i) == state->m_inListIx) {
+            inListIxPos = i + 1;
+            break;
+        }
+    }
+    result = lappend(result, makeConst(INT4OID, -1, InvalidOid, 4, Int32GetDatum(inListIxPos), false, true));
     int len = BITMAP_GETLEN(state->m_numAttrs);
     result = BitmapSerialize(result, state->m_attrsUsed, len);
 
@@ -2225,6 +2563,12 @@ void ReleaseFdwState(MOTFdwStateSt* state)
     if (state->m_remoteCondsOrig != nullptr)
         list_free(state->m_remoteCondsOrig);
 
+    if (state->m_inListSentinels != nullptr)
+        pfree(state->m_inListSentinels);
+
+    if (state->m_inListRemoteRows != nullptr)
+        pfree(state->m_inListRemoteRows);
+
     if (state->m_attrsUsed != NULL)
         pfree(state->m_attrsUsed);
 
@@ -2313,190 +2657,365 @@ uint64_t now_to_us(){
     return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
 }
 
-template<typename key, typename value>
-class ConcurrentHashMap {
+template<typename T>
+using BlockingConcurrentQueue =  moodycamel::BlockingConcurrentQueue<T>;
+
+struct send_thread_params{
+    uint64_t current_epoch;
+    uint64_t tot;
+    std::string* merge_request_ptr;
+    uint64_t enqueue_time = 0; // us, used by the batching sender to report batch latency
+    send_thread_params(uint64_t ce, uint64_t tot_temp, std::string* ptr1):
+        current_epoch(ce), tot(tot_temp), merge_request_ptr(ptr1){}
+    send_thread_params(){}
+};
+
+// power-of-two bucketed histogram, single writer, reported periodically to the log
+class Log2Histogram {
 public:
-    typedef typename std::unordered_map<key, value>::iterator map_iterator;
-    typedef typename std::unordered_map<key, value>::size_type size_type;
-
-    bool insert(key &k, value &v, value *p) {
-        std::mutex& _mutex_temp = GetMutexRef(k);
-        std::unordered_map<key, value>& _map_temp = GetMapRef(k);
-        std::unique_lock<std::mutex> lock(_mutex_temp);
-        map_iterator iter = _map_temp.find(k);
-        if (iter == _map_temp.end()) {
-            _map_temp[k] = v;
-            *p = nullptr;
-        } else {
-            *p = _map_temp[k];
-            _map_temp[k] = v;
+    static const uint64_t kBucketNum = 64;
+
+    void Add(uint64_t value) {
+        uint64_t bucket = (value == 0) ? 0 : (64 - __builtin_clzll(value));
+        if (bucket >= kBucketNum) {
+            bucket = kBucketNum - 1;
+        }
+        buckets[bucket]++;
+        count++;
+        sum += value;
+        if (value > max) {
+            max = value;
         }
-        return true;
     }
 
-    void insert(key &k, value &v) {
-        std::mutex& _mutex_temp = GetMutexRef(k);
-        std::unordered_map<key, value>& _map_temp = GetMapRef(k);
-        std::unique_lock<std::mutex> lock(_mutex_temp);
-        _map_temp[k] = v;
+    // upper bound of the bucket holding the given percentile
+    uint64_t Percentile(double percentile) const {
+        if (count == 0) {
+            return 0;
+        }
+        uint64_t target = (uint64_t)(count * percentile / 100.0), seen = 0;
+        for (uint64_t i = 0; i < kBucketNum; i++) {
+            seen += buckets[i];
+            if (seen > target) {
+                uint64_t upper = (i == 0) ? 0 : ((uint64_t)1 << i) - 1;
+                return (upper < max) ? upper : max;
+            }
+        }
+        return max;
     }
 
+    void Print(const char* name) const {
+        MOT_LOG_INFO("%s count %llu avg %llu p50 %llu p90 %llu p99 %llu max %llu", name, count,
+            count == 0 ? 0 : sum / count, Percentile(50), Percentile(90), Percentile(99), max);
+    }
 
-    void remove(key &k, value &v) {
-        std::mutex& _mutex_temp = GetMutexRef(k);
-        std::unordered_map<key, value>& _map_temp = GetMapRef(k);
-        std::unique_lock<std::mutex> lock(_mutex_temp);
-        map_iterator iter = _map_temp.find(k);
-        if (iter != _map_temp.end()) {
-            if (iter->second == v) {
-                _map_temp.erase(iter);
-            }
-        }
+    void Reset() {
+        memset(buckets, 0, sizeof(buckets));
+        count = sum = max = 0;
     }
 
-    void remove(key &k) {
-        std::mutex& _mutex_temp = GetMutexRef(k);
-        std::unordered_map<key, value>& _map_temp = GetMapRef(k);
-        std::unique_lock<std::mutex> lock(_mutex_temp);
-        map_iterator iter = _map_temp.find(k);
-        if (iter != _map_temp.end()) {
-            _map_temp.erase(iter);
-        }
+private:
+    uint64_t buckets[kBucketNum] = {0};
+    uint64_t count = 0, sum = 0, max = 0;
+};
+
+// per txn gzip is the format txn nodes speak when is_protobuf_gzip is set
+bool Gzip(google::protobuf::MessageLite* ptr, std::string* serialized_str_ptr) {
+    google::protobuf::io::StringOutputStream outputStream(serialized_str_ptr);
+    if(is_protobuf_gzip) {
+        google::protobuf::io::GzipOutputStream::Options options;
+        options.format = google::protobuf::io::GzipOutputStream::GZIP;
+        options.compression_level = (int)kWireCodecLevel;
+        google::protobuf::io::GzipOutputStream gzipStream(&outputStream, options);
+        auto res = ptr->SerializeToZeroCopyStream(&gzipStream);
+        return gzipStream.Close() && res;
     }
+    auto res = ptr->SerializeToZeroCopyStream(&outputStream);
+    return res;
+}
+
+bool UnGzip(google::protobuf::MessageLite* ptr, const std::string* str) {
+    google::protobuf::io::ArrayInputStream inputStream(str->data(), (int)str->size());
+    google::protobuf::io::GzipInputStream gzipStream(&inputStream);
+    return ptr->ParseFromZeroCopyStream(&gzipStream);
+}
+
+// A framed payload starts with an 8 byte header: 0x00 (field number 0 is invalid, so a raw Message never starts
+// with it), the codec, flags, the codecs the sender accepts and the uncompressed size. Gzip payloads are known by
+// the gzip magic, anything else is a raw Message. Links that negotiated nothing keep the plain wire format.
+enum WireCodec : uint8_t {
+    kWireCodecNone = 0,
+    kWireCodecLz4 = 1,
+    kWireCodecZstd = 2,
+    kWireCodecNum = 3
+};
+const char* const kWireCodecName[kWireCodecNum] = {"none", "lz4", "zstd"};
+const uint8_t kWireFlagBatch = 0x01; // payload is a sequence of varint length prefixed Messages
+const uint32_t kWireLocalCodecs = (1 << kWireCodecNum) - 1;
+const size_t kWireHeaderSize = 8, kWireMinCompressBytes = 256, kWireMaxRawBytes = 1UL << 31;
+
+struct WireFrameInfo {
+    uint8_t codec = kWireCodecNone;
+    uint8_t flags = 0;
+    uint32_t peer_codecs = 1 << kWireCodecNone; // unframed peers only accept raw Messages
+};
 
-    void clear() {
-        for(uint64_t i = 0; i < _N; i ++){
-            std::unique_lock<std::mutex> lock(_mutex[i]);
-            _map[i].clear();
+// "lz4,zstd" -> codec mask, none is always accepted
+uint32_t ParseWireCodecs(const std::string& codecs) {
+    uint32_t mask = 1 << kWireCodecNone;
+    for(uint8_t i = 0; i < kWireCodecNum; i ++) {
+        if(codecs.find(kWireCodecName[i]) != std::string::npos) {
+            mask |= 1 << i;
         }
     }
+    return mask;
+}
+
+struct WireZstdContext {
+    ZSTD_CCtx* cctx = ZSTD_createCCtx();
+    ZSTD_DCtx* dctx = ZSTD_createDCtx();
+    ~WireZstdContext() {
+        ZSTD_freeCCtx(cctx);
+        ZSTD_freeDCtx(dctx);
+    }
+};
+thread_local WireZstdContext wire_zstd_context;
 
-    void unsafe_clear() {
-        for(uint64_t i = 0; i < _N; i ++){
-            _map[i].clear();
+// header + payload compressed with codec, kWireCodecNone copies the payload and only announces our codecs
+bool WireFrame(WireCodec codec, int level, uint8_t flags, const char* src, size_t size, std::string* out) {
+    if(size >= kWireMaxRawBytes) {
+        return false;
+    }
+    size_t bound = size;
+    if(codec == kWireCodecLz4) {
+        bound = (size_t)LZ4_compressBound((int)size);
+    }
+    else if(codec == kWireCodecZstd) {
+        bound = ZSTD_compressBound(size);
+    }
+    out->resize(kWireHeaderSize + bound);
+    auto* header = reinterpret_cast<uint8_t*>(&(*out)[0]);
+    header[0] = 0;
+    header[1] = codec;
+    header[2] = flags;
+    header[3] = (uint8_t)kWireLocalCodecs;
+    for(int i = 0; i < 4; i ++) {
+        header[4 + i] = (uint8_t)(size >> (8 * i));
+    }
+    char* dst = &(*out)[kWireHeaderSize];
+    size_t compressed = size;
+    if(codec == kWireCodecLz4) {
+        int res = (level <= 1) ? LZ4_compress_default(src, dst, (int)size, (int)bound) :
+            LZ4_compress_HC(src, dst, (int)size, (int)bound, level);
+        if(res <= 0) {
+            return false;
+        }
+        compressed = (size_t)res;
+    }
+    else if(codec == kWireCodecZstd) {
+        compressed = ZSTD_compressCCtx(wire_zstd_context.cctx, dst, bound, src, size, level);
+        if(ZSTD_isError(compressed)) {
+            return false;
         }
     }
+    else {
+        memcpy(dst, src, size);
+    }
+    out->resize(kWireHeaderSize + compressed);
+    return true;
+}
 
-    bool contain(key &k, value &v){
-        std::unordered_map<key, value>& _map_temp = GetMapRef(k);
-        std::mutex& _mutex_temp = GetMutexRef(k);
-        std::unique_lock<std::mutex> lock(_mutex_temp);
-        map_iterator iter = _map_temp.find(k);
-        if(iter != _map_temp.end()){
-            if(iter->second == v){
-                return true;
+// the raw payload of a received message: data itself, or scratch once decompressed. nullptr if it is corrupt.
+// sizes come from the peer, nothing at or above kWireMaxRawBytes is accepted or allocated
+const char* WireUnframe(const void* data, size_t size, std::string& scratch, size_t& raw_size, WireFrameInfo& info) {
+    auto* bytes = static_cast<const uint8_t*>(data);
+    info = WireFrameInfo();
+    if(size >= kWireMaxRawBytes) {
+        return nullptr;
+    }
+    if(size >= 2 && bytes[0] == 0x1f && bytes[1] == 0x8b) {
+        google::protobuf::io::ArrayInputStream inputStream(data, (int)size);
+        google::protobuf::io::GzipInputStream gzipStream(&inputStream);
+        const void* chunk;
+        int chunk_size;
+        scratch.clear();
+        while(gzipStream.Next(&chunk, &chunk_size)) {
+            if(scratch.size() + (size_t)chunk_size >= kWireMaxRawBytes) {
+                return nullptr;
             }
+            scratch.append(static_cast<const char*>(chunk), chunk_size);
         }
-        return false;
+        raw_size = scratch.size();
+        return scratch.data();
+    }
+    if(size == 0 || bytes[0] != 0) {
+        raw_size = size;
+        return static_cast<const char*>(data);
+    }
+    if(size < kWireHeaderSize || bytes[1] >= kWireCodecNum) {
+        return nullptr;
+    }
+    info.codec = bytes[1];
+    info.flags = bytes[2];
+    info.peer_codecs = bytes[3] | (1 << kWireCodecNone);
+    raw_size = 0;
+    for(int i = 0; i < 4; i ++) {
+        raw_size |= (size_t)bytes[4 + i] << (8 * i);
+    }
+    if(raw_size >= kWireMaxRawBytes) {
+        return nullptr;
+    }
+    const char* src = static_cast<const char*>(data) + kWireHeaderSize;
+    const size_t src_size = size - kWireHeaderSize;
+    if(info.codec == kWireCodecNone) {
+        return (raw_size == src_size) ? src : nullptr;
     }
+    scratch.resize(raw_size);
+    if(info.codec == kWireCodecLz4) {
+        if(LZ4_decompress_safe(src, &scratch[0], (int)src_size, (int)raw_size) != (int)raw_size) {
+            return nullptr;
+        }
+    }
+    else if(ZSTD_decompressDCtx(wire_zstd_context.dctx, &scratch[0], raw_size, src, src_size) != raw_size) {
+        return nullptr;
+    }
+    return scratch.data();
+}
 
-    bool contain(key &k){
-        std::unordered_map<key, value>& _map_temp = GetMapRef(k);
-        std::mutex& _mutex_temp = GetMutexRef(k);
-        std::unique_lock<std::mutex> lock(_mutex_temp);
-        map_iterator iter = _map_temp.find(k);
-        if(iter != _map_temp.end()){
-            return true;
+// calls handle(data, size) for every Message of a raw payload, false if a batch is truncated
+template<typename Handler>
+bool ForEachWireMessage(const char* data, size_t size, uint8_t flags, Handler&& handle) {
+    if((flags & kWireFlagBatch) == 0) {
+        handle(data, size);
+        return true;
+    }
+    size_t pos = 0;
+    uint32_t len;
+    while(pos < size) {
+        google::protobuf::io::CodedInputStream input(reinterpret_cast<const uint8_t*>(data + pos), (int)(size - pos));
+        if(!input.ReadVarint32(&len)) {
+            return false;
         }
-        return false;
+        pos += input.CurrentPosition();
+        if(len > size - pos) {
+            return false;
+        }
+        handle(data + pos, (size_t)len);
+        pos += len;
     }
+    return true;
+}
 
-    bool unsafe_contain(key &k, value &v){
-        std::unordered_map<key, value>& _map_temp = GetMapRef(k);
-        map_iterator iter = _map_temp.find(k);
-        if(iter != _map_temp.end()){
-            if(iter->second == v){
-                return true;
+// Codec choice of one outgoing link, owned by its send thread. A batch costs its compression time at the
+// measured compression speed plus the transmit time of the compressed bytes at the estimated link bandwidth,
+// the cheapest codec the peer accepts wins: bandwidth bound cross AZ links end up on zstd, rack local ones
+// send raw. A fixed wire_codec skips the estimate.
+class WireLink {
+public:
+    explicit WireLink(uint32_t peer_codecs = 1 << kWireCodecNone) : accepted(peer_codecs | (1 << kWireCodecNone)) {
+        configured_bandwidth = (double)kLinkBandwidthMbps / 8; // bytes per us
+        bandwidth = configured_bandwidth;
+        adaptive = (kWireCodec == "adaptive");
+        fixed = kWireCodecNone;
+        for(uint8_t i = 0; i < kWireCodecNum; i ++) {
+            if(kWireCodec == kWireCodecName[i]) {
+                fixed = i;
             }
         }
-        return false;
+        // optimistic guesses until the first batches are measured
+        ratio[kWireCodecNone] = 1.0;
+        ratio[kWireCodecLz4] = 0.5;
+        ratio[kWireCodecZstd] = 0.35;
+        speed[kWireCodecNone] = 0;
+        speed[kWireCodecLz4] = 500;
+        speed[kWireCodecZstd] = 150;
     }
 
-    bool get_value(key &k, value &v) {
-        std::unordered_map<key, value>& _map_temp = GetMapRef(k);
-        std::mutex& _mutex_temp = GetMutexRef(k);
-        std::unique_lock<std::mutex> lock(_mutex_temp);
-        map_iterator iter = _map_temp.find(k);
-        if(iter != _map_temp.end()) {
-            v = iter->second;
-            return true;
+    void SetPeerCodecs(uint32_t peer_codecs) {
+        accepted = peer_codecs | (1 << kWireCodecNone);
+    }
+
+    WireCodec Choose(size_t bytes) {
+        if(bytes < kWireMinCompressBytes) {
+            return kWireCodecNone;
         }
-        else {
-            return false;
+        if(!adaptive) {
+            return ((accepted >> fixed) & 1) ? (WireCodec)fixed : kWireCodecNone;
+        }
+        // now and then try another codec, its estimate would go stale otherwise
+        if(++choose_cnt % kProbeInterval == 0) {
+            for(uint8_t i = 1; i < kWireCodecNum; i ++) {
+                probe = (uint8_t)(probe % (kWireCodecNum - 1) + 1);
+                if((accepted >> probe) & 1) {
+                    return (WireCodec)probe;
+                }
+            }
         }
+        uint8_t best = kWireCodecNone;
+        double best_cost = (double)bytes / bandwidth, cost;
+        for(uint8_t i = 1; i < kWireCodecNum; i ++) {
+            if(((accepted >> i) & 1) == 0) {
+                continue;
+            }
+            cost = (double)bytes / speed[i] + (double)bytes * ratio[i] / bandwidth;
+            if(cost < best_cost) {
+                best = i;
+                best_cost = cost;
+            }
+        }
+        return (WireCodec)best;
     }
 
-    bool unsafe_get_value(key &k, value &v) {
-        std::unordered_map<key, value>& _map_temp = GetMapRef(k);
-        map_iterator iter = _map_temp.find(k);
-        if(iter != _map_temp.end()) {
-            v = iter->second;
-            return true;
-        }
-        else {
-            return false;
+    void OnCompressed(WireCodec codec, size_t raw, size_t compressed, uint64_t elapsed_us) {
+        chosen[codec]++;
+        if(codec == kWireCodecNone || raw == 0) {
+            return;
         }
+        ratio[codec] = ratio[codec] * (1 - kAlpha) + (double)compressed / raw * kAlpha;
+        speed[codec] = speed[codec] * (1 - kAlpha) + (double)raw / std::max<uint64_t>(elapsed_us, 1) * kAlpha;
     }
 
-    size_type size() {
-        size_type ans = 0;
-        for(uint64_t i = 0; i < _N; i ++){
-            std::unique_lock<std::mutex> lock(_mutex[i]);
-            ans += _map[i].size();
+    // a send only blocks once the socket's high water mark is hit, that is when the link is the bottleneck
+    void OnSent(size_t bytes, uint64_t elapsed_us) {
+        if(elapsed_us >= kBackpressure_us) {
+            bandwidth = bandwidth * (1 - kAlpha) + (double)bytes / elapsed_us * kAlpha;
+        }
+        else {
+            bandwidth += (configured_bandwidth - bandwidth) * kRelax;
         }
-        return ans;
     }
 
-protected:
-    inline std::unordered_map<key, value>& GetMapRef(const key k){ return _map[(_hash(k) % _N)]; }
-    inline std::unordered_map<key, value>& GetMapRef(const key k) const { return _map[(_hash(k) % _N)]; }
-    inline std::mutex& GetMutexRef(const key k) { return _mutex[(_hash(k) % _N)]; }
-    inline std::mutex& GetMutexRef(const key k) const {return _mutex[(_hash(k) % _N)]; }
+    void Print(const char* name) {
+        MOT_LOG_INFO("%s bandwidth %.1f MB/s, lz4 ratio %.2f %.0f MB/s %llu batches, zstd ratio %.2f %.0f MB/s %llu batches, raw %llu batches",
+            name, bandwidth, ratio[kWireCodecLz4], speed[kWireCodecLz4], chosen[kWireCodecLz4],
+            ratio[kWireCodecZstd], speed[kWireCodecZstd], chosen[kWireCodecZstd], chosen[kWireCodecNone]);
+        memset(chosen, 0, sizeof(chosen));
+    }
 
 private:
-    const static uint64_t _N = 101;//521 997 1217 12281 122777 prime
-    std::hash<key> _hash;
-    std::unordered_map<key, value> _map[_N];
-    std::mutex _mutex[_N];
+    static constexpr double kAlpha = 0.1, kRelax = 0.01;
+    static const uint64_t kProbeInterval = 64, kBackpressure_us = 50;
+    uint32_t accepted;
+    bool adaptive;
+    uint8_t fixed, probe = 0;
+    uint64_t choose_cnt = 0;
+    double configured_bandwidth, bandwidth;
+    double ratio[kWireCodecNum], speed[kWireCodecNum]; // compressed/raw, raw bytes per us
+    uint64_t chosen[kWireCodecNum] = {0};
 };
 
+// frame a message for link with the codec it chose, raw if compression fails
+void WireFrameForLink(WireLink& link, WireCodec codec, uint8_t flags, const char* src, size_t size, std::string* out) {
+    uint64_t start = now_to_us();
+    if(!WireFrame(codec, (int)kWireCodecLevel, flags, src, size, out)) {
+        codec = kWireCodecNone;
+        WireFrame(codec, 0, flags, src, size, out);
+    }
+    link.OnCompressed(codec, size, out->size() - kWireHeaderSize, now_to_us() - start);
+}
 
 
 
-template<typename T>
-using BlockingConcurrentQueue =  moodycamel::BlockingConcurrentQueue<T>;
-
-struct send_thread_params{
-    uint64_t current_epoch;
-    uint64_t tot;
-    std::string* merge_request_ptr;
-    send_thread_params(uint64_t ce, uint64_t tot_temp, std::string* ptr1):
-        current_epoch(ce), tot(tot_temp), merge_request_ptr(ptr1){}
-    send_thread_params(){}
-};
-
-bool Gzip(google::protobuf::MessageLite* ptr, std::string* serialized_str_ptr) {
-    //        google::protobuf::io::GzipOutputStream::Options options;
-    //        options.format = google::protobuf::io::GzipOutputStream::GZIP;
-    //        options.compression_level = 9;
-    //        google::protobuf::io::StringOutputStream outputStream(serialized_str_ptr);
-    //        google::protobuf::io::GzipOutputStream gzipStream(&outputStream, options);
-    //        auto res = ptr->SerializeToZeroCopyStream(&gzipStream);
-    //        gzipStream.Close();
-
-    google::protobuf::io::StringOutputStream outputStream(serialized_str_ptr);
-    auto res = ptr->SerializeToZeroCopyStream(&outputStream);
-    return res;
-}
-
-bool UnGzip(google::protobuf::MessageLite* ptr, const std::string* str) {
-    //    auto message_string_ptr = std::make_unique<std::string>(static_cast<const char*>(message_ptr->data()), message_ptr->size());
-    //        google::protobuf::io::ArrayInputStream inputStream(str->data(), (int)str->size());
-    //        google::protobuf::io::GzipInputStream gzipStream(&inputStream);
-    //        return ptr->ParseFromZeroCopyStream(&gzipStream);
-    google::protobuf::io::ArrayInputStream inputStream(str->data(), (int)str->size());
-    return ptr->ParseFromZeroCopyStream(&inputStream);
-}
 
 
 
@@ -2530,11 +3049,30 @@ bool UnGzip(google::protobuf::MessageLite* ptr, const std::string* str) {
 
 
 
+//Storage
+// the rows of one pushed/pulled epoch that hash to one apply lane, in csn order
+struct storage_apply_batch {
+    uint64_t epoch;
+    uint64_t max_csn = 0; // csn of the last txn in the batch
+    bool regrouped = false; // some txn of the epoch left its keys' home lanes, see HandlePackTxnx
+    uint64_t barrier_epoch = 0; // epochs up to this one are fully applied before the batch starts
+    std::shared_ptr<proto::Message> msg; // keeps the decoded message alive until every lane applied its rows
+    std::vector<std::pair<const proto::Transaction*, const proto::Row*>> rows;
+};
 
+// a client read request and the codecs its sender announced in the frame header
+struct storage_read_params {
+    uint32_t peer_codecs;
+    std::unique_ptr<proto::Message> msg;
+    storage_read_params(uint32_t codecs, std::unique_ptr<proto::Message> m): peer_codecs(codecs), msg(std::move(m)){}
+};
 
+const uint64_t kMaxApplyLaneNum = 256;
+BlockingConcurrentQueue<std::unique_ptr<storage_apply_batch>> storage_apply_queue[kMaxApplyLaneNum];
 
-//Storage
-BlockingConcurrentQueue<std::unique_ptr<proto::Transaction>> storage_update_queue;
+uint64_t StorageMaxApplyLaneNum() {
+    return kMaxApplyLaneNum;
+}
 
 
 //**************************************************************************************************************************************************************************************************
@@ -2554,16 +3092,243 @@ BlockingConcurrentQueue<std::unique_ptr<proto::Message>> client_other_message_qu
 // std::shared_ptr<zmq::socket_t> client_send_socket, client_listen_socket;
 
 std::atomic<bool> client_init_ok_flag(false), client_start_flag(false);
-ConcurrentHashMap<uint64_t, MOT::TxnManager*> txn_map;
-std::atomic<uint64_t> local_csn(5);
+PendingCommitTable<MOT::TxnManager*> txn_map;
 
-bool MOTAdaptor::InsertTxntoLocalChangeSet(MOT::TxnManager* txMan){
-    auto msg = std::make_unique<proto::Message>();
-    auto* txn = msg->mutable_txn();
-    proto::Row *row;
-    proto::Column* col;
-    proto::OpType op_type;
-    MOT::Row* local_row = nullptr;
+// Picks the txn node of every change set from per node in-flight counts and EWMA reply latency, so one slow txn
+// node does not hold up a share of all commits. Nodes whose verdicts time out are ejected for a while.
+class TxnNodeRouter {
+public:
+    uint64_t Pick() {
+        const uint64_t node_num = NodeNum();
+        if(node_num <= 1) {
+            return 0;
+        }
+        if(kTxnRoutePolicy == "round_robin") {
+            return rr_cnt.fetch_add(1) % node_num;
+        }
+        const uint64_t now = now_to_us();
+        uint64_t best = node_num, live = 0;
+        if(kTxnRoutePolicy == "least") {
+            for(uint64_t i = 0; i < node_num; i ++) {
+                if(Ejected(i, now)) {
+                    continue;
+                }
+                live++;
+                if(best == node_num || Cost(i) < Cost(best)) {
+                    best = i;
+                }
+            }
+        }
+        else { // power of two choices
+            for(uint64_t i = 0; i < node_num; i ++) {
+                live += Ejected(i, now) ? 0 : 1;
+            }
+            if(live > 0) {
+                uint64_t a = NthLive(Random() % live, now), b = NthLive(Random() % live, now);
+                best = (Cost(b) < Cost(a)) ? b : a;
+            }
+        }
+        if(live == 0) {
+            // everyone is ejected, fall back to the least loaded one
+            best = 0;
+            for(uint64_t i = 1; i < node_num; i ++) {
+                if(Cost(i) < Cost(best)) {
+                    best = i;
+                }
+            }
+        }
+        return best;
+    }
+
+    void OnSend(uint64_t node) {
+        nodes[node].inflight.fetch_add(1);
+    }
+
+    void OnReply(uint64_t node, uint64_t latency_us) {
+        auto& state = nodes[node];
+        state.inflight.fetch_sub(1);
+        // lost updates between concurrent repliers only blur the average
+        uint64_t ewma = state.ewma_latency_us.load(std::memory_order_relaxed);
+        state.ewma_latency_us.store(ewma - ewma / 8 + latency_us / 8, std::memory_order_relaxed);
+    }
+
+    void OnTimeout(uint64_t node) {
+        auto& state = nodes[node];
+        const uint64_t now = now_to_us();
+        if(state.ejected_until.exchange(now + kTxnNodeEject_us) < now) {
+            MOT_LOG_INFO("txn node %s 回复超时, 暂停路由 %llu us, inflight %lld ewma %llu us", kTxnNodeIp[node].c_str(),
+                kTxnNodeEject_us, state.inflight.load(), state.ewma_latency_us.load());
+        }
+    }
+
+private:
+    static const uint64_t kMaxTxnNodeNum = 64, kTxnNodeEject_us = 2000000, kInitLatency_us = 1000;
+
+    struct alignas(64) NodeState {
+        std::atomic<int64_t> inflight{0};
+        std::atomic<uint64_t> ewma_latency_us{kInitLatency_us};
+        std::atomic<uint64_t> ejected_until{0};
+    };
+
+    static uint64_t NodeNum() {
+        return std::min<uint64_t>(kTxnNodeIp.size(), kMaxTxnNodeNum);
+    }
+
+    bool Ejected(uint64_t node, uint64_t now) const {
+        return nodes[node].ejected_until.load(std::memory_order_relaxed) > now;
+    }
+
+    // expected wait behind the node's outstanding change sets
+    uint64_t Cost(uint64_t node) const {
+        int64_t inflight = nodes[node].inflight.load(std::memory_order_relaxed);
+        return (uint64_t)(std::max<int64_t>(inflight, 0) + 1) * nodes[node].ewma_latency_us.load(std::memory_order_relaxed);
+    }
+
+    uint64_t NthLive(uint64_t n, uint64_t now) const {
+        for(uint64_t i = 0; i < NodeNum(); i ++) {
+            if(!Ejected(i, now) && n-- == 0) {
+                return i;
+            }
+        }
+        return 0;
+    }
+
+    static uint64_t Random() {
+        static thread_local uint64_t seed = now_to_us() ^ (uint64_t)pthread_self();
+        seed ^= seed << 13;
+        seed ^= seed >> 7;
+        seed ^= seed << 17;
+        return seed;
+    }
+
+    NodeState nodes[kMaxTxnNodeNum];
+    std::atomic<uint64_t> rr_cnt{0};
+};
+TxnNodeRouter txn_router;
+std::atomic<uint64_t> local_csn(5);
+
+// a backend waiting in RemoteRead for its ClientReadResponse
+struct RemoteReadContext {
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool done = false;
+    std::unique_ptr<proto::Message> response; // set together with done by the reply handler
+};
+
+const uint64_t kRemoteReadTimeout_us = 1000000;
+PendingCommitTable<RemoteReadContext*> read_map;
+extern std::atomic<uint64_t> update_epoch;
+std::atomic<uint64_t> remote_read_id(1);
+BlockingConcurrentQueue<std::unique_ptr<send_thread_params>> client_read_send_queue;
+
+// rows always carry the catalog id and schema version of their table, the name is left out only with
+// enable_compact_row_encoding and while the catalog id is not shared with another table
+static void SetRowTable(proto::Row* row, MOT::Table* table) {
+    row->set_table_id(table->GetCatalogId());
+    row->set_table_version(table->GetSchemaVersion());
+    if (!MOT::GetGlobalConfiguration().m_enableCompactRowEncoding || !table->IsCatalogIdUnique()) {
+        row->set_table_name(table->GetLongTableName());
+    }
+}
+
+MOT::RC MOTAdaptor::RemoteRead(MOT::Table* table, const std::vector<MOT::Key*>& keys, std::vector<std::string>& rows)
+{
+    rows.clear();
+    if (keys.empty()) {
+        return MOT::RC_OK;
+    }
+    if (kStorageNodeIp.empty() || !client_start_flag.load()) {
+        MOT_LOG_ERROR("Remote read of table %s failed: no storage node", table->GetLongTableName().c_str());
+        return MOT::RC_ERROR;
+    }
+
+    auto msg = std::make_unique<proto::Message>();
+    auto* request = msg->mutable_client_read_request();
+    uint64_t read_id = remote_read_id.fetch_add(1);
+    request->set_client_ip(kLocalIp);
+    request->set_txn_id(read_id);
+    // epochs are numbered by TaaS, so unlike local csns the storage node can map them onto its row versions
+    request->set_snapshot_epoch(update_epoch.load());
+    for (auto key : keys) {
+        proto::Row* row = request->add_rows();
+        row->set_op_type(proto::OpType::Read);
+        SetRowTable(row, table);
+        row->set_key(key->GetKeyBuf(), key->GetKeyLength());
+    }
+    std::string raw;
+    if (!msg->SerializeToString(&raw)) {
+        return MOT::RC_ERROR;
+    }
+    // requests are small and go raw, the frame header tells the storage node which codecs we decode
+    auto* serialized_str_ptr = new std::string();
+    WireFrame(kWireCodecNone, 0, 0, raw.data(), raw.size(), serialized_str_ptr);
+
+    RemoteReadContext context;
+    read_map.insert(read_id, &context);
+    // tot picks the storage node, spreading requests round robin
+    client_read_send_queue.enqueue(std::make_unique<send_thread_params>(0, read_id % kStorageNodeIp.size(), serialized_str_ptr));
+
+    std::unique_lock<std::mutex> lock(context.mutex);
+    if (!context.cv.wait_for(lock, std::chrono::microseconds(kRemoteReadTimeout_us), [&]() { return context.done; })) {
+        lock.unlock();
+        if (read_map.take(read_id) == nullptr) {
+            // the reply is being delivered right now, it cannot touch context after we return
+            lock.lock();
+            context.cv.wait(lock, [&]() { return context.done; });
+        } else {
+            MOT_LOG_ERROR("Remote read %llu of table %s timed out", read_id, table->GetLongTableName().c_str());
+            return MOT::RC_ERROR;
+        }
+    }
+    if (context.response == nullptr) {
+        return MOT::RC_ERROR;
+    }
+
+    auto& response = context.response->client_read_response();
+    if (response.result() != proto::Result::Success) {
+        return MOT::RC_ABORT;
+    }
+    rows.resize(keys.size());
+    for (int i = 0; i < response.rows_size() && i < (int)keys.size(); i++) {
+        if (response.rows(i).op_type() == proto::OpType::Read) {
+            rows[i] = response.rows(i).data();
+        }
+    }
+    return MOT::RC_OK;
+}
+
+// an update only ships the null bitmap (column 0) and the non-null modified columns, like the redo log does
+static void AddUpdatedColumns(proto::Row* row, MOT::Row* local_row, const MOT::BitmapSet& modified_columns) {
+    MOT::Table* table = local_row->GetTable();
+    const uint8_t* row_data = local_row->GetData();
+    MOT::Column* column = table->GetField((uint64_t)0);
+    proto::Column* col = row->add_column();
+    col->set_id(0);
+    col->set_value(row_data + column->m_offset, column->m_size);
+    if (!modified_columns.IsInitialized()) {
+        return;
+    }
+    MOT::BitmapSet valid_bitmap(const_cast<uint8_t*>(row_data) + column->m_offset, table->GetFieldCount() - 1);
+    MOT::BitmapSet::BitmapSetIterator it(modified_columns);
+    it.Start();
+    while (!it.End()) {
+        if (it.IsSet() && valid_bitmap.GetBit(it.GetPosition())) {
+            column = table->GetField(it.GetPosition() + 1);
+            col = row->add_column();
+            col->set_id(it.GetPosition() + 1);
+            col->set_value(row_data + column->m_offset, column->m_size);
+        }
+        it.Next();
+    }
+}
+
+bool MOTAdaptor::InsertTxntoLocalChangeSet(MOT::TxnManager* txMan){
+    auto msg = std::make_unique<proto::Message>();
+    auto* txn = msg->mutable_txn();
+    proto::Row *row;
+    proto::Column* col;
+    proto::OpType op_type;
+    MOT::Row* local_row = nullptr;
     MOT::Key* key = nullptr;
     void* buf = nullptr;
     uint64_t fieldCnt;
@@ -2600,12 +3365,17 @@ bool MOTAdaptor::InsertTxntoLocalChangeSet(MOT::TxnManager* txMan){
             return false;
         }
         row->set_key(std::move(std::string(key->GetKeyBuf(), key->GetKeyBuf() + key->GetKeyLength())));
-        row->set_table_name(local_row->GetTable()->GetLongTableName());
-//        if(op_type == proto::OpType::Update || op_type == proto::OpType::Insert) {
-//            row->set_data(local_row->GetData(), local_row->GetTable()->GetTupleSize());
-//        }
-        row->set_data(local_row->GetData(), local_row->GetTable()->GetTupleSize());
+        SetRowTable(row, local_row->GetTable());
         row->set_op_type(op_type);
+        if (op_type == proto::OpType::Insert) {
+            row->set_data(local_row->GetData(), local_row->GetTable()->GetTupleSize());
+        } else {
+            // read/update/delete carry the csn of the version this txn observed
+            row->set_csn(access->m_tid);
+            if (op_type == proto::OpType::Update) {
+                AddUpdatedColumns(row, local_row, access->m_modifiedColumns);
+            }
+        }
     }
     txn->set_client_ip(kLocalIp);
     txMan->SetCommitSequenceNumber(local_csn.fetch_add(1));
@@ -2613,30 +3383,151 @@ bool MOTAdaptor::InsertTxntoLocalChangeSet(MOT::TxnManager* txMan){
     txn->set_csn(txMan->GetCommitSequenceNumber());
     txn->set_storage_type("mot");
 
-    MOT::TxnManager* txnMan_ptr = nullptr;
-    auto csn = txMan->GetCommitSequenceNumber();
-    txn_map.insert(csn, txMan, &txnMan_ptr);
-    if(txnMan_ptr != nullptr && txnMan_ptr->commit_state == MOT::RC::RC_WAIT) {
-        //抢占了别人的 hash map 出现冲突 abort 前一个，然后存储当前的
-        txnMan_ptr->commit_state = MOT::RC::RC_ABORT;
-        txnMan_ptr->cv.notify_all();
-    }
+    txMan->commit_node = txn_router.Pick();
+    txn_router.OnSend(txMan->commit_node);
+    // the entry stays registered until the reply arrives, however late
+    txn_map.insert(txMan->GetCommitSequenceNumber(), txMan);
 
     {
         string* serialized_txn_str_ptr = new string();
-//        Gzip(msg.get(), serialized_txn_str_ptr);
-
-        google::protobuf::io::StringOutputStream outputStream(serialized_txn_str_ptr);
-        auto res = msg->SerializeToZeroCopyStream(&outputStream);
+        Gzip(msg.get(), serialized_txn_str_ptr);
 
-        client_send_message_queue.enqueue(std::move(std::make_unique<send_thread_params>(0, 0, serialized_txn_str_ptr)));
+        // tot carries the txn node picked by txn_router
+        auto params = std::make_unique<send_thread_params>(0, txMan->commit_node, serialized_txn_str_ptr);
+        params->enqueue_time = now_to_us();
+        client_send_message_queue.enqueue(std::move(params));
         client_send_message_queue.enqueue(std::move(std::make_unique<send_thread_params>(0, 0, nullptr)));
     }
     return true;
 }
 
+void MOTAdaptor::ReportCommitTimeout(MOT::TxnManager* txMan) {
+    txn_router.OnTimeout(txMan->commit_node);
+}
+
+MOT::RC MOTAdaptor::AbandonCommit(MOT::TxnManager* txMan) {
+    if (txn_map.take(txMan->GetCommitSequenceNumber()) == nullptr) {
+        // the reply thread took the entry first and is completing the commit right now
+        return txMan->WaitCommit();
+    }
+    // a reply arriving later finds no entry and is dropped, so it cannot complete the next txn of this session
+    MOT_LOG_ERROR("No TaaS verdict for txn csn %" PRIu64 " from txn node %" PRIu64 " after %" PRIu64 " us, reporting "
+        "it aborted: its outcome on the txn nodes is unknown", txMan->GetCommitSequenceNumber(),
+        (uint64_t)txMan->commit_node, kTxnReplyTimeout_us + kTxnVerdictTimeout_us);
+    return MOT::RC_ABORT;
+}
+
+
 
 
+const uint64_t kClientBatchDequeueNum = 64, kClientBatchReportInterval_us = 10000000;
+
+// send one node's batch. If the link picks a codec the whole batch goes as one compressed frame, otherwise every
+// txn is one part of a multipart message and the txn node still receives one Message per frame
+static void ClientSendNodeBatch(zmq::socket_t& socket, WireLink& link, std::vector<std::unique_ptr<send_thread_params>>& batch,
+    uint64_t now, Log2Histogram& batch_latency_hist, Log2Histogram& batch_size_hist, Log2Histogram& batch_bytes_hist) {
+    uint64_t bytes = 0, frame_size, start;
+    for(auto& params : batch) {
+        bytes += params->merge_request_ptr->size();
+    }
+    WireCodec codec = link.Choose(bytes);
+    if(codec != kWireCodecNone) {
+        std::string raw;
+        {
+            google::protobuf::io::StringOutputStream output(&raw);
+            google::protobuf::io::CodedOutputStream coded(&output);
+            for(auto& params : batch) {
+                coded.WriteVarint32((uint32_t)params->merge_request_ptr->size());
+                coded.WriteString(*(params->merge_request_ptr));
+                delete params->merge_request_ptr;
+                params->merge_request_ptr = nullptr;
+            }
+        }
+        auto* frame_ptr = new std::string();
+        WireFrameForLink(link, codec, kWireFlagBatch, raw.data(), raw.size(), frame_ptr);
+        frame_size = frame_ptr->size();
+        zmq::message_t msg(static_cast<void*>(const_cast<char*>(frame_ptr->data())), frame_size, string_free, static_cast<void*>(frame_ptr));
+        start = now_to_us();
+        socket.send(msg);
+        link.OnSent(frame_size, now_to_us() - start);
+    }
+    else {
+        link.OnCompressed(kWireCodecNone, bytes, bytes, 0);
+        start = now_to_us();
+        for(size_t i = 0; i < batch.size(); i ++) {
+            auto* str_ptr = batch[i]->merge_request_ptr;
+            zmq::message_t msg(static_cast<void*>(const_cast<char*>(str_ptr->data())), str_ptr->size(), string_free, static_cast<void*>(str_ptr));
+            socket.send(msg, (i + 1 < batch.size()) ? ZMQ_SNDMORE : 0);
+        }
+        link.OnSent(bytes, now_to_us() - start);
+    }
+    // txns are appended in enqueue order, the first one waited longest
+    batch_latency_hist.Add(now - batch[0]->enqueue_time);
+    batch_size_hist.Add(batch.size());
+    batch_bytes_hist.Add(bytes);
+    batch.clear();
+}
+
+// collect txns for kClientBatchWindow_us (or kClientBatchMaxTxnNum txns) and send one batch per txn node
+static void ClientBatchSend(std::vector<std::shared_ptr<zmq::socket_t>>& client_send_sockets) {
+    const uint64_t node_num = client_send_sockets.size();
+    std::vector<std::vector<std::unique_ptr<send_thread_params>>> node_batches(node_num);
+    // txn nodes never announce codecs, txn_wire_codec tells what they decode. gzip already compresses every txn
+    std::vector<WireLink> links(node_num, WireLink(is_protobuf_gzip ? 0 : ParseWireCodecs(kTxnWireCodec)));
+    std::unique_ptr<send_thread_params> params[kClientBatchDequeueNum];
+    Log2Histogram batch_latency_hist, batch_size_hist, batch_bytes_hist;
+    uint64_t pending_num = 0, window_start = 0, last_report = now_to_us(), now;
+    int64_t timeout;
+
+    auto flush = [&]() {
+        for(uint64_t i = 0; i < node_num; i ++) {
+            if(!node_batches[i].empty()) {
+                ClientSendNodeBatch(*client_send_sockets[i], links[i], node_batches[i], now, batch_latency_hist, batch_size_hist, batch_bytes_hist);
+            }
+        }
+        pending_num = 0;
+    };
+
+    MOT_LOG_INFO("ClientSendThreadMain 批量发送 window %llu us, max txn num %llu", kClientBatchWindow_us, kClientBatchMaxTxnNum);
+    while(true) {
+        timeout = (int64_t)kClientBatchWindow_us;
+        if(pending_num > 0) {
+            timeout = (int64_t)(window_start + kClientBatchWindow_us) - (int64_t)now_to_us();
+            if(timeout < 0) {
+                timeout = 0;
+            }
+        }
+        auto num = client_send_message_queue.wait_dequeue_bulk_timed(params, kClientBatchDequeueNum, timeout);
+        now = now_to_us();
+        for(size_t i = 0; i < num; i ++) {
+            if(params[i] == nullptr || params[i]->merge_request_ptr == nullptr) {
+                continue;
+            }
+            if(pending_num == 0) {
+                window_start = now;
+            }
+            node_batches[params[i]->tot % node_num].emplace_back(std::move(params[i]));
+            if(++pending_num >= kClientBatchMaxTxnNum) {
+                flush();
+            }
+        }
+        if(pending_num > 0 && now - window_start >= kClientBatchWindow_us) {
+            flush();
+        }
+        if(now - last_report >= kClientBatchReportInterval_us) {
+            batch_latency_hist.Print("ClientSend batch latency(us)");
+            batch_size_hist.Print("ClientSend batch txn num");
+            batch_bytes_hist.Print("ClientSend batch bytes");
+            batch_latency_hist.Reset();
+            batch_size_hist.Reset();
+            batch_bytes_hist.Reset();
+            for(uint64_t i = 0; i < node_num; i ++) {
+                links[i].Print(("ClientSend link " + kTxnNodeIp[i]).c_str());
+            }
+            last_report = now;
+        }
+    }
+}
 
 void ClientSendThreadMain(uint64_t id) {
     SetCPU();
@@ -2651,15 +3542,17 @@ void ClientSendThreadMain(uint64_t id) {
 
     std::unique_ptr<send_thread_params> params;
     std::unique_ptr<zmq::message_t> msg;
-    auto cnt = 0;
     while(!client_init_ok_flag.load()) usleep(200);
+    if(kClientBatchWindow_us > 0) {
+        ClientBatchSend(client_send_sockets);
+        return;
+    }
     while(true) {
         client_send_message_queue.wait_dequeue(params);
         if(params != nullptr && params->merge_request_ptr != nullptr) {
             msg = std::make_unique<zmq::message_t>(static_cast<void*>(const_cast<char*>(params->merge_request_ptr->data())),
                     params->merge_request_ptr->size(), string_free, static_cast<void*>(params->merge_request_ptr));
-            client_send_sockets[cnt]->send(*(msg));
-            cnt = (cnt + 1) % kTxnNodeIp.size();
+            client_send_sockets[params->tot % client_send_sockets.size()]->send(*(msg));
             // MOT_LOG_INFO("ClientSendThreadMain 发送一个事务");
         }
     }
@@ -2690,63 +3583,84 @@ void ClientWorker1ThreadMain(uint64_t id) { // handle result return from Txn nod
     SetCPU();
     MOT_LOG_INFO("线程 ClientWorker1ThreadMain 开始工作 %llu", id);
     std::unique_ptr<zmq::message_t> message_ptr;
-    std::unique_ptr<std::string> message_string_ptr;
-    std::unique_ptr<proto::Message> msg_ptr;
+    auto msg_ptr = std::make_unique<proto::Message>(); // reused for every reply
     MOT::TxnManager* txnMan;
     uint64_t csn = 0;
+    std::string scratch; // decompressed payload
+    size_t raw_size;
+    WireFrameInfo frame_info;
+
+    auto handle_message = [&](const char* data, size_t size) {
+        if(!msg_ptr->ParseFromArray(data, (int)size)) {
+            return;
+        }
+
+        if(msg_ptr->type_case() == proto::Message::TypeCase::kReplyTxnResultToClient) {
+            //wake up local thread and return the commit result
+            auto& txn = msg_ptr->reply_txn_result_to_client();
+            csn = txn.client_txn_id();
+//             MOT_LOG_INFO("唤醒2 csn %llu %llu", csn, now_to_us());
+            txnMan = txn_map.take(csn);
+            if(txnMan != nullptr) {
+                txn_router.OnReply(txnMan->commit_node, now_to_us() - txnMan->commit_submit_time);
+                // MOT_LOG_INFO("唤醒3 csn %llu, txn txnid %llu, txn_state %llu %llu", csn, txnMan->GetCommitSequenceNumber(), txnMan->commit_state, now_to_us());
+                txnMan->CompleteCommit(txn.txn_state() == proto::TxnState::Commit ? MOT::RC::RC_OK : MOT::RC::RC_ABORT);
+            }
+            else {
+                // MOT_LOG_INFO("未找到 csn %llu", csn);
+            }
+        }
+        else if(msg_ptr->type_case() == proto::Message::TypeCase::kClientReadResponse) {
+            //wake up local thread and return the read result
+            auto* context = read_map.take(msg_ptr->client_read_response().txn_id());
+            if(context != nullptr) {
+                auto response = std::make_unique<proto::Message>();
+                response->Swap(msg_ptr.get());
+                std::unique_lock<std::mutex> lock(context->mutex);
+                context->response = std::move(response);
+                context->done = true;
+                context->cv.notify_all();
+            }
+        }
+        else {
+//            client_other_message_queue.enqueue(std::move(msg_ptr));
+//            client_other_message_queue.enqueue(std::move(std::make_unique<proto::Message>()));
+        }
+    };
 
     while(true) {
         client_listen_message_queue.wait_dequeue(message_ptr);
 //        MOT_LOG_INFO("Client 收到一个事务");
         if(message_ptr != nullptr && message_ptr->size() > 0) {
-//            message_string_ptr = std::make_unique<std::string>(static_cast<const char *>(message_ptr->data()),message_ptr->size());
-//            msg_ptr = std::make_unique<proto::Message>();
-//            UnGzip(msg_ptr.get(), message_string_ptr.get());
-
-            msg_ptr = std::make_unique<proto::Message>();
-            message_string_ptr = std::make_unique<std::string>(static_cast<const char*>(message_ptr->data()), message_ptr->size());
-            google::protobuf::io::ArrayInputStream inputStream(message_string_ptr->data(), message_string_ptr->size());
-            msg_ptr->ParseFromZeroCopyStream(&inputStream);
-
-            if(msg_ptr->type_case() == proto::Message::TypeCase::kReplyTxnResultToClient) {
-                //wake up local thread and return the commit result
-                auto& txn = msg_ptr->reply_txn_result_to_client();
-                csn = txn.client_txn_id();
-//                 MOT_LOG_INFO("唤醒2 csn %llu %llu", csn, now_to_us());
-                if(txn_map.get_value(csn, txnMan)) {
-                    if(txn.txn_state() == proto::TxnState::Commit) {
-                        txnMan->commit_state = MOT::RC::RC_OK;
-                    }
-                    else{
-                        txnMan->commit_state = MOT::RC::RC_ABORT;
-                    }
-                    txnMan->cv.notify_all();
-                    // MOT_LOG_INFO("唤醒3 csn %llu, txn txnid %llu, txn_state %llu %llu", csn, txnMan->GetCommitSequenceNumber(), txnMan->commit_state, now_to_us());
-                    txn_map.remove(csn);
-                }
-                else {
-                    // MOT_LOG_INFO("未找到 csn %llu", csn);
-                }
-            }
-            else if(msg_ptr->type_case() == proto::Message::TypeCase::kClientReadResponse) {
-                //wake up local thread and return the read result
-            }
-            else {
-//                client_other_message_queue.enqueue(std::move(msg_ptr));
-//                client_other_message_queue.enqueue(std::move(std::make_unique<proto::Message>()));
+            const char* raw = WireUnframe(message_ptr->data(), message_ptr->size(), scratch, raw_size, frame_info);
+            if(raw == nullptr || !ForEachWireMessage(raw, raw_size, frame_info.flags, handle_message)) {
+                MOT_LOG_INFO("ClientWorker1ThreadMain 解析消息失败 size %llu", message_ptr->size());
             }
         }
     }
 }
 
-void ClientManagerThreadMain(uint64_t id) { //handle other status
+void ClientManagerThreadMain(uint64_t id) { //handle other status, send remote read requests
     MOT_LOG_INFO("线程 ClientManagerThreadMain 开始工作 %llu", id);
+    std::vector<std::shared_ptr<zmq::socket_t>> storage_sockets;
+    auto storage_context = std::make_shared<zmq::context_t>(1);
+    for(int i = 0; i < kStorageNodeIp.size(); i ++) {
+        auto storage_socket = std::make_shared<zmq::socket_t>(*storage_context, ZMQ_PUSH);
+        storage_socket->connect("tcp://" + kStorageNodeIp[i] + ":5554");
+        storage_sockets.emplace_back(storage_socket);
+        MOT_LOG_INFO("ClientManagerThreadMain 连接 storage tcp://%s:5554", kStorageNodeIp[i].c_str());
+    }
     client_init_ok_flag.store(true);
     usleep(1000000);
     client_start_flag.store(true);
-    auto msg_ptr = std::make_unique<proto::Message>();
+    std::unique_ptr<send_thread_params> params;
     while(true) {
-        client_other_message_queue.wait_dequeue(msg_ptr);
+        client_read_send_queue.wait_dequeue(params);
+        if(params != nullptr && params->merge_request_ptr != nullptr) {
+            zmq::message_t msg(static_cast<void*>(const_cast<char*>(params->merge_request_ptr->data())),
+                params->merge_request_ptr->size(), string_free, static_cast<void*>(params->merge_request_ptr));
+            storage_sockets[params->tot % storage_sockets.size()]->send(msg);
+        }
     }
 }
 
@@ -2787,10 +3701,75 @@ void ClientManagerThreadMain(uint64_t id) { //handle other status
 BlockingConcurrentQueue<std::unique_ptr<zmq::message_t>> storage_listen_message_queue;
 BlockingConcurrentQueue<std::unique_ptr<send_thread_params>> storage_send_message_queue;
 BlockingConcurrentQueue<std::unique_ptr<proto::Message>> storage_other_message_queue;
-BlockingConcurrentQueue<std::unique_ptr<proto::Message>> storage_read_queue;
+BlockingConcurrentQueue<std::unique_ptr<storage_read_params>> storage_read_queue;
 
 std::atomic<bool> storage_init_ok_flag(false), storage_start_flag(false);
-std::atomic<uint64_t> update_epoch(0), current_epoch(5), total_commit_txn_num(0);
+std::atomic<uint64_t> update_epoch(0), current_epoch(5), total_commit_txn_num(0); // update_epoch: last fully applied epoch
+std::atomic<uint64_t> storage_apply_lane_cnt(0);
+
+// Epochs are handed to the apply lanes strictly in epoch order. Pushed epochs that arrive after a gap wait in
+// storage_dispatch_buffer while the missing ones are pulled, at most kStoragePullWindow requests in flight.
+const uint64_t kStoragePullWindow = 32, kStoragePullTimeout_us = 200000;
+std::mutex storage_dispatch_mutex;
+std::map<uint64_t, std::vector<std::unique_ptr<storage_apply_batch>>> storage_dispatch_buffer;
+std::map<uint64_t, uint64_t> storage_pull_inflight; // epoch -> time the pull request was sent
+uint64_t storage_dispatch_epoch = 0; // next epoch to dispatch, 0 until the first epoch arrives
+
+// lane batches of each dispatched epoch that are not applied yet and the epoch's max csn,
+// guarded by storage_applied_mutex. storage_applied_cv is signalled whenever an epoch is fully applied
+std::mutex storage_applied_mutex;
+std::condition_variable storage_applied_cv;
+std::map<uint64_t, std::pair<uint64_t, uint64_t>> storage_applying_epochs;
+// stable csn once each of the last kStorageSnapshotEpochs applied epochs was applied, guarded by
+// storage_applied_mutex. Remote reads name their snapshot by epoch, this maps it onto the csns of the row versions
+const uint64_t kStorageSnapshotEpochs = 1024, kStorageSnapshotWait_us = 100000;
+std::map<uint64_t, uint64_t> storage_applied_csns;
+uint64_t storage_last_regrouped_epoch = 0; // guarded by storage_dispatch_mutex
+// apply lanes parked on a row they cannot apply yet and their retries so far (see StorageStallApplyLane)
+const uint64_t kStorageStallBackoffMin_us = 1000, kStorageStallBackoffMax_us = 1000000, kStorageStallLogRetries = 60;
+std::atomic<uint64_t> storage_stalled_lanes(0), storage_stall_retries(0);
+
+// Decoded epochs are recycled instead of freed. Clearing only the response keeps its repeated txns/rows and
+// their string buffers allocated, and merging the next epoch into it reuses them, so once warmed up a pushed
+// epoch is decoded without per txn allocations.
+const uint64_t kStorageMessagePoolSize = 64;
+moodycamel::ConcurrentQueue<proto::Message*> storage_message_pool;
+std::atomic<uint64_t> storage_message_pool_num(0);
+
+void RecycleStorageMessage(proto::Message* msg) {
+    if(storage_message_pool_num.fetch_add(1) >= kStorageMessagePoolSize) {
+        storage_message_pool_num.fetch_sub(1);
+        delete msg;
+        return;
+    }
+    if(msg->type_case() == proto::Message::TypeCase::kStoragePushResponse) {
+        msg->mutable_storage_push_response()->Clear();
+    }
+    else if(msg->type_case() == proto::Message::TypeCase::kStoragePullResponse) {
+        msg->mutable_storage_pull_response()->Clear();
+    }
+    else {
+        msg->Clear();
+    }
+    storage_message_pool.enqueue(msg);
+}
+
+std::shared_ptr<proto::Message> AcquireStorageMessage() {
+    proto::Message* msg = nullptr;
+    if(storage_message_pool.try_dequeue(msg)) {
+        storage_message_pool_num.fetch_sub(1);
+    }
+    else {
+        msg = new proto::Message();
+    }
+    return std::shared_ptr<proto::Message>(msg, RecycleStorageMessage);
+}
+
+// parse straight from the received (or decompressed) buffer, merging into a recycled message keeps its sub-objects
+bool MergeFromBuffer(proto::Message* msg, const char* data, size_t size) {
+    google::protobuf::io::CodedInputStream input(reinterpret_cast<const uint8_t*>(data), (int)size);
+    return msg->MergeFromCodedStream(&input) && input.ConsumedEntireMessage();
+}
 
 uint64_t start_time_ll, start_physical_epoch = 1, cache_size = 10000;
 struct timeval start_time;
@@ -2804,33 +3783,261 @@ void SendPullRequest(uint64_t epoch_id) {
     request->mutable_recv_node()->CopyFrom(dest_node);
     request->set_epoch_id(epoch_id);
     auto serialized_txn_str_ptr = std::make_unique<std::string>();
-//    Gzip(msg.get(), serialized_txn_str_ptr.get());
-    google::protobuf::io::StringOutputStream outputStream(serialized_txn_str_ptr.get());
-    auto res = msg->SerializeToZeroCopyStream(&outputStream);
+    Gzip(msg.get(), serialized_txn_str_ptr.get());
     storage_send_message_queue.enqueue(std::move(std::make_unique<send_thread_params>(0, 0, serialized_txn_str_ptr.release())));
     storage_send_message_queue.enqueue(std::move(std::make_unique<send_thread_params>(0, 0, nullptr)));
 }
 
-bool HandlePackTxnx(proto::Message* msg) {
+inline uint64_t GetApplyLaneNum() {
+    if (kStorageUpdaterThreadNum == 0) {
+        return 1;
+    }
+    return kStorageUpdaterThreadNum < kMaxApplyLaneNum ? kStorageUpdaterThreadNum : kMaxApplyLaneNum;
+}
+
+// identifies the key of a row across tables. the table is hashed by catalog id, which rows sent by name or by id
+// agree on. equal hashes of different keys only make HandlePackTxnx group more txns than needed
+inline uint64_t GetRowKeyHash(const proto::Row& row) {
+    static std::hash<std::string> hash;
+    uint64_t table_id = row.table_id() != 0 ? row.table_id() :
+        MOT::Table::ComputeCatalogId(row.table_name().data(), row.table_name().length());
+    return hash(row.key()) ^ (table_id * 31);
+}
+
+// split the txns of a push/pull response into per lane batches, each lane receives its rows in csn order.
+// A txn is applied whole by one lane, so it is never seen half applied. Txns that share a key are grouped and the
+// group goes to one lane, which keeps the versions of every key of the epoch in csn order. A group goes to the home
+// lane of its first row's key. If a group holds keys of other home lanes, the epoch is marked regrouped and the
+// dispatcher orders it after the previous epochs, as another lane may still apply an older version of such a key.
+bool HandlePackTxnx(const std::shared_ptr<proto::Message>& msg, std::vector<std::unique_ptr<storage_apply_batch>>& lanes) {
+    const google::protobuf::RepeatedPtrField<proto::Transaction>* txns;
+    uint64_t epoch;
     if(msg->type_case() == proto::Message::TypeCase::kStoragePullResponse) {
         auto* response = &(msg->storage_pull_response());
         if(response->result() == proto::Result::Fail) {
-            //Send pull request to another server or wait a few seconds
-            return true;
-        }
-        for(int i = 0; i < (int) response->txns_size(); i ++) {
-            auto txn = std::make_unique<proto::Transaction>(std::move(std::move(response->txns(i))));
-            storage_update_queue.enqueue(std::move(txn));
+            //pulled again by RequestMissingEpochs once the request times out
+            return false;
         }
-        storage_update_queue.enqueue(std::move(std::make_unique<proto::Transaction>()));
+        txns = &(response->txns());
+        epoch = response->epoch_id();
     }
     else {
-        auto* response = &(msg->storage_push_response());
-        for(int i = 0; i < (int) response->txns_size(); i ++) {
-            auto txn = std::make_unique<proto::Transaction>(std::move(std::move(response->txns(i))));
-            storage_update_queue.enqueue(std::move(txn));
+        txns = &(msg->storage_push_response().txns());
+        epoch = msg->storage_push_response().epoch_id();
+    }
+    std::vector<const proto::Transaction*> sorted_txns;
+    sorted_txns.reserve(txns->size());
+    for(int i = 0; i < txns->size(); i ++) {
+        sorted_txns.push_back(&(txns->Get(i)));
+    }
+    std::stable_sort(sorted_txns.begin(), sorted_txns.end(),
+        [](const proto::Transaction* a, const proto::Transaction* b) { return a->csn() < b->csn(); });
+
+    const uint64_t lane_num = GetApplyLaneNum();
+    const uint32_t txn_num = (uint32_t)sorted_txns.size();
+    std::vector<uint32_t> group(txn_num);
+    auto find_group = [&group](uint32_t i) {
+        while(group[i] != i) {
+            group[i] = group[group[i]];
+            i = group[i];
+        }
+        return i;
+    };
+    std::vector<uint64_t> group_lane(txn_num, lane_num); // lane_num: not assigned yet
+    if(lane_num > 1) {
+        std::unordered_map<uint64_t, uint32_t> key_owner;
+        key_owner.reserve(txn_num * 2);
+        for(uint32_t t = 0; t < txn_num; t ++) {
+            group[t] = t;
+            for(int i = 0; i < sorted_txns[t]->row_size(); i ++) {
+                auto* row = &(sorted_txns[t]->row(i));
+                if(row->op_type() == proto::OpType::Read) {
+                    continue;
+                }
+                auto owner = key_owner.emplace(GetRowKeyHash(*row), t);
+                if(!owner.second) {
+                    // the root stays the oldest txn of the group
+                    uint32_t a = find_group(t), b = find_group(owner.first->second);
+                    group[std::max(a, b)] = std::min(a, b);
+                }
+            }
+        }
+    }
+    lanes.resize(lane_num);
+    bool regrouped = false;
+    uint64_t single_lane = 0;
+    for(uint32_t t = 0; t < txn_num; t ++) {
+        auto txn = sorted_txns[t];
+        uint64_t& lane_id = lane_num > 1 ? group_lane[find_group(t)] : single_lane;
+        for(int i = 0; i < txn->row_size(); i ++) {
+            auto* row = &(txn->row(i));
+            if(row->op_type() == proto::OpType::Read) {
+                continue;
+            }
+            if(lane_num > 1) {
+                const uint64_t home = GetRowKeyHash(*row) % lane_num;
+                if(lane_id == lane_num) {
+                    lane_id = home;
+                }
+                regrouped = regrouped || home != lane_id;
+            }
+            auto& lane = lanes[lane_id];
+            if(lane == nullptr) {
+                lane = std::make_unique<storage_apply_batch>();
+                lane->epoch = epoch;
+                lane->msg = msg;
+            }
+            lane->rows.emplace_back(txn, row);
+            lane->max_csn = txn->csn();
+        }
+    }
+    for(auto& lane : lanes) {
+        if(lane != nullptr) {
+            lane->regrouped = regrouped;
+        }
+    }
+    auto num = total_commit_txn_num.fetch_add(sorted_txns.size()) + sorted_txns.size();
+    MOT_LOG_DEBUG("共提交 txn num %llu", num);
+    return true;
+}
+
+// advance update_epoch over the epochs whose lane batches are all applied. csns grow with the epochs, so every
+// version up to the max csn of an applied epoch is installed and snapshot readers may start there
+static void AdvanceAppliedEpoch() {
+    auto it = storage_applying_epochs.begin();
+    while(it != storage_applying_epochs.end() && it->second.first == 0) {
+        MOT::SnapshotRegistry::GetInstance().SetStableCsn(it->second.second);
+        storage_applied_csns[it->first] = MOT::SnapshotRegistry::GetInstance().GetStableCsn();
+        if(storage_applied_csns.size() > kStorageSnapshotEpochs) {
+            storage_applied_csns.erase(storage_applied_csns.begin());
+        }
+        update_epoch.store(it->first);
+        MOTAdaptor::m_engine->GetCheckpointManager()->SetAppliedEpoch(it->first);
+        it = storage_applying_epochs.erase(it);
+        storage_applied_cv.notify_all();
+    }
+}
+
+// block until every dispatched epoch up to barrier_epoch is applied
+static void WaitStorageEpochsApplied(uint64_t barrier_epoch) {
+    std::unique_lock<std::mutex> lock(storage_applied_mutex);
+    storage_applied_cv.wait(lock, [barrier_epoch]() {
+        return storage_applying_epochs.empty() || storage_applying_epochs.begin()->first > barrier_epoch;
+    });
+}
+
+// the csn of the row versions a reader at snapshot_epoch sees, waiting briefly for an epoch this node has not applied
+// yet. Fails for epochs still not applied and for those older than the retained ones
+static bool GetStorageSnapshotCsn(uint64_t snapshot_epoch, uint64_t& csn) {
+    std::unique_lock<std::mutex> lock(storage_applied_mutex);
+    if(!storage_applied_cv.wait_for(lock, std::chrono::microseconds(kStorageSnapshotWait_us),
+        [snapshot_epoch]() { return update_epoch.load() >= snapshot_epoch; })) {
+        return false;
+    }
+    auto it = storage_applied_csns.upper_bound(snapshot_epoch);
+    if(it == storage_applied_csns.begin()) {
+        return false;
+    }
+    csn = (--it)->second;
+    return true;
+}
+
+void StorageEpochBatchApplied(uint64_t epoch) {
+    std::unique_lock<std::mutex> lock(storage_applied_mutex);
+    auto it = storage_applying_epochs.find(epoch);
+    if(it != storage_applying_epochs.end() && it->second.first > 0) {
+        it->second.first--;
+    }
+    AdvanceAppliedEpoch();
+}
+
+// pull the missing epochs below the newest buffered one, oldest first, keeping the request window full.
+// caller holds storage_dispatch_mutex
+static void RequestMissingEpochs(uint64_t now) {
+    if(storage_dispatch_buffer.empty()) {
+        return;
+    }
+    const uint64_t newest = storage_dispatch_buffer.rbegin()->first;
+    uint64_t inflight = 0;
+    for(auto& it : storage_pull_inflight) {
+        if(now - it.second < kStoragePullTimeout_us) {
+            inflight++;
+        }
+    }
+    for(uint64_t epoch = storage_dispatch_epoch; epoch < newest && inflight < kStoragePullWindow; epoch ++) {
+        if(storage_dispatch_buffer.count(epoch) > 0) {
+            continue;
         }
-        storage_update_queue.enqueue(std::move(std::make_unique<proto::Transaction>()));
+        auto it = storage_pull_inflight.find(epoch);
+        if(it != storage_pull_inflight.end() && now - it->second < kStoragePullTimeout_us) {
+            continue;
+        }
+        if(it != storage_pull_inflight.end()) {
+            MOT_LOG_INFO("Storage 重新拉取 epoch %llu", epoch);
+        }
+        SendPullRequest(epoch);
+        storage_pull_inflight[epoch] = now;
+        inflight++;
+    }
+}
+
+// hand the lane batches of an epoch to the updaters once every earlier epoch is handed over
+void DispatchStorageEpoch(uint64_t epoch, std::vector<std::unique_ptr<storage_apply_batch>>&& lanes) {
+    std::unique_lock<std::mutex> lock(storage_dispatch_mutex);
+    if(storage_dispatch_epoch == 0) {
+        storage_dispatch_epoch = epoch;
+        MOT_LOG_INFO("Storage 从 epoch %llu 开始应用", epoch);
+    }
+    storage_pull_inflight.erase(epoch);
+    if(epoch < storage_dispatch_epoch || storage_dispatch_buffer.count(epoch) > 0) {
+        return; // pushed and pulled both, or pulled twice
+    }
+    storage_dispatch_buffer[epoch] = std::move(lanes);
+    auto it = storage_dispatch_buffer.begin();
+    while(it != storage_dispatch_buffer.end() && it->first == storage_dispatch_epoch) {
+        uint64_t batch_num = 0, max_csn = 0;
+        bool regrouped = false;
+        for(auto& lane : it->second) {
+            if(lane != nullptr) {
+                batch_num++;
+                max_csn = std::max(max_csn, lane->max_csn);
+                regrouped = regrouped || lane->regrouped;
+            }
+        }
+        // a regrouped epoch waits for all older epochs, and every later epoch waits for it
+        const uint64_t barrier_epoch = regrouped ? it->first - 1 : storage_last_regrouped_epoch;
+        if(regrouped) {
+            storage_last_regrouped_epoch = it->first;
+        }
+        for(auto& lane : it->second) {
+            if(lane != nullptr) {
+                lane->barrier_epoch = barrier_epoch;
+            }
+        }
+        {
+            std::unique_lock<std::mutex> applied_lock(storage_applied_mutex);
+            storage_applying_epochs[it->first] = std::make_pair(batch_num, max_csn);
+            AdvanceAppliedEpoch();
+        }
+        for(uint64_t i = 0; i < it->second.size(); i ++) {
+            if(it->second[i] != nullptr) {
+                storage_apply_queue[i].enqueue(std::move(it->second[i]));
+            }
+        }
+        it = storage_dispatch_buffer.erase(it);
+        storage_dispatch_epoch++;
+    }
+    if(!storage_dispatch_buffer.empty()) {
+        RequestMissingEpochs(now_to_us());
+    }
+}
+
+// the txn node could not serve the epoch yet, it is pulled again once the request times out
+void StoragePullFailed(uint64_t epoch) {
+    std::unique_lock<std::mutex> lock(storage_dispatch_mutex);
+    auto it = storage_pull_inflight.find(epoch);
+    if(it != storage_pull_inflight.end()) {
+        it->second = now_to_us();
     }
 }
 
@@ -2841,248 +4048,457 @@ void StorageMessageManagerThreadMain(uint64_t id) { // handle result return from
                                            CreateSessionContext(IS_PGXC_COORDINATOR, 0, nullptr, INVALID_CONNECTION_ID);
     MOT::TxnManager* txn_manager = session_context->GetTxnManager();
     std::unique_ptr<zmq::message_t> message_ptr;
-    std::unique_ptr<proto::Message> msg_ptr;
-    std::unique_ptr<std::string> message_string_ptr;
+    std::shared_ptr<proto::Message> msg_ptr;
+    std::vector<std::unique_ptr<storage_apply_batch>> lanes;
+    uint64_t epoch;
+    std::string scratch; // decompressed payload
+    size_t raw_size;
+    WireFrameInfo frame_info;
+
+    auto handle_message = [&](const char* data, size_t size) {
+        lanes.clear();
+        msg_ptr = AcquireStorageMessage();
+        if(!MergeFromBuffer(msg_ptr.get(), data, size)) {
+            MOT_LOG_INFO("StorageMessageManagerThreadMain 解析消息失败 size %llu", size);
+        }
+        else if(msg_ptr->type_case() == proto::Message::TypeCase::kStoragePullResponse || msg_ptr->type_case() == proto::Message::TypeCase::kStoragePushResponse) {
+            epoch = (msg_ptr->type_case() == proto::Message::TypeCase::kStoragePullResponse) ?
+                msg_ptr->storage_pull_response().epoch_id() : msg_ptr->storage_push_response().epoch_id();
+            if(HandlePackTxnx(msg_ptr, lanes)) {
+                msg_ptr.reset();
+                DispatchStorageEpoch(epoch, std::move(lanes));
+            }
+            else {
+                StoragePullFailed(epoch);
+            }
+        }
+        else if(msg_ptr->type_case() == proto::Message::TypeCase::kClientReadRequest) {
+            auto read_msg = std::make_unique<proto::Message>();
+            read_msg->Swap(msg_ptr.get());
+            storage_read_queue.enqueue(std::make_unique<storage_read_params>(frame_info.peer_codecs, std::move(read_msg)));
+            storage_read_queue.enqueue(nullptr);
+        }
+        else {
+            auto other_msg = std::make_unique<proto::Message>();
+            other_msg->Swap(msg_ptr.get());
+            storage_other_message_queue.enqueue(std::move(other_msg));
+            storage_other_message_queue.enqueue(std::move(std::make_unique<proto::Message>()));
+        }
+        msg_ptr.reset();
+    };
+
     while(true) {
         storage_listen_message_queue.wait_dequeue(message_ptr);
         if(message_ptr != nullptr && message_ptr->size() > 0) {
-//            message_string_ptr = std::make_unique<std::string>(static_cast<const char*>(message_ptr->data()), message_ptr->size());
-//            msg_ptr = std::make_unique<proto::Message>();
-//            UnGzip(msg_ptr.get(), message_string_ptr.get());
-
-            msg_ptr = std::make_unique<proto::Message>();
-            assert(msg_ptr != nullptr);
-//            message_string_ptr = std::make_unique<std::string>(static_cast<const char*>(message_ptr->data()), message_ptr->size());
-            google::protobuf::io::ArrayInputStream inputStream(message_ptr->data(), message_ptr->size());
-//            google::protobuf::io::ArrayInputStream inputStream(message_string_ptr->data(), message_string_ptr->size());
-            msg_ptr->ParseFromZeroCopyStream(&inputStream);
-
-            if(msg_ptr->type_case() == proto::Message::TypeCase::kStoragePullResponse || msg_ptr->type_case() == proto::Message::TypeCase::kStoragePushResponse) {
-                if(msg_ptr->type_case() == proto::Message::TypeCase::kStoragePullResponse) {
-                    auto* response = &(msg_ptr->storage_pull_response());
-                    if(response->result() == proto::Result::Fail) {
-                        //Send pull request to another server or wait a few seconds
-                        continue;
-                    }
-                    for(int i = 0; i < (int) response->txns_size(); i ++) {
-                        auto txn = std::make_unique<proto::Transaction>(response->txns(i));
-                        storage_update_queue.enqueue(std::move(txn));
-                    }
-                    storage_update_queue.enqueue(std::move(std::make_unique<proto::Transaction>()));
-                }
-                else {
-                    auto* response = &(msg_ptr->storage_push_response());
-                    for(int i = 0; i < (int) response->txns_size(); i ++) {
-                        auto txn = std::make_unique<proto::Transaction>(response->txns(i));
-                        storage_update_queue.enqueue(std::move(txn));
-                    }
-                    storage_update_queue.enqueue(std::move(std::make_unique<proto::Transaction>()));
-                }
+            const char* raw = WireUnframe(message_ptr->data(), message_ptr->size(), scratch, raw_size, frame_info);
+            if(raw == nullptr || !ForEachWireMessage(raw, raw_size, frame_info.flags, handle_message)) {
+                MOT_LOG_INFO("StorageMessageManagerThreadMain 解帧失败 size %llu", message_ptr->size());
             }
-            else {
-                storage_other_message_queue.enqueue(std::move(msg_ptr));
-                storage_other_message_queue.enqueue(std::move(std::make_unique<proto::Message>()));
+            message_ptr.reset();
+        }
+    }
+}
+
+// install the update/delete as a new version in front of the current one instead of overwriting it, so snapshot
+// readers keep their version. versions no snapshot can see any more are retired to the lane's gc session
+static void ApplyStorageRowVersion(MOT::TxnManager* txn_manager, MOT::Table* table, const proto::Transaction* txn,
+    const proto::Row* row_it, MOT::Row* row) {
+    MOT::Row* version = table->CreateNewRow();
+    if (version == nullptr) {
+        MOT_REPORT_ERROR(MOT_ERROR_OOM,
+            "Taas Storage Updater",
+            "Failed to allocate a row version for table %s",
+            table->GetLongTableName().c_str());
+        return;
+    }
+    version->DeepCopy(row);
+    version->SetPrimarySentinel(row->GetPrimarySentinel());
+    version->SetOlderVersion(row);
+    version->LockRow();
+    if (row_it->op_type() == proto::OpType::Delete) {
+        version->SetCSN_Delete(txn->csn());
+    } else {
+        if (row_it->column_size() > 0) {
+            for (auto col_it = row_it->column().begin(); col_it != row_it->column().end(); ++col_it) {
+                version->SetValueVariable(col_it->id(), col_it->value().c_str(), col_it->value().length());
+            }
+        } else {
+            version->CopyData((uint8_t*)row_it->data().c_str(), table->GetTupleSize());
+        }
+        version->SetCSN_Update(txn->csn());
+    }
+    version->ReleaseRow();
+
+    // SetNextPtr rewrites the whole status word, the sentinel lock keeps concurrent lockers from losing their bit
+    MOT::Sentinel* sentinel = row->GetPrimarySentinel();
+    sentinel->Lock(0);
+    sentinel->SetNextPtr(version);
+    if (row_it->op_type() == proto::OpType::Delete) {
+        sentinel->SetDirty();
+    }
+    sentinel->Release();
+    MOTAdaptor::m_engine->GetCheckpointManager()->ApplyStorageWrite(
+        version, row_it->op_type() == proto::OpType::Delete);
+    version->RetireOlderVersions(MOT::SnapshotRegistry::GetInstance().GetOldestSnapshot(), txn_manager->GetGcSession());
+}
+
+// primary key lookups of the rows of a request, resolved READ_BATCH_SIZE keys at a time so the index
+// descents of the window overlap instead of stalling one after another
+struct storage_lookup_window {
+    // tables resolved without the table manager lock, flushed on ddl
+    MOT::TableCatalogCache table_cache{MOTAdaptor::m_engine->GetTableManager()};
+    MOT::MaxKey keys[MOT::Index::READ_BATCH_SIZE];
+    const MOT::Key* key_ptrs[MOT::Index::READ_BATCH_SIZE];
+    MOT::Table* tables[MOT::Index::READ_BATCH_SIZE];
+    MOT::Sentinel* sentinels[MOT::Index::READ_BATCH_SIZE];
+
+    // row(i) gives the i-th row of the window, consecutive rows of one table share a batched lookup
+    template <typename RowAt>
+    void Lookup(size_t count, RowAt row) {
+        MOT::Table* run_tables[MOT::Index::READ_BATCH_SIZE];
+        MOT::Table* table = nullptr;
+        for (size_t i = 0; i < count; i++) {
+            const proto::Row& row_it = row(i);
+            if (!SameTable(table, row_it)) {
+                table = ResolveTable(row_it);
+            }
+            tables[i] = table;
+            run_tables[i] = table;
+            sentinels[i] = nullptr;
+            if (row_it.key().length() > MAX_KEY_SIZE) {
+                run_tables[i] = nullptr; // left to the caller's scalar lookup
+                continue;
+            }
+            keys[i].InitKey((uint16_t)row_it.key().length());
+            keys[i].CpKey((const uint8_t*)row_it.key().data(), (uint16_t)row_it.key().length());
+            key_ptrs[i] = &keys[i];
+        }
+        for (size_t start = 0, end = 0; start < count; start = end) {
+            for (end = start + 1; end < count && run_tables[end] == run_tables[start]; end++) {
+            }
+            if (run_tables[start] != nullptr) {
+                (void)run_tables[start]->GetPrimaryIndex()->IndexReadBatch(
+                    &key_ptrs[start], (uint32_t)(end - start), &sentinels[start], 0);
+            }
+        }
+    }
+
+    static bool SameTable(MOT::Table* table, const proto::Row& row_it) {
+        if (table == nullptr) {
+            return false;
+        }
+        if (row_it.table_id() != 0 && row_it.table_name().empty()) {
+            return table->GetCatalogId() == row_it.table_id();
+        }
+        return table->GetLongTableName() == row_it.table_name();
+    }
+
+    // the name decides when the row carries it, the catalog id only resolves rows sent without a name. a row
+    // whose table is unknown, shares its catalog id with another local table, or was encoded with another schema
+    // version cannot be applied: null is returned and the caller fails the row
+    MOT::Table* ResolveTable(const proto::Row& row_it) {
+        MOT::Table* table = row_it.table_name().empty() ? table_cache.GetTable(row_it.table_id()) :
+            table_cache.GetTable(row_it.table_name());
+        if (table == nullptr) {
+            MOT_LOG_ERROR("Table %s (catalog id %" PRIu64 ") of a storage row is unknown or its catalog id is shared "
+                "by several tables", row_it.table_name().c_str(), (uint64_t)row_it.table_id());
+            return nullptr;
+        }
+        if (row_it.table_version() != 0 && row_it.table_version() != table->GetSchemaVersion()) {
+            MOT_LOG_ERROR("Table %s schema version %u does not match row schema version %u",
+                table->GetLongTableName().c_str(), table->GetSchemaVersion(), row_it.table_version());
+            return nullptr;
+        }
+        return table;
+    }
+};
+
+// the payload of an insert or update comes from a peer and is copied into the row as is, so it must fit the local
+// table: every column id must exist and its value must fit the column, full row images must hold a whole tuple
+static bool ValidStorageRowData(MOT::Table* table, const proto::Row* row_it) {
+    if (row_it->op_type() == proto::OpType::Delete) {
+        return true;
+    }
+    if (row_it->op_type() == proto::OpType::Update && row_it->column_size() > 0) {
+        for (auto col_it = row_it->column().begin(); col_it != row_it->column().end(); ++col_it) {
+            if (col_it->id() >= table->GetFieldCount()) {
+                MOT_LOG_ERROR("Column %u of a storage row is out of range for table %s with %" PRIu64 " columns",
+                    col_it->id(), table->GetLongTableName().c_str(), table->GetFieldCount());
+                return false;
+            }
+            if (col_it->value().length() > table->GetFieldSize(col_it->id())) {
+                MOT_LOG_ERROR("Value of %zu bytes of a storage row does not fit column %u of table %s (%" PRIu64
+                    " bytes)", col_it->value().length(), col_it->id(), table->GetLongTableName().c_str(),
+                    table->GetFieldSize(col_it->id()));
+                return false;
+            }
+        }
+        return true;
+    }
+    if (row_it->data().length() < table->GetTupleSize()) {
+        MOT_LOG_ERROR("Row image of %zu bytes of a storage row is shorter than the tuple size %u of table %s",
+            row_it->data().length(), table->GetTupleSize(), table->GetLongTableName().c_str());
+        return false;
+    }
+    return true;
+}
+
+// apply one row version, the lane owns the key so the row lock only fences local readers.
+// sentinel is the key's primary sentinel looked up ahead, or null to look the key up here (the lookup window
+// ran before the earlier rows of the window were applied, so a key inserted by them is not in it).
+// returns false if the row cannot be applied because its table did not resolve (see ResolveTable) or its payload
+// does not fit the table (see ValidStorageRowData)
+static bool ApplyStorageRow(MOT::TxnManager* txn_manager, const proto::Transaction* txn, const proto::Row* row_it,
+    MOT::Table* table, MOT::Sentinel* sentinel, bool& inserted) {
+    if (table == nullptr || !ValidStorageRowData(table, row_it)) {
+        return false;
+    }
+    MOT::Row* row = nullptr;
+    MOT::RC res;
+    if (sentinel != nullptr) {
+        row = sentinel->GetData();
+        if (row != nullptr && row->IsAbsentRow()) {
+            row = nullptr;
+        }
+    } else {
+        size_t key_length = row_it->key().length();
+        void* buf = MOT::MemSessionAlloc(key_length);
+        if (buf == nullptr)
+            Assert(false);
+        MOT::Key* key = new (buf) MOT::Key(key_length);
+        key->CpKey((uint8_t*)row_it->key().c_str(), key_length);
+        res = table->FindRow(key, row, 0);
+        MOT::MemSessionFree(buf);
+        if (res != MOT::RC_OK) {  // an error
+            // look up fail!~
+            row = nullptr;
+        }
+    }
+
+    if (row == nullptr || row_it->op_type() == proto::OpType::Insert) {  // insert or delete by others before this epoch
+        if (row_it->op_type() == proto::OpType::Insert) {
+            row = table->CreateNewRow();
+            row->CopyData((uint8_t*)row_it->data().c_str(), table->GetTupleSize());
+            res = table->InsertRow(row, txn_manager);
+            if (res == MOT::RC_OK) {
+                inserted = true;
+            } else if (res == MOT::RC_UNIQUE_VIOLATION) {
+                // the key is already installed, e.g. by an epoch that was both pushed and pulled
+                MOT_LOG_DEBUG("Taas Insert Row skipped an existing key txn %llu table %s",
+                    txn->client_txn_id(), table->GetLongTableName().c_str());
+            } else {
+                MOT_REPORT_ERROR(MOT_ERROR_OOM,
+                    "Taas Insert Row ",
+                    "Failed to insert new row for table %s",
+                    table->GetLongTableName().c_str());
             }
+        } else {
+            MOT_LOG_INFO("Storage Error Update/Delete a NULL row txn %llu op_type %llu",
+                txn->client_txn_id(),
+                row_it->op_type());
+        }
+        return true;
+    }
+
+    if (MOT::GetGlobalConfiguration().m_enableRowVersions) {
+        ApplyStorageRowVersion(txn_manager, table, txn, row_it, row);
+        return true;
+    }
+
+    row->LockRow();
+    if (row_it->op_type() == proto::OpType::Delete) {
+        row->GetPrimarySentinel()->SetDirty();
+        row->SetCSN_Delete(txn->csn());
+    } else if (row_it->op_type() == proto::OpType::Update) {
+        if (row_it->column_size() > 0) {
+            for (auto col_it = row_it->column().begin(); col_it != row_it->column().end(); ++col_it) {
+                row->SetValueVariable(col_it->id(), col_it->value().c_str(), col_it->value().length());
+            }
+        } else {
+            row->CopyData((uint8_t*)row_it->data().c_str(), table->GetTupleSize());
         }
+        row->SetCSN_Update(txn->csn());
     }
+    row->ReleaseRow();
+    // the update bypasses the commit protocol, so the delta checkpoint is told directly
+    MOTAdaptor::m_engine->GetCheckpointManager()->ApplyStorageWrite(
+        row, row_it->op_type() == proto::OpType::Delete);
+    return true;
+}
+
+uint64_t StorageStalledLaneNum() {
+    return storage_stalled_lanes.load();
+}
+
+// park the lane on a row that cannot be applied, retrying with an exponential backoff. the row's epoch is not
+// marked applied meanwhile, so later epochs wait for it and a restart resumes from the last applied epoch. the
+// table cache revalidates on each catalog change, so the row is applied as soon as ddl catches up on this node.
+// the row wrote nothing when it failed, so retrying it is safe
+static void StorageStallApplyLane(uint64_t lane, uint64_t epoch, const proto::Transaction* txn,
+    const proto::Row* row_it, MOT::TxnManager* txn_manager, storage_lookup_window* window, bool& inserted) {
+    uint64_t backoff_us = kStorageStallBackoffMin_us;
+    uint64_t retries = 0;
+    storage_stalled_lanes.fetch_add(1);
+    MOT_LOG_ERROR("Taas Storage Updater lane %llu stalled at epoch %llu: a row of txn %llu of table %s cannot be "
+        "applied, retrying until the catalog catches up", lane, epoch, txn->client_txn_id(),
+        row_it->table_name().c_str());
+    do {
+        // a parked lane must not hold back the gc epoch
+        txn_manager->GcSessionEnd();
+        usleep(backoff_us);
+        txn_manager->GcSessionStart();
+        storage_stall_retries.fetch_add(1);
+        if (++retries % kStorageStallLogRetries == 0) {
+            MOT_LOG_WARN("Taas Storage Updater lane %llu still stalled at epoch %llu after %llu retries", lane, epoch,
+                retries);
+        }
+        backoff_us = std::min(backoff_us * 2, kStorageStallBackoffMax_us);
+    } while (!ApplyStorageRow(txn_manager, txn, row_it, window->ResolveTable(*row_it), nullptr, inserted));
+    storage_stalled_lanes.fetch_sub(1);
+    MOT_LOG_INFO("Taas Storage Updater lane %llu resumed at epoch %llu after %llu retries", lane, epoch, retries);
 }
 
 void StorageUpdaterThreadMain(uint64_t id) {
-    MOT_LOG_INFO("线程 StorageUpdaterThreadMain 开始工作 %llu", id);
+    // the postmaster starts one updater per lane
+    const uint64_t lane = storage_apply_lane_cnt.fetch_add(1);
+    MOT_LOG_INFO("线程 StorageUpdaterThreadMain 开始工作 %llu lane %llu", id, lane);
+    MOT_ASSERT(lane < GetApplyLaneNum());
     MOT::SessionContext* session_context = MOT::GetSessionManager()->
         CreateSessionContext(IS_PGXC_COORDINATOR, 0, nullptr, INVALID_CONNECTION_ID);
     MOT::TxnManager* txn_manager = session_context->GetTxnManager();
-    std::map<MOT::Row*, bool> lock_map, should_lock_map;
-    std::vector<MOT::Table*> vec_table;
-    std::vector<MOT::Row*> vec_row;
-    size_t key_length, key_id;
-    std::string key_str;
-    MOT::Table* table;
-    MOT::Row* row;
-    MOT::Key* key;
-    std::shared_ptr<MOT::Key> key_ptr;
-    void* buf;
-    MOT::RC res;
-    bool commit_res = false;
-    uint64_t commit_txn_num = 0;
+    const proto::Transaction* txn = nullptr;
+    bool inserted = false;
+
+    // inserts go through txn_manager and are published by TaasLogCommit with the txn's csn
+    auto commit_inserts = [&]() {
+        if (inserted) {
+            txn_manager->SetCommitSequenceNumber(txn->csn());
+            if (txn_manager->TaasLogCommit() != MOT::RC::RC_OK) {
+                MOT_LOG_INFO("TaasLogCommit Failed txn %llu", txn->client_txn_id());
+            }  // write change时会写入csn
+        }
+        inserted = false;
+    };
 
-    auto txn_ptr = std::make_unique<proto::Transaction>();
+    std::unique_ptr<storage_apply_batch> batch;
+    std::unique_ptr<storage_lookup_window> window = std::make_unique<storage_lookup_window>();
     while(true) {
-        txn_ptr.reset(nullptr);
-//        while(!storage_update_queue.try_dequeue(txn_ptr)) usleep(100);
-        storage_update_queue.wait_dequeue(txn_ptr);
-
-        // handle txn read request
-        if (txn_ptr->row_size() > 0) {
-            //             MOT_LOG_INFO("Storage 收到一个事务");
-            txn_manager->CleanTxn();
-            vec_row.clear();
-            vec_table.clear();
-            lock_map.clear();
-            should_lock_map.clear();
-            commit_res = true;
-            key_id = 0;
-
-            for (int i = 0; i < txn_ptr->row_size(); i++) {
-                auto *row_it = &(txn_ptr->row(i));
-                MOT::Table* table = MOTAdaptor::m_engine->GetTableManager()->GetTable(row_it->table_name());
-                if (table != nullptr) {
-                    key_length = row_it->key().length();
-                    buf = MOT::MemSessionAlloc(key_length);
-                    if (buf == nullptr)
-                        Assert(false);
-                    key = new (buf) MOT::Key(key_length);
-                    key->CpKey((uint8_t*)row_it->key().c_str(), key_length);
-                    key_str = key->GetKeyStr();
-                    res = table->FindRow(key, row, 0);
-                    MOT::MemSessionFree(buf);
-                    if (res != MOT::RC_OK) {  // an error
-                        // look up fail!~
-                        row = nullptr;
-                    }
-                    if (row != nullptr && (row_it->op_type() == proto::OpType::Update ||
-                                              row_it->op_type() == proto::OpType::Delete)) {
-                        should_lock_map[row] = true;
-                    }
-                }
-                else {
-                    table = nullptr, row = nullptr;
-                    MOT_LOG_INFO("Taas Storage Updater 3010 table is null %s", row_it->table_name().c_str());
-                }
-                vec_row.push_back(row);
-                vec_table.push_back(table);
+        storage_apply_queue[lane].wait_dequeue(batch);
+        if (batch == nullptr) {
+            continue;
+        }
+        if (batch->barrier_epoch != 0) {
+            WaitStorageEpochsApplied(batch->barrier_epoch);
+        }
+        txn = nullptr;
+        const size_t row_num = batch->rows.size();
+        // rows [window_start, window_start + READ_BATCH_SIZE) were looked up together
+        size_t window_start = 0;
+        bool relookup = true;
+        for (size_t i = 0; i < row_num; i++) {
+            if (relookup || i - window_start == MOT::Index::READ_BATCH_SIZE) {
+                window_start = i;
+                relookup = false;
+                window->Lookup(std::min((size_t)MOT::Index::READ_BATCH_SIZE, row_num - i),
+                    [&](size_t j) -> const proto::Row& { return *batch->rows[i + j].second; });
             }
-
-            for (auto row_it = should_lock_map.begin(); row_it != should_lock_map.end(); ++row_it) {
-                auto row_temp = row_it->first;
-                if (!lock_map[row_temp]) {
-                    row_temp->LockRow();
-                    lock_map[row_temp] = true;
+            const size_t slot = i - window_start;
+            auto& it = batch->rows[i];
+            if (it.first != txn) {
+                if (txn != nullptr) {
+                    commit_inserts();
                 }
+                txn = it.first;
+                txn_manager->CleanTxn();
+                // CleanTxn ended the previous gc session, retired row versions are reclaimed from there
+                txn_manager->GcSessionStart();
             }
-
-            // process operation
-            key_id = 0;
-            //            for (auto row_it = txn_ptr->row().begin(); row_it != txn_ptr->row().end(); ++row_it) {
-            for (int i = 0; i < txn_ptr->row_size(); i++) {
-                auto* row_it = &(txn_ptr->row(i));
-                row = vec_row[key_id];
-                table = vec_table[key_id];
-                key_id++;
-                if (table == nullptr) {
-                    continue;
-                }
-                if (row == nullptr) {  // insert or delete by others before this epoch
-                    if (row_it->op_type() == proto::OpType::Insert) {
-                        row = table->CreateNewRow();
-                        row->CopyData((uint8_t*)row_it->data().c_str(), table->GetTupleSize());
-                        res = table->InsertRow(row, txn_manager);
-                        if ((res != MOT::RC_OK) && (res != MOT::RC_UNIQUE_VIOLATION)) {
-                            MOT_REPORT_ERROR(MOT_ERROR_OOM,
-                                "Insert Row ",
-                                "Failed to insert new row for table %s",
-                                table->GetLongTableName().c_str());
-                        }
-                        if (res != MOT::RC_OK) {
-                            MOT_REPORT_ERROR(MOT_ERROR_OOM,
-                                "Taas Insert Row ",
-                                "Failed to insert new row for table %s",
-                                table->GetLongTableName().c_str());
-                        }
-                    } else {
-                        MOT_LOG_INFO("Storage Error Update/Delete a NULL row txn %llu key_id %llu op_type %llu",
-                            txn_ptr->client_txn_id(),
-                            key_id,
-                            row_it->op_type());
-                    }
-                    /* code */
-                } else {
-                    if (row_it->op_type() == proto::OpType::Delete) {
-                        row->GetPrimarySentinel()->SetDirty();
-                        row->SetCSN_Delete(txn_ptr->csn());
-                        // MOT_LOG_INFO("Storage Delete txn %llu key_id %llu op_type %llu", txn_ptr->client_txn_id(), key_id++, row_it->op_type());
-                    } else if (row_it->op_type() == proto::OpType::Update) {
-                        row->CopyData((uint8_t*)row_it->data().c_str(), table->GetTupleSize());
-                        // for (auto col_it = row_it->column().begin(); col_it != row_it->column().end(); ++col_it) {
-                        //     row->SetValueVariable(col_it->id(), col_it->value().c_str(), col_it->value().length()); //
-                        // }
-                        row->SetCSN_Update(txn_ptr->csn());
-                        // MOT_LOG_INFO("Storage Update txn %llu key_id %llu op_type %llu", txn_ptr->client_txn_id(), key_id++, row_it->op_type());
-                    } else if (row_it->op_type() == proto::OpType::Insert) {  /// never should be happen
-                        row = table->CreateNewRow();
-                        row->CopyData((uint8_t*)row_it->data().c_str(), table->GetTupleSize());
-                        res = table->InsertRow(row, txn_manager);
-                        if ((res != MOT::RC_OK) && (res != MOT::RC_UNIQUE_VIOLATION)) {
-                            MOT_REPORT_ERROR(MOT_ERROR_OOM,
-                                "Insert Row ",
-                                "Failed to insert new row for table %s",
-                                table->GetLongTableName().c_str());
-                        }
-                        if (res != MOT::RC_OK) {
-                            MOT_REPORT_ERROR(MOT_ERROR_OOM,
-                                "Taas Insert Row ",
-                                "Failed to insert new row for table %s",
-                                table->GetLongTableName().c_str());
-                        }
-                        // MOT_LOG_INFO("Storage Insert %llu key_id %llu op_type %llu", txn_ptr->client_txn_id(), key_id++, row_it->op_type());
-                    }
-                }
+            if (!ApplyStorageRow(txn_manager, txn, it.second, window->tables[slot], window->sentinels[slot],
+                inserted)) {
+                // skipping the row would leave this node diverged for good, so the lane parks on it until ddl makes
+                // it applicable (see StorageStallApplyLane), then looks the rest of the window up again
+                StorageStallApplyLane(lane, batch->epoch, txn, it.second, txn_manager, window.get(), inserted);
+                relookup = true;
             }
-             txn_manager->SetCommitSequenceNumber(txn_ptr->csn());
-            if (txn_manager->TaasLogCommit() != MOT::RC::RC_OK) {
-                // MOT_LOG_INFO("TaasLogCommit Failed");
-                commit_res = false;
-            }  // write change时会写入csn
+        }
+        if (txn != nullptr) {
+            commit_inserts();
+        }
+        // an idle lane must not hold back the gc epoch
+        txn_manager->GcSessionEnd();
+        StorageEpochBatchApplied(batch->epoch);
+        batch.reset();
+    }
+}
 
-            // release
-            key_id = 0;
-            for (auto row_it = lock_map.begin(); row_it != lock_map.end(); ++row_it) {
-                auto row_temp = row_it->first;
-                if (lock_map[row_temp]) {
-                    row_temp->ReleaseRow();
-                    lock_map[row_temp] = false;
-                }
+// Serve a batched point read. Rows come back in request order; a missing key is answered with op_type Delete
+// and no data. The snapshot epoch of the request is mapped onto a csn, a row whose current version is newer is
+// served from its older versions when enable_row_versions is set; otherwise, if the version was already retired,
+// or if the epoch cannot be mapped, the whole request fails and the client retries or aborts.
+void HandleClientReadRequest(const proto::ClientReadRequest& request, proto::ClientReadResponse* response,
+    storage_lookup_window* window) {
+    MOT::Table* table = nullptr;
+    MOT::Row* row;
+    uint64_t csn;
+    uint64_t snapshot_csn = 0;
+    response->set_txn_id(request.txn_id());
+    response->set_result(proto::Result::Success);
+    if(request.snapshot_epoch() != 0 && !GetStorageSnapshotCsn(request.snapshot_epoch(), snapshot_csn)) {
+        response->set_result(proto::Result::Fail);
+        return;
+    }
+    for(int i = 0; i < request.rows_size(); i ++) {
+        const int slot = i % (int)MOT::Index::READ_BATCH_SIZE;
+        if(slot == 0) {
+            window->Lookup(std::min((size_t)MOT::Index::READ_BATCH_SIZE, (size_t)(request.rows_size() - i)),
+                [&](size_t j) -> const proto::Row& { return request.rows(i + (int)j); });
+        }
+        auto& row_it = request.rows(i);
+        auto* result_row = response->add_rows();
+        result_row->set_table_name(row_it.table_name());
+        result_row->set_table_id(row_it.table_id());
+        result_row->set_table_version(row_it.table_version());
+        result_row->set_key(row_it.key());
+        result_row->set_op_type(proto::OpType::Delete);
+        table = window->tables[slot];
+        if(table == nullptr) {
+            // a row of an unresolved table is not known to be missing
+            response->set_result(proto::Result::Fail);
+            response->clear_rows();
+            return;
+        }
+        if(window->sentinels[slot] == nullptr) {
+            continue;
+        }
+        row = window->sentinels[slot]->GetData();
+        if(row == nullptr || row->IsAbsentRow()) {
+            continue;
+        }
+        row->LockRow();
+        csn = row->GetCommitSequenceNumber();
+        if(snapshot_csn != 0 && csn > snapshot_csn) {
+            // older versions are immutable, the caller's gc session keeps a retired one readable
+            MOT::Row* version = MOT::GetGlobalConfiguration().m_enableRowVersions ?
+                row->GetVisibleVersion(snapshot_csn) : nullptr;
+            row->ReleaseRow();
+            if(version == nullptr) {
+                response->set_result(proto::Result::Fail);
+                response->clear_rows();
+                return;
             }
-//            for (int i = 0; i < txn_ptr->row_size(); i++) {
-//                auto* row_it = &(txn_ptr->row(i));
-//                //            for (auto row_it = txn_ptr->row().begin(); row_it != txn_ptr->row().end(); ++row_it) {
-//                row = vec_row[key_id];
-//                table = vec_table[key_id];
-//                key_id++;
-//                if (table == nullptr) {
-//                    continue;
-//                }
-//                if (row == nullptr) {  // an error
-//                    /* code */
-//                }
-//                if (row != nullptr &&
-//                    (row_it->op_type() == proto::OpType::Update || row_it->op_type() == proto::OpType::Delete)) {
-//                    if (lock_map[row]) {
-//                        row->ReleaseRow();
-//                        lock_map[row] = false;
-//                        // MOT_LOG_INFO("txn ReleaseRow %llu key_id %llu op_type %llu", txn_ptr->client_txn_id(), key_id++, row_it->op_type());
-//                    } else {
-//                        // MOT_LOG_INFO("txn ReleaseRow else");
-//                    }
-//                }
-//            }
-
-            vec_row.clear();
-            vec_table.clear();
-            lock_map.clear();
-            //            MOT_LOG_INFO("Storage 提交 txn num %llu", commit_txn_num);
-            if (!commit_res) {
-                ///
-            } else {
-                commit_txn_num++;
-                if (commit_txn_num % 5 == 0) {
-                    auto num = total_commit_txn_num.fetch_add(commit_txn_num);
-                    commit_txn_num = 0;
-                    MOT_LOG_INFO("共提交 txn num %llu", num);
-                }
+            if(!version->IsRowDeleted()) {
+                result_row->set_op_type(proto::OpType::Read);
+                result_row->set_data(version->GetData(), table->GetTupleSize());
             }
-            txn_ptr.release();
+            result_row->set_csn(version->GetCommitSequenceNumber());
+            continue;
+        }
+        if(!row->IsRowDeleted()) {
+            result_row->set_op_type(proto::OpType::Read);
+            result_row->set_data(row->GetData(), table->GetTupleSize());
         }
+        row->ReleaseRow();
+        result_row->set_csn(csn);
     }
 }
 
@@ -3091,17 +4507,67 @@ void StorageReaderThreadMain(uint64_t id) {
                                            CreateSessionContext(IS_PGXC_COORDINATOR, 0, nullptr, INVALID_CONNECTION_ID);
     MOT::TxnManager* txn_manager = session_context->GetTxnManager();
     MOT_LOG_INFO("线程 StorageReaderThreadMain 开始工作 %llu", id);
-    auto msg_ptr = std::make_unique<proto::Message>();
+    std::unique_ptr<storage_read_params> params;
+    std::unique_ptr<storage_lookup_window> window = std::make_unique<storage_lookup_window>();
+    zmq::context_t reply_context(1);
+    std::unordered_map<std::string, std::unique_ptr<zmq::socket_t>> reply_sockets;
+    std::unordered_map<std::string, WireLink> reply_links;
+    std::string raw;
     while(true) {
-        storage_read_queue.wait_dequeue(msg_ptr);
+        storage_read_queue.wait_dequeue(params);
+        if(params == nullptr || params->msg->type_case() != proto::Message::TypeCase::kClientReadRequest) {
+            continue;
+        }
         //handle client read request
+        auto& request = params->msg->client_read_request();
+        auto response_msg = std::make_unique<proto::Message>();
+        txn_manager->GcSessionStart();
+        HandleClientReadRequest(request, response_msg->mutable_client_read_response(), window.get());
+        txn_manager->GcSessionEnd();
 
         //send client read response
+        auto& socket = reply_sockets[request.client_ip()];
+        if(socket == nullptr) {
+            socket = std::make_unique<zmq::socket_t>(reply_context, ZMQ_PUSH);
+            socket->connect("tcp://" + request.client_ip() + ":5552");
+        }
+        // the client decodes whatever its request frame announced
+        auto& link = reply_links[request.client_ip()];
+        link.SetPeerCodecs(params->peer_codecs);
+        auto* serialized_str_ptr = new std::string();
+        response_msg->SerializeToString(&raw);
+        WireFrameForLink(link, link.Choose(raw.size()), 0, raw.data(), raw.size(), serialized_str_ptr);
+        const size_t frame_size = serialized_str_ptr->size();
+        zmq::message_t msg(static_cast<void*>(const_cast<char*>(serialized_str_ptr->data())),
+            frame_size, string_free, static_cast<void*>(serialized_str_ptr));
+        const uint64_t start = now_to_us();
+        socket->send(msg);
+        link.OnSent(frame_size, now_to_us() - start);
     }
 }
 
 void StorageInit() {
-
+    // pull requests go to the first txn node, which replies to our PULL socket
+    src_node.set_ip(kLocalIp);
+    src_node.set_port(5554);
+    dest_node.set_ip(kTxnNodeIp.empty() ? std::string() : kTxnNodeIp[0]);
+    dest_node.set_port(5553);
+
+    // resume after the last epoch contained in the recovered checkpoint. the epochs between it and the first
+    // pushed one are pulled before anything newer is applied; redo recovery may have replayed some of them
+    // already, applying them again only rewrites the same row versions
+    MOT::CheckpointControlFile* ctrl_file = MOT::CheckpointControlFile::GetCtrlFile();
+    uint64_t applied_epoch = ctrl_file != nullptr ? ctrl_file->GetLastAppliedEpoch() : 0;
+    if (applied_epoch == MOT::CheckpointControlFile::invalidId || applied_epoch == 0) {
+        MOT_LOG_INFO("Storage 无已应用 epoch 记录, 从收到的第一个 epoch 开始应用");
+        return;
+    }
+    std::unique_lock<std::mutex> lock(storage_dispatch_mutex);
+    if (storage_dispatch_epoch == 0) {
+        storage_dispatch_epoch = applied_epoch + 1;
+        update_epoch.store(applied_epoch);
+        MOT_LOG_INFO("Storage 从 checkpoint 恢复已应用 epoch %llu", applied_epoch);
+    }
 }
 
 uint64_t GetSleeptime(){
@@ -3135,7 +4601,12 @@ void StorageManagerThreadMain(uint64_t id) { //handle other status
     request_puller.bind("tcp://*:5546");
     MOT_LOG_INFO("Storage 等待接受同步消息");
     request_puller.recv(&message);
-    while(true) usleep(1000000000);
+    // retry pulls that failed or got no answer, gaps are otherwise only noticed when a new epoch arrives
+    while(true) {
+        usleep(kStoragePullTimeout_us);
+        std::unique_lock<std::mutex> lock(storage_dispatch_mutex);
+        RequestMissingEpochs(now_to_us());
+    }
 //    uint64_t sleep_time = static_cast<uint64_t>((((start_time.tv_sec / 60) + 1) * 60) * 1000000);
 //    usleep(sleep_time - start_time_ll);
 //    gettimeofday(&start_time, NULL);
@@ -71,6 +71,8 @@ extern void StorageSendThreadMain(uint64_t id);
 extern void StorageListenThreadMain(uint64_t id);
 extern void StorageMessageManagerThreadMain(uint64_t id);
 extern void StorageUpdaterThreadMain(uint64_t id);
+extern uint64_t StorageMaxApplyLaneNum();
+extern uint64_t StorageStalledLaneNum();
 extern void StorageReaderThreadMain(uint64_t id);
 extern void StorageManagerThreadMain(uint64_t id);
 extern void StorageWorker1ThreadMain(uint64_t id);
@@ -120,6 +122,7 @@ class Index;
 class IndexIterator;
 class Column;
 class MOTEngine;
+struct HistogramSummary;
 }  // namespace MOT
 
 #ifndef MOTFdwStateSt
@@ -188,12 +191,41 @@ struct MOTFdwState_St {
     MOT::MaxKey m_stateKey[2];
     bool m_forwardDirectionScan;
     MOT::AccessType m_internalCmdOper;
+
+    // IN-list lookup through a single column unique index: the sentinels of all listed keys are read in one batch
+    MOT::Index* m_inListIx;
+    Expr* m_inListExpr;
+    MOT::Sentinel** m_inListSentinels;
+    uint32_t m_inListCount;
+    uint32_t m_inListPos;
+
+    // tuples of the listed keys missing locally, read from a storage node in one request (see enable_remote_read)
+    uint8_t* m_inListRemoteRows;
+    uint32_t m_inListRemoteCount;
+    uint32_t m_inListRemotePos;
 };
 
 class MOTAdaptor {
 public:
 //ADDBY TAAS
     static bool InsertTxntoLocalChangeSet(MOT::TxnManager* txMan);
+    /**
+     * @brief Reports that the verdict of an in-flight transaction is overdue, its txn node is ejected from routing
+     * for a while. The transaction keeps waiting for the verdict, up to txn_verdict_timeout_us more.
+     */
+    static void ReportCommitTimeout(MOT::TxnManager* txMan);
+    /**
+     * @brief Gives up on the verdict of a transaction still pending after txn_verdict_timeout_us more. Its entry is
+     * removed, so a late reply cannot complete the next transaction of the session.
+     * @return The verdict if the reply was being delivered meanwhile, otherwise RC_ABORT.
+     */
+    static MOT::RC AbandonCommit(MOT::TxnManager* txMan);
+    /**
+     * @brief Batched point read from a TaaS storage node. rows[i] receives the tuple of keys[i], or stays empty if
+     * the key does not exist. The rows are read as of the last epoch applied on this node. Returns RC_ABORT if the
+     * storage node cannot serve that epoch.
+     */
+    static MOT::RC RemoteRead(MOT::Table* table, const std::vector<MOT::Key*>& keys, std::vector<std::string>& rows);
 
     static void Init();
     static void Destroy();
@@ -243,6 +275,7 @@ public:
     static uint64_t GetTableIndexSize(uint64_t tabId, uint64_t ixId);
     static MotMemoryDetail* GetMemSize(uint32_t* nodeCount, bool isGlobal);
     static MotSessionMemoryDetail* GetSessionMemSize(uint32_t* sessionCount);
+    static MOT::HistogramSummary* GetHistogramStatistics(uint32_t* histogramCount);
     static MOT::RC ValidateCommit();
     static void RecordCommit(uint64_t csn);
     static MOT::RC Commit(uint64_t csn);  // Does both ValidateCommit and RecordCommit
@@ -304,10 +337,33 @@ public:
     static void PackUpdateRow(TupleTableSlot* slot, MOT::Table* table, const uint8_t* attrs_used, uint8_t* destRow);
     static void UnpackRow(TupleTableSlot* slot, MOT::Table* table, const uint8_t* attrs_used, uint8_t* srcRow);
 
+    /**
+     * @brief Decodes rows into a vector batch, one used column at a time.
+     * @param batch The batch, with a column for every attribute of the table.
+     * @param table The table of the rows.
+     * @param attrs_used The attributes to decode. The other columns are set to null.
+     * @param rows The rows.
+     * @param numRows The number of rows, up to the batch size.
+     */
+    static void UnpackBatch(
+        VectorBatch* batch, MOT::Table* table, const uint8_t* attrs_used, MOT::Row* const* rows, int numRows);
+
     // scan helpers
     static void OpenCursor(Relation rel, MOTFdwStateSt* festate);
     static bool IsScanEnd(MOTFdwStateSt* festate);
     static void CreateKeyBuffer(Relation rel, MOTFdwStateSt* festate, int start);
+    /**
+     * @brief Evaluates the IN-list array of the scan and reads the sentinels of its distinct keys in one batch
+     * through festate->m_inListIx. Null elements match nothing and are skipped. With remote reads enabled, the
+     * keys of a primary key missing locally are read from a storage node in one RemoteRead() call.
+     */
+    static MOT::RC LookupInList(Relation rel, MOTFdwStateSt* festate);
+
+    /**
+     * @brief Reads the listed keys that have no local sentinel into festate->m_inListRemoteRows, with a single
+     * RemoteRead() call.
+     */
+    static MOT::RC ReadInListRemote(MOTFdwStateSt* festate, MOT::Key** keys, uint32_t numKeys);
 
     // planning helpers
     static bool SetMatchingExpr(MOTFdwStateSt* state, MatchIndexArr* marr, int16_t colId, KEY_OPER op, Expr* expr,
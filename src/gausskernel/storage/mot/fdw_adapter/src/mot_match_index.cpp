@@ -25,6 +25,12 @@
 #include "mot_match_index.h"
 #include "mot_internal.h"
 #include "nodes/makefuncs.h"
+#include "utils/selfuncs.h"
+
+/*
+ * Distinct counts above this fraction of the analyzed rows are assumed to grow with the table, as in ANALYZE.
+ */
+#define MOT_DISTINCT_SCALE_FRACTION 0.1
 
 static KEY_OPER keyOperStateMachine[KEY_OPER::READ_INVALID + 1][KEY_OPER::READ_INVALID];
 
@@ -227,15 +233,55 @@ bool MatchIndex::SetIndexColumn(
     return res;
 }
 
+double MatchIndex::EstimateRows(int side) const
+{
+    MOT::Table* table = m_ix->GetTable();
+    MOT::IndexStatistics stats;
+    bool hasStats = m_ix->GetStatistics(stats);
+    double tuples = table->GetRowCount();
+    int16_t numFields = m_ix->GetNumFields();
+    int16_t numExact = 0;
+
+    if (tuples == 0) {
+        tuples = hasStats ? stats.m_numRows : 0;
+    }
+
+    while (numExact < numFields && m_opers[side][numExact] == KEY_OPER::READ_KEY_EXACT) {
+        numExact++;
+    }
+
+    if (numExact == numFields && m_ix->GetUnique()) {
+        return 1.0;
+    }
+
+    double selectivity = 1.0;
+    if (numExact > 0) {
+        if (hasStats && stats.m_distinctPrefix[numExact - 1] > 0) {
+            double distinct = stats.m_distinctPrefix[numExact - 1];
+            if (distinct > stats.m_numRows * MOT_DISTINCT_SCALE_FRACTION && stats.m_numRows > 0) {
+                distinct *= (tuples / stats.m_numRows);
+            }
+            selectivity = (distinct > 1.0) ? (1.0 / distinct) : 1.0;
+        } else {
+            for (int16_t i = 0; i < numExact; i++) {
+                selectivity *= DEFAULT_EQ_SEL;
+            }
+        }
+    }
+
+    // a range on the column following the equality prefix
+    if (numExact < numFields && m_opers[side][numExact] < KEY_OPER::READ_INVALID) {
+        selectivity *= DEFAULT_INEQ_SEL;
+    }
+
+    double rows = tuples * selectivity;
+    return (rows < 1.0) ? 1.0 : rows;
+}
+
 double MatchIndex::GetCost(int numClauses)
 {
     if (m_costs[0] == 0) {
-        int partialIxMulti = 100;
         int notUsed[2] = {0, 0};
-        int used[2] = {0, 0};
-
-        m_costs[0] = 1.0;
-        m_costs[1] = 1.0;
 
         for (int i = 0; i < m_ix->GetNumFields(); i++) {
             // we had same operations on the column, clean all settings
@@ -268,7 +314,6 @@ double MatchIndex::GetCost(int numClauses)
 
                 if (curr < KEY_OPER::READ_INVALID) {
                     m_ixOpers[0] = curr;
-                    used[0]++;
                     if (m_colMatch[1][i] == nullptr &&
                         (m_opers[0][i] == KEY_OPER::READ_KEY_EXACT || m_opers[0][i] == KEY_OPER::READ_KEY_LIKE)) {
                         m_colMatch[1][i] = m_colMatch[0][i];
@@ -292,7 +337,6 @@ double MatchIndex::GetCost(int numClauses)
 
                 if (curr < KEY_OPER::READ_INVALID) {
                     m_ixOpers[1] = curr;
-                    used[1]++;
                 } else {
                     m_opers[1][i] = KEY_OPER::READ_INVALID;
                     notUsed[1]++;
@@ -303,26 +347,12 @@ double MatchIndex::GetCost(int numClauses)
             }
         }
 
+        // the cost of a side is the number of rows its key operation yields
         for (int i = 0; i < 2; i++) {
-            int estimatedRows = 0;
-            if (notUsed[i] > 0) {
-                if (m_ixOpers[i] < KEY_OPER::READ_INVALID) {
-                    m_ixOpers[i] = (KEY_OPER)((uint8_t)m_ixOpers[i] | KEY_OPER_PREFIX_BITMASK);
-                }
-                estimatedRows += (notUsed[i] * partialIxMulti);
-            }
-
-            // we assume that that all other operations will bring 10 times rows
-            if (m_ixOpers[i] != KEY_OPER::READ_KEY_EXACT) {
-                estimatedRows += 10;
+            if (notUsed[i] > 0 && m_ixOpers[i] < KEY_OPER::READ_INVALID) {
+                m_ixOpers[i] = (KEY_OPER)((uint8_t)m_ixOpers[i] | KEY_OPER_PREFIX_BITMASK);
             }
-
-            // we assume that using partial key will bring 10 times more rows per not used column
-            if (used[i] < numClauses) {
-                estimatedRows += (numClauses - used[i]) * 10;
-            }
-
-            m_costs[i] += estimatedRows;
+            m_costs[i] = EstimateRows(i);
         }
 
         if (!m_ix->GetUnique()) {
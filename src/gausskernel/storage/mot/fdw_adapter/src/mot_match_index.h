@@ -115,11 +115,23 @@ public:
         return (m_numMatches[0] == m_ix->GetNumFields() || m_numMatches[1] == m_ix->GetNumFields());
     }
 
+    inline bool IsPointLookup() const
+    {
+        return (m_ixOpers[m_start] == KEY_OPER::READ_KEY_EXACT && m_end < 0);
+    }
+
     inline int32_t GetNumMatchedCols() const
     {
         return m_numMatches[0];
     }
 
+    /**
+     * @brief Estimates the number of rows a side of the match yields, from the index statistics when the index
+     * was analyzed, and from default selectivities otherwise.
+     */
+    double EstimateRows(int side) const;
+
+    /** @brief Computes the key operations of the match and returns the estimated number of rows it yields. */
     double GetCost(int numClauses);
     bool CanApplyOrdering(const int* orderCols) const;
     bool AdjustForOrdering(bool desc);
@@ -97,6 +97,8 @@ const ::PROTOBUF_NAMESPACE_ID::uint32 TableStruct_transaction_2eproto::offsets[]
   PROTOBUF_FIELD_OFFSET(::proto::Row, data_),
   PROTOBUF_FIELD_OFFSET(::proto::Row, column_),
   PROTOBUF_FIELD_OFFSET(::proto::Row, csn_),
+  PROTOBUF_FIELD_OFFSET(::proto::Row, table_id_),
+  PROTOBUF_FIELD_OFFSET(::proto::Row, table_version_),
   ~0u,  // no _has_bits_
   PROTOBUF_FIELD_OFFSET(::proto::Transaction, _internal_metadata_),
   ~0u,  // no _extensions_
@@ -121,7 +123,7 @@ const ::PROTOBUF_NAMESPACE_ID::uint32 TableStruct_transaction_2eproto::offsets[]
 static const ::PROTOBUF_NAMESPACE_ID::internal::MigrationSchema schemas[] PROTOBUF_SECTION_VARIABLE(protodesc_cold) = {
   { 0, -1, sizeof(::proto::Column)},
   { 7, -1, sizeof(::proto::Row)},
-  { 18, -1, sizeof(::proto::Transaction)},
+  { 20, -1, sizeof(::proto::Transaction)},
 };
 
 static ::PROTOBUF_NAMESPACE_ID::Message const * const file_default_instances[] = {
@@ -132,37 +134,38 @@ static ::PROTOBUF_NAMESPACE_ID::Message const * const file_default_instances[] =
 
 const char descriptor_table_protodef_transaction_2eproto[] PROTOBUF_SECTION_VARIABLE(protodesc_cold) =
   "\n\021transaction.proto\022\005proto\032\nnode.proto\"#"
-  "\n\006Column\022\n\n\002id\030\001 \001(\r\022\r\n\005value\030\002 \001(\014\"\200\001\n\003"
+  "\n\006Column\022\n\n\002id\030\001 \001(\r\022\r\n\005value\030\002 \001(\014\"\251\001\n\003"
   "Row\022\036\n\007op_type\030\001 \001(\0162\r.proto.OpType\022\022\n\nt"
   "able_name\030\002 \001(\t\022\013\n\003key\030\003 \001(\014\022\014\n\004data\030\004 \001"
   "(\014\022\035\n\006column\030\005 \003(\0132\r.proto.Column\022\013\n\003csn"
-  "\030\006 \001(\004\"\363\002\n\013Transaction\022\027\n\003row\030\001 \003(\0132\n.pr"
-  "oto.Row\022\023\n\013start_epoch\030\002 \001(\004\022\024\n\014commit_e"
-  "poch\030\003 \001(\004\022\013\n\003csn\030\004 \001(\004\022 \n\010txn_type\030\005 \001("
-  "\0162\016.proto.TxnType\022\"\n\ttxn_state\030\006 \001(\0162\017.p"
-  "roto.TxnState\022\031\n\021message_server_id\030\n \001(\004"
-  "\022\020\n\010shard_id\030\013 \001(\004\022\027\n\017shard_server_id\030\014 "
-  "\001(\004\022\025\n\rtxn_server_ip\030\r \001(\t\022\025\n\rtxn_server"
-  "_id\030\016 \001(\r\022\021\n\tclient_ip\030\017 \001(\t\022\025\n\rclient_t"
-  "xn_id\030\020 \001(\004\022\031\n\021storage_total_num\030\025 \001(\004\022\024"
-  "\n\014storage_type\030\026 \001(\t*\037\n\006Result\022\010\n\004Fail\020\000"
-  "\022\013\n\007Success\020\001*\210\004\n\007TxnType\022\r\n\tClientTxn\020\000"
-  "\022\024\n\020ShardedClientTxn\020\001\022\025\n\021EpochShardEndF"
-  "lag\020\002\022\023\n\017RemoteServerTxn\020\003\022\034\n\030EpochRemot"
-  "eServerEndFlag\020\004\022\r\n\tBackUpTxn\020\005\022\026\n\022Epoch"
-  "BackUpEndFlag\020\006\022\020\n\014CommittedTxn\020\007\022\034\n\030Epo"
-  "chCommittedTxnEndFlag\020\010\022\014\n\010AbortSet\020\024\022\r\n"
-  "\tInsertSet\020\025\022\021\n\rEpochShardACK\020\036\022\030\n\024Epoch"
-  "RemoteServerACK\020\037\022\r\n\tBackUpACK\020 \022\017\n\013Abor"
-  "tSetACK\020!\022\020\n\014InsertSetACK\020\"\022\034\n\030EpochLogP"
-  "ushDownComplete\020#\022\014\n\010NullMark\020(\022\013\n\007Lock_"
-  "ok\0203\022\016\n\nLock_abort\0204\022\017\n\013Prepare_req\0205\022\016\n"
-  "\nPrepare_ok\0206\022\021\n\rPrepare_abort\0207\022\016\n\nComm"
-  "it_req\0208\022\r\n\tCommit_ok\0209\022\020\n\014Commit_abort\020"
-  ":\022\r\n\tAbort_txn\020;*,\n\010TxnState\022\t\n\005Empty\020\000\022"
-  "\t\n\005Abort\020\001\022\n\n\006Commit\020\002*6\n\006OpType\022\010\n\004Read"
-  "\020\000\022\n\n\006Insert\020\001\022\n\n\006Update\020\002\022\n\n\006Delete\020\003B\016"
-  "Z\014./taas_protob\006proto3"
+  "\030\006 \001(\004\022\020\n\010table_id\030\007 \001(\004\022\025\n\rtable_versio"
+  "n\030\010 \001(\r\"\363\002\n\013Transaction\022\027\n\003row\030\001 \003(\0132\n.p"
+  "roto.Row\022\023\n\013start_epoch\030\002 \001(\004\022\024\n\014commit_"
+  "epoch\030\003 \001(\004\022\013\n\003csn\030\004 \001(\004\022 \n\010txn_type\030\005 \001"
+  "(\0162\016.proto.TxnType\022\"\n\ttxn_state\030\006 \001(\0162\017."
+  "proto.TxnState\022\031\n\021message_server_id\030\n \001("
+  "\004\022\020\n\010shard_id\030\013 \001(\004\022\027\n\017shard_server_id\030\014"
+  " \001(\004\022\025\n\rtxn_server_ip\030\r \001(\t\022\025\n\rtxn_serve"
+  "r_id\030\016 \001(\r\022\021\n\tclient_ip\030\017 \001(\t\022\025\n\rclient_"
+  "txn_id\030\020 \001(\004\022\031\n\021storage_total_num\030\025 \001(\004\022"
+  "\024\n\014storage_type\030\026 \001(\t*\037\n\006Result\022\010\n\004Fail\020"
+  "\000\022\013\n\007Success\020\001*\210\004\n\007TxnType\022\r\n\tClientTxn\020"
+  "\000\022\024\n\020ShardedClientTxn\020\001\022\025\n\021EpochShardEnd"
+  "Flag\020\002\022\023\n\017RemoteServerTxn\020\003\022\034\n\030EpochRemo"
+  "teServerEndFlag\020\004\022\r\n\tBackUpTxn\020\005\022\026\n\022Epoc"
+  "hBackUpEndFlag\020\006\022\020\n\014CommittedTxn\020\007\022\034\n\030Ep"
+  "ochCommittedTxnEndFlag\020\010\022\014\n\010AbortSet\020\024\022\r"
+  "\n\tInsertSet\020\025\022\021\n\rEpochShardACK\020\036\022\030\n\024Epoc"
+  "hRemoteServerACK\020\037\022\r\n\tBackUpACK\020 \022\017\n\013Abo"
+  "rtSetACK\020!\022\020\n\014InsertSetACK\020\"\022\034\n\030EpochLog"
+  "PushDownComplete\020#\022\014\n\010NullMark\020(\022\013\n\007Lock"
+  "_ok\0203\022\016\n\nLock_abort\0204\022\017\n\013Prepare_req\0205\022\016"
+  "\n\nPrepare_ok\0206\022\021\n\rPrepare_abort\0207\022\016\n\nCom"
+  "mit_req\0208\022\r\n\tCommit_ok\0209\022\020\n\014Commit_abort"
+  "\020:\022\r\n\tAbort_txn\020;*,\n\010TxnState\022\t\n\005Empty\020\000"
+  "\022\t\n\005Abort\020\001\022\n\n\006Commit\020\002*6\n\006OpType\022\010\n\004Rea"
+  "d\020\000\022\n\n\006Insert\020\001\022\n\n\006Update\020\002\022\n\n\006Delete\020\003B"
+  "\016Z\014./taas_protob\006proto3"
   ;
 static const ::PROTOBUF_NAMESPACE_ID::internal::DescriptorTable*const descriptor_table_transaction_2eproto_deps[1] = {
   &::descriptor_table_node_2eproto,
@@ -175,7 +178,7 @@ static ::PROTOBUF_NAMESPACE_ID::internal::SCCInfoBase*const descriptor_table_tra
 static ::PROTOBUF_NAMESPACE_ID::internal::once_flag descriptor_table_transaction_2eproto_once;
 static bool descriptor_table_transaction_2eproto_initialized = false;
 const ::PROTOBUF_NAMESPACE_ID::internal::DescriptorTable descriptor_table_transaction_2eproto = {
-  &descriptor_table_transaction_2eproto_initialized, descriptor_table_protodef_transaction_2eproto, "transaction.proto", 1262,
+  &descriptor_table_transaction_2eproto_initialized, descriptor_table_protodef_transaction_2eproto, "transaction.proto", 1303,
   &descriptor_table_transaction_2eproto_once, descriptor_table_transaction_2eproto_sccs, descriptor_table_transaction_2eproto_deps, 3, 1,
   schemas, file_default_instances, TableStruct_transaction_2eproto::offsets,
   file_level_metadata_transaction_2eproto, 3, file_level_enum_descriptors_transaction_2eproto, file_level_service_descriptors_transaction_2eproto,
@@ -521,8 +524,8 @@ Row::Row(const Row& from)
     data_.AssignWithDefault(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), from.data_);
   }
   ::memcpy(&csn_, &from.csn_,
-    static_cast<size_t>(reinterpret_cast<char*>(&op_type_) -
-    reinterpret_cast<char*>(&csn_)) + sizeof(op_type_));
+    static_cast<size_t>(reinterpret_cast<char*>(&table_version_) -
+    reinterpret_cast<char*>(&csn_)) + sizeof(table_version_));
   // @@protoc_insertion_point(copy_constructor:proto.Row)
 }
 
@@ -532,8 +535,8 @@ void Row::SharedCtor() {
   key_.UnsafeSetDefault(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited());
   data_.UnsafeSetDefault(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited());
   ::memset(&csn_, 0, static_cast<size_t>(
-      reinterpret_cast<char*>(&op_type_) -
-      reinterpret_cast<char*>(&csn_)) + sizeof(op_type_));
+      reinterpret_cast<char*>(&table_version_) -
+      reinterpret_cast<char*>(&csn_)) + sizeof(table_version_));
 }
 
 Row::~Row() {
@@ -567,8 +570,8 @@ void Row::Clear() {
   key_.ClearToEmptyNoArena(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited());
   data_.ClearToEmptyNoArena(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited());
   ::memset(&csn_, 0, static_cast<size_t>(
-      reinterpret_cast<char*>(&op_type_) -
-      reinterpret_cast<char*>(&csn_)) + sizeof(op_type_));
+      reinterpret_cast<char*>(&table_version_) -
+      reinterpret_cast<char*>(&csn_)) + sizeof(table_version_));
   _internal_metadata_.Clear();
 }
 
@@ -631,6 +634,20 @@ const char* Row::_InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::intern
           CHK_(ptr);
         } else goto handle_unusual;
         continue;
+      // uint64 table_id = 7;
+      case 7:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<::PROTOBUF_NAMESPACE_ID::uint8>(tag) == 56)) {
+          table_id_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint(&ptr);
+          CHK_(ptr);
+        } else goto handle_unusual;
+        continue;
+      // uint32 table_version = 8;
+      case 8:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<::PROTOBUF_NAMESPACE_ID::uint8>(tag) == 64)) {
+          table_version_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint(&ptr);
+          CHK_(ptr);
+        } else goto handle_unusual;
+        continue;
       default: {
       handle_unusual:
         if ((tag & 7) == 4 || tag == 0) {
@@ -700,6 +717,18 @@ failure:
     target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::WriteUInt64ToArray(6, this->_internal_csn(), target);
   }
 
+  // uint64 table_id = 7;
+  if (this->table_id() != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::WriteUInt64ToArray(7, this->_internal_table_id(), target);
+  }
+
+  // uint32 table_version = 8;
+  if (this->table_version() != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::WriteUInt32ToArray(8, this->_internal_table_version(), target);
+  }
+
   if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
     target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormat::InternalSerializeUnknownFieldsToArray(
         _internal_metadata_.unknown_fields(), target, stream);
@@ -751,12 +780,26 @@ size_t Row::ByteSizeLong() const {
         this->_internal_csn());
   }
 
+  // uint64 table_id = 7;
+  if (this->table_id() != 0) {
+    total_size += 1 +
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::UInt64Size(
+        this->_internal_table_id());
+  }
+
   // .proto.OpType op_type = 1;
   if (this->op_type() != 0) {
     total_size += 1 +
       ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::EnumSize(this->_internal_op_type());
   }
 
+  // uint32 table_version = 8;
+  if (this->table_version() != 0) {
+    total_size += 1 +
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::UInt32Size(
+        this->_internal_table_version());
+  }
+
   if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
     return ::PROTOBUF_NAMESPACE_ID::internal::ComputeUnknownFieldsSize(
         _internal_metadata_, total_size, &_cached_size_);
@@ -807,6 +850,12 @@ void Row::MergeFrom(const Row& from) {
   if (from.op_type() != 0) {
     _internal_set_op_type(from._internal_op_type());
   }
+  if (from.table_id() != 0) {
+    _internal_set_table_id(from._internal_table_id());
+  }
+  if (from.table_version() != 0) {
+    _internal_set_table_version(from._internal_table_version());
+  }
 }
 
 void Row::CopyFrom(const ::PROTOBUF_NAMESPACE_ID::Message& from) {
@@ -839,6 +888,8 @@ void Row::InternalSwap(Row* other) {
     GetArenaNoVirtual());
   swap(csn_, other->csn_);
   swap(op_type_, other->op_type_);
+  swap(table_id_, other->table_id_);
+  swap(table_version_, other->table_version_);
 }
 
 ::PROTOBUF_NAMESPACE_ID::Metadata Row::GetMetadata() const {
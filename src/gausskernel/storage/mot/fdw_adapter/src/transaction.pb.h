@@ -462,6 +462,8 @@ class Row :
     kDataFieldNumber = 4,
     kCsnFieldNumber = 6,
     kOpTypeFieldNumber = 1,
+    kTableIdFieldNumber = 7,
+    kTableVersionFieldNumber = 8,
   };
   // repeated .proto.Column column = 5;
   int column_size() const;
@@ -547,6 +549,24 @@ class Row :
   void _internal_set_op_type(::proto::OpType value);
   public:
 
+  // uint64 table_id = 7;
+  void clear_table_id();
+  ::PROTOBUF_NAMESPACE_ID::uint64 table_id() const;
+  void set_table_id(::PROTOBUF_NAMESPACE_ID::uint64 value);
+  private:
+  ::PROTOBUF_NAMESPACE_ID::uint64 _internal_table_id() const;
+  void _internal_set_table_id(::PROTOBUF_NAMESPACE_ID::uint64 value);
+  public:
+
+  // uint32 table_version = 8;
+  void clear_table_version();
+  ::PROTOBUF_NAMESPACE_ID::uint32 table_version() const;
+  void set_table_version(::PROTOBUF_NAMESPACE_ID::uint32 value);
+  private:
+  ::PROTOBUF_NAMESPACE_ID::uint32 _internal_table_version() const;
+  void _internal_set_table_version(::PROTOBUF_NAMESPACE_ID::uint32 value);
+  public:
+
   // @@protoc_insertion_point(class_scope:proto.Row)
  private:
   class _Internal;
@@ -557,7 +577,9 @@ class Row :
   ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr key_;
   ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr data_;
   ::PROTOBUF_NAMESPACE_ID::uint64 csn_;
+  ::PROTOBUF_NAMESPACE_ID::uint64 table_id_;
   int op_type_;
+  ::PROTOBUF_NAMESPACE_ID::uint32 table_version_;
   mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
   friend struct ::TableStruct_transaction_2eproto;
 };
@@ -1227,6 +1249,46 @@ inline void Row::set_csn(::PROTOBUF_NAMESPACE_ID::uint64 value) {
   // @@protoc_insertion_point(field_set:proto.Row.csn)
 }
 
+// uint64 table_id = 7;
+inline void Row::clear_table_id() {
+  table_id_ = PROTOBUF_ULONGLONG(0);
+}
+inline ::PROTOBUF_NAMESPACE_ID::uint64 Row::_internal_table_id() const {
+  return table_id_;
+}
+inline ::PROTOBUF_NAMESPACE_ID::uint64 Row::table_id() const {
+  // @@protoc_insertion_point(field_get:proto.Row.table_id)
+  return _internal_table_id();
+}
+inline void Row::_internal_set_table_id(::PROTOBUF_NAMESPACE_ID::uint64 value) {
+  
+  table_id_ = value;
+}
+inline void Row::set_table_id(::PROTOBUF_NAMESPACE_ID::uint64 value) {
+  _internal_set_table_id(value);
+  // @@protoc_insertion_point(field_set:proto.Row.table_id)
+}
+
+// uint32 table_version = 8;
+inline void Row::clear_table_version() {
+  table_version_ = 0u;
+}
+inline ::PROTOBUF_NAMESPACE_ID::uint32 Row::_internal_table_version() const {
+  return table_version_;
+}
+inline ::PROTOBUF_NAMESPACE_ID::uint32 Row::table_version() const {
+  // @@protoc_insertion_point(field_get:proto.Row.table_version)
+  return _internal_table_version();
+}
+inline void Row::_internal_set_table_version(::PROTOBUF_NAMESPACE_ID::uint32 value) {
+  
+  table_version_ = value;
+}
+inline void Row::set_table_version(::PROTOBUF_NAMESPACE_ID::uint32 value) {
+  _internal_set_table_version(value);
+  // @@protoc_insertion_point(field_set:proto.Row.table_version)
+}
+
 // -------------------------------------------------------------------
 
 // Transaction
@@ -97,6 +97,10 @@ extern const char* CommandToString(JitCommandType commandType)
             return "Aggregate-Range-Join";
         case JIT_COMMAND_COMPOUND_SELECT:
             return "Compound-Select";
+        case JIT_COMMAND_GROUP_BY_SELECT:
+            return "Group-By-Select";
+        case JIT_COMMAND_MULTI_JOIN:
+            return "Multi-Join";
 
         case JIT_COMMAND_INVALID:
         default:
@@ -115,6 +119,8 @@ extern bool IsRangeCommand(JitCommandType commandType)
         case JIT_COMMAND_POINT_JOIN:
         case JIT_COMMAND_RANGE_JOIN:
         case JIT_COMMAND_AGGREGATE_JOIN:
+        case JIT_COMMAND_GROUP_BY_SELECT:
+        case JIT_COMMAND_MULTI_JOIN:
             rangeCommand = true;
             break;
 
@@ -134,6 +140,7 @@ extern bool IsJoinCommand(JitCommandType commandType)
         case JIT_COMMAND_POINT_JOIN:
         case JIT_COMMAND_RANGE_JOIN:
         case JIT_COMMAND_AGGREGATE_JOIN:
+        case JIT_COMMAND_MULTI_JOIN:
             joinCommand = true;
             break;
 
@@ -623,4 +630,41 @@ extern bool PrepareSubQueryData(JitContext* jitContext, JitCompoundPlan* plan)
 
     return result;
 }
+
+extern bool PrepareJoinScanData(JitContext* jitContext, JitNestedLoopPlan* plan)
+{
+    // the first two scans use the main and inner table of the context
+    int subQueryCount = plan->_scan_count - 2;
+    if (subQueryCount <= 0) {
+        return true;
+    }
+
+    MOT_LOG_TRACE("Preparing %d join scan data items", subQueryCount);
+    uint32_t allocSize = sizeof(JitContext::SubQueryData) * subQueryCount;
+    jitContext->m_subQueryData = (JitContext::SubQueryData*)MOT::MemGlobalAllocAligned(allocSize, L1_CACHE_LINE);
+    if (jitContext->m_subQueryData == nullptr) {
+        MOT_REPORT_ERROR(MOT_ERROR_OOM,
+            "Generate JIT code",
+            "Failed to allocate %u bytes for %d join scan data items in JIT context object",
+            allocSize,
+            subQueryCount);
+        return false;
+    }
+
+    jitContext->m_subQueryCount = subQueryCount;
+    for (int i = 0; i < subQueryCount; ++i) {
+        JitIndexScan* indexScan = &plan->_scans[i + 2];
+        JitContext::SubQueryData* subQueryData = &jitContext->m_subQueryData[i];
+        subQueryData->m_commandType = JIT_COMMAND_RANGE_SELECT;
+        subQueryData->m_tupleDesc = nullptr;
+        subQueryData->m_slot = nullptr;
+        subQueryData->m_searchKey = nullptr;
+        subQueryData->m_endIteratorKey = nullptr;
+        subQueryData->m_table = indexScan->_table;
+        subQueryData->m_index = subQueryData->m_table->GetIndex(indexScan->_index_id);
+        subQueryData->m_indexId = subQueryData->m_index->GetExtId();
+        MOT_LOG_TRACE("Installed join scan %d index id: %" PRIu64, i + 2, subQueryData->m_indexId);
+    }
+    return true;
+}
 }  // namespace JitExec
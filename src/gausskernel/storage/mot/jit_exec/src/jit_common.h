@@ -35,6 +35,7 @@
 namespace JitExec {
 // forward declaration
 struct JitCompoundPlan;
+struct JitNestedLoopPlan;
 
 // common helpers for code generation
 /** @brief Converts a PG command type to LLVM command type. */
@@ -125,6 +126,15 @@ extern void DestroyTableInfo(TableInfo* table_info);
  * @return True if operations succeeded, otherwise false.
  */
 extern bool PrepareSubQueryData(JitContext* jitContext, JitCompoundPlan* plan);
+
+/**
+ * @brief Prepares sub-query data items for the join scans of a nested-loop plan beyond the first two (which use the
+ * main and inner table of the JIT context).
+ * @param jitContext The JIT context to prepare.
+ * @param plan The nested-loop plan for the query.
+ * @return True if operations succeeded, otherwise false.
+ */
+extern bool PrepareJoinScanData(JitContext* jitContext, JitNestedLoopPlan* plan);
 }  // namespace JitExec
 
 #endif
@@ -39,6 +39,7 @@
 #include "jit_tvm.h"
 #include "mot_internal.h"
 #include "jit_source.h"
+#include "jit_group_table.h"
 #include "mm_global_api.h"
 
 namespace JitExec {
@@ -271,8 +272,9 @@ extern bool ReFetchIndices(JitContext* jitContext)
         }
     }
 
-    // re-fetch sub-query indices (COMPOUND commands only)
-    if (jitContext->m_commandType == JIT_COMMAND_COMPOUND_SELECT) {
+    // re-fetch sub-query indices (COMPOUND and MULTI-JOIN commands only)
+    if ((jitContext->m_commandType == JIT_COMMAND_COMPOUND_SELECT) ||
+        (jitContext->m_commandType == JIT_COMMAND_MULTI_JOIN)) {
         for (uint32_t i = 0; i < jitContext->m_subQueryCount; ++i) {
             JitContext::SubQueryData* subQueryData = &jitContext->m_subQueryData[i];
             if (subQueryData->m_index == nullptr) {
@@ -341,11 +343,14 @@ static bool PrepareJitContextJoinData(JitContext* jitContext)
 static bool PrepareJitContextSubQueryData(JitContext* jitContext)
 {
     // allocate sub-query search keys and generate tuple table slot array using session top memory context
+    // in a multi-join command the sub-query data describes the inner scans beyond the second table, and these only
+    // require search keys (the join has a single result slot)
+    bool isJoinScan = (jitContext->m_commandType == JIT_COMMAND_MULTI_JOIN);
     MemoryContext oldCtx = CurrentMemoryContext;
     CurrentMemoryContext = SESS_GET_MEM_CXT_GROUP(MEMORY_CONTEXT_EXECUTOR);
     for (uint32_t i = 0; i < jitContext->m_subQueryCount; ++i) {
         JitContext::SubQueryData* subQueryData = &jitContext->m_subQueryData[i];
-        if (subQueryData->m_tupleDesc == nullptr) {
+        if (!isJoinScan && (subQueryData->m_tupleDesc == nullptr)) {
             MOT_LOG_TRACE("Preparing sub-query %u tuple descriptor", i);
             List* targetList = GetSubQueryTargetList(jitContext->m_queryString, i);
             if (targetList == nullptr) {
@@ -362,7 +367,7 @@ static bool PrepareJitContextSubQueryData(JitContext* jitContext)
             }
         }
 
-        if (subQueryData->m_slot == nullptr) {
+        if (!isJoinScan && (subQueryData->m_slot == nullptr)) {
             MOT_ASSERT(subQueryData->m_tupleDesc != nullptr);
             MOT_LOG_TRACE("Preparing sub-query %u result slot", i);
             subQueryData->m_slot = MakeSingleTupleTableSlot(subQueryData->m_tupleDesc);
@@ -384,7 +389,7 @@ static bool PrepareJitContextSubQueryData(JitContext* jitContext)
             }
         }
 
-        if ((subQueryData->m_commandType == JIT_COMMAND_AGGREGATE_RANGE_SELECT) &&
+        if ((isJoinScan || (subQueryData->m_commandType == JIT_COMMAND_AGGREGATE_RANGE_SELECT)) &&
             (subQueryData->m_endIteratorKey == nullptr)) {
             MOT_LOG_TRACE("Preparing sub-query %u end-iterator search key from index %s",
                 i,
@@ -481,8 +486,9 @@ extern bool PrepareJitContext(JitContext* jitContext)
         return false;  // safe cleanup during destroy
     }
 
-    // prepare sub-query data for COMPOUND commands
-    if (jitContext->m_commandType == JIT_COMMAND_COMPOUND_SELECT) {
+    // prepare sub-query data for COMPOUND and MULTI-JOIN commands
+    if ((jitContext->m_commandType == JIT_COMMAND_COMPOUND_SELECT) ||
+        (jitContext->m_commandType == JIT_COMMAND_MULTI_JOIN)) {
         if (!PrepareJitContextSubQueryData(jitContext)) {
             MOT_LOG_TRACE("Failed to sub-query data for JIT context, aborting jitted code execution");
             return false;  // safe cleanup during destroy
@@ -516,6 +522,12 @@ extern void DestroyJitContext(JitContext* jitContext)
         // cleanup sub-query data array
         CleanupJitContextSubQueryDataArray(jitContext);
 
+        // cleanup group table of an interrupted GROUP BY or multi-join scan
+        if (jitContext->m_groupTable != nullptr) {
+            DestroyGroupTable((JitGroupTable*)jitContext->m_groupTable);
+            jitContext->m_groupTable = nullptr;
+        }
+
         // cleanup keys(s)
         CleanupJitContextPrimary(jitContext);
 
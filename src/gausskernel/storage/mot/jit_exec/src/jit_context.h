@@ -192,27 +192,31 @@ struct JitContext {
     /** @var The number of sub-queries used. */
     uint64_t m_subQueryCount;  // L1 offset 8
 
+    /*---------------------- Group By Execution -------------------*/
+    /** @var Materialized group table of a GROUP BY or multi-table join query (see jit_group_table.h). */
+    void* m_groupTable;  // L1 offset 16
+
     /*---------------------- Cleanup -------------------*/
     /** @var Chain all context objects related to the same source, for cleanup during relation modification. */
-    JitContext* m_nextInSource;  // L1 offset 16
+    JitContext* m_nextInSource;  // L1 offset 24
 
     /** @var The JIT source from which this context originated. */
-    JitSource* m_jitSource;  // L1 offset 24
+    JitSource* m_jitSource;  // L1 offset 32
 
     /*---------------------- Batch Execution -------------------*/
     /**
      * @var The number of times (iterations) a single stateful query was invoked. Used for distinguishing query
      * boundaries in a stateful query execution when client uses batches.
      */
-    uint64_t m_iterCount;  // L1 offset 32
+    uint64_t m_iterCount;  // L1 offset 40
 
     /** @var The number of full query executions. */
-    uint64_t m_queryCount;  // L1 offset 40
+    uint64_t m_queryCount;  // L1 offset 48
 
     /*---------------------- Debug execution state -------------------*/
     /** @var The number of times this context was invoked for execution. */
 #ifdef MOT_JIT_DEBUG
-    uint64_t m_execCount;  // L1 offset 48
+    uint64_t m_execCount;  // L1 offset 56
 #endif
 };
 
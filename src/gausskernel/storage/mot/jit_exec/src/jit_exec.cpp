@@ -152,6 +152,8 @@ static void ProcessJitResult(MOT::RC result, JitContext* jitContext, int newScan
             case JIT_COMMAND_POINT_JOIN:
             case JIT_COMMAND_RANGE_JOIN:
             case JIT_COMMAND_COMPOUND_SELECT:
+            case JIT_COMMAND_GROUP_BY_SELECT:
+            case JIT_COMMAND_MULTI_JOIN:
             case JIT_COMMAND_UPDATE:
             case JIT_COMMAND_RANGE_UPDATE:
                 // this is considered as successful execution
@@ -348,6 +350,11 @@ extern JitContext* JitCodegenQuery(Query* query, const char* queryString, JitPla
     return jitContext;
 }
 
+extern const char* GetJitContextCommand(JitContext* jitContext)
+{
+    return CommandToString(jitContext->m_commandType);
+}
+
 extern void JitResetScan(JitContext* jitContext)
 {
     MOT_LOG_DEBUG("JitResetScan(): Resetting iteration count for context %p", jitContext);
@@ -432,6 +439,9 @@ extern int JitExecQuery(
     ++jitContext->m_iterCount;
 
     // invoke the jitted function
+    JitStatisticsProvider& jitStats = JitStatisticsProvider::GetInstance();
+    bool collectStats = jitStats.IsEnabled();
+    uint64_t startTime = collectStats ? GetSysClock() : 0;
     if (jitContext->m_llvmFunction != nullptr) {
 #ifdef MOT_JIT_DEBUG
         MOT_LOG_DEBUG("Executing LLVM-jitted function %p: %s", jitContext->m_llvmFunction, jitContext->m_queryString);
@@ -456,6 +466,9 @@ extern int JitExecQuery(
 #endif
         result = JitExecTvmQuery(jitContext, params, slot, tuplesProcessed, scanEnded, newScan);
     }
+    if (collectStats) {
+        jitStats.AddInvokeTime(MOT::CpuCyclesLevelTime::CyclesToNanoseconds(GetSysClock() - startTime));
+    }
 
 #ifdef MOT_JIT_DEBUG
     if (firstExec) {
@@ -633,10 +633,14 @@ static void ExplainAggregateOperator(int indent, const JitAggregate* aggregate,
     if (aggregate->_distinct) {
         MOT_LOG_APPEND(MOT::LogLevel::LL_TRACE, "DISTINCT(");
     }
-    MOT_LOG_APPEND(MOT::LogLevel::LL_TRACE,
-        "%s.%s)",
-        aggregate->_table->GetTableName().c_str(),
-        aggregate->_table->GetFieldName(aggregate->_table_column_id));
+    if (aggregate->_table == nullptr) {  // COUNT(*)
+        MOT_LOG_APPEND(MOT::LogLevel::LL_TRACE, "*)");
+    } else {
+        MOT_LOG_APPEND(MOT::LogLevel::LL_TRACE,
+            "%s.%s)",
+            aggregate->_table->GetTableName().c_str(),
+            aggregate->_table->GetFieldName(aggregate->_table_column_id));
+    }
     if (aggregate->_distinct) {
         MOT_LOG_APPEND(MOT::LogLevel::LL_TRACE, ")");
     }
@@ -749,6 +753,42 @@ static void ExplainCompoundPlan(Query* query, JitCompoundPlan* plan)
     ExplainSearchExprArray(query, (JitPlan*)plan, indent + 4, &plan->_outer_query_plan->_query._search_exprs, false);
 }
 
+static void ExplainNestedLoopPlan(Query* query, JitNestedLoopPlan* plan)
+{
+    MOT_LOG_BEGIN(MOT::LogLevel::LL_TRACE, "[Plan] Nested-Loop %s on tables", CommandToString(plan->_command_type));
+    for (int i = 0; i < plan->_scan_count; ++i) {
+        MOT_LOG_APPEND(MOT::LogLevel::LL_TRACE,
+            "%s%s",
+            (i == 0) ? " " : ", ",
+            plan->_scans[i]._table->GetTableName().c_str());
+    }
+    MOT_LOG_END(MOT::LogLevel::LL_TRACE);
+    int indent = 2;
+    if (plan->_grouped) {
+        for (int i = 0; i < plan->_group_by._aggregate_count; ++i) {
+            ExplainAggregateOperator(indent, &plan->_group_by._aggregates[i]._aggregate);
+        }
+        if (plan->_group_by._group_exprs._count > 0) {
+            MOT_LOG_BEGIN(MOT::LogLevel::LL_TRACE, "%*sGROUP BY", indent, "");
+            ExplainSelectExprArray(query, (JitPlan*)plan, &plan->_group_by._group_exprs);
+            MOT_LOG_END(MOT::LogLevel::LL_TRACE);
+        }
+    } else {
+        MOT_LOG_BEGIN(MOT::LogLevel::LL_TRACE, "%*sSELECT", indent, "");
+        ExplainSelectExprArray(query, (JitPlan*)plan, &plan->_select_exprs);
+        MOT_LOG_END(MOT::LogLevel::LL_TRACE);
+    }
+    if (plan->_limit_count > 0) {
+        MOT_LOG_TRACE("%*sLIMIT %d", indent, "", plan->_limit_count);
+    }
+    for (int i = 0; i < plan->_scan_count; ++i) {
+        char scanName[32];
+        errno_t erc = snprintf_s(scanName, sizeof(scanName), sizeof(scanName) - 1, "LEVEL %d", i);
+        securec_check_ss(erc, "\0", "\0");
+        ExplainIndexScan(query, (JitPlan*)plan, indent + 2 * (i + 1), &plan->_scans[i], scanName);
+    }
+}
+
 extern void JitExplainPlan(Query* query, JitPlan* plan)
 {
     if (plan != nullptr) {
@@ -773,6 +813,10 @@ extern void JitExplainPlan(Query* query, JitPlan* plan)
                 ExplainCompoundPlan(query, (JitCompoundPlan*)plan);
                 break;
 
+            case JIT_PLAN_NESTED_LOOP:
+                ExplainNestedLoopPlan(query, (JitNestedLoopPlan*)plan);
+                break;
+
             case JIT_PLAN_INVALID:
             default:
                 break;
@@ -0,0 +1,613 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * -------------------------------------------------------------------------
+ *
+ * jit_group_table.cpp
+ *    Materialized group table used by jitted GROUP BY and multi-table join queries.
+ *
+ * IDENTIFICATION
+ *    src/gausskernel/storage/mot/jit_exec/src/jit_group_table.cpp
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include "global.h"
+#include "jit_group_table.h"
+#include "utilities.h"
+#include "table.h"
+#include "row.h"
+
+#include "knl/knl_session.h"
+#include "catalog/pg_aggregate.h"
+#include "catalog/pg_collation.h"
+#include "utils/builtins.h"
+#include "utils/datum.h"
+#include "utils/lsyscache.h"
+#include "utils/memutils.h"
+#include "utils/syscache.h"
+#include "utils/typcache.h"
+
+namespace JitExec {
+DECLARE_LOGGER(JitGroupTable, JitExec)
+
+/** @define Initial number of hash buckets (must be a power of two). */
+#define JIT_GROUP_INITIAL_BUCKETS 64
+
+/** @define Initial capacity of the ordered group array. */
+#define JIT_GROUP_INITIAL_CAPACITY 64
+
+/** @struct Describes one group key. */
+struct JitGroupKeyInfo {
+    /** @var The key type. */
+    Oid m_typeOid;
+
+    /** @var The collation used for hashing and comparing the key. */
+    Oid m_collation;
+
+    /** @var The result tuple column, or -1 if the key is not selected. */
+    int m_tupleColumnId;
+
+    /** @var The type length. */
+    int16 m_typeLen;
+
+    /** @var Specifies whether the type is passed by value. */
+    bool m_typeByVal;
+
+    /** @var The type hash function (hash mode only). */
+    FmgrInfo* m_hashFunc;
+
+    /** @var The type equality function (hash mode only). */
+    FmgrInfo* m_eqFunc;
+};
+
+/** @struct Describes one aggregate computed per group (see nodeAgg.cpp). */
+struct JitGroupAggInfo {
+    /** @var The aggregate transition function. */
+    FmgrInfo m_transFunc;
+
+    /** @var The aggregate final function (valid only if @ref m_hasFinalFunc is set). */
+    FmgrInfo m_finalFunc;
+
+    /** @var Specifies whether the aggregate has a final function. */
+    bool m_hasFinalFunc;
+
+    /** @var Specifies whether the aggregate takes an argument (false for COUNT(*)). */
+    bool m_hasArg;
+
+    /** @var Specifies whether the transition type is passed by value. */
+    bool m_transTypeByVal;
+
+    /** @var Specifies whether the initial transition value is null. */
+    bool m_initValueIsNull;
+
+    /** @var The transition type length. */
+    int16 m_transTypeLen;
+
+    /** @var The initial transition value. */
+    Datum m_initValue;
+
+    /** @var The result tuple column. */
+    int m_tupleColumnId;
+};
+
+/** @struct A single group (or a single row in append mode). */
+struct JitGroupEntry {
+    /** @var Next group in the same hash bucket. */
+    JitGroupEntry* m_next;
+
+    /** @var The hash value of the group keys. */
+    uint32 m_hashValue;
+
+    /** @var Key values followed by transition values. */
+    Datum* m_values;
+
+    /** @var Key null flags followed by transition null flags. */
+    bool* m_isNull;
+
+    /** @var Specifies for each aggregate whether the transition value was initialized (strict functions only). */
+    bool* m_noTransValue;
+};
+
+struct JitGroupTable {
+    /** @var Memory context holding all groups. */
+    MemoryContext m_groupCxt;
+
+    /** @var Memory context reset after each accumulated row. */
+    MemoryContext m_tempCxt;
+
+    /** @var The number of keys. */
+    uint32_t m_keyCount;
+
+    /** @var The number of aggregates. */
+    uint32_t m_aggCount;
+
+    /** @var Specifies whether rows are appended rather than grouped. */
+    bool m_appendMode;
+
+    /** @var Specifies whether the table was fully materialized. */
+    bool m_ready;
+
+    /** @var The maximum number of rows collected (append mode) or emitted (hash mode), zero means no limit. */
+    uint32_t m_limit;
+
+    /** @var Key descriptors. */
+    JitGroupKeyInfo* m_keys;
+
+    /** @var Aggregate descriptors. */
+    JitGroupAggInfo* m_aggs;
+
+    /** @var The key values of the next accumulated row. */
+    Datum* m_keyValues;
+
+    /** @var The key null flags of the next accumulated row. */
+    bool* m_keyIsNull;
+
+    /** @var The aggregate arguments of the next accumulated row. */
+    Datum* m_aggArgs;
+
+    /** @var The aggregate argument null flags of the next accumulated row. */
+    bool* m_aggArgIsNull;
+
+    /** @var Hash buckets (hash mode only). */
+    JitGroupEntry** m_buckets;
+
+    /** @var The number of hash buckets. */
+    uint32_t m_bucketCount;
+
+    /** @var Groups in insertion order. */
+    JitGroupEntry** m_groups;
+
+    /** @var The number of groups. */
+    uint32_t m_groupCount;
+
+    /** @var The capacity of the group array. */
+    uint32_t m_groupCapacity;
+
+    /** @var The next group to emit. */
+    uint32_t m_emitIndex;
+
+    /** @var Copies of the current rows of outer join scan levels. */
+    MOT::Row* m_joinRows[MOT_JIT_MAX_JOIN_TABLES];
+
+    /** @var The tables from which the join row copies were allocated. */
+    MOT::Table* m_joinRowTables[MOT_JIT_MAX_JOIN_TABLES];
+};
+
+// forward declarations
+static JitGroupEntry* CreateGroupEntry(JitGroupTable* groupTable, uint32 hashValue);
+static void AdvanceGroupAggregates(JitGroupTable* groupTable, JitGroupEntry* entry);
+
+extern JitGroupTable* CreateGroupTable(uint32_t keyCount, uint32_t aggCount, bool appendMode, uint32_t limit)
+{
+    MemoryContext groupCxt = AllocSetContextCreate(SESS_GET_MEM_CXT_GROUP(MEMORY_CONTEXT_EXECUTOR),
+        "MOT JIT Group Table",
+        ALLOCSET_DEFAULT_MINSIZE,
+        ALLOCSET_DEFAULT_INITSIZE,
+        ALLOCSET_DEFAULT_MAXSIZE);
+    MemoryContext oldCxt = MemoryContextSwitchTo(groupCxt);
+
+    JitGroupTable* groupTable = (JitGroupTable*)palloc0(sizeof(JitGroupTable));
+    groupTable->m_groupCxt = groupCxt;
+    groupTable->m_tempCxt = AllocSetContextCreate(groupCxt,
+        "MOT JIT Group Table Temp",
+        ALLOCSET_SMALL_MINSIZE,
+        ALLOCSET_SMALL_INITSIZE,
+        ALLOCSET_SMALL_MAXSIZE);
+    groupTable->m_keyCount = keyCount;
+    groupTable->m_aggCount = aggCount;
+    groupTable->m_appendMode = appendMode;
+    groupTable->m_limit = limit;
+    if (keyCount > 0) {
+        groupTable->m_keys = (JitGroupKeyInfo*)palloc0(sizeof(JitGroupKeyInfo) * keyCount);
+        groupTable->m_keyValues = (Datum*)palloc0(sizeof(Datum) * keyCount);
+        groupTable->m_keyIsNull = (bool*)palloc0(sizeof(bool) * keyCount);
+    }
+    if (aggCount > 0) {
+        groupTable->m_aggs = (JitGroupAggInfo*)palloc0(sizeof(JitGroupAggInfo) * aggCount);
+        groupTable->m_aggArgs = (Datum*)palloc0(sizeof(Datum) * aggCount);
+        groupTable->m_aggArgIsNull = (bool*)palloc0(sizeof(bool) * aggCount);
+    }
+    if (!appendMode) {
+        groupTable->m_bucketCount = JIT_GROUP_INITIAL_BUCKETS;
+        groupTable->m_buckets = (JitGroupEntry**)palloc0(sizeof(JitGroupEntry*) * JIT_GROUP_INITIAL_BUCKETS);
+    }
+    groupTable->m_groupCapacity = JIT_GROUP_INITIAL_CAPACITY;
+    groupTable->m_groups = (JitGroupEntry**)palloc(sizeof(JitGroupEntry*) * JIT_GROUP_INITIAL_CAPACITY);
+
+    (void)MemoryContextSwitchTo(oldCxt);
+    MOT_LOG_DEBUG("Created group table %p with %u keys and %u aggregates (append-mode: %s, limit: %u)",
+        groupTable,
+        keyCount,
+        aggCount,
+        appendMode ? "yes" : "no",
+        limit);
+    return groupTable;
+}
+
+extern void DestroyGroupTable(JitGroupTable* groupTable)
+{
+    if (groupTable != nullptr) {
+        MOT_LOG_DEBUG("Destroying group table %p with %u groups", groupTable, groupTable->m_groupCount);
+        for (uint32_t i = 0; i < MOT_JIT_MAX_JOIN_TABLES; ++i) {
+            if (groupTable->m_joinRows[i] != nullptr) {
+                groupTable->m_joinRowTables[i]->DestroyRow(groupTable->m_joinRows[i]);
+            }
+        }
+        // the group table itself is allocated from its own memory context
+        MemoryContextDelete(groupTable->m_groupCxt);
+    }
+}
+
+extern bool DefineGroupKey(JitGroupTable* groupTable, uint32_t keyIndex, Oid typeOid, int tupleColumnId)
+{
+    JitGroupKeyInfo* keyInfo = &groupTable->m_keys[keyIndex];
+    keyInfo->m_typeOid = typeOid;
+    keyInfo->m_collation = type_is_collatable(typeOid) ? DEFAULT_COLLATION_OID : InvalidOid;
+    keyInfo->m_tupleColumnId = tupleColumnId;
+    get_typlenbyval(typeOid, &keyInfo->m_typeLen, &keyInfo->m_typeByVal);
+
+    if (!groupTable->m_appendMode) {
+        TypeCacheEntry* typeEntry = lookup_type_cache(typeOid, TYPECACHE_HASH_PROC_FINFO | TYPECACHE_EQ_OPR_FINFO);
+        if (!OidIsValid(typeEntry->hash_proc) || !OidIsValid(typeEntry->eq_opr)) {
+            MOT_LOG_TRACE("Cannot define group key %u: type %u cannot be hashed", keyIndex, typeOid);
+            return false;
+        }
+        keyInfo->m_hashFunc = &typeEntry->hash_proc_finfo;
+        keyInfo->m_eqFunc = &typeEntry->eq_opr_finfo;
+    }
+    return true;
+}
+
+extern bool DefineGroupAggregate(
+    JitGroupTable* groupTable, uint32_t aggIndex, Oid aggFuncId, Oid argType, int tupleColumnId)
+{
+    HeapTuple aggTuple = SearchSysCache1(AGGFNOID, ObjectIdGetDatum(aggFuncId));
+    if (!HeapTupleIsValid(aggTuple)) {
+        MOT_LOG_TRACE("Cannot define group aggregate %u: aggregate function %u not found", aggIndex, aggFuncId);
+        return false;
+    }
+    Form_pg_aggregate aggForm = (Form_pg_aggregate)GETSTRUCT(aggTuple);
+
+    JitGroupAggInfo* aggInfo = &groupTable->m_aggs[aggIndex];
+    aggInfo->m_hasArg = OidIsValid(argType);
+    aggInfo->m_tupleColumnId = tupleColumnId;
+    fmgr_info_cxt(aggForm->aggtransfn, &aggInfo->m_transFunc, groupTable->m_groupCxt);
+    aggInfo->m_hasFinalFunc = OidIsValid(aggForm->aggfinalfn);
+    if (aggInfo->m_hasFinalFunc) {
+        fmgr_info_cxt(aggForm->aggfinalfn, &aggInfo->m_finalFunc, groupTable->m_groupCxt);
+    }
+    get_typlenbyval(aggForm->aggtranstype, &aggInfo->m_transTypeLen, &aggInfo->m_transTypeByVal);
+
+    // initial value is potentially null, so don't try to access it as a struct field
+    Datum textInitVal = SysCacheGetAttr(AGGFNOID, aggTuple, Anum_pg_aggregate_agginitval, &aggInfo->m_initValueIsNull);
+    if (aggInfo->m_initValueIsNull) {
+        aggInfo->m_initValue = (Datum)0;
+    } else {
+        Oid typeInput = InvalidOid;
+        Oid typeIOParam = InvalidOid;
+        getTypeInputInfo(aggForm->aggtranstype, &typeInput, &typeIOParam);
+        MemoryContext oldCxt = MemoryContextSwitchTo(groupTable->m_groupCxt);
+        char* strInitVal = TextDatumGetCString(textInitVal);
+        aggInfo->m_initValue = OidInputFunctionCall(typeInput, strInitVal, typeIOParam, -1);
+        pfree(strInitVal);
+        (void)MemoryContextSwitchTo(oldCxt);
+    }
+    ReleaseSysCache(aggTuple);
+
+    // a strict transition function without initial value takes the first input as its initial value
+    if (aggInfo->m_transFunc.fn_strict && aggInfo->m_initValueIsNull && !aggInfo->m_hasArg) {
+        MOT_LOG_TRACE("Cannot define group aggregate %u: strict aggregate %u without argument and initial value",
+            aggIndex,
+            aggFuncId);
+        return false;
+    }
+
+    // an aggregate over an empty input without grouping keys still yields a single row (e.g. COUNT() yields zero)
+    if (!groupTable->m_appendMode && (groupTable->m_keyCount == 0) && (aggIndex == groupTable->m_aggCount - 1)) {
+        if (CreateGroupEntry(groupTable, 0) == nullptr) {
+            return false;
+        }
+    }
+    return true;
+}
+
+extern bool PrepareGroupJoinRow(JitGroupTable* groupTable, uint32_t level, MOT::Table* table)
+{
+    if (groupTable->m_joinRows[level] == nullptr) {
+        groupTable->m_joinRows[level] = table->CreateNewRow();
+        if (groupTable->m_joinRows[level] == nullptr) {
+            MOT_LOG_TRACE("Failed to allocate join row copy for level %u on table %s",
+                level,
+                table->GetTableName().c_str());
+            return false;
+        }
+        groupTable->m_joinRowTables[level] = table;
+    }
+    return true;
+}
+
+extern MOT::Row* CopyGroupJoinRow(JitGroupTable* groupTable, uint32_t level, MOT::Row* row)
+{
+    MOT::Row* rowCopy = groupTable->m_joinRows[level];
+    rowCopy->Copy(row);
+    return rowCopy;
+}
+
+extern void SetGroupKey(JitGroupTable* groupTable, uint32_t keyIndex, Datum value, bool isNull)
+{
+    groupTable->m_keyValues[keyIndex] = value;
+    groupTable->m_keyIsNull[keyIndex] = isNull;
+}
+
+extern void SetGroupAggregateArg(JitGroupTable* groupTable, uint32_t aggIndex, Datum value, bool isNull)
+{
+    groupTable->m_aggArgs[aggIndex] = value;
+    groupTable->m_aggArgIsNull[aggIndex] = isNull;
+}
+
+static uint32 ComputeGroupHash(JitGroupTable* groupTable)
+{
+    uint32 hashValue = 0;
+    for (uint32_t i = 0; i < groupTable->m_keyCount; ++i) {
+        // rotate hashkey left 1 bit at each step (see execGrouping.cpp)
+        hashValue = (hashValue << 1) | ((hashValue & 0x80000000) ? 1 : 0);
+        if (!groupTable->m_keyIsNull[i]) {
+            JitGroupKeyInfo* keyInfo = &groupTable->m_keys[i];
+            uint32 keyHash = DatumGetUInt32(
+                FunctionCall1Coll(keyInfo->m_hashFunc, keyInfo->m_collation, groupTable->m_keyValues[i]));
+            hashValue ^= keyHash;
+        }
+    }
+    return hashValue;
+}
+
+static bool IsGroupMatch(JitGroupTable* groupTable, JitGroupEntry* entry)
+{
+    for (uint32_t i = 0; i < groupTable->m_keyCount; ++i) {
+        // null keys are grouped together
+        if (entry->m_isNull[i] || groupTable->m_keyIsNull[i]) {
+            if (entry->m_isNull[i] != groupTable->m_keyIsNull[i]) {
+                return false;
+            }
+        } else {
+            JitGroupKeyInfo* keyInfo = &groupTable->m_keys[i];
+            if (!DatumGetBool(FunctionCall2Coll(
+                    keyInfo->m_eqFunc, keyInfo->m_collation, entry->m_values[i], groupTable->m_keyValues[i]))) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+static void GrowGroupBuckets(JitGroupTable* groupTable)
+{
+    uint32_t bucketCount = groupTable->m_bucketCount * 2;
+    JitGroupEntry** buckets =
+        (JitGroupEntry**)MemoryContextAllocZero(groupTable->m_groupCxt, sizeof(JitGroupEntry*) * bucketCount);
+    for (uint32_t i = 0; i < groupTable->m_groupCount; ++i) {
+        JitGroupEntry* entry = groupTable->m_groups[i];
+        uint32_t bucket = entry->m_hashValue & (bucketCount - 1);
+        entry->m_next = buckets[bucket];
+        buckets[bucket] = entry;
+    }
+    pfree(groupTable->m_buckets);
+    groupTable->m_buckets = buckets;
+    groupTable->m_bucketCount = bucketCount;
+}
+
+/** @brief Creates a group from the current key values, and links it to the hash table (hash mode only). */
+static JitGroupEntry* CreateGroupEntry(JitGroupTable* groupTable, uint32 hashValue)
+{
+    MemoryContext oldCxt = MemoryContextSwitchTo(groupTable->m_groupCxt);
+    uint32_t valueCount = groupTable->m_keyCount + groupTable->m_aggCount;
+    JitGroupEntry* entry = (JitGroupEntry*)palloc0(sizeof(JitGroupEntry));
+    entry->m_hashValue = hashValue;
+    if (valueCount > 0) {
+        entry->m_values = (Datum*)palloc0(sizeof(Datum) * valueCount);
+        entry->m_isNull = (bool*)palloc0(sizeof(bool) * valueCount);
+    }
+    if (groupTable->m_aggCount > 0) {
+        entry->m_noTransValue = (bool*)palloc0(sizeof(bool) * groupTable->m_aggCount);
+    }
+
+    // copy keys
+    for (uint32_t i = 0; i < groupTable->m_keyCount; ++i) {
+        JitGroupKeyInfo* keyInfo = &groupTable->m_keys[i];
+        entry->m_isNull[i] = groupTable->m_keyIsNull[i];
+        if (!entry->m_isNull[i]) {
+            entry->m_values[i] = datumCopy(groupTable->m_keyValues[i], keyInfo->m_typeByVal, keyInfo->m_typeLen);
+        }
+    }
+
+    // initialize transition values
+    for (uint32_t i = 0; i < groupTable->m_aggCount; ++i) {
+        JitGroupAggInfo* aggInfo = &groupTable->m_aggs[i];
+        uint32_t valueIndex = groupTable->m_keyCount + i;
+        entry->m_isNull[valueIndex] = aggInfo->m_initValueIsNull;
+        entry->m_noTransValue[i] = aggInfo->m_initValueIsNull;
+        if (!aggInfo->m_initValueIsNull) {
+            entry->m_values[valueIndex] =
+                datumCopy(aggInfo->m_initValue, aggInfo->m_transTypeByVal, aggInfo->m_transTypeLen);
+        }
+    }
+
+    // add to ordered group array
+    if (groupTable->m_groupCount == groupTable->m_groupCapacity) {
+        groupTable->m_groupCapacity *= 2;
+        groupTable->m_groups = (JitGroupEntry**)repalloc(
+            groupTable->m_groups, sizeof(JitGroupEntry*) * groupTable->m_groupCapacity);
+    }
+    groupTable->m_groups[groupTable->m_groupCount++] = entry;
+
+    // link to hash bucket, and keep average chain length below one
+    if (!groupTable->m_appendMode) {
+        uint32_t bucket = hashValue & (groupTable->m_bucketCount - 1);
+        entry->m_next = groupTable->m_buckets[bucket];
+        groupTable->m_buckets[bucket] = entry;
+        if (groupTable->m_groupCount > groupTable->m_bucketCount) {
+            GrowGroupBuckets(groupTable);
+        }
+    }
+    (void)MemoryContextSwitchTo(oldCxt);
+    return entry;
+}
+
+extern bool AccumulateGroupRow(JitGroupTable* groupTable)
+{
+    if (groupTable->m_appendMode) {
+        if (IsGroupTableFull(groupTable)) {
+            return true;
+        }
+        return (CreateGroupEntry(groupTable, 0) != nullptr);
+    }
+
+    // find the group (hash and compare in temporary memory, since some types detoast values)
+    MemoryContext oldCxt = MemoryContextSwitchTo(groupTable->m_tempCxt);
+    uint32 hashValue = ComputeGroupHash(groupTable);
+    JitGroupEntry* entry = groupTable->m_buckets[hashValue & (groupTable->m_bucketCount - 1)];
+    while (entry != nullptr) {
+        if ((entry->m_hashValue == hashValue) && IsGroupMatch(groupTable, entry)) {
+            break;
+        }
+        entry = entry->m_next;
+    }
+    (void)MemoryContextSwitchTo(oldCxt);
+
+    if (entry == nullptr) {
+        entry = CreateGroupEntry(groupTable, hashValue);
+        if (entry == nullptr) {
+            MemoryContextReset(groupTable->m_tempCxt);
+            return false;
+        }
+    }
+
+    AdvanceGroupAggregates(groupTable, entry);
+    MemoryContextReset(groupTable->m_tempCxt);
+    return true;
+}
+
+/** @brief Applies all aggregate transition functions on a group (see advance_transition_function() in nodeAgg.cpp). */
+static void AdvanceGroupAggregates(JitGroupTable* groupTable, JitGroupEntry* entry)
+{
+    MemoryContext oldCxt = MemoryContextSwitchTo(groupTable->m_tempCxt);
+    for (uint32_t i = 0; i < groupTable->m_aggCount; ++i) {
+        JitGroupAggInfo* aggInfo = &groupTable->m_aggs[i];
+        uint32_t valueIndex = groupTable->m_keyCount + i;
+        Datum arg = groupTable->m_aggArgs[i];
+        bool argIsNull = aggInfo->m_hasArg ? groupTable->m_aggArgIsNull[i] : false;
+
+        if (aggInfo->m_transFunc.fn_strict) {
+            // a strict transition function ignores null input
+            if (aggInfo->m_hasArg && argIsNull) {
+                continue;
+            }
+            // the first non-null input becomes the initial transition value
+            if (entry->m_noTransValue[i]) {
+                (void)MemoryContextSwitchTo(groupTable->m_groupCxt);
+                entry->m_values[valueIndex] = datumCopy(arg, aggInfo->m_transTypeByVal, aggInfo->m_transTypeLen);
+                (void)MemoryContextSwitchTo(groupTable->m_tempCxt);
+                entry->m_isNull[valueIndex] = false;
+                entry->m_noTransValue[i] = false;
+                continue;
+            }
+            // once the state became null (strict function returned null) it stays null
+            if (entry->m_isNull[valueIndex]) {
+                continue;
+            }
+        }
+
+        FunctionCallInfoData fcinfo;
+        short argCount = aggInfo->m_hasArg ? 2 : 1;
+        InitFunctionCallInfoData(fcinfo, &aggInfo->m_transFunc, argCount, InvalidOid, nullptr, nullptr);
+        fcinfo.arg[0] = entry->m_values[valueIndex];
+        fcinfo.argnull[0] = entry->m_isNull[valueIndex];
+        if (aggInfo->m_hasArg) {
+            fcinfo.arg[1] = arg;
+            fcinfo.argnull[1] = argIsNull;
+        }
+        Datum newValue = FunctionCallInvoke(&fcinfo);
+
+        // copy a new pass-by-reference state into the group memory, and free the old one
+        if (!aggInfo->m_transTypeByVal && (DatumGetPointer(newValue) != DatumGetPointer(entry->m_values[valueIndex]))) {
+            if (!fcinfo.isnull) {
+                (void)MemoryContextSwitchTo(groupTable->m_groupCxt);
+                newValue = datumCopy(newValue, aggInfo->m_transTypeByVal, aggInfo->m_transTypeLen);
+                (void)MemoryContextSwitchTo(groupTable->m_tempCxt);
+            }
+            if (!entry->m_isNull[valueIndex]) {
+                pfree(DatumGetPointer(entry->m_values[valueIndex]));
+            }
+        }
+        entry->m_values[valueIndex] = newValue;
+        entry->m_isNull[valueIndex] = fcinfo.isnull;
+    }
+    (void)MemoryContextSwitchTo(oldCxt);
+}
+
+extern bool IsGroupTableFull(JitGroupTable* groupTable)
+{
+    return groupTable->m_appendMode && (groupTable->m_limit > 0) && (groupTable->m_groupCount >= groupTable->m_limit);
+}
+
+extern void SetGroupTableReady(JitGroupTable* groupTable)
+{
+    groupTable->m_ready = true;
+}
+
+extern bool IsGroupTableReady(JitGroupTable* groupTable)
+{
+    return groupTable->m_ready;
+}
+
+extern bool GetNextGroup(JitGroupTable* groupTable, TupleTableSlot* slot)
+{
+    if (groupTable->m_emitIndex >= groupTable->m_groupCount) {
+        return false;
+    }
+    if ((groupTable->m_limit > 0) && (groupTable->m_emitIndex >= groupTable->m_limit)) {
+        return false;
+    }
+    JitGroupEntry* entry = groupTable->m_groups[groupTable->m_emitIndex++];
+
+    for (uint32_t i = 0; i < groupTable->m_keyCount; ++i) {
+        int tupleColumnId = groupTable->m_keys[i].m_tupleColumnId;
+        if (tupleColumnId >= 0) {
+            slot->tts_values[tupleColumnId] = entry->m_values[i];
+            slot->tts_isnull[tupleColumnId] = entry->m_isNull[i];
+        }
+    }
+
+    // final values are computed in the group memory, so they remain valid until the table is destroyed
+    MemoryContext oldCxt = MemoryContextSwitchTo(groupTable->m_groupCxt);
+    for (uint32_t i = 0; i < groupTable->m_aggCount; ++i) {
+        JitGroupAggInfo* aggInfo = &groupTable->m_aggs[i];
+        uint32_t valueIndex = groupTable->m_keyCount + i;
+        Datum result = entry->m_values[valueIndex];
+        bool isNull = entry->m_isNull[valueIndex];
+        if (aggInfo->m_hasFinalFunc && !(aggInfo->m_finalFunc.fn_strict && isNull)) {
+            FunctionCallInfoData fcinfo;
+            InitFunctionCallInfoData(fcinfo, &aggInfo->m_finalFunc, 1, InvalidOid, nullptr, nullptr);
+            fcinfo.arg[0] = result;
+            fcinfo.argnull[0] = isNull;
+            result = FunctionCallInvoke(&fcinfo);
+            isNull = fcinfo.isnull;
+        }
+        slot->tts_values[aggInfo->m_tupleColumnId] = result;
+        slot->tts_isnull[aggInfo->m_tupleColumnId] = isNull;
+    }
+    (void)MemoryContextSwitchTo(oldCxt);
+    return true;
+}
+}  // namespace JitExec
@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * -------------------------------------------------------------------------
+ *
+ * jit_group_table.h
+ *    Materialized group table used by jitted GROUP BY and multi-table join queries.
+ *
+ * IDENTIFICATION
+ *    src/gausskernel/storage/mot/jit_exec/src/jit_group_table.h
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef JIT_GROUP_TABLE_H
+#define JIT_GROUP_TABLE_H
+
+#include "postgres.h"
+#include "executor/tuptable.h"
+#include "storage/mot/jit_def.h"
+
+namespace MOT {
+class Table;
+class Row;
+}  // namespace MOT
+
+namespace JitExec {
+/**
+ * @struct JitGroupTable A session-local table that collects the result of a jitted nested-loop scan. In hash mode
+ * each distinct combination of key values maps to one group whose aggregates are accumulated with the transition
+ * functions of the aggregate catalog. In append mode every accumulated row is kept as is (plain multi-table join).
+ * Groups are emitted in insertion order.
+ */
+struct JitGroupTable;
+
+/**
+ * @brief Creates a group table.
+ * @param keyCount The number of key columns (in append mode these are all the selected columns).
+ * @param aggCount The number of aggregates computed per group (must be zero in append mode).
+ * @param appendMode Specifies whether rows are appended rather than grouped.
+ * @param limit The maximum number of rows to collect (append mode) or to emit (hash mode), or zero if not limited.
+ * @return The group table, or null if failed.
+ */
+extern JitGroupTable* CreateGroupTable(uint32_t keyCount, uint32_t aggCount, bool appendMode, uint32_t limit);
+
+/** @brief Destroys a group table and all memory it holds. */
+extern void DestroyGroupTable(JitGroupTable* groupTable);
+
+/**
+ * @brief Defines the type and result tuple column of a key.
+ * @param groupTable The group table.
+ * @param keyIndex The key index.
+ * @param typeOid The key type.
+ * @param tupleColumnId The result tuple column, or -1 if the key is not selected.
+ * @return True if succeeded, or false if the key type cannot be hashed.
+ */
+extern bool DefineGroupKey(JitGroupTable* groupTable, uint32_t keyIndex, Oid typeOid, int tupleColumnId);
+
+/**
+ * @brief Defines an aggregate computed for each group.
+ * @param groupTable The group table.
+ * @param aggIndex The aggregate index.
+ * @param aggFuncId The aggregate function identifier (as in pg_aggregate).
+ * @param argType The aggregated column type, or @ref InvalidOid for an aggregate without argument (COUNT(*)).
+ * @param tupleColumnId The result tuple column.
+ * @return True if succeeded, otherwise false.
+ */
+extern bool DefineGroupAggregate(
+    JitGroupTable* groupTable, uint32_t aggIndex, Oid aggFuncId, Oid argType, int tupleColumnId);
+
+/**
+ * @brief Allocates the buffer into which the current row of an outer join scan level is copied. A row returned by a
+ * lookup may be overwritten by the next lookup (i.e. the lookups of inner levels), so outer rows must be copied.
+ * @param groupTable The group table.
+ * @param level The join scan level.
+ * @param table The table scanned at this level.
+ * @return True if succeeded, otherwise false.
+ */
+extern bool PrepareGroupJoinRow(JitGroupTable* groupTable, uint32_t level, MOT::Table* table);
+
+/**
+ * @brief Copies the current row of an outer join scan level.
+ * @return The row copy, which remains valid until the next copy at the same level.
+ */
+extern MOT::Row* CopyGroupJoinRow(JitGroupTable* groupTable, uint32_t level, MOT::Row* row);
+
+/** @brief Sets the value of a key for the next accumulated row. */
+extern void SetGroupKey(JitGroupTable* groupTable, uint32_t keyIndex, Datum value, bool isNull);
+
+/** @brief Sets the argument of an aggregate for the next accumulated row. */
+extern void SetGroupAggregateArg(JitGroupTable* groupTable, uint32_t aggIndex, Datum value, bool isNull);
+
+/**
+ * @brief Accumulates the row whose keys and aggregate arguments were set.
+ * @return True if succeeded, or false if failed to allocate memory.
+ */
+extern bool AccumulateGroupRow(JitGroupTable* groupTable);
+
+/** @brief Queries whether the group table reached its limit (append mode only). */
+extern bool IsGroupTableFull(JitGroupTable* groupTable);
+
+/** @brief Marks the group table as fully materialized, so that next calls only emit groups. */
+extern void SetGroupTableReady(JitGroupTable* groupTable);
+
+/** @brief Queries whether the group table is fully materialized. */
+extern bool IsGroupTableReady(JitGroupTable* groupTable);
+
+/**
+ * @brief Writes the next group into a result tuple slot (the slot is not stored).
+ * @return True if a group was written, or false if all groups were already emitted.
+ */
+extern bool GetNextGroup(JitGroupTable* groupTable, TupleTableSlot* slot);
+}  // namespace JitExec
+
+#endif /* JIT_GROUP_TABLE_H */
@@ -35,6 +35,7 @@
 
 #include "jit_helpers.h"
 #include "jit_common.h"
+#include "jit_group_table.h"
 #include "mot_internal.h"
 #include "utilities.h"
 #include <unordered_set>
@@ -1409,4 +1410,88 @@ MOT::Key* GetSubQueryEndIteratorKey(int subQueryIndex)
 {
     return u_sess->mot_cxt.jit_context->m_subQueryData[subQueryIndex].m_endIteratorKey;
 }
+static inline JitExec::JitGroupTable* GetCurrentGroupTable()
+{
+    return (JitExec::JitGroupTable*)u_sess->mot_cxt.jit_context->m_groupTable;
+}
+
+int PrepareGroupTable(int keyCount, int aggCount, int appendMode, int limit)
+{
+    MOT_LOG_DEBUG("Preparing group table with %d keys and %d aggregates", keyCount, aggCount);
+    DestroyCurrentGroupTable();
+    JitExec::JitGroupTable* groupTable =
+        JitExec::CreateGroupTable((uint32_t)keyCount, (uint32_t)aggCount, appendMode != 0, (uint32_t)limit);
+    u_sess->mot_cxt.jit_context->m_groupTable = groupTable;
+    return (groupTable != nullptr) ? 1 : 0;
+}
+
+int DefineGroupKeyType(int keyIndex, int typeOid, int tupleColumnId)
+{
+    return JitExec::DefineGroupKey(GetCurrentGroupTable(), (uint32_t)keyIndex, (Oid)typeOid, tupleColumnId) ? 1 : 0;
+}
+
+int DefineGroupAggregateFunc(int aggIndex, int aggFuncId, int argType, int tupleColumnId)
+{
+    bool result = JitExec::DefineGroupAggregate(
+        GetCurrentGroupTable(), (uint32_t)aggIndex, (Oid)aggFuncId, (Oid)argType, tupleColumnId);
+    return result ? 1 : 0;
+}
+
+int PrepareJoinRowCopy(int level, MOT::Table* table)
+{
+    return JitExec::PrepareGroupJoinRow(GetCurrentGroupTable(), (uint32_t)level, table) ? 1 : 0;
+}
+
+MOT::Row* CopyJoinRow(int level, MOT::Row* row)
+{
+    return JitExec::CopyGroupJoinRow(GetCurrentGroupTable(), (uint32_t)level, row);
+}
+
+void SetGroupKeyValue(int keyIndex, Datum value, int argPos)
+{
+    bool isNull = (getExprArgIsNull(argPos) != 0);
+    JitExec::SetGroupKey(GetCurrentGroupTable(), (uint32_t)keyIndex, value, isNull);
+}
+
+void SetGroupAggregateValue(int aggIndex, Datum value, int argPos)
+{
+    bool isNull = (getExprArgIsNull(argPos) != 0);
+    JitExec::SetGroupAggregateArg(GetCurrentGroupTable(), (uint32_t)aggIndex, value, isNull);
+}
+
+int AccumulateGroup()
+{
+    return JitExec::AccumulateGroupRow(GetCurrentGroupTable()) ? 1 : 0;
+}
+
+int IsGroupTableFull()
+{
+    return JitExec::IsGroupTableFull(GetCurrentGroupTable()) ? 1 : 0;
+}
+
+void SetGroupTableReady()
+{
+    JitExec::SetGroupTableReady(GetCurrentGroupTable());
+}
+
+int IsGroupTableReady()
+{
+    JitExec::JitGroupTable* groupTable = GetCurrentGroupTable();
+    return ((groupTable != nullptr) && JitExec::IsGroupTableReady(groupTable)) ? 1 : 0;
+}
+
+int EmitNextGroup(TupleTableSlot* slot)
+{
+    return JitExec::GetNextGroup(GetCurrentGroupTable(), slot) ? 1 : 0;
+}
+
+void DestroyCurrentGroupTable()
+{
+    JitExec::JitContext* jitContext = u_sess->mot_cxt.jit_context;
+    if (jitContext->m_groupTable != nullptr) {
+        MOT_LOG_DEBUG("Destroying group table");
+        JitExec::DestroyGroupTable((JitExec::JitGroupTable*)jitContext->m_groupTable);
+        jitContext->m_groupTable = nullptr;
+    }
+}
 }  // extern "C"
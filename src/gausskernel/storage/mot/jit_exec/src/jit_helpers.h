@@ -557,6 +557,44 @@ MOT::Key* GetSubQuerySearchKey(int subQueryIndex);
 
 /** @brief Retrieves the end-iterator key of a sub-query (LLVM only). */
 MOT::Key* GetSubQueryEndIteratorKey(int subQueryIndex);
+/** @brief Creates the group table of the current jitted nested-loop query (LLVM only). */
+int PrepareGroupTable(int keyCount, int aggCount, int appendMode, int limit);
+
+/** @brief Defines the type and result tuple column of a group key (LLVM only). */
+int DefineGroupKeyType(int keyIndex, int typeOid, int tupleColumnId);
+
+/** @brief Defines an aggregate of the current group table (LLVM only). */
+int DefineGroupAggregateFunc(int aggIndex, int aggFuncId, int argType, int tupleColumnId);
+
+/** @brief Allocates the row copy buffer of an outer join scan level (LLVM only). */
+int PrepareJoinRowCopy(int level, MOT::Table* table);
+
+/** @brief Copies the current row of an outer join scan level (LLVM only). */
+MOT::Row* CopyJoinRow(int level, MOT::Row* row);
+
+/** @brief Sets a group key of the next accumulated row from an expression argument (LLVM only). */
+void SetGroupKeyValue(int keyIndex, Datum value, int argPos);
+
+/** @brief Sets an aggregate argument of the next accumulated row from an expression argument (LLVM only). */
+void SetGroupAggregateValue(int aggIndex, Datum value, int argPos);
+
+/** @brief Accumulates the next row into the group table (LLVM only). */
+int AccumulateGroup();
+
+/** @brief Queries whether the group table reached its row limit (LLVM only). */
+int IsGroupTableFull();
+
+/** @brief Marks the group table as fully materialized (LLVM only). */
+void SetGroupTableReady();
+
+/** @brief Queries whether the group table exists and is fully materialized (LLVM only). */
+int IsGroupTableReady();
+
+/** @brief Writes the next group into the result slot (LLVM only). */
+int EmitNextGroup(TupleTableSlot* slot);
+
+/** @brief Destroys the group table of the current jitted query (LLVM only). */
+void DestroyCurrentGroupTable();
 }  // extern "C"
 
 #endif
@@ -794,6 +794,14 @@ static llvm::Value* ProcessVarExpr(JitLlvmCodeGenContext* ctx, llvm::Value* row,
     } else {
         // this is a bit awkward, but it works
         llvm::Value* table = (expr->_table == ctx->_table_info.m_table) ? ctx->table_value : ctx->inner_table_value;
+        // in a nested-loop join each scan level has its own table and current row
+        for (int level = 0; level < ctx->m_joinCount; ++level) {
+            if ((expr->_table == ctx->m_joinTables[level]) && (ctx->m_joinRows[level] != nullptr)) {
+                table = ctx->m_joinTableValues[level];
+                row = ctx->m_joinRows[level];
+                break;
+            }
+        }
         result = AddReadDatumColumn(ctx, table, row, expr->_column_id, expr->_arg_pos);
         if (max_arg && (expr->_arg_pos > *max_arg)) {
             *max_arg = expr->_arg_pos;
@@ -632,6 +632,85 @@ inline void DefineGetSubQueryEndIteratorKey(JitLlvmCodeGenContext* ctx, llvm::Mo
         defineFunction(module, ctx->KeyType->getPointerTo(), "GetSubQueryEndIteratorKey", ctx->INT32_T, nullptr);
 }
 
+inline void DefinePrepareGroupTable(JitLlvmCodeGenContext* ctx, llvm::Module* module)
+{
+    ctx->PrepareGroupTableFunc = defineFunction(
+        module, ctx->INT32_T, "PrepareGroupTable", ctx->INT32_T, ctx->INT32_T, ctx->INT32_T, ctx->INT32_T, nullptr);
+}
+
+inline void DefineDefineGroupKeyType(JitLlvmCodeGenContext* ctx, llvm::Module* module)
+{
+    ctx->DefineGroupKeyTypeFunc = defineFunction(
+        module, ctx->INT32_T, "DefineGroupKeyType", ctx->INT32_T, ctx->INT32_T, ctx->INT32_T, nullptr);
+}
+
+inline void DefineDefineGroupAggregateFunc(JitLlvmCodeGenContext* ctx, llvm::Module* module)
+{
+    ctx->DefineGroupAggregateFuncFunc = defineFunction(module,
+        ctx->INT32_T,
+        "DefineGroupAggregateFunc",
+        ctx->INT32_T,
+        ctx->INT32_T,
+        ctx->INT32_T,
+        ctx->INT32_T,
+        nullptr);
+}
+
+inline void DefinePrepareJoinRowCopy(JitLlvmCodeGenContext* ctx, llvm::Module* module)
+{
+    ctx->PrepareJoinRowCopyFunc = defineFunction(
+        module, ctx->INT32_T, "PrepareJoinRowCopy", ctx->INT32_T, ctx->TableType->getPointerTo(), nullptr);
+}
+
+inline void DefineCopyJoinRow(JitLlvmCodeGenContext* ctx, llvm::Module* module)
+{
+    ctx->CopyJoinRowFunc = defineFunction(
+        module, ctx->RowType->getPointerTo(), "CopyJoinRow", ctx->INT32_T, ctx->RowType->getPointerTo(), nullptr);
+}
+
+inline void DefineSetGroupKeyValue(JitLlvmCodeGenContext* ctx, llvm::Module* module)
+{
+    ctx->SetGroupKeyValueFunc = defineFunction(
+        module, ctx->VOID_T, "SetGroupKeyValue", ctx->INT32_T, ctx->DATUM_T, ctx->INT32_T, nullptr);
+}
+
+inline void DefineSetGroupAggregateValue(JitLlvmCodeGenContext* ctx, llvm::Module* module)
+{
+    ctx->SetGroupAggregateValueFunc = defineFunction(
+        module, ctx->VOID_T, "SetGroupAggregateValue", ctx->INT32_T, ctx->DATUM_T, ctx->INT32_T, nullptr);
+}
+
+inline void DefineAccumulateGroup(JitLlvmCodeGenContext* ctx, llvm::Module* module)
+{
+    ctx->AccumulateGroupFunc = defineFunction(module, ctx->INT32_T, "AccumulateGroup", nullptr);
+}
+
+inline void DefineIsGroupTableFull(JitLlvmCodeGenContext* ctx, llvm::Module* module)
+{
+    ctx->IsGroupTableFullFunc = defineFunction(module, ctx->INT32_T, "IsGroupTableFull", nullptr);
+}
+
+inline void DefineSetGroupTableReady(JitLlvmCodeGenContext* ctx, llvm::Module* module)
+{
+    ctx->SetGroupTableReadyFunc = defineFunction(module, ctx->VOID_T, "SetGroupTableReady", nullptr);
+}
+
+inline void DefineIsGroupTableReady(JitLlvmCodeGenContext* ctx, llvm::Module* module)
+{
+    ctx->IsGroupTableReadyFunc = defineFunction(module, ctx->INT32_T, "IsGroupTableReady", nullptr);
+}
+
+inline void DefineEmitNextGroup(JitLlvmCodeGenContext* ctx, llvm::Module* module)
+{
+    ctx->EmitNextGroupFunc =
+        defineFunction(module, ctx->INT32_T, "EmitNextGroup", ctx->TupleTableSlotType->getPointerTo(), nullptr);
+}
+
+inline void DefineDestroyCurrentGroupTable(JitLlvmCodeGenContext* ctx, llvm::Module* module)
+{
+    ctx->DestroyCurrentGroupTableFunc = defineFunction(module, ctx->VOID_T, "DestroyCurrentGroupTable", nullptr);
+}
+
 /*--------------------------- End of LLVM Helper Prototypes ---------------------------*/
 
 /*--------------------------- Helpers to generate calls to Helper function via LLVM ---------------------------*/
@@ -720,7 +799,7 @@ inline llvm::Value* AddReadDatumColumn(
     llvm::ConstantInt* table_colid_value = llvm::ConstantInt::get(ctx->INT32_T, table_colid, true);
     llvm::ConstantInt* arg_pos_value = llvm::ConstantInt::get(ctx->INT32_T, arg_pos, true);
     return AddFunctionCall(
-        ctx, ctx->readDatumColumnFunc, ctx->table_value, row, table_colid_value, arg_pos_value, nullptr);
+        ctx, ctx->readDatumColumnFunc, table, row, table_colid_value, arg_pos_value, nullptr);
 }
 
 /** @brief Adds a call to writeDatumColumn(table_colid, value). */
@@ -1324,6 +1403,98 @@ inline llvm::Value* AddGetSubQueryEndIteratorKey(JitLlvmCodeGenContext* ctx, int
     return AddFunctionCall(ctx, ctx->GetSubQueryEndIteratorKeyFunc, subQueryIndexValue, nullptr);
 }
 
+inline llvm::Value* AddPrepareGroupTable(
+    JitLlvmCodeGenContext* ctx, int keyCount, int aggCount, bool appendMode, int limit)
+{
+    llvm::ConstantInt* keyCountValue = llvm::ConstantInt::get(ctx->INT32_T, keyCount, true);
+    llvm::ConstantInt* aggCountValue = llvm::ConstantInt::get(ctx->INT32_T, aggCount, true);
+    llvm::ConstantInt* appendModeValue = llvm::ConstantInt::get(ctx->INT32_T, appendMode ? 1 : 0, true);
+    llvm::ConstantInt* limitValue = llvm::ConstantInt::get(ctx->INT32_T, limit, true);
+    return AddFunctionCall(
+        ctx, ctx->PrepareGroupTableFunc, keyCountValue, aggCountValue, appendModeValue, limitValue, nullptr);
+}
+
+inline llvm::Value* AddDefineGroupKeyType(JitLlvmCodeGenContext* ctx, int keyIndex, int typeOid, int tupleColumnId)
+{
+    llvm::ConstantInt* keyIndexValue = llvm::ConstantInt::get(ctx->INT32_T, keyIndex, true);
+    llvm::ConstantInt* typeOidValue = llvm::ConstantInt::get(ctx->INT32_T, typeOid, true);
+    llvm::ConstantInt* tupleColumnIdValue = llvm::ConstantInt::get(ctx->INT32_T, tupleColumnId, true);
+    return AddFunctionCall(
+        ctx, ctx->DefineGroupKeyTypeFunc, keyIndexValue, typeOidValue, tupleColumnIdValue, nullptr);
+}
+
+inline llvm::Value* AddDefineGroupAggregateFunc(
+    JitLlvmCodeGenContext* ctx, int aggIndex, int aggFuncId, int argType, int tupleColumnId)
+{
+    llvm::ConstantInt* aggIndexValue = llvm::ConstantInt::get(ctx->INT32_T, aggIndex, true);
+    llvm::ConstantInt* aggFuncIdValue = llvm::ConstantInt::get(ctx->INT32_T, aggFuncId, true);
+    llvm::ConstantInt* argTypeValue = llvm::ConstantInt::get(ctx->INT32_T, argType, true);
+    llvm::ConstantInt* tupleColumnIdValue = llvm::ConstantInt::get(ctx->INT32_T, tupleColumnId, true);
+    return AddFunctionCall(ctx,
+        ctx->DefineGroupAggregateFuncFunc,
+        aggIndexValue,
+        aggFuncIdValue,
+        argTypeValue,
+        tupleColumnIdValue,
+        nullptr);
+}
+
+inline llvm::Value* AddPrepareJoinRowCopy(JitLlvmCodeGenContext* ctx, int level, llvm::Value* table)
+{
+    llvm::ConstantInt* levelValue = llvm::ConstantInt::get(ctx->INT32_T, level, true);
+    return AddFunctionCall(ctx, ctx->PrepareJoinRowCopyFunc, levelValue, table, nullptr);
+}
+
+inline llvm::Value* AddCopyJoinRow(JitLlvmCodeGenContext* ctx, int level, llvm::Value* row)
+{
+    llvm::ConstantInt* levelValue = llvm::ConstantInt::get(ctx->INT32_T, level, true);
+    return AddFunctionCall(ctx, ctx->CopyJoinRowFunc, levelValue, row, nullptr);
+}
+
+inline void AddSetGroupKeyValue(JitLlvmCodeGenContext* ctx, int keyIndex, llvm::Value* value, int argPos)
+{
+    llvm::ConstantInt* keyIndexValue = llvm::ConstantInt::get(ctx->INT32_T, keyIndex, true);
+    llvm::ConstantInt* argPosValue = llvm::ConstantInt::get(ctx->INT32_T, argPos, true);
+    AddFunctionCall(ctx, ctx->SetGroupKeyValueFunc, keyIndexValue, value, argPosValue, nullptr);
+}
+
+inline void AddSetGroupAggregateValue(JitLlvmCodeGenContext* ctx, int aggIndex, llvm::Value* value, int argPos)
+{
+    llvm::ConstantInt* aggIndexValue = llvm::ConstantInt::get(ctx->INT32_T, aggIndex, true);
+    llvm::ConstantInt* argPosValue = llvm::ConstantInt::get(ctx->INT32_T, argPos, true);
+    AddFunctionCall(ctx, ctx->SetGroupAggregateValueFunc, aggIndexValue, value, argPosValue, nullptr);
+}
+
+inline llvm::Value* AddAccumulateGroup(JitLlvmCodeGenContext* ctx)
+{
+    return AddFunctionCall(ctx, ctx->AccumulateGroupFunc, nullptr);
+}
+
+inline llvm::Value* AddIsGroupTableFull(JitLlvmCodeGenContext* ctx)
+{
+    return AddFunctionCall(ctx, ctx->IsGroupTableFullFunc, nullptr);
+}
+
+inline void AddSetGroupTableReady(JitLlvmCodeGenContext* ctx)
+{
+    AddFunctionCall(ctx, ctx->SetGroupTableReadyFunc, nullptr);
+}
+
+inline llvm::Value* AddIsGroupTableReady(JitLlvmCodeGenContext* ctx)
+{
+    return AddFunctionCall(ctx, ctx->IsGroupTableReadyFunc, nullptr);
+}
+
+inline llvm::Value* AddEmitNextGroup(JitLlvmCodeGenContext* ctx)
+{
+    return AddFunctionCall(ctx, ctx->EmitNextGroupFunc, ctx->slot_value, nullptr);
+}
+
+inline void AddDestroyCurrentGroupTable(JitLlvmCodeGenContext* ctx)
+{
+    AddFunctionCall(ctx, ctx->DestroyCurrentGroupTableFunc, nullptr);
+}
+
 /** @brief Adds a call to issueDebugLog(function, msg). */
 #ifdef MOT_JIT_DEBUG
 inline void IssueDebugLogImpl(JitLlvmCodeGenContext* ctx, const char* function, const char* msg)
@@ -172,6 +172,20 @@ struct JitLlvmCodeGenContext {
     llvm::FunctionCallee GetSubQuerySearchKeyFunc;
     llvm::FunctionCallee GetSubQueryEndIteratorKeyFunc;
 
+    llvm::FunctionCallee PrepareGroupTableFunc;
+    llvm::FunctionCallee DefineGroupKeyTypeFunc;
+    llvm::FunctionCallee DefineGroupAggregateFuncFunc;
+    llvm::FunctionCallee PrepareJoinRowCopyFunc;
+    llvm::FunctionCallee CopyJoinRowFunc;
+    llvm::FunctionCallee SetGroupKeyValueFunc;
+    llvm::FunctionCallee SetGroupAggregateValueFunc;
+    llvm::FunctionCallee AccumulateGroupFunc;
+    llvm::FunctionCallee IsGroupTableFullFunc;
+    llvm::FunctionCallee SetGroupTableReadyFunc;
+    llvm::FunctionCallee IsGroupTableReadyFunc;
+    llvm::FunctionCallee EmitNextGroupFunc;
+    llvm::FunctionCallee DestroyCurrentGroupTableFunc;
+
     // builtins
 #define APPLY_UNARY_OPERATOR(funcid, name) llvm::FunctionCallee _builtin_##name;
 #define APPLY_BINARY_OPERATOR(funcid, name) llvm::FunctionCallee _builtin_##name;
@@ -219,6 +233,12 @@ struct JitLlvmCodeGenContext {
     uint64_t m_subQueryCount;
     SubQueryData* m_subQueryData;
 
+    // nested-loop join scan levels (the table and current row of each level)
+    int m_joinCount;
+    MOT::Table* m_joinTables[MOT_JIT_MAX_JOIN_TABLES];
+    llvm::Value* m_joinTableValues[MOT_JIT_MAX_JOIN_TABLES];
+    llvm::Value* m_joinRows[MOT_JIT_MAX_JOIN_TABLES];
+
     // compile context
     TableInfo _table_info;
     TableInfo _inner_table_info;
@@ -140,6 +140,20 @@ void InitCodeGenContextFuncs(JitLlvmCodeGenContext* ctx)
     DefineGetSubQueryIndex(ctx, module);
     DefineGetSubQuerySearchKey(ctx, module);
     DefineGetSubQueryEndIteratorKey(ctx, module);
+
+    DefinePrepareGroupTable(ctx, module);
+    DefineDefineGroupKeyType(ctx, module);
+    DefineDefineGroupAggregateFunc(ctx, module);
+    DefinePrepareJoinRowCopy(ctx, module);
+    DefineCopyJoinRow(ctx, module);
+    DefineSetGroupKeyValue(ctx, module);
+    DefineSetGroupAggregateValue(ctx, module);
+    DefineAccumulateGroup(ctx, module);
+    DefineIsGroupTableFull(ctx, module);
+    DefineSetGroupTableReady(ctx, module);
+    DefineIsGroupTableReady(ctx, module);
+    DefineEmitNextGroup(ctx, module);
+    DefineDestroyCurrentGroupTable(ctx, module);
 }
 
 #define APPLY_UNARY_OPERATOR(funcid, name)                                                              \
@@ -1944,6 +1958,368 @@ static JitContext* JitPointQueryCodegen(Query* query, const char* query_string,
     return jit_context;
 }
 
+/** @brief Initializes a context for compiling a nested-loop plan (scans beyond the inner one use sub-query data). */
+static bool InitNestedLoopCodeGenContext(
+    JitLlvmCodeGenContext* ctx, GsCodeGen* code_gen, GsCodeGen::LlvmBuilder* builder, JitNestedLoopPlan* plan)
+{
+    MOT::Table* table = plan->_scans[0]._table;
+    MOT::Index* index = table->GetIndex(plan->_scans[0]._index_id);
+    MOT::Table* innerTable = nullptr;
+    MOT::Index* innerIndex = nullptr;
+    if (plan->_scan_count > 1) {
+        innerTable = plan->_scans[1]._table;
+        innerIndex = innerTable->GetIndex(plan->_scans[1]._index_id);
+    }
+    if (!InitCodeGenContext(ctx, code_gen, builder, table, index, innerTable, innerIndex)) {
+        return false;
+    }
+
+    ctx->m_joinCount = plan->_scan_count;
+    for (int i = 0; i < plan->_scan_count; ++i) {
+        ctx->m_joinTables[i] = plan->_scans[i]._table;
+    }
+    if (plan->_scan_count <= 2) {
+        return true;
+    }
+
+    // prepare sub-query table info for the scans of the third level and beyond
+    uint32_t subQueryCount = (uint32_t)(plan->_scan_count - 2);
+    uint32_t allocSize = sizeof(TableInfo) * subQueryCount;
+    ctx->m_subQueryTableInfo = (TableInfo*)MOT::MemSessionAlloc(allocSize);
+    if (ctx->m_subQueryTableInfo == nullptr) {
+        MOT_REPORT_ERROR(MOT_ERROR_OOM,
+            "JIT Compile",
+            "Failed to allocate %u bytes for %u join scan table information objects in code-generation context",
+            allocSize,
+            subQueryCount);
+        DestroyCodeGenContext(ctx);
+        return false;
+    }
+    errno_t erc = memset_s(ctx->m_subQueryTableInfo, allocSize, 0, allocSize);
+    securec_check(erc, "\0", "\0");
+    ctx->m_subQueryCount = subQueryCount;
+
+    for (uint32_t i = 0; i < subQueryCount; ++i) {
+        JitIndexScan* indexScan = &plan->_scans[i + 2];
+        MOT::Table* subTable = indexScan->_table;
+        if (!InitTableInfo(&ctx->m_subQueryTableInfo[i], subTable, subTable->GetIndex(indexScan->_index_id))) {
+            MOT_REPORT_ERROR(MOT_ERROR_OOM,
+                "JIT Compile",
+                "Failed to initialize join scan table information for code-generation context");
+            DestroyCodeGenContext(ctx);
+            return false;
+        }
+    }
+
+    // prepare sub-query data array (for join scan runtime context)
+    allocSize = sizeof(JitLlvmCodeGenContext::SubQueryData) * subQueryCount;
+    ctx->m_subQueryData = (JitLlvmCodeGenContext::SubQueryData*)MOT::MemSessionAlloc(allocSize);
+    if (ctx->m_subQueryData == nullptr) {
+        MOT_REPORT_ERROR(MOT_ERROR_OOM,
+            "JIT Compile",
+            "Failed to allocate %u bytes for %u join scan data items in code-generation context",
+            allocSize,
+            subQueryCount);
+        DestroyCodeGenContext(ctx);
+        return false;
+    }
+    erc = memset_s(ctx->m_subQueryData, allocSize, 0, allocSize);
+    securec_check(erc, "\0", "\0");
+
+    return true;
+}
+
+/** @brief Retrieves the range scan type used by a nested-loop level. */
+static JitRangeScanType GetNestedLoopScanType(int level, int* subQueryIndex)
+{
+    *subQueryIndex = -1;
+    if (level == 0) {
+        return JIT_RANGE_SCAN_MAIN;
+    } else if (level == 1) {
+        return JIT_RANGE_SCAN_INNER;
+    }
+    *subQueryIndex = level - 2;
+    return JIT_RANGE_SCAN_SUB_QUERY;
+}
+
+/** @brief Emits code that reads a column of the current row of the nested-loop level that scans its table. */
+static llvm::Value* ReadNestedLoopColumn(JitLlvmCodeGenContext* ctx, MOT::Table* table, int columnId)
+{
+    for (int level = 0; level < ctx->m_joinCount; ++level) {
+        if (ctx->m_joinTables[level] == table) {
+            return AddReadDatumColumn(ctx, ctx->m_joinTableValues[level], ctx->m_joinRows[level], columnId, 0);
+        }
+    }
+    MOT_LOG_TRACE("Column %d refers to table %s which is not scanned by the nested loop",
+        columnId,
+        table->GetTableName().c_str());
+    return nullptr;
+}
+
+/** @brief Emits code that returns an error from the jitted function if a group table operation failed. */
+static void buildCheckGroupTableResult(JitLlvmCodeGenContext* ctx, llvm::Value* res)
+{
+    JIT_IF_BEGIN(group_table_op_failed)
+    JIT_IF_EVAL_NOT(res)
+    IssueDebugLog("Failed to prepare group table");
+    AddDestroyCurrentGroupTable(ctx);
+    JIT_RETURN_CONST(MOT::RC_MEMORY_ALLOCATION_ERROR);
+    JIT_IF_END()
+}
+
+/** @brief Emits code that feeds the current joined row into the group table (innermost loop body). */
+static bool buildNestedLoopAccumulate(JitLlvmCodeGenContext* ctx, JitNestedLoopPlan* plan,
+    JitLlvmRuntimeCursor* cursors, llvm::BasicBlock* outerLoopEndBlock)
+{
+    JitSelectExprArray* keys = plan->_grouped ? &plan->_group_by._group_exprs : &plan->_select_exprs;
+    for (int i = 0; i < keys->_count; ++i) {
+        JitVarExpr* columnExpr = keys->_exprs[i]._column_expr;
+        llvm::Value* value = ReadNestedLoopColumn(ctx, columnExpr->_table, columnExpr->_column_id);
+        if (value == nullptr) {
+            return false;
+        }
+        AddSetGroupKeyValue(ctx, i, value, 0);
+    }
+
+    if (plan->_grouped) {
+        for (int i = 0; i < plan->_group_by._aggregate_count; ++i) {
+            JitAggregate* aggregate = &plan->_group_by._aggregates[i]._aggregate;
+            if (aggregate->_table == nullptr) {
+                continue;  // COUNT(*) has no argument
+            }
+            llvm::Value* value = ReadNestedLoopColumn(ctx, aggregate->_table, aggregate->_table_column_id);
+            if (value == nullptr) {
+                return false;
+            }
+            AddSetGroupAggregateValue(ctx, i, value, 0);
+        }
+    }
+
+    JIT_IF_BEGIN(accumulate_group)
+    llvm::Value* res = AddAccumulateGroup(ctx);
+    JIT_IF_EVAL_NOT(res)
+    IssueDebugLog("Failed to accumulate row into group table");
+    for (int level = 0; level < plan->_scan_count; ++level) {
+        AddDestroyCursor(ctx, &cursors[level]);
+    }
+    AddDestroyCurrentGroupTable(ctx);
+    JIT_RETURN_CONST(MOT::RC_MEMORY_ALLOCATION_ERROR);
+    JIT_IF_END()
+
+    // a plain join with a limit clause stops scanning as soon as enough rows were collected
+    if (!plan->_grouped && (plan->_limit_count > 0)) {
+        JIT_IF_BEGIN(group_table_full)
+        llvm::Value* isFull = AddIsGroupTableFull(ctx);
+        JIT_IF_EVAL(isFull)
+        IssueDebugLog("Reached limit specified in limit clause, stopping nested loop");
+        for (int level = 1; level < plan->_scan_count; ++level) {
+            AddDestroyCursor(ctx, &cursors[level]);
+        }
+        JIT_GOTO(outerLoopEndBlock);  // break out of all loops, outermost cursor is destroyed there
+        JIT_IF_END()
+    }
+    return true;
+}
+
+/** @brief Emits the loop of one nested-loop level, and recursively the loops of all deeper levels. */
+static bool buildNestedLoopLevel(JitLlvmCodeGenContext* ctx, JitNestedLoopPlan* plan, int level,
+    MOT::AccessType accessMode, JitLlvmRuntimeCursor* cursors, llvm::BasicBlock* outerLoopEndBlock, int* maxArg)
+{
+    JitIndexScan* indexScan = &plan->_scans[level];
+    int subQueryIndex = -1;
+    JitRangeScanType rangeScanType = GetNestedLoopScanType(level, &subQueryIndex);
+    llvm::Value* outerRow = (level > 0) ? ctx->m_joinRows[level - 1] : nullptr;
+
+    MOT_LOG_DEBUG("Generating level %d loop cursor for nested-loop query", level);
+    cursors[level] =
+        buildRangeCursor(ctx, indexScan, maxArg, rangeScanType, JIT_INDEX_SCAN_FORWARD, outerRow, subQueryIndex);
+    if (cursors[level].begin_itr == nullptr) {
+        MOT_LOG_TRACE("Failed to generate jitted code for nested-loop query: unsupported level %d WHERE clause", level);
+        return false;
+    }
+
+    JIT_WHILE_BEGIN(cursor_nested_loop)
+    if (level == 0) {
+        outerLoopEndBlock = JIT_WHILE_POST_BLOCK();
+    }
+    llvm::Value* res = AddIsScanEnd(ctx, JIT_INDEX_SCAN_FORWARD, &cursors[level], rangeScanType, subQueryIndex);
+    JIT_WHILE_EVAL_NOT(res)
+    llvm::Value* row = buildGetRowFromIterator(ctx,
+        JIT_WHILE_POST_BLOCK(),
+        accessMode,
+        JIT_INDEX_SCAN_FORWARD,
+        &cursors[level],
+        rangeScanType,
+        subQueryIndex);
+    ctx->m_joinRows[level] = row;
+
+    // check for additional filters and join predicates, if not try to fetch next row
+    if (!buildFilterRow(ctx, row, &indexScan->_filters, maxArg, JIT_WHILE_COND_BLOCK())) {
+        MOT_LOG_TRACE("Failed to generate jitted code for nested-loop query: unsupported level %d filter", level);
+        return false;
+    }
+
+    bool result = false;
+    if (level < (plan->_scan_count - 1)) {
+        // lookups of deeper levels overwrite the row buffer, so we continue with a safe copy of this row
+        ctx->m_joinRows[level] = AddCopyJoinRow(ctx, level, row);
+        result = buildNestedLoopLevel(ctx, plan, level + 1, accessMode, cursors, outerLoopEndBlock, maxArg);
+    } else {
+        result = buildNestedLoopAccumulate(ctx, plan, cursors, outerLoopEndBlock);
+    }
+    if (!result) {
+        return false;
+    }
+    JIT_WHILE_END()
+
+    // cleanup
+    IssueDebugLog("Reached end of nested loop level");
+    AddDestroyCursor(ctx, &cursors[level]);
+    ctx->m_joinRows[level] = nullptr;
+    return true;
+}
+
+/** @brief Emits code that defines the keys and aggregates of the group table. */
+static void buildDefineGroupTable(JitLlvmCodeGenContext* ctx, JitNestedLoopPlan* plan)
+{
+    llvm::Value* res = nullptr;
+    if (plan->_grouped) {
+        JitGroupBy* groupBy = &plan->_group_by;
+        res = AddPrepareGroupTable(
+            ctx, groupBy->_group_exprs._count, groupBy->_aggregate_count, false, plan->_limit_count);
+        buildCheckGroupTableResult(ctx, res);
+        for (int i = 0; i < groupBy->_group_exprs._count; ++i) {
+            JitSelectExpr* groupExpr = &groupBy->_group_exprs._exprs[i];
+            res = AddDefineGroupKeyType(
+                ctx, i, groupExpr->_column_expr->_column_type, groupExpr->_tuple_column_id);
+            buildCheckGroupTableResult(ctx, res);
+        }
+        for (int i = 0; i < groupBy->_aggregate_count; ++i) {
+            JitGroupAggregate* groupAggregate = &groupBy->_aggregates[i];
+            res = AddDefineGroupAggregateFunc(ctx,
+                i,
+                groupAggregate->_aggregate._func_id,
+                groupAggregate->_arg_type,
+                groupAggregate->_tuple_column_id);
+            buildCheckGroupTableResult(ctx, res);
+        }
+    } else {
+        // a plain join collects the selected columns of each joined row in order
+        res = AddPrepareGroupTable(ctx, plan->_select_exprs._count, 0, true, plan->_limit_count);
+        buildCheckGroupTableResult(ctx, res);
+        for (int i = 0; i < plan->_select_exprs._count; ++i) {
+            JitSelectExpr* selectExpr = &plan->_select_exprs._exprs[i];
+            res = AddDefineGroupKeyType(
+                ctx, i, selectExpr->_column_expr->_column_type, selectExpr->_tuple_column_id);
+            buildCheckGroupTableResult(ctx, res);
+        }
+    }
+
+    // outer scan levels need a safe row copy
+    for (int level = 0; level < (plan->_scan_count - 1); ++level) {
+        res = AddPrepareJoinRowCopy(ctx, level, ctx->m_joinTableValues[level]);
+        buildCheckGroupTableResult(ctx, res);
+    }
+}
+
+/** @brief Generates code for a multi-table join or a GROUP BY query executed as nested loops. */
+static JitContext* JitNestedLoopCodegen(Query* query, const char* query_string, JitNestedLoopPlan* plan)
+{
+    // our strategy is as follows:
+    // 1. on first call, all loops are executed and each joined row is accumulated into a session-local group table
+    //    (grouped by key values, or appended as is in a plain join)
+    // 2. each call (including the first one) emits the next group from the table into the result tuple
+    MOT_LOG_DEBUG("Generating code for MOT nested-loop query at thread %p", (void*)pthread_self());
+
+    GsCodeGen* codeGen = SetupCodegenEnv();
+    if (codeGen == nullptr) {
+        return nullptr;
+    }
+    GsCodeGen::LlvmBuilder builder(codeGen->context());
+
+    JitLlvmCodeGenContext cg_ctx = {0};
+    if (!InitNestedLoopCodeGenContext(&cg_ctx, codeGen, &builder, plan)) {
+        return nullptr;
+    }
+    JitLlvmCodeGenContext* ctx = &cg_ctx;
+
+    // prepare the jitted function (declare, get arguments into context and define locals)
+    CreateJittedFunction(ctx, "MotJittedNestedLoop");
+    IssueDebugLog("Starting execution of jitted nested-loop query");
+    for (int level = 0; level < plan->_scan_count; ++level) {
+        if (level == 0) {
+            ctx->m_joinTableValues[level] = ctx->table_value;
+        } else if (level == 1) {
+            ctx->m_joinTableValues[level] = ctx->inner_table_value;
+        } else {
+            ctx->m_joinTableValues[level] = ctx->m_subQueryData[level - 2].m_table;
+        }
+    }
+
+    // initialize rows_processed local variable
+    buildResetRowsProcessed(ctx);
+
+    // a new scan discards the groups of the previous one
+    JIT_IF_BEGIN(cleanup_old_groups)
+    JIT_IF_EVAL(ctx->isNewScanValue)
+    IssueDebugLog("Destroying group table due to new scan");
+    AddDestroyCurrentGroupTable(ctx);
+    JIT_IF_END()
+
+    // materialize all groups if not done so already
+    int max_arg = 0;
+    MOT::AccessType accessMode = query->hasForUpdate ? MOT::AccessType::RD_FOR_UPDATE : MOT::AccessType::RD;
+    JitLlvmRuntimeCursor cursors[MOT_JIT_MAX_JOIN_TABLES];
+    JIT_IF_BEGIN(materialize_groups)
+    llvm::Value* isReady = AddIsGroupTableReady(ctx);
+    JIT_IF_EVAL_NOT(isReady)
+    IssueDebugLog("Materializing group table");
+    buildDefineGroupTable(ctx, plan);
+    if (!buildNestedLoopLevel(ctx, plan, 0, accessMode, cursors, nullptr, &max_arg)) {
+        MOT_LOG_TRACE("Failed to generate jitted code for nested-loop query: failed to generate loops");
+        DestroyCodeGenContext(ctx);
+        return nullptr;
+    }
+    AddSetGroupTableReady(ctx);
+    JIT_IF_END()
+
+    // emit next group into the result tuple
+    AddExecClearTuple(ctx);
+    JIT_IF_BEGIN(emit_next_group)
+    llvm::Value* emitted = AddEmitNextGroup(ctx);
+    JIT_IF_EVAL_NOT(emitted)
+    IssueDebugLog("All groups emitted, scan ended");
+    AddDestroyCurrentGroupTable(ctx);
+    AddSetTpProcessed(ctx);
+    AddSetScanEnded(ctx, 1);
+    JIT_RETURN_CONST(MOT::RC_LOCAL_ROW_NOT_FOUND);
+    JIT_IF_END()
+
+    AddExecStoreVirtualTuple(ctx);
+    buildIncrementRowsProcessed(ctx);
+
+    // execute *tp_processed = rows_processed
+    AddSetTpProcessed(ctx);
+
+    // return success from calling function
+    builder.CreateRet(llvm::ConstantInt::get(ctx->INT32_T, (int)MOT::RC_OK, true));
+
+    // wrap up
+    JitContext* jitContext = FinalizeCodegen(ctx, max_arg, plan->_command_type);
+
+    // prepare join scan data in resulting JIT context (for later execution)
+    if ((jitContext != nullptr) && !PrepareJoinScanData(jitContext, plan)) {
+        MOT_LOG_TRACE("Failed to prepare join scan data in JIT context object");
+        DestroyJitContext(jitContext);
+        jitContext = nullptr;
+    }
+
+    // cleanup
+    DestroyCodeGenContext(ctx);
+
+    return jitContext;
+}
+
 JitContext* JitCodegenLlvmQuery(Query* query, const char* query_string, JitPlan* plan)
 {
     JitContext* jit_context = nullptr;
@@ -1971,6 +2347,10 @@ JitContext* JitCodegenLlvmQuery(Query* query, const char* query_string, JitPlan*
             jit_context = JitCompoundCodegen(query, query_string, (JitCompoundPlan*)plan);
             break;
 
+        case JIT_PLAN_NESTED_LOOP:
+            jit_context = JitNestedLoopCodegen(query, query_string, (JitNestedLoopPlan*)plan);
+            break;
+
         default:
             MOT_REPORT_ERROR(
                 MOT_ERROR_INTERNAL, "Generate JIT Code", "Invalid JIT plan type %d", (int)plan->_plan_type);
@@ -33,6 +33,7 @@
 #include "utilities.h"
 #include "nodes/pg_list.h"
 #include "catalog/pg_aggregate.h"
+#include "utils/typcache.h"
 
 #include <algorithm>
 
@@ -86,7 +87,8 @@ static bool countWhereClauseEqualsLeaves(Query* query, MOT::Table* table, MOT::I
         return false;                                                            \
     }
 
-static bool CheckQueryAttributes(const Query* query, bool allowSorting, bool allowAggregate, bool allowSublink)
+static bool CheckQueryAttributes(
+    const Query* query, bool allowSorting, bool allowAggregate, bool allowSublink, bool allowGrouping = false)
 {
     checkJittableAttribute(query, hasWindowFuncs);
     checkJittableAttribute(query, hasDistinctOn);
@@ -94,7 +96,6 @@ static bool CheckQueryAttributes(const Query* query, bool allowSorting, bool all
     checkJittableAttribute(query, hasModifyingCTE);
 
     checkJittableClause(query, returningList);
-    checkJittableClause(query, groupClause);
     checkJittableClause(query, groupingSets);
     checkJittableClause(query, havingQual);
     checkJittableClause(query, windowClause);
@@ -114,6 +115,10 @@ static bool CheckQueryAttributes(const Query* query, bool allowSorting, bool all
         checkJittableAttribute(query, hasSubLinks);
     }
 
+    if (!allowGrouping) {
+        checkJittableClause(query, groupClause);
+    }
+
     return true;
 }
 
@@ -336,6 +341,12 @@ static void freeFilterArray(JitFilterArray* filter_array)
     }
 }
 
+static void freeIndexScan(JitIndexScan* index_scan)
+{
+    freeExprArray(&index_scan->_search_exprs);
+    freeFilterArray(&index_scan->_filters);
+}
+
 static bool getFilters(Query* query, MOT::Table* table, MOT::Index* index, JitFilterArray* filter_array, int* count,
     JitColumnExprArray* pkey_exprs)
 {
@@ -801,11 +812,16 @@ static bool getAggregateOperator(Query* query, JitAggregate* aggregate)
     return result;
 }
 
+static double evaluateIndexScan(const JitIndexScan* index_scan)
+{
+    // currently the value of a range scan is how much it matches the used index
+    MOT::Index* index = index_scan->_table->GetIndex(index_scan->_index_id);
+    return ((double)index_scan->_column_count) / ((double)index->GetNumFields());
+}
+
 static double evaluatePlan(const JitRangeSelectPlan* plan)
 {
-    // currently the value of a range scan plan is how much it matches the used index
-    MOT::Index* index = plan->_index_scan._table->GetIndex(plan->_index_scan._index_id);
-    return ((double)plan->_index_scan._column_count) / ((double)index->GetNumFields());
+    return evaluateIndexScan(&plan->_index_scan);
 }
 
 static bool isJitPlanBetter(JitRangeSelectPlan* candidate_plan, JitRangeSelectPlan* current_plan)
@@ -958,6 +974,10 @@ static JitRangeScanPlan* JitPrepareRangeScanPlan(Query* query, MOT::Table* table
         table->GetTableName().c_str(),
         index_id,
         index->GetName().c_str());
+    if (index->GetIndexingMethod() != MOT::IndexingMethod::INDEXING_METHOD_TREE) {
+        MOT_LOG_TRACE("Disqualifying plan - index %s does not support range scans", index->GetName().c_str());
+        return nullptr;
+    }
     JitRangeScanPlan* plan = (JitRangeScanPlan*)MOT::MemSessionAlloc(alloc_size);
     if (plan == nullptr) {
         MOT_REPORT_ERROR(MOT_ERROR_OOM,
@@ -1033,6 +1053,10 @@ static JitPlan* JitPrepareRangeSelectPlan(Query* query, MOT::Table* table, JoinC
     size_t alloc_size = sizeof(JitRangeSelectPlan);
 
     for (int index_id = 0; index_id < (int)table->GetNumIndexes(); ++index_id) {
+        if (table->GetIndex(index_id)->GetIndexingMethod() != MOT::IndexingMethod::INDEXING_METHOD_TREE) {
+            MOT_LOG_TRACE("Skipping hash index %d for range select plan", index_id);
+            continue;
+        }
         MOT_LOG_TRACE("Attempting to prepare plan with index %d", index_id);
         JitRangeSelectPlan* next_plan = (JitRangeSelectPlan*)JitPrepareRangeScanPlan(
             query, table, index_id, alloc_size, JIT_COMMAND_SELECT, join_clause_type);
@@ -1434,6 +1458,403 @@ static JitPlan* JitPrepareJoinPlan(Query* query)
     return plan;
 }
 
+static int getAggregateTargetEntryCount(const Query* query)
+{
+    int count = 0;
+    ListCell* lc = nullptr;
+
+    foreach (lc, query->targetList) {
+        TargetEntry* target_entry = (TargetEntry*)lfirst(lc);
+        if (!target_entry->resjunk && (target_entry->expr->type == T_Aggref)) {
+            ++count;
+        }
+    }
+    return count;
+}
+
+static bool isNestedLoopQuery(const Query* query)
+{
+    if ((query->commandType != CMD_SELECT) || query->hasSubLinks) {
+        return false;
+    }
+
+    // explicit JOIN clauses are handled by the two-table join plan
+    ListCell* lc = nullptr;
+    foreach (lc, query->rtable) {
+        RangeTblEntry* rte = (RangeTblEntry*)lfirst(lc);
+        if (rte->rtekind != RTE_RELATION) {
+            return false;
+        }
+    }
+
+    // a join of more than two tables, any GROUP BY query, and any query with more than one aggregate
+    int table_count = list_length(query->rtable);
+    return (table_count > 2) || (query->groupClause != nullptr) || (getAggregateTargetEntryCount(query) > 1);
+}
+
+static bool getNestedLoopTables(const Query* query, MOT::Table** tables, int* table_count)
+{
+    *table_count = list_length(query->rtable);
+    if (*table_count > MOT_JIT_MAX_JOIN_TABLES) {
+        MOT_LOG_TRACE("Query is not jittable - nested-loop join of %d tables exceeds the maximum of %d",
+            *table_count,
+            MOT_JIT_MAX_JOIN_TABLES);
+        return false;
+    }
+
+    // every table must be listed as-is in the FROM clause (implicit join)
+    if (list_length(query->jointree->fromlist) != *table_count) {
+        MOT_LOG_TRACE("Query is not jittable - unsupported nested-loop JOIN format");
+        return false;
+    }
+    ListCell* lc = nullptr;
+    foreach (lc, query->jointree->fromlist) {
+        Node* from_node = (Node*)lfirst(lc);
+        if (from_node->type != T_RangeTblRef) {
+            MOT_LOG_TRACE("Query is not jittable - unsupported FROM clause item type %d", (int)from_node->type);
+            return false;
+        }
+    }
+
+    // the loops are nested in range table order
+    int i = 0;
+    foreach (lc, query->rtable) {
+        RangeTblEntry* rte = (RangeTblEntry*)lfirst(lc);
+        MOT::Table* table = MOT::GetTableManager()->GetTableByExternal(rte->relid);
+        if (table == nullptr) {
+            MOT_LOG_TRACE("Query is not jittable - failed to retrieve table %d of nested-loop JOIN", i);
+            return false;
+        }
+        for (int j = 0; j < i; ++j) {
+            if (tables[j] == table) {
+                MOT_LOG_TRACE("Query is not jittable - self JOIN on table %s", table->GetTableName().c_str());
+                return false;
+            }
+        }
+        tables[i++] = table;
+    }
+    return true;
+}
+
+static bool prepareJoinFilters(Query* query, MOT::Table** tables, int level, JitIndexScan* index_scan)
+{
+    // count join predicates evaluated at this level, which are not used to search the index
+    int join_filter_count = 0;
+    FilterCounter filter_counter(&join_filter_count);
+    if (!visitJoinFilterExpressions(query, tables, level, &index_scan->_search_exprs, &filter_counter)) {
+        MOT_LOG_TRACE("Failed to count join filters at level %d", level);
+        return false;
+    }
+    if (join_filter_count == 0) {
+        return true;
+    }
+
+    // append join filters to the filters of the scanned table
+    int filter_count = (index_scan->_filters._scan_filters != nullptr) ? index_scan->_filters._filter_count : 0;
+    JitFilterArray filters = {nullptr, 0};
+    if (!allocFilterArray(&filters, filter_count + join_filter_count)) {
+        MOT_LOG_TRACE("Failed to allocate filter array with %d items", filter_count + join_filter_count);
+        return false;
+    }
+    if (filter_count > 0) {
+        size_t copy_size = sizeof(JitFilter) * filter_count;
+        errno_t erc = memcpy_s(filters._scan_filters, copy_size, index_scan->_filters._scan_filters, copy_size);
+        securec_check(erc, "\0", "\0");
+    }
+
+    int collected_count = filter_count;
+    FilterCollector filter_collector(query, &filters, &collected_count);
+    if (!visitJoinFilterExpressions(query, tables, level, &index_scan->_search_exprs, &filter_collector)) {
+        MOT_LOG_TRACE("Failed to collect join filters at level %d", level);
+        MOT::MemSessionFree(filters._scan_filters);
+        return false;
+    }
+    MOT_LOG_TRACE("Collected %d join filters at level %d", collected_count - filter_count, level);
+    filters._filter_count = collected_count;
+
+    if (index_scan->_filters._scan_filters != nullptr) {
+        MOT::MemSessionFree(index_scan->_filters._scan_filters);
+    }
+    index_scan->_filters = filters;
+    return true;
+}
+
+static bool prepareNestedLoopIndexScan(
+    Query* query, MOT::Table** tables, int level, MOT::Index* index, JitIndexScan* index_scan)
+{
+    MOT::Table* table = tables[level];
+    int expr_count = index->GetNumFields() + 1;  // could be an open scan
+    if (!allocExprArray(&index_scan->_search_exprs, expr_count)) {
+        MOT_LOG_TRACE("Failed to allocate expression array with %d items", expr_count);
+        return false;
+    }
+
+    // search expressions may refer only to this table and tables of enclosing loops
+    JoinClauseType join_clause_type = (level > 0) ? JoinClauseImplicit : JoinClauseNone;
+    if (!getRangeSearchExpressions(query, table, index, index_scan, join_clause_type, tables, level + 1)) {
+        MOT_LOG_TRACE("Failed to collect range search expressions");
+        return false;
+    }
+    if (index_scan->_scan_type == JIT_INDEX_SCAN_TYPE_INVALID) {
+        MOT_LOG_TRACE("Disqualifying index %s - invalid range scan type", index->GetName().c_str());
+        return false;
+    }
+
+    if (!prepareFilters(query, table, index, &index_scan->_filters, &index_scan->_search_exprs)) {
+        MOT_LOG_TRACE("Failed to prepare filters");
+        return false;
+    }
+    if ((level > 0) && !prepareJoinFilters(query, tables, level, index_scan)) {
+        MOT_LOG_TRACE("Failed to prepare join filters");
+        return false;
+    }
+
+    // results are materialized anyway, so there is no point in following any specific order
+    index_scan->_sort_order = JIT_QUERY_SORT_ASCENDING;
+    index_scan->_scan_direction = JIT_INDEX_SCAN_FORWARD;
+    return true;
+}
+
+static bool prepareNestedLoopScan(Query* query, MOT::Table** tables, int level, JitIndexScan* index_scan)
+{
+    MOT::Table* table = tables[level];
+    MOT_LOG_TRACE("Preparing nested-loop scan at level %d on table %s", level, table->GetTableName().c_str());
+
+    bool found = false;
+    for (int index_id = 0; index_id < (int)table->GetNumIndexes(); ++index_id) {
+        MOT::Index* index = table->GetIndex(index_id);
+        if (index->GetIndexingMethod() != MOT::IndexingMethod::INDEXING_METHOD_TREE) {
+            MOT_LOG_TRACE("Skipping hash index %d for nested-loop scan", index_id);
+            continue;
+        }
+
+        JitIndexScan candidate_scan;
+        errno_t erc = memset_s(&candidate_scan, sizeof(JitIndexScan), 0, sizeof(JitIndexScan));
+        securec_check(erc, "\0", "\0");
+        candidate_scan._table = table;
+        candidate_scan._index_id = index_id;
+        if (!prepareNestedLoopIndexScan(query, tables, level, index, &candidate_scan)) {
+            MOT_LOG_TRACE("Failed to prepare nested-loop scan with index %d", index_id);
+            freeIndexScan(&candidate_scan);
+            continue;
+        }
+
+        if (!found) {
+            MOT_LOG_TRACE("Using initial scan with index %d (%s)", index_id, index->GetName().c_str());
+            *index_scan = candidate_scan;
+            found = true;
+        } else if (evaluateIndexScan(&candidate_scan) > evaluateIndexScan(index_scan)) {
+            MOT_LOG_TRACE("Scan with index %d (%s) is better than previous scan", index_id, index->GetName().c_str());
+            freeIndexScan(index_scan);
+            *index_scan = candidate_scan;
+        } else {
+            freeIndexScan(&candidate_scan);
+        }
+    }
+
+    if (!found) {
+        MOT_LOG_TRACE("Failed to prepare nested-loop scan at level %d", level);
+    }
+    return found;
+}
+
+static bool getGroupAggregate(Query* query, TargetEntry* target_entry, JitGroupAggregate* group_aggregate)
+{
+    Aggref* agg_ref = (Aggref*)target_entry->expr;
+    if ((agg_ref->aggorder != nullptr) || (agg_ref->aggdistinct != nullptr)) {
+        MOT_LOG_TRACE("getGroupAggregate(): Unsupported aggregate operator with ORDER BY or DISTINCT specifiers");
+        return false;
+    } else if (agg_ref->agglevelsup != 0) {
+        MOT_LOG_TRACE("getGroupAggregate(): Unsupported outer-level aggregate");
+        return false;
+    } else if (!isValidAggregateFunction(agg_ref->aggfnoid)) {
+        MOT_LOG_TRACE("getGroupAggregate(): Unsupported aggregate operator %d", agg_ref->aggfnoid);
+        return false;
+    } else if (!IsTypeSupported(agg_ref->aggtype)) {
+        MOT_LOG_TRACE("getGroupAggregate(): Unsupported aggregate result type %d", agg_ref->aggtype);
+        return false;
+    }
+
+    JitAggregate* aggregate = &group_aggregate->_aggregate;
+    aggregate->_aggreaget_op = classifyAggregateOperator(agg_ref->aggfnoid);
+    aggregate->_func_id = agg_ref->aggfnoid;
+    aggregate->_element_type = agg_ref->aggtype;
+    aggregate->_avg_element_type = -1;
+    aggregate->_distinct = false;
+    group_aggregate->_tuple_column_id = target_entry->resno - 1;
+
+    if (agg_ref->args == nullptr) {  // COUNT(*)
+        if (aggregate->_aggreaget_op != JIT_AGGREGATE_COUNT) {
+            MOT_LOG_TRACE("getGroupAggregate(): Unsupported aggregate operator %d without arguments", agg_ref->aggfnoid);
+            return false;
+        }
+        aggregate->_table = nullptr;
+        aggregate->_table_column_id = -1;
+        group_aggregate->_arg_type = InvalidOid;
+        return true;
+    }
+
+    if (list_length(agg_ref->args) != 1) {
+        MOT_LOG_TRACE("getGroupAggregate(): Unsupported aggregate argument list with length unequal to 1");
+        return false;
+    }
+    TargetEntry* sub_te = (TargetEntry*)linitial(agg_ref->args);
+    if (sub_te->expr->type != T_Var) {
+        MOT_LOG_TRACE("getGroupAggregate(): Unsupported aggregate operator with non-column argument");
+        return false;
+    }
+    Var* var_expr = (Var*)sub_te->expr;
+    if (!IsTypeSupported(var_expr->vartype)) {
+        MOT_LOG_TRACE("getGroupAggregate(): Unsupported aggregate operator with column type %d", var_expr->vartype);
+        return false;
+    }
+    aggregate->_table = getRealTable(query, var_expr->varno, var_expr->varattno);
+    if (aggregate->_table == nullptr) {
+        MOT_LOG_TRACE("getGroupAggregate(): Failed to retrieve aggregated column table");
+        return false;
+    }
+    aggregate->_table_column_id = getRealColumnId(query, var_expr->varno, var_expr->varattno, aggregate->_table);
+    if (aggregate->_table_column_id < 0) {
+        MOT_LOG_TRACE("getGroupAggregate(): Failed to retrieve aggregated column id");
+        return false;
+    }
+    group_aggregate->_arg_type = var_expr->vartype;
+    return true;
+}
+
+static bool prepareGroupBy(Query* query, JitGroupBy* group_by)
+{
+    // prepare grouping columns, which must be hashable
+    int key_count = list_length(query->groupClause);
+    if (key_count > 0) {
+        if (!allocSelectExprArray(&group_by->_group_exprs, key_count)) {
+            MOT_LOG_TRACE("Failed to allocate group expression array with %d items", key_count);
+            return false;
+        }
+        if (!getGroupExpressions(query, &group_by->_group_exprs)) {
+            MOT_LOG_TRACE("Failed to collect group expressions");
+            return false;
+        }
+        for (int i = 0; i < key_count; ++i) {
+            Oid key_type = (Oid)group_by->_group_exprs._exprs[i]._column_expr->_column_type;
+            TypeCacheEntry* type_entry = lookup_type_cache(key_type, TYPECACHE_HASH_PROC | TYPECACHE_EQ_OPR);
+            if (!OidIsValid(type_entry->hash_proc) || !OidIsValid(type_entry->eq_opr)) {
+                MOT_LOG_TRACE("Disqualifying query - group column type %u cannot be hashed", key_type);
+                return false;
+            }
+        }
+    }
+
+    // each result column is either an aggregate or a grouping column
+    ListCell* lc = nullptr;
+    foreach (lc, query->targetList) {
+        TargetEntry* target_entry = (TargetEntry*)lfirst(lc);
+        if (target_entry->resjunk || (target_entry->expr->type == T_Aggref)) {
+            continue;
+        }
+        if ((target_entry->expr->type != T_Var) || (target_entry->ressortgroupref == 0)) {
+            MOT_LOG_TRACE("Disqualifying query - result column %d is neither an aggregate nor a group column",
+                target_entry->resno);
+            return false;
+        }
+    }
+
+    // prepare aggregates
+    int aggregate_count = getAggregateTargetEntryCount(query);
+    if (aggregate_count > MOT_JIT_MAX_AGGREGATES) {
+        MOT_LOG_TRACE("Disqualifying query - %d aggregates exceed the maximum of %d",
+            aggregate_count,
+            MOT_JIT_MAX_AGGREGATES);
+        return false;
+    }
+    if (aggregate_count > 0) {
+        size_t alloc_size = sizeof(JitGroupAggregate) * aggregate_count;
+        group_by->_aggregates = (JitGroupAggregate*)MOT::MemSessionAlloc(alloc_size);
+        if (group_by->_aggregates == nullptr) {
+            MOT_REPORT_ERROR(MOT_ERROR_OOM,
+                "Prepare JIT plan",
+                "Failed to allocate %u bytes for %d group aggregates",
+                (unsigned)alloc_size,
+                aggregate_count);
+            return false;
+        }
+        errno_t erc = memset_s(group_by->_aggregates, alloc_size, 0, alloc_size);
+        securec_check(erc, "\0", "\0");
+        group_by->_aggregate_count = aggregate_count;
+
+        int i = 0;
+        foreach (lc, query->targetList) {
+            TargetEntry* target_entry = (TargetEntry*)lfirst(lc);
+            if (!target_entry->resjunk && (target_entry->expr->type == T_Aggref)) {
+                if (!getGroupAggregate(query, target_entry, &group_by->_aggregates[i])) {
+                    MOT_LOG_TRACE("Failed to prepare group aggregate %d", i);
+                    return false;
+                }
+                ++i;
+            }
+        }
+    }
+    return true;
+}
+
+static JitPlan* JitPrepareNestedLoopPlan(Query* query)
+{
+    MOT_LOG_TRACE("Preparing a nested-loop plan");
+
+    // we do not support ORDER BY clause, but we can aggregate and group
+    if (!CheckQueryAttributes(query, false, true, false, true)) {
+        MOT_LOG_TRACE("JitPrepareNestedLoopPlan(): Disqualifying query - Invalid query attributes");
+        return nullptr;
+    }
+
+    MOT::Table* tables[MOT_JIT_MAX_JOIN_TABLES];
+    int table_count = 0;
+    int limit_count = 0;
+    if (!getNestedLoopTables(query, tables, &table_count) || !getLimitCount(query, &limit_count)) {
+        MOT_LOG_TRACE("JitPrepareNestedLoopPlan(): Disqualifying query - unsupported tables or limit clause");
+        return nullptr;
+    }
+
+    size_t alloc_size = sizeof(JitNestedLoopPlan);
+    JitNestedLoopPlan* plan = (JitNestedLoopPlan*)MOT::MemSessionAlloc(alloc_size);
+    if (plan == nullptr) {
+        MOT_REPORT_ERROR(MOT_ERROR_OOM,
+            "Prepare JIT plan",
+            "Failed to allocate %u bytes for nested-loop plan",
+            (unsigned)alloc_size);
+        return nullptr;
+    }
+    errno_t erc = memset_s(plan, alloc_size, 0, alloc_size);
+    securec_check(erc, "\0", "\0");
+    plan->_plan_type = JIT_PLAN_NESTED_LOOP;
+    plan->_command_type = (table_count == 1) ? JIT_COMMAND_GROUP_BY_SELECT : JIT_COMMAND_MULTI_JOIN;
+    plan->_scan_count = table_count;
+    plan->_limit_count = limit_count;
+    plan->_grouped = (query->groupClause != nullptr) || query->hasAggs;
+
+    bool result = true;
+    for (int level = 0; level < table_count; ++level) {
+        if (!prepareNestedLoopScan(query, tables, level, &plan->_scans[level])) {
+            result = false;
+            break;
+        }
+    }
+    if (result) {
+        if (plan->_grouped) {
+            result = prepareGroupBy(query, &plan->_group_by);
+        } else {
+            result = prepareSelectExpressions(query, &plan->_select_exprs);
+        }
+    }
+
+    if (!result) {
+        MOT_LOG_TRACE("Failed to prepare nested-loop plan");
+        JitDestroyPlan((JitPlan*)plan);
+        return nullptr;
+    }
+    return (JitPlan*)plan;
+}
+
 static SubLink* GetSingleSubLink(Query* query, MOT::Table* table)
 {
     SubLink* result = nullptr;
@@ -1707,8 +2128,11 @@ extern JitPlan* JitPreparePlan(Query* query, const char* query_string)
     JitPlan* plan = nullptr;
     MOT_LOG_TRACE("Preparing plan for query: %s", query_string);
 
-    // we start by checking the number of tables involved
-    if (list_length(query->rtable) == 1) {
+    // multi-table joins and GROUP BY queries are executed as nested loops with materialized results, otherwise we
+    // continue by checking the number of tables involved
+    if (isNestedLoopQuery(query)) {
+        plan = JitPrepareNestedLoopPlan(query);
+    } else if (list_length(query->rtable) == 1) {
         plan = JitPrepareSimplePlan(query);
         // special case: a sub-query that evaluates to point query or single value aggregate, which in turn
         // is used in a point-select outer query
@@ -1786,12 +2210,6 @@ static void JitDestroyPointQueryPlan(JitPointQueryPlan* plan)
     MOT::MemSessionFree(plan);
 }
 
-static void freeIndexScan(JitIndexScan* index_scan)
-{
-    freeExprArray(&index_scan->_search_exprs);
-    freeFilterArray(&index_scan->_filters);
-}
-
 static void JitDestroyRangeUpdatePlan(JitRangeUpdatePlan* plan)
 {
     freeExprArray(&plan->_update_exprs);
@@ -1821,6 +2239,19 @@ static void JitDestroyJoinPlan(JitJoinPlan* plan)
     MOT::MemSessionFree(plan);
 }
 
+static void JitDestroyNestedLoopPlan(JitNestedLoopPlan* plan)
+{
+    for (int i = 0; i < plan->_scan_count; ++i) {
+        freeIndexScan(&plan->_scans[i]);
+    }
+    freeSelectExprArray(&plan->_select_exprs);
+    freeSelectExprArray(&plan->_group_by._group_exprs);
+    if (plan->_group_by._aggregates != nullptr) {
+        MOT::MemSessionFree(plan->_group_by._aggregates);
+    }
+    MOT::MemSessionFree(plan);
+}
+
 static void JitDestroyCompoundPlan(JitCompoundPlan* plan)
 {
     for (uint32_t i = 0; i < plan->_sub_query_count; ++i) {
@@ -1856,6 +2287,10 @@ extern void JitDestroyPlan(JitPlan* plan)
                 JitDestroyCompoundPlan((JitCompoundPlan*)plan);
                 break;
 
+            case JIT_PLAN_NESTED_LOOP:
+                JitDestroyNestedLoopPlan((JitNestedLoopPlan*)plan);
+                break;
+
             case JIT_PLAN_INVALID:
             default:
                 break;
@@ -46,7 +46,10 @@ enum JitPlanType {
     JIT_PLAN_JOIN,
 
     /** @var Plan for a query with sub-queries. */
-    JIT_PLAN_COMPOUND
+    JIT_PLAN_COMPOUND,
+
+    /** @var Plan for a nested loop join over any number of tables, or for a GROUP BY query. */
+    JIT_PLAN_NESTED_LOOP
 };
 
 /** @struct The parent struct for all plans. */
@@ -214,6 +217,36 @@ struct JitCompoundPlan {
     JitPlan** _sub_query_plans;
 };
 
+/** @strut Plan for multi-table nested loop join and GROUP BY queries (results are materialized before returned). */
+struct JitNestedLoopPlan {
+    /** @var The type of plan being used (always @ref JIT_PLAN_NESTED_LOOP). */
+    JitPlanType _plan_type;  // always JIT_PLAN_NESTED_LOOP
+
+    /** @var The command type being used (either @ref JIT_COMMAND_GROUP_BY_SELECT or @ref JIT_COMMAND_MULTI_JOIN). */
+    JitCommandType _command_type;
+
+    /** @var The number of scans (one per table, outermost first). */
+    int _scan_count;
+
+    /**
+     * @var The scan of each loop level. The search expressions and filters of each scan refer only to its own table
+     * and the tables of enclosing loops, and the filters also contain the join predicates not used in the search.
+     */
+    JitIndexScan _scans[MOT_JIT_MAX_JOIN_TABLES];
+
+    /** @var Array of expressions to copy to the result tuple (ungrouped join only). */
+    JitSelectExprArray _select_exprs;
+
+    /** @var Limit on number of rows returned to the user (zero for none). */
+    int _limit_count;
+
+    /** @var Specifies whether rows are grouped (by zero or more columns), or rather just joined. */
+    bool _grouped;
+
+    /** @var The grouping parameters (valid only if @ref _grouped is set). */
+    JitGroupBy _group_by;
+};
+
 /** @define A special constant denoting a plan is not needed since jitted query has already been generated. */
 #define MOT_READY_JIT_PLAN ((JitPlan*)-1)
 
@@ -35,6 +35,8 @@ DECLARE_LOGGER(JitPlanExpr, JitExec)
 
 // Forward declarations
 JitExpr* parseExpr(Query* query, Expr* expr, int arg_pos, int depth);
+static bool getExprTableLevels(const Query* query, const Expr* expr, MOT::Table** tables, int table_count,
+    uint32_t* levels);
 
 bool ExpressionCounter::OnExpression(
     Expr* expr, int columnType, int tableColumnId, MOT::Table* table, JitWhereOperatorClass opClass, bool joinExpr)
@@ -112,6 +114,11 @@ bool RangeScanExpressionCollector::OnExpression(
             _max_index_ops);
         return false;
     } else {
+        uint32_t levels = 0;
+        if ((_bound_table_count >= 0) && !getExprTableLevels(_query, expr, _bound_tables, _bound_table_count, &levels)) {
+            MOT_LOG_TRACE("RangeScanExpressionCollector::onExpression(): Skipping expression referring an unbound table");
+            return true;  // not an error, this expression is evaluated in an inner loop of the join
+        }
         JitExpr* jit_expr = parseExpr(_query, expr, 0, 0);
         if (jit_expr == nullptr) {
             MOT_LOG_TRACE(
@@ -933,6 +940,65 @@ void freeExpr(JitExpr* expr)
     MOT::MemSessionFree(expr);
 }
 
+// Collects the join scan levels referred by an expression (as a bit-set), and returns false if any of the referred
+// tables is not in the given table array
+static bool getExprTableLevels(const Query* query, const Expr* expr, MOT::Table** tables, int table_count,
+    uint32_t* levels)
+{
+    bool result = true;
+    ListCell* lc = nullptr;
+    switch (expr->type) {
+        case T_Var: {
+            const Var* var_expr = (const Var*)expr;
+            MOT::Table* table = getRealTable(query, var_expr->varno, var_expr->varattno);
+            result = false;
+            for (int i = 0; i < table_count; ++i) {
+                if (tables[i] == table) {
+                    *levels |= (1u << i);
+                    result = true;
+                    break;
+                }
+            }
+            break;
+        }
+
+        case T_RelabelType:
+            result = getExprTableLevels(query, ((const RelabelType*)expr)->arg, tables, table_count, levels);
+            break;
+
+        case T_OpExpr:
+            foreach (lc, ((const OpExpr*)expr)->args) {
+                if (!getExprTableLevels(query, (Expr*)lfirst(lc), tables, table_count, levels)) {
+                    result = false;
+                    break;
+                }
+            }
+            break;
+
+        case T_FuncExpr:
+            foreach (lc, ((const FuncExpr*)expr)->args) {
+                if (!getExprTableLevels(query, (Expr*)lfirst(lc), tables, table_count, levels)) {
+                    result = false;
+                    break;
+                }
+            }
+            break;
+
+        case T_BoolExpr:
+            foreach (lc, ((const BoolExpr*)expr)->args) {
+                if (!getExprTableLevels(query, (Expr*)lfirst(lc), tables, table_count, levels)) {
+                    result = false;
+                    break;
+                }
+            }
+            break;
+
+        default:  // constants and parameters do not refer any table
+            break;
+    }
+    return result;
+}
+
 static bool containsExpr(const JitColumnExprArray* pkey_exprs, const Expr* expr)
 {
     for (int i = 0; i < pkey_exprs->_count; ++i) {
@@ -1395,8 +1461,8 @@ static const char* joinClauseTypeToString(JoinClauseType join_clause_type)
     }
 }
 
-bool getRangeSearchExpressions(
-    Query* query, MOT::Table* table, MOT::Index* index, JitIndexScan* index_scan, JoinClauseType join_clause_type)
+bool getRangeSearchExpressions(Query* query, MOT::Table* table, MOT::Index* index, JitIndexScan* index_scan,
+    JoinClauseType join_clause_type, MOT::Table** bound_tables /* = nullptr */, int bound_table_count /* = -1 */)
 {
     MOT_LOG_TRACE("Getting range search expressions for table %s, index %s (join_clause_type: %s)",
         table->GetTableName().c_str(),
@@ -1404,6 +1470,7 @@ bool getRangeSearchExpressions(
         joinClauseTypeToString(join_clause_type));
     bool result = false;
     RangeScanExpressionCollector expr_collector(query, table, index, index_scan);
+    expr_collector.SetBoundTables(bound_tables, bound_table_count);
     if (!expr_collector.Init()) {
         MOT_LOG_TRACE("Failed to initialize range search expression collector");
     } else {
@@ -1437,6 +1504,71 @@ bool getRangeSearchExpressions(
     return result;
 }
 
+static Expr* peelRelabelExpr(Expr* expr)
+{
+    if (expr->type == T_RelabelType) {
+        expr = ((RelabelType*)expr)->arg;
+    }
+    return expr;
+}
+
+static bool visitJoinFilterExpression(Query* query, MOT::Table** tables, int level, Expr* expr,
+    JitColumnExprArray* search_exprs, ExpressionVisitor* visitor)
+{
+    if (expr->type == T_BoolExpr) {
+        const BoolExpr* bool_expr = (const BoolExpr*)expr;
+        if (bool_expr->boolop == AND_EXPR) {
+            ListCell* lc = nullptr;
+            foreach (lc, bool_expr->args) {
+                if (!visitJoinFilterExpression(query, tables, level, (Expr*)lfirst(lc), search_exprs, visitor)) {
+                    return false;
+                }
+            }
+        }
+        return true;  // other boolean operators were already disqualified while collecting search expressions
+    }
+
+    if ((expr->type != T_OpExpr) || (list_length(((OpExpr*)expr)->args) != 2)) {
+        return true;
+    }
+
+    // a join filter refers the table of this level, at least one table of an enclosing loop and no inner table
+    OpExpr* op_expr = (OpExpr*)expr;
+    uint32_t levels = 0;
+    uint32_t level_bit = (1u << level);
+    if (!getExprTableLevels(query, expr, tables, level + 1, &levels) || ((levels & level_bit) == 0) ||
+        (levels == level_bit)) {
+        return true;
+    }
+
+    // skip join expressions already used to search the index of this level
+    Expr* lhs = (Expr*)linitial(op_expr->args);
+    Expr* rhs = (Expr*)lsecond(op_expr->args);
+    if (containsExpr(search_exprs, peelRelabelExpr(lhs)) || containsExpr(search_exprs, peelRelabelExpr(rhs))) {
+        MOT_LOG_TRACE("visitJoinFilterExpression(): Skipping join search expression %p at level %d", op_expr, level);
+        return true;
+    }
+
+    if (op_expr->opresulttype != BOOLOID) {
+        MOT_LOG_TRACE("visitJoinFilterExpression(): Disqualifying query - join filter result type %d is unsupported",
+            op_expr->opresulttype);
+        return false;
+    }
+
+    MOT_LOG_TRACE("visitJoinFilterExpression(): Collecting join filter expression %p at level %d", op_expr, level);
+    return visitor->OnFilterExpr(op_expr->opno, op_expr->opfuncid, lhs, rhs);
+}
+
+bool visitJoinFilterExpressions(
+    Query* query, MOT::Table** tables, int level, JitColumnExprArray* search_exprs, ExpressionVisitor* visitor)
+{
+    Node* quals = query->jointree->quals;
+    if (quals == nullptr) {
+        return true;
+    }
+    return visitJoinFilterExpression(query, tables, level, (Expr*)&quals[0], search_exprs, visitor);
+}
+
 bool getTargetExpressions(Query* query, JitColumnExprArray* target_exprs)
 {
     int i = 0;
@@ -1524,4 +1656,49 @@ bool getSelectExpressions(Query* query, JitSelectExprArray* select_exprs)
     }
     return true;
 }
+
+bool getGroupExpressions(Query* query, JitSelectExprArray* group_exprs)
+{
+    int i = 0;
+    ListCell* lc = nullptr;
+
+    foreach (lc, query->groupClause) {
+        SortGroupClause* group_clause = (SortGroupClause*)lfirst(lc);
+        TargetEntry* target_entry = nullptr;
+        ListCell* lc2 = nullptr;
+        foreach (lc2, query->targetList) {
+            TargetEntry* next_entry = (TargetEntry*)lfirst(lc2);
+            if (next_entry->ressortgroupref == group_clause->tleSortGroupRef) {
+                target_entry = next_entry;
+                break;
+            }
+        }
+        if (target_entry == nullptr) {
+            MOT_LOG_TRACE("getGroupExpressions(): Cannot find target entry for group clause %d", i);
+            return false;
+        }
+        if (i < group_exprs->_count) {
+            JitExpr* sub_expr = parseExpr(query, target_entry->expr, 0, 0);
+            if (sub_expr == nullptr) {
+                MOT_LOG_TRACE("getGroupExpressions(): Failed to parse group expression %d", i);
+                return false;
+            }
+            if (sub_expr->_expr_type != JIT_EXPR_TYPE_VAR) {
+                MOT_LOG_TRACE("getGroupExpressions(): Unsupported non-var group expression");
+                freeExpr(sub_expr);
+                return false;
+            }
+            group_exprs->_exprs[i]._column_expr = (JitVarExpr*)sub_expr;
+            group_exprs->_exprs[i]._tuple_column_id = target_entry->resjunk ? -1 : (target_entry->resno - 1);
+            ++i;
+        } else {
+            MOT_REPORT_ERROR(MOT_ERROR_INTERNAL,
+                "Prepare JIT Plan",
+                "Exceeded number of group expressions %d",
+                group_exprs->_count);
+            return false;
+        }
+    }
+    return true;
+}
 }  // namespace JitExec
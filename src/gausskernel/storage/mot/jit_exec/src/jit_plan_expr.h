@@ -464,6 +464,30 @@ struct JitJoinExpr {
     int _inner_column_id;
 };
 
+/** @struct An aggregate computed for each group in a GROUP BY query. */
+struct JitGroupAggregate {
+    /** @var The aggregate (the table is null and the column id is -1 for COUNT(*)). */
+    JitAggregate _aggregate;
+
+    /** @var The aggregated column type, or @ref InvalidOid for COUNT(*). */
+    int _arg_type;
+
+    /** @var The zero-based output tuple column id. */
+    int _tuple_column_id;
+};
+
+/** @struct Specifies grouping parameters. */
+struct JitGroupBy {
+    /** @var The grouping columns (a column that is not selected has output tuple column id -1). */
+    JitSelectExprArray _group_exprs;
+
+    /** @var The aggregates computed for each group. */
+    JitGroupAggregate* _aggregates;
+
+    /** @var The number of aggregates. */
+    int _aggregate_count;
+};
+
 // Parent class for all expression visitors
 class ExpressionVisitor {
 public:
@@ -542,7 +566,9 @@ public:
           _index_ops(nullptr),
           _max_index_ops(0),
           _index_op_count(0),
-          _index_scan(index_scan)
+          _index_scan(index_scan),
+          _bound_tables(nullptr),
+          _bound_table_count(-1)
     {}
 
     ~RangeScanExpressionCollector() noexcept final
@@ -555,10 +581,21 @@ public:
         _table = nullptr;
         _index = nullptr;
         _index_scan = nullptr;
+        _bound_tables = nullptr;
     }
 
     bool Init();
 
+    /**
+     * @brief Restricts collected expressions to those referring only the given tables (the tables of the enclosing
+     * loops of a nested-loop join, followed by the scanned table).
+     */
+    inline void SetBoundTables(MOT::Table** boundTables, int boundTableCount)
+    {
+        _bound_tables = boundTables;
+        _bound_table_count = boundTableCount;
+    }
+
     bool OnExpression(Expr* expr, int columnType, int tableColumnId, MOT::Table* table, JitWhereOperatorClass opClass,
         bool joinExpr) final;
 
@@ -577,6 +614,8 @@ private:
     int _max_index_ops;
     int _index_op_count;
     JitIndexScan* _index_scan;
+    MOT::Table** _bound_tables;
+    int _bound_table_count;
 
     bool DetermineScanType(JitIndexScanType& scanType, int& columnCount);
 
@@ -667,10 +706,13 @@ bool visitSearchExpressions(Query* query, MOT::Table* table, MOT::Index* index,
     ExpressionVisitor* visitor, bool include_join_exprs, JitColumnExprArray* pkey_exprs = nullptr);
 bool getSearchExpressions(Query* query, MOT::Table* table, MOT::Index* index, bool include_pkey,
     JitColumnExprArray* search_exprs, int* count, bool use_join_clause);
-bool getRangeSearchExpressions(
-    Query* query, MOT::Table* table, MOT::Index* index, JitIndexScan* index_scan, JoinClauseType join_clause_type);
+bool getRangeSearchExpressions(Query* query, MOT::Table* table, MOT::Index* index, JitIndexScan* index_scan,
+    JoinClauseType join_clause_type, MOT::Table** bound_tables = nullptr, int bound_table_count = -1);
+bool visitJoinFilterExpressions(
+    Query* query, MOT::Table** tables, int level, JitColumnExprArray* search_exprs, ExpressionVisitor* visitor);
 bool getTargetExpressions(Query* query, JitColumnExprArray* target_exprs);
 bool getSelectExpressions(Query* query, JitSelectExprArray* select_exprs);
+bool getGroupExpressions(Query* query, JitSelectExprArray* group_exprs);
 }  // namespace JitExec
 
 #endif /* JIT_PLAN_EXPR_H */
@@ -36,12 +36,14 @@ JitThreadStatistics::JitThreadStatistics(uint64_t threadId, void* inplaceBuffer)
       m_execQueryCount(MakeName("jit-exec", threadId).c_str()),
       m_invokeQueryCount(MakeName("jit-invoke", threadId).c_str()),
       m_execFailQueryCount(MakeName("jit-exec-fail", threadId).c_str()),
-      m_execAbortQueryCount(MakeName("jit-exec-abort", threadId).c_str())
+      m_execAbortQueryCount(MakeName("jit-exec-abort", threadId).c_str()),
+      m_invokeTime(MakeName("jit-invoke-time", threadId).c_str(), "ns")
 {
     RegisterStatistics(&m_execQueryCount);
     RegisterStatistics(&m_invokeQueryCount);
     RegisterStatistics(&m_execFailQueryCount);
     RegisterStatistics(&m_execAbortQueryCount);
+    RegisterStatistics(&m_invokeTime);
 }
 
 JitGlobalStatistics::JitGlobalStatistics(GlobalStatistics::NamingScheme namingScheme)
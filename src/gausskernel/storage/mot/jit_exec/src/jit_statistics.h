@@ -26,6 +26,7 @@
 #define JIT_STATISTICS_H
 
 #include "frequency_statistic_variable.h"
+#include "histogram_statistic_variable.h"
 #include "level_statistic_variable.h"
 #include "numeric_statistic_variable.h"
 #include "iconfig_change_listener.h"
@@ -73,6 +74,12 @@ public:
         m_execAbortQueryCount.AddSample();
     }
 
+    /** @brief Updates the JIT function invocation time statistics. */
+    inline void AddInvokeTime(uint64_t nanos)
+    {
+        m_invokeTime.AddSample(nanos);
+    }
+
 private:
     /** @var The successful JIT query execution count statistic variable. */
     MOT::FrequencyStatisticVariable m_execQueryCount;
@@ -85,6 +92,9 @@ private:
 
     /** @var The aborted JIT query execution count statistic variable. */
     MOT::FrequencyStatisticVariable m_execAbortQueryCount;
+
+    /** @var The JIT function invocation time statistic variable. */
+    MOT::HistogramStatisticVariable m_invokeTime;
 };
 
 class JitGlobalStatistics : public MOT::GlobalStatistics {
@@ -298,6 +308,15 @@ public:
         }
     }
 
+    /** @brief Records the time of a JIT function invocation. */
+    inline void AddInvokeTime(uint64_t nanos)
+    {
+        JitThreadStatistics* jts = GetCurrentThreadStatistics<JitThreadStatistics>();
+        if (jts != nullptr) {
+            jts->AddInvokeTime(nanos);
+        }
+    }
+
     /**
      * @brief Derives classes should react to a notification that configuration changed. New
      * configuration is accessible via the ConfigManager.
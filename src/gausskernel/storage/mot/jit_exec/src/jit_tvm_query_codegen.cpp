@@ -1688,6 +1688,10 @@ extern JitContext* JitCodegenTvmQuery(Query* query, const char* query_string, Ji
             jit_context = JitCompoundCodegen(query, query_string, (JitCompoundPlan*)plan);
             break;
 
+        case JIT_PLAN_NESTED_LOOP:
+            MOT_LOG_TRACE("Nested-loop plans are not supported in TVM-jitted code, query executed without JIT");
+            break;
+
         default:
             MOT_REPORT_ERROR(
                 MOT_ERROR_INTERNAL, "Generate JIT Code", "Invalid JIT plan type %d", (int)plan->_plan_type);
@@ -47,6 +47,7 @@ extern "C" Datum hdfs_fdw_validator(PG_FUNCTION_ARGS);
 #ifdef ENABLE_MOT
 extern "C" Datum mot_fdw_validator(PG_FUNCTION_ARGS);
 extern "C" Datum mot_fdw_handler(PG_FUNCTION_ARGS);
+extern "C" Datum mot_histogram_statistics(PG_FUNCTION_ARGS);
 #endif
 
 extern void encryptOBSForeignTableOption(List** options);
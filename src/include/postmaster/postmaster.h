@@ -36,6 +36,11 @@ extern volatile bool is_stable_epoch_send, is_epoch_advanced_by_message, is_read
 extern std::vector<std::string> kTxnNodeIp, kStorageNodeIp;
 extern std::string kLocalIp;
 extern uint64_t kStorageUpdaterThreadNum, kStorageReaderThreadNum, kMessageManagerThreadNum, kEpochSize_us, txn_ip_index;
+extern uint64_t kClientBatchWindow_us, kClientBatchMaxTxnNum;
+extern std::string kWireCodec, kTxnWireCodec;
+extern uint64_t kWireCodecLevel, kLinkBandwidthMbps;
+extern std::string kTxnRoutePolicy;
+extern uint64_t kTxnReplyTimeout_us, kTxnVerdictTimeout_us;
 
 extern THR_LOCAL bool comm_client_bind;
 
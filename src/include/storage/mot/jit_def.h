@@ -42,6 +42,12 @@
 /** @define The maximum number of arguments in a function call expression. */
 #define MOT_JIT_MAX_FUNC_EXPR_ARGS 3
 
+/** @define The maximum number of tables in a jitted nested-loop join. */
+#define MOT_JIT_MAX_JOIN_TABLES 8
+
+/** @define The maximum number of aggregates in a jitted GROUP BY query. */
+#define MOT_JIT_MAX_AGGREGATES 16
+
 namespace JitExec {
 
 // To debug JIT execution, #define MOT_JIT_DEBUG
@@ -99,7 +105,13 @@ enum JitCommandType : uint8_t {
     JIT_COMMAND_AGGREGATE_JOIN,
 
     /** @var Compound select command (point-select with sub-queries). */
-    JIT_COMMAND_COMPOUND_SELECT
+    JIT_COMMAND_COMPOUND_SELECT,
+
+    /** @var Range select command with GROUP BY clause and possibly several aggregates. */
+    JIT_COMMAND_GROUP_BY_SELECT,
+
+    /** @var Nested-loop join command over more than two tables (or a grouped two-table join). */
+    JIT_COMMAND_MULTI_JOIN
 };
 
 /** @enum JIT context usage constants. */
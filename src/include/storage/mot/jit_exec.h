@@ -74,6 +74,13 @@ extern JitPlan* IsJittable(Query* query, const char* queryString);
  */
 extern JitContext* JitCodegenQuery(Query* query, const char* queryString, JitPlan* jitPlan);
 
+/**
+ * @brief Retrieves the kind of query a JIT context executes, for display.
+ * @param jitContext The context produced by a previous call to @ref JitCodegenQuery().
+ * @return The command type name (e.g. "Multi-Join").
+ */
+extern const char* GetJitContextCommand(JitContext* jitContext);
+
 /** @brief Resets the scan iteration counter for the JIT context. */
 extern void JitResetScan(JitContext* jitContext);
 
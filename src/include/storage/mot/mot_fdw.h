@@ -117,6 +117,7 @@ extern void FDWStorageMessageManagerThreadMain(uint64_t id);
 extern void FDWStorageReaderThreadMain(uint64_t id);
 extern void FDWStorageSenderThreadMain(uint64_t id);
 extern void FDWStorageUpdaterThreadMain(uint64_t id);
+extern uint64_t FDWStorageMaxApplyLaneNum();
 extern void FDWStorageWorker1ThreadMain(uint64_t id);
 
 #endif  // MOT_FDW_H
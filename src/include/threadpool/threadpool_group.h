@@ -87,6 +87,9 @@ public:
     float4 GetSessionPerThread();
     void GetThreadPoolGroupStat(ThreadPoolStat* stat);
     bool IsGroupHang();
+    void BeginRemoteWait();
+    void EndRemoteWait();
+    bool IsRemoteWaitStarved();
 
     inline ThreadPoolListener* GetListener()
     {
@@ -145,6 +148,7 @@ private:
     volatile int m_sessionCount;           // all session count;
     volatile int m_waitServeSessionCount;  // wait for worker to server
     volatile int m_processTaskCount;
+    volatile int m_remoteWaitWorkerNum;    // workers parked on a remote commit reply
 
     int m_groupId;
     int m_numaId;
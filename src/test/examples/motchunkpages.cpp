@@ -0,0 +1,233 @@
+/*
+ * src/test/examples/motchunkpages.cpp
+ *
+ *
+ * motchunkpages.cpp
+ *		Measures point lookups over memory mapped like MOT chunks, for each
+ *		chunk_huge_pages mode.
+ *
+ * Usage: motchunkpages [megabytes [lookups]]
+ *
+ * MOT rows and index nodes live in 2 MB chunks, so the TLB reach of the chunk
+ * mapping bounds the speed of random point lookups once the table outgrows
+ * the caches. For each chunk_huge_pages mode the program maps chunks the way
+ * the chunk pools do: none maps them with regular pages, transparent advises
+ * them with madvise(MADV_HUGEPAGE) before they are touched, and explicit maps
+ * each one with MAP_HUGETLB and falls back to transparent when no huge page
+ * is reserved (see vm.nr_hugepages). It fills the given amount of chunks with
+ * 64 byte rows and an open addressing hash index over their keys, both spread
+ * over the chunks, and then looks up random keys. It prints the rate of each
+ * mode and how much of the memory was actually backed by huge pages. The
+ * server and the protocol are left out, only the memory access is measured.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/time.h>
+#include <vector>
+
+#ifndef MAP_HUGE_2MB
+#define MAP_HUGE_2MB (21 << 26)
+#endif
+
+#define CHUNK_SIZE (2 * 1024 * 1024UL)
+#define ROW_SIZE 64
+
+typedef enum ChunkMode { CHUNK_MODE_NONE, CHUNK_MODE_TRANSPARENT, CHUNK_MODE_EXPLICIT } ChunkMode;
+
+static const char* modeNames[] = {"none", "transparent", "explicit"};
+
+typedef struct Row {
+    uint64_t key;
+    uint64_t value[ROW_SIZE / sizeof(uint64_t) - 1];
+} Row;
+
+typedef struct ChunkSet {
+    std::vector<uint8_t*> chunks;
+    uint64_t fallbacks;
+} ChunkSet;
+
+static double now_seconds(void)
+{
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return tv.tv_sec + tv.tv_usec / 1000000.0;
+}
+
+static inline uint64_t next_random(uint64_t* state)
+{
+    uint64_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    *state = x;
+    return x;
+}
+
+/* maps a chunk aligned to its size with regular pages, like the chunk pools do without huge pages */
+static uint8_t* map_aligned_chunk(void)
+{
+    uint8_t* mem = (uint8_t*)mmap(NULL, CHUNK_SIZE * 2, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (mem == MAP_FAILED) {
+        return NULL;
+    }
+    uint8_t* chunk = (uint8_t*)(((uintptr_t)mem + CHUNK_SIZE - 1) & ~(CHUNK_SIZE - 1));
+    if (chunk > mem) {
+        (void)munmap(mem, chunk - mem);
+    }
+    (void)munmap(chunk + CHUNK_SIZE, mem + CHUNK_SIZE * 2 - (chunk + CHUNK_SIZE));
+    return chunk;
+}
+
+static uint8_t* map_chunk(ChunkMode mode, uint64_t* fallbacks)
+{
+    if (mode == CHUNK_MODE_EXPLICIT) {
+        void* mem = mmap(
+            NULL, CHUNK_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB | MAP_HUGE_2MB, -1, 0);
+        if (mem != MAP_FAILED) {
+            return (uint8_t*)mem;
+        }
+        (*fallbacks)++;
+        mode = CHUNK_MODE_TRANSPARENT;
+    }
+
+    uint8_t* chunk = map_aligned_chunk();
+    if (chunk != NULL && mode == CHUNK_MODE_TRANSPARENT) {
+        (void)madvise(chunk, CHUNK_SIZE, MADV_HUGEPAGE);
+    }
+    return chunk;
+}
+
+/* maps and touches count chunks, as the chunk pools do when they reserve memory */
+static bool map_chunks(ChunkMode mode, uint64_t count, ChunkSet* set)
+{
+    set->fallbacks = 0;
+    for (uint64_t i = 0; i < count; i++) {
+        uint8_t* chunk = map_chunk(mode, &set->fallbacks);
+        if (chunk == NULL) {
+            return false;
+        }
+        memset(chunk, 0, CHUNK_SIZE);
+        set->chunks.push_back(chunk);
+    }
+    return true;
+}
+
+static void unmap_chunks(ChunkSet* set)
+{
+    for (size_t i = 0; i < set->chunks.size(); i++) {
+        (void)munmap(set->chunks[i], CHUNK_SIZE);
+    }
+    set->chunks.clear();
+}
+
+/* kilobytes of anonymous memory backed by transparent or explicit huge pages in this process */
+static uint64_t huge_page_kb(void)
+{
+    FILE* file = fopen("/proc/self/smaps", "r");
+    char line[256];
+    uint64_t total = 0;
+    uint64_t kb = 0;
+
+    if (file == NULL) {
+        return 0;
+    }
+    while (fgets(line, sizeof(line), file) != NULL) {
+        if (sscanf(line, "AnonHugePages: %" SCNu64 " kB", &kb) == 1 ||
+            sscanf(line, "Private_Hugetlb: %" SCNu64 " kB", &kb) == 1) {
+            total += kb;
+        }
+    }
+    fclose(file);
+    return total;
+}
+
+static double run_mode(ChunkMode mode, uint64_t megabytes, uint64_t lookups)
+{
+    /* a quarter of the memory holds the index buckets, at most half full */
+    uint64_t bucketChunks = megabytes / 8;
+    uint64_t rowChunks = megabytes / 2 - bucketChunks;
+    uint64_t bucketsPerChunk = CHUNK_SIZE / sizeof(Row*);
+    uint64_t rowsPerChunk = CHUNK_SIZE / ROW_SIZE;
+    uint64_t numBuckets = bucketChunks * bucketsPerChunk;
+    uint64_t numRows = rowChunks * rowsPerChunk;
+    ChunkSet set;
+
+    if (numRows * 2 > numBuckets) {
+        numRows = numBuckets / 2;
+    }
+    if (!map_chunks(mode, bucketChunks + rowChunks, &set)) {
+        fprintf(stderr, "%s: failed to map %" PRIu64 " chunks\n", modeNames[mode], bucketChunks + rowChunks);
+        unmap_chunks(&set);
+        return 0;
+    }
+
+    std::vector<Row**> buckets;
+    for (uint64_t i = 0; i < bucketChunks; i++) {
+        buckets.push_back((Row**)set.chunks[i]);
+    }
+    uint8_t** rows = &set.chunks[bucketChunks];
+    for (uint64_t i = 0; i < numRows; i++) {
+        Row* row = (Row*)(rows[i / rowsPerChunk] + (i % rowsPerChunk) * ROW_SIZE);
+        row->key = i * 0x9E3779B97F4A7C15ULL | 1;
+        row->value[0] = i;
+        uint64_t b = (row->key * 0xFF51AFD7ED558CCDULL) % numBuckets;
+        while (buckets[b / bucketsPerChunk][b % bucketsPerChunk] != NULL) {
+            b = (b + 1) % numBuckets;
+        }
+        buckets[b / bucketsPerChunk][b % bucketsPerChunk] = row;
+    }
+    uint64_t hugeKb = huge_page_kb();
+
+    uint64_t state = 88172645463325252ULL;
+    uint64_t found = 0;
+    double start = now_seconds();
+    for (uint64_t n = 0; n < lookups; n++) {
+        uint64_t key = (next_random(&state) % numRows) * 0x9E3779B97F4A7C15ULL | 1;
+        uint64_t b = (key * 0xFF51AFD7ED558CCDULL) % numBuckets;
+        Row* row;
+        while ((row = buckets[b / bucketsPerChunk][b % bucketsPerChunk]) != NULL) {
+            if (row->key == key) {
+                found += row->value[0] & 1;
+                break;
+            }
+            b = (b + 1) % numBuckets;
+        }
+    }
+    double elapsed = now_seconds() - start;
+
+    printf("%-11s: %" PRIu64 " MB in %" PRIu64 " chunks, %" PRIu64 " MB on huge pages, %" PRIu64
+           " explicit fallbacks, %.0f lookups/s (%.1f ns each, checksum %" PRIu64 ")\n",
+        modeNames[mode],
+        (bucketChunks + rowChunks) * CHUNK_SIZE >> 20,
+        bucketChunks + rowChunks,
+        hugeKb >> 10,
+        set.fallbacks,
+        lookups / elapsed,
+        elapsed * 1e9 / lookups,
+        found);
+    unmap_chunks(&set);
+    return lookups / elapsed;
+}
+
+int main(int argc, char** argv)
+{
+    long megabytes = (argc > 1) ? atol(argv[1]) : 2048;
+    long lookups = (argc > 2) ? atol(argv[2]) : 20000000;
+
+    if (megabytes < 16 || lookups <= 0) {
+        fprintf(stderr, "usage: %s [megabytes (16..) [lookups]]\n", argv[0]);
+        return 1;
+    }
+
+    double none = run_mode(CHUNK_MODE_NONE, megabytes, lookups);
+    double transparent = run_mode(CHUNK_MODE_TRANSPARENT, megabytes, lookups);
+    double hugetlb = run_mode(CHUNK_MODE_EXPLICIT, megabytes, lookups);
+    if (none > 0) {
+        printf("speedup over none: transparent %.2fx, explicit %.2fx\n", transparent / none, hugetlb / none);
+    }
+    return 0;
+}
@@ -0,0 +1,205 @@
+/*
+ * src/test/examples/motcommittable.cpp
+ *
+ *
+ * motcommittable.cpp
+ *		Exercises the registries of commits waiting for a TaaS reply.
+ *
+ * Usage: motcommittable [threads [cycles [window]]]
+ *
+ * The program first runs a ring wrap stress test of PendingCommitTable: the
+ * threads keep one csn in a thousand pending while more than twice the ring
+ * size of newer csns is registered and completed around it, so those entries
+ * go to the overflow map. Every csn must be taken exactly once with its own
+ * value. It then measures register/complete cycles of PendingCommitTable and
+ * of the ConcurrentHashMap it replaced: each thread keeps window csns in
+ * flight and completes the oldest one whenever it registers a new one. It
+ * prints the rate of both tables and exits with 1 if a csn was not taken back
+ * with its own value.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <pthread.h>
+#include <sys/time.h>
+#include <vector>
+#include "mot_commit_table.h"
+
+#define MAX_THREADS 1024
+
+/* more than twice the PendingCommitTable ring size */
+#define STRESS_HOLD_CYCLES (2 * 65536 + 1)
+#define STRESS_HOLD_EVERY 1000
+
+typedef struct CommitThread {
+    pthread_t thread;
+    uint64_t cycles;
+    uint32_t window;
+    bool hashMap;
+    uint64_t failures;
+} CommitThread;
+
+static std::atomic<uint64_t> nextCsn(1);
+/* static, so that the cache line aligned slots are aligned without C++17 aligned new */
+static PendingCommitTable<void*> pendingTable;
+static ConcurrentHashMap<uint64_t, void*> hashMap;
+static pthread_barrier_t startBarrier;
+
+static double now_seconds(void)
+{
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return tv.tv_sec + tv.tv_usec / 1000000.0;
+}
+
+/* every csn is registered with a distinct non-null value derived from it */
+static inline void* csn_value(uint64_t csn)
+{
+    return reinterpret_cast<void*>((uintptr_t)(csn << 1 | 1));
+}
+
+static inline void register_csn(const CommitThread* arg, uint64_t csn)
+{
+    if (arg->hashMap) {
+        void* value = csn_value(csn);
+        void* prev = nullptr;
+        (void)hashMap.insert(csn, value, &prev);
+    } else {
+        pendingTable.insert(csn, csn_value(csn));
+    }
+}
+
+static inline void* complete_csn(const CommitThread* arg, uint64_t csn)
+{
+    if (arg->hashMap) {
+        void* value = nullptr;
+        if (!hashMap.get_value(csn, value)) {
+            return nullptr;
+        }
+        hashMap.remove(csn);
+        return value;
+    }
+    return pendingTable.take(csn);
+}
+
+/* keeps window csns in flight, the oldest one is completed whenever a new one is registered */
+static void* bench_main(void* p)
+{
+    CommitThread* arg = (CommitThread*)p;
+    std::vector<uint64_t> inflight(arg->window, 0);
+
+    (void)pthread_barrier_wait(&startBarrier);
+    for (uint64_t i = 0; i < arg->cycles; i++) {
+        uint64_t csn = nextCsn.fetch_add(1);
+        register_csn(arg, csn);
+        uint64_t& oldest = inflight[i % arg->window];
+        if (oldest != 0 && complete_csn(arg, oldest) != csn_value(oldest)) {
+            arg->failures++;
+        }
+        oldest = csn;
+    }
+    for (uint32_t i = 0; i < arg->window; i++) {
+        if (inflight[i] != 0 && complete_csn(arg, inflight[i]) != csn_value(inflight[i])) {
+            arg->failures++;
+        }
+    }
+    return NULL;
+}
+
+/* completes most csns right away, one in STRESS_HOLD_EVERY only after STRESS_HOLD_CYCLES more cycles */
+static void* stress_main(void* p)
+{
+    CommitThread* arg = (CommitThread*)p;
+    std::vector<uint64_t> held;
+    std::vector<uint64_t> heldUntil;
+    size_t nextHeld = 0;
+
+    (void)pthread_barrier_wait(&startBarrier);
+    for (uint64_t i = 0; i < arg->cycles; i++) {
+        uint64_t csn = nextCsn.fetch_add(1);
+        pendingTable.insert(csn, csn_value(csn));
+        if (i % STRESS_HOLD_EVERY == 0) {
+            held.push_back(csn);
+            heldUntil.push_back(i + STRESS_HOLD_CYCLES);
+        } else if (!pendingTable.contain(csn) || pendingTable.take(csn) != csn_value(csn)) {
+            arg->failures++;
+        }
+
+        while (nextHeld < held.size() && (heldUntil[nextHeld] <= i || i + 1 == arg->cycles)) {
+            uint64_t old = held[nextHeld++];
+            if (!pendingTable.contain(old) || pendingTable.take(old) != csn_value(old) ||
+                pendingTable.take(old) != nullptr) {
+                arg->failures++;
+            }
+        }
+    }
+    return NULL;
+}
+
+/* runs nthreads threads from a common start, returns the elapsed time and adds up their failures */
+static double run_threads(
+    CommitThread* threads, int nthreads, void* (*main)(void*), uint64_t cycles, uint32_t window, bool hashMap,
+    uint64_t* failures)
+{
+    (void)pthread_barrier_init(&startBarrier, NULL, nthreads + 1);
+    for (int i = 0; i < nthreads; i++) {
+        threads[i].cycles = cycles;
+        threads[i].window = window;
+        threads[i].hashMap = hashMap;
+        threads[i].failures = 0;
+        if (pthread_create(&threads[i].thread, NULL, main, &threads[i]) != 0) {
+            fprintf(stderr, "failed to create thread\n");
+            exit(1);
+        }
+    }
+
+    (void)pthread_barrier_wait(&startBarrier);
+    double start = now_seconds();
+    *failures = 0;
+    for (int i = 0; i < nthreads; i++) {
+        (void)pthread_join(threads[i].thread, NULL);
+        *failures += threads[i].failures;
+    }
+    double elapsed = now_seconds() - start;
+    (void)pthread_barrier_destroy(&startBarrier);
+    return elapsed;
+}
+
+int main(int argc, char** argv)
+{
+    int nthreads = (argc > 1) ? atoi(argv[1]) : 64;
+    long cycles = (argc > 2) ? atol(argv[2]) : 1000000;
+    int window = (argc > 3) ? atoi(argv[3]) : 16;
+    uint64_t failures = 0;
+
+    if (nthreads <= 0 || nthreads > MAX_THREADS || cycles <= 0 || window <= 0) {
+        fprintf(stderr, "usage: %s [threads (1..%d) [cycles [window]]]\n", argv[0], MAX_THREADS);
+        return 1;
+    }
+
+    CommitThread* threads = (CommitThread*)calloc(nthreads, sizeof(CommitThread));
+    if (threads == NULL) {
+        fprintf(stderr, "out of memory\n");
+        return 1;
+    }
+
+    uint64_t stressCycles = (uint64_t)cycles < 4 * STRESS_HOLD_CYCLES ? 4 * STRESS_HOLD_CYCLES : (uint64_t)cycles;
+    (void)run_threads(threads, nthreads, stress_main, stressCycles, 0, false, &failures);
+    printf("ring wrap: %d threads, %" PRIu64 " csns each, %" PRIu64 " failures\n", nthreads, stressCycles,
+        failures);
+    bool ok = (failures == 0);
+
+    double elapsed = run_threads(threads, nthreads, bench_main, cycles, window, false, &failures);
+    printf("PendingCommitTable: %d threads, %d in flight each, %.0f cycles/s, %" PRIu64 " failures\n", nthreads,
+        window, nthreads * cycles / elapsed, failures);
+    ok = ok && (failures == 0);
+
+    elapsed = run_threads(threads, nthreads, bench_main, cycles, window, true, &failures);
+    printf("ConcurrentHashMap:  %d threads, %d in flight each, %.0f cycles/s, %" PRIu64 " failures\n", nthreads,
+        window, nthreads * cycles / elapsed, failures);
+    ok = ok && (failures == 0);
+
+    free(threads);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,153 @@
+/*
+ * src/test/examples/motlookup.cpp
+ *
+ *
+ * motlookup.cpp
+ *		Measures primary key lookups on a MOT table.
+ *
+ * Usage: motlookup [conninfo [rows [lookups [batch]]]]
+ *
+ * The program creates the foreign table mot_lookup with the given number of
+ * rows and then reads the same random keys twice: once with one prepared
+ * point query per key, and once with prepared IN-list queries of batch keys
+ * each, which MOT serves with a single batched index lookup. It prints the
+ * rate of both runs and drops the table.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+#include "libpq-fe.h"
+
+#define MAX_BATCH 1024
+
+static void exit_nicely(PGconn* conn)
+{
+    PQfinish(conn);
+    exit(1);
+}
+
+static void exec_or_die(PGconn* conn, const char* sql)
+{
+    PGresult* res = PQexec(conn, sql);
+    if (PQresultStatus(res) != PGRES_COMMAND_OK && PQresultStatus(res) != PGRES_TUPLES_OK) {
+        fprintf(stderr, "%s failed: %s", sql, PQerrorMessage(conn));
+        PQclear(res);
+        exit_nicely(conn);
+    }
+    PQclear(res);
+}
+
+static double now_seconds(void)
+{
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return tv.tv_sec + tv.tv_usec / 1000000.0;
+}
+
+/* runs the prepared statement stmt once per group of batch keys, returns the number of rows read */
+static long run_lookups(PGconn* conn, const char* stmt, const int* keys, int lookups, int batch, bool asArray)
+{
+    char values[MAX_BATCH][16];
+    char array[MAX_BATCH * 16 + 2];
+    const char* params[MAX_BATCH];
+    long found = 0;
+
+    for (int base = 0; base < lookups; base += batch) {
+        int count = (lookups - base < batch) ? (lookups - base) : batch;
+        int nparams = count;
+
+        if (asArray) {
+            int len = 0;
+            array[len++] = '{';
+            for (int i = 0; i < count; i++) {
+                len += snprintf(array + len, sizeof(array) - len, (i > 0) ? ",%d" : "%d", keys[base + i]);
+            }
+            array[len++] = '}';
+            array[len] = '\0';
+            params[0] = array;
+            nparams = 1;
+        } else {
+            for (int i = 0; i < count; i++) {
+                snprintf(values[i], sizeof(values[i]), "%d", keys[base + i]);
+                params[i] = values[i];
+            }
+        }
+
+        PGresult* res = PQexecPrepared(conn, stmt, nparams, params, NULL, NULL, 0);
+        if (PQresultStatus(res) != PGRES_TUPLES_OK) {
+            fprintf(stderr, "lookup failed: %s", PQerrorMessage(conn));
+            PQclear(res);
+            exit_nicely(conn);
+        }
+        found += PQntuples(res);
+        PQclear(res);
+    }
+    return found;
+}
+
+int main(int argc, char** argv)
+{
+    const char* conninfo = (argc > 1) ? argv[1] : "dbname = postgres";
+    int rows = (argc > 2) ? atoi(argv[2]) : 100000;
+    int lookups = (argc > 3) ? atoi(argv[3]) : 100000;
+    int batch = (argc > 4) ? atoi(argv[4]) : 32;
+    char sql[256];
+
+    if (rows <= 0 || lookups <= 0 || batch <= 0 || batch > MAX_BATCH) {
+        fprintf(stderr, "usage: %s [conninfo [rows [lookups [batch (1..%d)]]]]\n", argv[0], MAX_BATCH);
+        return 1;
+    }
+
+    PGconn* conn = PQconnectdb(conninfo);
+    if (PQstatus(conn) != CONNECTION_OK) {
+        fprintf(stderr, "Connection to database failed: %s", PQerrorMessage(conn));
+        exit_nicely(conn);
+    }
+
+    exec_or_die(conn, "drop foreign table if exists mot_lookup");
+    exec_or_die(conn, "create foreign table mot_lookup (id int not null primary key, val int)");
+    snprintf(sql, sizeof(sql), "insert into mot_lookup select g, g from generate_series(1, %d) g", rows);
+    exec_or_die(conn, sql);
+
+    PGresult* res = PQprepare(conn, "point", "select val from mot_lookup where id = $1", 1, NULL);
+    if (PQresultStatus(res) != PGRES_COMMAND_OK) {
+        fprintf(stderr, "prepare failed: %s", PQerrorMessage(conn));
+        PQclear(res);
+        exit_nicely(conn);
+    }
+    PQclear(res);
+    res = PQprepare(conn, "inlist", "select val from mot_lookup where id = any($1::int[])", 1, NULL);
+    if (PQresultStatus(res) != PGRES_COMMAND_OK) {
+        fprintf(stderr, "prepare failed: %s", PQerrorMessage(conn));
+        PQclear(res);
+        exit_nicely(conn);
+    }
+    PQclear(res);
+
+    int* keys = (int*)malloc(sizeof(int) * lookups);
+    if (keys == NULL) {
+        fprintf(stderr, "out of memory\n");
+        exit_nicely(conn);
+    }
+    srandom(1);
+    for (int i = 0; i < lookups; i++) {
+        keys[i] = (int)(random() % rows) + 1;
+    }
+
+    double start = now_seconds();
+    long found = run_lookups(conn, "point", keys, lookups, 1, false);
+    double elapsed = now_seconds() - start;
+    printf("point:   %d lookups, %ld rows, %.0f lookups/s\n", lookups, found, lookups / elapsed);
+
+    start = now_seconds();
+    found = run_lookups(conn, "inlist", keys, lookups, batch, true);
+    elapsed = now_seconds() - start;
+    printf("in-list: %d lookups in batches of %d, %ld rows, %.0f lookups/s\n", lookups, batch, found,
+        lookups / elapsed);
+
+    free(keys);
+    exec_or_die(conn, "drop foreign table mot_lookup");
+    PQfinish(conn);
+    return 0;
+}
@@ -9,3 +9,12 @@ analyze test1;
 
 drop foreign table test1;
 drop table test2;
+
+-- a table of more than ten times the sample size is sampled through its primary index
+set default_statistics_target = 10;
+create foreign table test3 (i integer primary key, y int);
+insert into test3 select g, g % 100 from generate_series(1, 50000) g;
+analyze test3;
+select attname, null_frac, n_distinct from pg_stats where tablename = 'test3' order by attname;
+reset default_statistics_target;
+drop foreign table test3;
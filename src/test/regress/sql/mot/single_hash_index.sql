@@ -0,0 +1,22 @@
+create foreign table hash_test (id int not null, grp int not null, val int);
+create unique index hash_test_idx on hash_test using hash (id);
+create unique index hash_test_grp_idx on hash_test using hash (grp, id);
+insert into hash_test values (generate_series(1,5000), generate_series(1,5000) % 10, generate_series(1,5000));
+select count(*) from hash_test;
+select * from hash_test where id = 4242;
+select * from hash_test where id = 5001;
+select * from hash_test where grp = 3 and id = 13;
+select count(*) from hash_test where id > 4990;
+select count(*) from hash_test where id between 100 and 199;
+select count(*) from hash_test where grp = 3;
+select id from hash_test where id < 6 order by id;
+insert into hash_test values (2500, 7, 0);
+delete from hash_test where id % 2 = 0;
+select count(*) from hash_test;
+select * from hash_test where id = 4242;
+select * from hash_test where id = 4243;
+update hash_test set val = -val where id = 4243;
+select * from hash_test where id = 4243;
+insert into hash_test values (4242, 2, 4242);
+select * from hash_test where id = 4242;
+drop foreign table hash_test;
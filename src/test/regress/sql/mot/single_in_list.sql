@@ -0,0 +1,17 @@
+create foreign table in_list_test (id int not null primary key, code int not null, val int);
+create unique index in_list_code_idx on in_list_test (code);
+insert into in_list_test values (generate_series(1,1000), generate_series(1,1000) + 5000, generate_series(1,1000));
+select * from in_list_test where id in (3, 1, 2, 1001, 2) order by id;
+select * from in_list_test where id in (7, null, 9) order by id;
+select * from in_list_test where code in (5010, 5020, 7000) order by id;
+select count(*) from in_list_test where id in (10, 20, 30) and val > 15;
+prepare in_list_lookup(int[]) as select id, val from in_list_test where id = any($1) order by id;
+execute in_list_lookup('{100,200,300}');
+execute in_list_lookup('{400,400,9999}');
+execute in_list_lookup('{}');
+update in_list_test set val = -val where id in (5, 6);
+select * from in_list_test where id in (4, 5, 6, 7) order by id;
+delete from in_list_test where code in (5001, 5002);
+select count(*) from in_list_test;
+deallocate in_list_lookup;
+drop foreign table in_list_test;
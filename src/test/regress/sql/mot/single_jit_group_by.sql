@@ -0,0 +1,79 @@
+create foreign table jit_grp (id int not null primary key, grp int, val int);
+insert into jit_grp values (1, 1, 10), (2, 1, null), (3, 1, 30), (4, 1, null);
+insert into jit_grp values (5, null, 5), (6, null, null), (7, null, 7);
+insert into jit_grp values (8, 2, null), (9, 2, null);
+insert into jit_grp values (10, 3, 1), (11, 3, 2), (12, 3, 3);
+-- each execution covers a single group, so the output order does not depend on the plan
+prepare jit_grp_q(int, int) as select grp, count(*), count(val), sum(val), min(val), max(val) from jit_grp where id >= $1 and id <= $2 group by grp;
+execute jit_grp_q(1, 4);
+execute jit_grp_q(5, 7);
+execute jit_grp_q(8, 9);
+execute jit_grp_q(10, 12);
+execute jit_grp_q(13, 20);
+execute jit_grp_q(1, 4);
+-- the statement runs through jitted code
+\o jit_group_by_explain.txt
+explain (costs off) execute jit_grp_q(1, 4);
+\o
+\! grep -o 'MOT JIT: [A-Za-z-]*' jit_group_by_explain.txt
+\! rm jit_group_by_explain.txt
+deallocate jit_grp_q;
+prepare jit_agg_q(int, int) as select count(*), count(val), sum(val), min(val), max(val) from jit_grp where id >= $1 and id <= $2;
+execute jit_agg_q(1, 12);
+execute jit_agg_q(8, 9);
+execute jit_agg_q(13, 20);
+deallocate jit_agg_q;
+drop foreign table jit_grp;
+-- three tables joined through their primary keys, one nested loop level per table
+create foreign table jit_region (id int not null primary key, code int);
+create foreign table jit_cust (id int not null primary key, region int);
+create foreign table jit_ord (id int not null primary key, cust int, amount int);
+insert into jit_region values (1, 100), (2, 200);
+insert into jit_cust values (1, 1), (2, 1), (3, 2), (4, 9);
+-- orders 7 and 8 have no region and no customer, the join drops them
+insert into jit_ord values (1, 1, 10), (2, 2, 20), (3, 1, null), (4, 2, 5), (5, 3, 7), (6, 3, 8), (7, 4, 100), (8, 9, 50);
+-- grouped, each execution covers a single group
+prepare jit_join_grp_q(int, int) as select r.code, count(*), count(o.amount), sum(o.amount), min(o.amount), max(o.amount) from jit_ord o, jit_cust c, jit_region r where o.id >= $1 and o.id <= $2 and c.id = o.cust and r.id = c.region group by r.code;
+execute jit_join_grp_q(1, 4);
+execute jit_join_grp_q(5, 8);
+execute jit_join_grp_q(7, 8);
+\o jit_group_by_explain.txt
+explain (costs off) execute jit_join_grp_q(1, 4);
+\o
+\! grep -o 'MOT JIT: [A-Za-z-]*' jit_group_by_explain.txt
+\! rm jit_group_by_explain.txt
+deallocate jit_join_grp_q;
+-- aggregates without GROUP BY
+prepare jit_join_agg_q(int, int) as select count(*), sum(o.amount), max(c.id), min(r.code) from jit_ord o, jit_cust c, jit_region r where o.id >= $1 and o.id <= $2 and c.id = o.cust and r.id = c.region;
+execute jit_join_agg_q(1, 8);
+execute jit_join_agg_q(7, 8);
+\o jit_group_by_explain.txt
+explain (costs off) execute jit_join_agg_q(1, 8);
+\o
+\! grep -o 'MOT JIT: [A-Za-z-]*' jit_group_by_explain.txt
+\! rm jit_group_by_explain.txt
+deallocate jit_join_agg_q;
+-- plain join, rows come in the order of the outer scan
+prepare jit_join_q(int, int) as select o.id, c.id, r.code from jit_ord o, jit_cust c, jit_region r where o.id >= $1 and o.id <= $2 and c.id = o.cust and r.id = c.region;
+execute jit_join_q(4, 8);
+execute jit_join_q(7, 8);
+\o jit_group_by_explain.txt
+explain (costs off) execute jit_join_q(4, 8);
+\o
+\! grep -o 'MOT JIT: [A-Za-z-]*' jit_group_by_explain.txt
+\! rm jit_group_by_explain.txt
+deallocate jit_join_q;
+-- plain join with a limit, the scan stops once the limit is reached (all qualifying rows are alike)
+prepare jit_join_limit_q(int) as select r.code from jit_ord o, jit_cust c, jit_region r where o.id >= $1 and c.id = o.cust and r.id = c.region and r.id = 1 limit 2;
+execute jit_join_limit_q(1);
+execute jit_join_limit_q(4);
+execute jit_join_limit_q(5);
+\o jit_group_by_explain.txt
+explain (costs off) execute jit_join_limit_q(1);
+\o
+\! grep -o 'MOT JIT: [A-Za-z-]*' jit_group_by_explain.txt
+\! rm jit_group_by_explain.txt
+deallocate jit_join_limit_q;
+drop foreign table jit_ord;
+drop foreign table jit_cust;
+drop foreign table jit_region;
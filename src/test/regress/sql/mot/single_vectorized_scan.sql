@@ -0,0 +1,14 @@
+create foreign table vec_test (id int not null primary key, grp int, val int, name varchar(20));
+insert into vec_test select g, case when g % 7 = 0 then null else g % 5 end, case when g % 11 = 0 then null else g end, case when g % 13 = 0 then null else 'name' || (g % 3) end from generate_series(1, 3000) g;
+set enable_vector_engine = on;
+select count(*), count(grp), count(val), count(name) from vec_test;
+select count(*), sum(val) from vec_test where val > 1500;
+select count(*) from vec_test where grp is null;
+select count(*) from vec_test where name is null and val is not null;
+select grp, count(*), sum(val), min(val), max(val) from vec_test where id <= 2000 group by grp order by grp;
+select name, count(*) from vec_test where val between 100 and 300 group by name order by name;
+select id, grp, val, name from vec_test where id > 2990 order by id;
+update vec_test set val = null where id <= 10;
+select count(val), sum(val) from vec_test where id <= 20;
+reset enable_vector_engine;
+drop foreign table vec_test;